@@ -38,6 +38,7 @@
 #include "Open3D/IO/ClassIO/PinholeCameraTrajectoryIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -56,6 +57,7 @@ void OptimizeImageCoorNonrigid(
         const std::vector<std::vector<int>>& visiblity_image_to_vertex,
         std::vector<double>& proxy_intensity,
         const ColorMapOptimizationOption& option) {
+    OPEN3D_PROFILE_ZONE("ColorMapOptimization::OptimizeNonRigid");
     auto n_vertex = mesh.vertices_.size();
     int n_camera = int(camera.parameters_.size());
     SetProxyIntensityForVertex(mesh, images_gray, warping_fields, camera,
@@ -153,6 +155,7 @@ void OptimizeImageCoorRigid(
         const std::vector<std::vector<int>>& visiblity_image_to_vertex,
         std::vector<double>& proxy_intensity,
         const ColorMapOptimizationOption& option) {
+    OPEN3D_PROFILE_ZONE("ColorMapOptimization::OptimizeRigid");
     int total_num_ = 0;
     int n_camera = int(camera.parameters_.size());
     SetProxyIntensityForVertex(mesh, images_gray, camera,
@@ -221,6 +224,7 @@ std::tuple<std::vector<std::shared_ptr<geometry::Image>>,
            std::vector<std::shared_ptr<geometry::Image>>>
 CreateGradientImages(
         const std::vector<std::shared_ptr<geometry::RGBDImage>>& images_rgbd) {
+    OPEN3D_PROFILE_ZONE("ColorMapOptimization::CreateGradientImages");
     std::vector<std::shared_ptr<geometry::Image>> images_gray;
     std::vector<std::shared_ptr<geometry::Image>> images_dx;
     std::vector<std::shared_ptr<geometry::Image>> images_dy;
@@ -247,6 +251,7 @@ CreateGradientImages(
 std::vector<std::shared_ptr<geometry::Image>> CreateDepthBoundaryMasks(
         const std::vector<std::shared_ptr<geometry::Image>>& images_depth,
         const ColorMapOptimizationOption& option) {
+    OPEN3D_PROFILE_ZONE("ColorMapOptimization::CreateDepthBoundaryMasks");
     auto n_images = images_depth.size();
     std::vector<std::shared_ptr<geometry::Image>> masks;
     for (size_t i = 0; i < n_images; i++) {
@@ -281,6 +286,7 @@ void ColorMapOptimization(
         camera::PinholeCameraTrajectory& camera,
         const ColorMapOptimizationOption& option
         /* = ColorMapOptimizationOption()*/) {
+    OPEN3D_PROFILE_ZONE("ColorMapOptimization");
     utility::LogDebug("[ColorMapOptimization]\n");
     std::vector<std::shared_ptr<geometry::Image>> images_gray, images_dx,
             images_dy, images_color, images_depth;
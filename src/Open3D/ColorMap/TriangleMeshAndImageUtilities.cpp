@@ -32,6 +32,8 @@
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Utility/Parallel.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 namespace color_map {
@@ -59,6 +61,8 @@ CreateVertexAndImageVisibility(
         const camera::PinholeCameraTrajectory& camera,
         double maximum_allowable_depth,
         double depth_threshold_for_visiblity_check) {
+    OPEN3D_PROFILE_ZONE("ColorMapOptimization::VertexAndImageVisibility");
+    OPEN3D_PROFILE_POINTS(mesh.vertices_.size());
     auto n_camera = camera.parameters_.size();
     auto n_vertex = mesh.vertices_.size();
     std::vector<std::vector<int>> visiblity_vertex_to_image;
@@ -164,10 +168,7 @@ void SetProxyIntensityForVertex(
     auto n_vertex = mesh.vertices_.size();
     proxy_intensity.resize(n_vertex);
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < int(n_vertex); i++) {
+    utility::ParallelFor(0, int(n_vertex), [&](int i) {
         proxy_intensity[i] = 0.0;
         float sum = 0.0;
         for (size_t iter = 0; iter < visiblity_vertex_to_image[i].size();
@@ -186,7 +187,7 @@ void SetProxyIntensityForVertex(
         if (sum > 0) {
             proxy_intensity[i] /= sum;
         }
-    }
+    });
 }
 
 void SetProxyIntensityForVertex(
@@ -199,10 +200,7 @@ void SetProxyIntensityForVertex(
     auto n_vertex = mesh.vertices_.size();
     proxy_intensity.resize(n_vertex);
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < int(n_vertex); i++) {
+    utility::ParallelFor(0, int(n_vertex), [&](int i) {
         proxy_intensity[i] = 0.0;
         float sum = 0.0;
         for (size_t iter = 0; iter < visiblity_vertex_to_image[i].size();
@@ -221,7 +219,7 @@ void SetProxyIntensityForVertex(
         if (sum > 0) {
             proxy_intensity[i] /= sum;
         }
-    }
+    });
 }
 
 void SetGeometryColorAverage(
@@ -231,6 +229,7 @@ void SetGeometryColorAverage(
         const std::vector<std::vector<int>>& visiblity_vertex_to_image,
         int image_boundary_margin /*= 10*/,
         int invisible_vertex_color_knn /*= 3*/) {
+    OPEN3D_PROFILE_ZONE("ColorMapOptimization::SetGeometryColorAverage");
     size_t n_vertex = mesh.vertices_.size();
     mesh.vertex_colors_.clear();
     mesh.vertex_colors_.resize(n_vertex);
@@ -280,10 +279,7 @@ void SetGeometryColorAverage(
         std::shared_ptr<geometry::TriangleMesh> valid_mesh =
                 mesh.SelectDownSample(valid_vertices);
         geometry::KDTreeFlann kd_tree(*valid_mesh);
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-        for (int i = 0; i < (int)invalid_vertices.size(); ++i) {
+        utility::ParallelFor(0, (int)invalid_vertices.size(), [&](int i) {
             size_t invalid_vertex = invalid_vertices[i];
             std::vector<int> indices;  // indices to valid_mesh
             std::vector<double> dists;
@@ -297,7 +293,7 @@ void SetGeometryColorAverage(
                 new_color /= indices.size();
             }
             mesh.vertex_colors_[invalid_vertex] = new_color;
-        }
+        });
     }
 }
 
@@ -309,6 +305,7 @@ void SetGeometryColorAverage(
         const std::vector<std::vector<int>>& visiblity_vertex_to_image,
         int image_boundary_margin /*= 10*/,
         int invisible_vertex_color_knn /*= 3*/) {
+    OPEN3D_PROFILE_ZONE("ColorMapOptimization::SetGeometryColorAverage");
     size_t n_vertex = mesh.vertices_.size();
     mesh.vertex_colors_.clear();
     mesh.vertex_colors_.resize(n_vertex);
@@ -358,10 +355,7 @@ void SetGeometryColorAverage(
         std::shared_ptr<geometry::TriangleMesh> valid_mesh =
                 mesh.SelectDownSample(valid_vertices);
         geometry::KDTreeFlann kd_tree(*valid_mesh);
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-        for (int i = 0; i < (int)invalid_vertices.size(); ++i) {
+        utility::ParallelFor(0, (int)invalid_vertices.size(), [&](int i) {
             size_t invalid_vertex = invalid_vertices[i];
             std::vector<int> indices;  // indices to valid_mesh
             std::vector<double> dists;
@@ -375,7 +369,7 @@ void SetGeometryColorAverage(
                 new_color /= indices.size();
             }
             mesh.vertex_colors_[invalid_vertex] = new_color;
-        }
+        });
     }
 }
 }  // namespace color_map
@@ -24,14 +24,18 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <limits>
 #include <numeric>
 #include <unordered_map>
 
+#include "Open3D/Geometry/FixedRadiusIndex.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Helper.h"
+#include "Open3D/Utility/Parallel.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -146,6 +150,7 @@ std::shared_ptr<PointCloud> PointCloud::SelectDownSample(
     auto output = std::make_shared<PointCloud>();
     bool has_normals = HasNormals();
     bool has_colors = HasColors();
+    bool has_covariances = HasCovariances();
 
     std::vector<bool> mask = std::vector<bool>(points_.size(), invert);
     for (size_t i : indices) {
@@ -157,6 +162,9 @@ std::shared_ptr<PointCloud> PointCloud::SelectDownSample(
             output->points_.push_back(points_[i]);
             if (has_normals) output->normals_.push_back(normals_[i]);
             if (has_colors) output->colors_.push_back(colors_[i]);
+            if (has_covariances) {
+                output->covariances_.push_back(covariances_[i]);
+            }
         }
     }
     utility::LogDebug(
@@ -248,6 +256,8 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SelectDownSample(
 
 std::shared_ptr<PointCloud> PointCloud::VoxelDownSample(
         double voxel_size) const {
+    OPEN3D_PROFILE_ZONE("PointCloud::VoxelDownSample");
+    OPEN3D_PROFILE_POINTS(points_.size());
     auto output = std::make_shared<PointCloud>();
     if (voxel_size <= 0.0) {
         utility::LogWarning("[VoxelDownSample] voxel_size <= 0.\n");
@@ -373,6 +383,65 @@ std::shared_ptr<PointCloud> PointCloud::UniformDownSample(
     return SelectDownSample(indices);
 }
 
+std::shared_ptr<PointCloud> PointCloud::OrganizedDownSample(
+        int factor) const {
+    if (!IsOrganized()) {
+        utility::LogWarning(
+                "[OrganizedDownSample] The point cloud is not organized.\n");
+        return std::make_shared<PointCloud>();
+    }
+    if (factor < 1) {
+        utility::LogWarning("[OrganizedDownSample] Illegal factor.\n");
+        return std::make_shared<PointCloud>();
+    }
+    auto output = std::make_shared<PointCloud>();
+    output->width_ = (width_ + factor - 1) / factor;
+    output->height_ = (height_ + factor - 1) / factor;
+    const size_t num_points = size_t(output->width_) * output->height_;
+    output->points_.resize(num_points);
+    if (HasNormals()) {
+        output->normals_.resize(num_points);
+    }
+    if (HasColors()) {
+        output->colors_.resize(num_points);
+    }
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    utility::ParallelFor(0, output->height_, [&](int v) {
+        const int v1 = std::min((v + 1) * factor, height_);
+        for (int u = 0; u < output->width_; u++) {
+            const int u1 = std::min((u + 1) * factor, width_);
+            AccumulatedPoint accumulated_point;
+            for (int sv = v * factor; sv < v1; sv++) {
+                for (int su = u * factor; su < u1; su++) {
+                    const int index = sv * width_ + su;
+                    if (points_[index].allFinite()) {
+                        accumulated_point.AddPoint(*this, index);
+                    }
+                }
+            }
+            const size_t i = size_t(v) * output->width_ + u;
+            if (accumulated_point.num_of_points_ > 0) {
+                output->points_[i] = accumulated_point.GetAveragePoint();
+                if (HasNormals()) {
+                    output->normals_[i] = accumulated_point.GetAverageNormal();
+                }
+                if (HasColors()) {
+                    output->colors_[i] = accumulated_point.GetAverageColor();
+                }
+            } else {
+                output->points_[i] = Eigen::Vector3d::Constant(nan);
+                if (HasNormals()) {
+                    output->normals_[i] = Eigen::Vector3d::Constant(nan);
+                }
+                if (HasColors()) {
+                    output->colors_[i] = Eigen::Vector3d::Zero();
+                }
+            }
+        }
+    });
+    return output;
+}
+
 std::shared_ptr<PointCloud> PointCloud::Crop(
         const Eigen::Vector3d &min_bound,
         const Eigen::Vector3d &max_bound) const {
@@ -403,19 +472,12 @@ PointCloud::RemoveRadiusOutliers(size_t nb_points, double search_radius) const {
         return std::make_tuple(std::make_shared<PointCloud>(),
                                std::vector<size_t>());
     }
-    KDTreeFlann kdtree;
-    kdtree.SetGeometry(*this);
-    std::vector<bool> mask = std::vector<bool>(points_.size());
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < int(points_.size()); i++) {
-        std::vector<int> tmp_indices;
-        std::vector<double> dist;
-        size_t nb_neighbors = kdtree.SearchRadius(points_[i], search_radius,
-                                                  tmp_indices, dist);
+    FixedRadiusIndex index(search_radius, *this);
+    std::vector<uint8_t> mask(points_.size());
+    utility::ParallelFor(0, int(points_.size()), [&](int i) {
+        size_t nb_neighbors = index.CountRadius(points_[i], search_radius);
         mask[i] = (nb_neighbors > nb_points);
-    }
+    });
     std::vector<size_t> indices;
     for (size_t i = 0; i < mask.size(); i++) {
         if (mask[i]) {
@@ -425,6 +487,67 @@ PointCloud::RemoveRadiusOutliers(size_t nb_points, double search_radius) const {
     return std::make_tuple(SelectDownSample(indices), indices);
 }
 
+std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
+PointCloud::RemoveOrganizedRadiusOutliers(size_t nb_points,
+                                          double search_radius,
+                                          int window_radius /* = 2*/) const {
+    if (!IsOrganized()) {
+        utility::LogWarning(
+                "[RemoveOrganizedRadiusOutliers] The point cloud is not "
+                "organized.\n");
+        return std::make_tuple(std::make_shared<PointCloud>(),
+                               std::vector<size_t>());
+    }
+    if (nb_points < 1 || search_radius <= 0 || window_radius < 1) {
+        utility::LogWarning(
+                "[RemoveOrganizedRadiusOutliers] Illegal input parameters, "
+                "number of points, radius and window radius must be "
+                "positive\n");
+        return std::make_tuple(std::make_shared<PointCloud>(),
+                               std::vector<size_t>());
+    }
+    const double search_radius2 = search_radius * search_radius;
+    std::vector<uint8_t> mask(points_.size(), 0);
+    utility::ParallelFor(0, height_, [&](int v) {
+        const int v0 = std::max(v - window_radius, 0);
+        const int v1 = std::min(v + window_radius, height_ - 1);
+        for (int u = 0; u < width_; u++) {
+            const int u0 = std::max(u - window_radius, 0);
+            const int u1 = std::min(u + window_radius, width_ - 1);
+            const Eigen::Vector3d &point = points_[v * width_ + u];
+            if (!point.allFinite()) {
+                continue;
+            }
+            // Like RemoveRadiusOutliers, the point itself is counted
+            size_t nb_neighbors = 0;
+            for (int nv = v0; nv <= v1; nv++) {
+                for (int nu = u0; nu <= u1; nu++) {
+                    if ((points_[nv * width_ + nu] - point).squaredNorm() <=
+                        search_radius2) {
+                        nb_neighbors++;
+                    }
+                }
+            }
+            mask[v * width_ + u] = (nb_neighbors > nb_points);
+        }
+    });
+    auto output = std::make_shared<PointCloud>(*this);
+    const Eigen::Vector3d invalid_point =
+            Eigen::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN());
+    std::vector<size_t> indices;
+    for (size_t i = 0; i < mask.size(); i++) {
+        if (mask[i]) {
+            indices.push_back(i);
+        } else {
+            output->points_[i] = invalid_point;
+            if (output->HasNormals()) {
+                output->normals_[i] = invalid_point;
+            }
+        }
+    }
+    return std::make_tuple(output, indices);
+}
+
 std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
 PointCloud::RemoveStatisticalOutliers(size_t nb_neighbors,
                                       double std_ratio) const {
@@ -445,10 +568,7 @@ PointCloud::RemoveStatisticalOutliers(size_t nb_neighbors,
     std::vector<double> avg_distances = std::vector<double>(points_.size());
     std::vector<size_t> indices;
     size_t valid_distances = 0;
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < int(points_.size()); i++) {
+    utility::ParallelFor(0, int(points_.size()), [&](int i) {
         std::vector<int> tmp_indices;
         std::vector<double> dist;
         kdtree.SearchKNN(points_[i], int(nb_neighbors), tmp_indices, dist);
@@ -460,7 +580,7 @@ PointCloud::RemoveStatisticalOutliers(size_t nb_neighbors,
             mean = std::accumulate(dist.begin(), dist.end(), 0.0) / dist.size();
         }
         avg_distances[i] = mean;
-    }
+    });
     if (valid_distances == 0) {
         return std::make_tuple(std::make_shared<PointCloud>(),
                                std::vector<size_t>());
@@ -0,0 +1,354 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/DynamicKDTree.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Open3D/Geometry/HalfEdgeTriangleMesh.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace geometry {
+
+DynamicKDTree::DynamicKDTree() {}
+
+DynamicKDTree::DynamicKDTree(const Eigen::MatrixXd &data) {
+    SetMatrixData(data);
+}
+
+DynamicKDTree::DynamicKDTree(const Geometry &geometry) {
+    SetGeometry(geometry);
+}
+
+DynamicKDTree::~DynamicKDTree() {}
+
+bool DynamicKDTree::SetMatrixData(const Eigen::MatrixXd &data) {
+    if (data.rows() != 3) {
+        utility::LogWarning(
+                "[DynamicKDTree::SetMatrixData] Failed due to dimension {:d} "
+                "instead of 3.\n",
+                data.rows());
+        return false;
+    }
+    std::vector<Eigen::Vector3d> points(data.cols());
+    for (size_t i = 0; i < points.size(); i++) {
+        points[i] = data.col(i);
+    }
+    Clear();
+    AddPoints(points);
+    return true;
+}
+
+bool DynamicKDTree::SetGeometry(const Geometry &geometry) {
+    switch (geometry.GetGeometryType()) {
+        case Geometry::GeometryType::PointCloud:
+            Clear();
+            AddPoints(((const PointCloud &)geometry).points_);
+            return true;
+        case Geometry::GeometryType::TriangleMesh:
+        case Geometry::GeometryType::HalfEdgeTriangleMesh:
+            Clear();
+            AddPoints(((const TriangleMesh &)geometry).vertices_);
+            return true;
+        case Geometry::GeometryType::Image:
+        case Geometry::GeometryType::Unspecified:
+        default:
+            utility::LogWarning(
+                    "[DynamicKDTree::SetGeometry] Unsupported Geometry "
+                    "type.\n");
+            return false;
+    }
+}
+
+void DynamicKDTree::Clear() {
+    points_.clear();
+    removed_.clear();
+    num_removed_ = 0;
+    levels_.clear();
+    buffer_.clear();
+    blocks_.clear();
+}
+
+void DynamicKDTree::AddPoints(const std::vector<Eigen::Vector3d> &points) {
+    for (const auto &point : points) {
+        buffer_.push_back(int(points_.size()));
+        points_.push_back(point);
+        removed_.push_back(false);
+        levels_.push_back(-1);
+    }
+    if (buffer_.size() >= size_t(kBufferSize)) {
+        FlushBuffer();
+    }
+}
+
+void DynamicKDTree::RemovePoints(const std::vector<size_t> &indices) {
+    for (size_t index : indices) {
+        if (index >= points_.size() || removed_[index]) {
+            continue;
+        }
+        removed_[index] = true;
+        num_removed_++;
+        if (levels_[index] < 0) {
+            auto it = std::find(buffer_.begin(), buffer_.end(), int(index));
+            *it = buffer_.back();
+            buffer_.pop_back();
+        } else {
+            blocks_[levels_[index]].num_removed_++;
+        }
+    }
+    for (size_t level = 0; level < blocks_.size(); level++) {
+        Block &block = blocks_[level];
+        if (block.num_removed_ * 2 > block.indices_.size()) {
+            std::vector<int> indices;
+            for (int index : block.indices_) {
+                if (!removed_[index]) {
+                    indices.push_back(index);
+                }
+            }
+            BuildBlock(level, indices);
+        }
+    }
+}
+
+void DynamicKDTree::FlushBuffer() {
+    std::vector<int> indices;
+    indices.swap(buffer_);
+    size_t level = 0;
+    while (level < blocks_.size() &&
+           (blocks_[level].kdtree_ ||
+            indices.size() > (size_t(kBufferSize) << level))) {
+        for (int index : blocks_[level].indices_) {
+            if (!removed_[index]) {
+                indices.push_back(index);
+            }
+        }
+        blocks_[level] = Block();
+        level++;
+    }
+    while (indices.size() > (size_t(kBufferSize) << level)) {
+        level++;
+    }
+    if (level >= blocks_.size()) {
+        blocks_.resize(level + 1);
+    }
+    // The points of a block are sorted by index, so that the blocks order
+    // points at equal distances like a single tree.
+    std::sort(indices.begin(), indices.end());
+    BuildBlock(level, indices);
+}
+
+void DynamicKDTree::BuildBlock(size_t level, std::vector<int> &indices) {
+    Block &block = blocks_[level];
+    block.num_removed_ = 0;
+    block.indices_.swap(indices);
+    if (block.indices_.empty()) {
+        block.kdtree_.reset();
+        return;
+    }
+    Eigen::MatrixXd data(3, block.indices_.size());
+    block.min_bound_ = points_[block.indices_[0]];
+    block.max_bound_ = block.min_bound_;
+    for (size_t i = 0; i < block.indices_.size(); i++) {
+        const Eigen::Vector3d &point = points_[block.indices_[i]];
+        data.col(i) = point;
+        block.min_bound_ = block.min_bound_.cwiseMin(point);
+        block.max_bound_ = block.max_bound_.cwiseMax(point);
+        levels_[block.indices_[i]] = int(level);
+    }
+    block.kdtree_.reset(new StaticKDTree<double, 3>(data));
+}
+
+void DynamicKDTree::SearchNeighbors(
+        const Eigen::Vector3d &query,
+        double radius,
+        int max_nn,
+        std::vector<std::pair<double, int>> &neighbors,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const {
+    // The squared distances are computed as in StaticKDTree.
+    const double radius2 = double(float(radius * radius));
+    for (int index : buffer_) {
+        const Eigen::Vector3d &point = points_[index];
+        double dist2 = 0;
+        for (int d = 0; d < 3; d++) {
+            const double diff = query(d) - point(d);
+            dist2 += diff * diff;
+        }
+        if (dist2 < radius2) {
+            neighbors.push_back(std::make_pair(dist2, index));
+        }
+    }
+
+    // The largest blocks are searched first. Once max_nn neighbors are
+    // found, the next blocks are searched within a radius a little larger
+    // than the distance to the farthest of them, and blocks whose bounds are
+    // out of the radius are skipped.
+    for (auto block = blocks_.rbegin(); block != blocks_.rend(); block++) {
+        if (!block->kdtree_) {
+            continue;
+        }
+        double block_radius = radius;
+        if (max_nn > 0 && neighbors.size() >= size_t(max_nn)) {
+            std::nth_element(neighbors.begin(), neighbors.begin() + max_nn - 1,
+                             neighbors.end());
+            neighbors.resize(max_nn);
+            block_radius = std::min(
+                    radius, std::sqrt(neighbors.back().first) * 1.0001);
+        }
+        double box_dist2 = 0;
+        for (int d = 0; d < 3; d++) {
+            const double diff =
+                    std::max(std::max(block->min_bound_(d) - query(d),
+                                      query(d) - block->max_bound_(d)),
+                             0.0);
+            box_dist2 += diff * diff;
+        }
+        if (box_dist2 >= double(float(block_radius * block_radius))) {
+            continue;
+        }
+        if (max_nn < 0) {
+            block->kdtree_->SearchRadius(query, radius, indices, distance2);
+        } else {
+            block->kdtree_->SearchHybrid(query, block_radius,
+                                         max_nn + int(block->num_removed_),
+                                         indices, distance2);
+        }
+        for (size_t i = 0; i < indices.size(); i++) {
+            int index = block->indices_[indices[i]];
+            if (!removed_[index]) {
+                neighbors.push_back(std::make_pair(distance2[i], index));
+            }
+        }
+    }
+}
+
+template <typename T>
+int DynamicKDTree::Search(const T &query,
+                          const KDTreeSearchParam &param,
+                          std::vector<int> &indices,
+                          std::vector<double> &distance2) const {
+    switch (param.GetSearchType()) {
+        case KDTreeSearchParam::SearchType::Knn:
+            return SearchKNN(query, ((const KDTreeSearchParamKNN &)param).knn_,
+                             indices, distance2);
+        case KDTreeSearchParam::SearchType::Radius:
+            return SearchRadius(
+                    query, ((const KDTreeSearchParamRadius &)param).radius_,
+                    indices, distance2);
+        case KDTreeSearchParam::SearchType::Hybrid:
+            return SearchHybrid(
+                    query, ((const KDTreeSearchParamHybrid &)param).radius_,
+                    ((const KDTreeSearchParamHybrid &)param).max_nn_, indices,
+                    distance2);
+        default:
+            return -1;
+    }
+    return -1;
+}
+
+template <typename T>
+int DynamicKDTree::SearchKNN(const T &query,
+                             int knn,
+                             std::vector<int> &indices,
+                             std::vector<double> &distance2) const {
+    return SearchHybrid(query, std::numeric_limits<double>::infinity(), knn,
+                        indices, distance2);
+}
+
+template <typename T>
+int DynamicKDTree::SearchRadius(const T &query,
+                                double radius,
+                                std::vector<int> &indices,
+                                std::vector<double> &distance2) const {
+    if (query.rows() != 3) {
+        return -1;
+    }
+    std::vector<std::pair<double, int>> neighbors;
+    SearchNeighbors(query.template cast<double>(), radius, -1, neighbors,
+                    indices, distance2);
+    std::sort(neighbors.begin(), neighbors.end());
+    indices.resize(neighbors.size());
+    distance2.resize(neighbors.size());
+    for (size_t i = 0; i < neighbors.size(); i++) {
+        distance2[i] = neighbors[i].first;
+        indices[i] = neighbors[i].second;
+    }
+    return int(neighbors.size());
+}
+
+template <typename T>
+int DynamicKDTree::SearchHybrid(const T &query,
+                                double radius,
+                                int max_nn,
+                                std::vector<int> &indices,
+                                std::vector<double> &distance2) const {
+    if (query.rows() != 3 || max_nn < 0) {
+        return -1;
+    }
+    std::vector<std::pair<double, int>> neighbors;
+    SearchNeighbors(query.template cast<double>(), radius, max_nn, neighbors,
+                    indices, distance2);
+    size_t k = std::min(neighbors.size(), size_t(max_nn));
+    std::partial_sort(neighbors.begin(), neighbors.begin() + k,
+                      neighbors.end());
+    indices.resize(k);
+    distance2.resize(k);
+    for (size_t i = 0; i < k; i++) {
+        distance2[i] = neighbors[i].first;
+        indices[i] = neighbors[i].second;
+    }
+    return int(k);
+}
+
+template int DynamicKDTree::Search<Eigen::Vector3d>(
+        const Eigen::Vector3d &query,
+        const KDTreeSearchParam &param,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int DynamicKDTree::SearchKNN<Eigen::Vector3d>(
+        const Eigen::Vector3d &query,
+        int knn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int DynamicKDTree::SearchRadius<Eigen::Vector3d>(
+        const Eigen::Vector3d &query,
+        double radius,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int DynamicKDTree::SearchHybrid<Eigen::Vector3d>(
+        const Eigen::Vector3d &query,
+        double radius,
+        int max_nn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,141 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Open3D/Geometry/Geometry.h"
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/StaticKDTree.h"
+
+namespace open3d {
+namespace geometry {
+
+/// KD-tree over 3D points that supports adding and removing points.
+///
+/// The points are kept in StaticKDTree blocks whose capacities are
+/// kBufferSize times powers of two (the logarithmic method), so adding a
+/// point rebuilds O(log n) points amortized. Added points wait in a buffer of
+/// up to kBufferSize points that is searched linearly. Removed points are
+/// skipped by the searches until half of the points of their block are
+/// removed, then the block is rebuilt. The searches return the same results
+/// as a KDTreeFlann over the remaining points.
+class DynamicKDTree {
+public:
+    static const int kBufferSize = 256;
+
+public:
+    DynamicKDTree();
+    DynamicKDTree(const Eigen::MatrixXd &data);
+    DynamicKDTree(const Geometry &geometry);
+    ~DynamicKDTree();
+    DynamicKDTree(const DynamicKDTree &) = delete;
+    DynamicKDTree &operator=(const DynamicKDTree &) = delete;
+
+public:
+    /// Replaces the points by the columns of a 3 x N matrix.
+    bool SetMatrixData(const Eigen::MatrixXd &data);
+    bool SetGeometry(const Geometry &geometry);
+    /// Removes all the points, the next added points start from index 0.
+    void Clear();
+
+    /// Adds points, which get the indices following the points added before.
+    void AddPoints(const std::vector<Eigen::Vector3d> &points);
+    /// Removes the points with the given indices. The indices of the other
+    /// points do not change.
+    void RemovePoints(const std::vector<size_t> &indices);
+    /// Returns the number of points that were added and not removed.
+    size_t GetSize() const { return points_.size() - num_removed_; }
+
+    template <typename T>
+    int Search(const T &query,
+               const KDTreeSearchParam &param,
+               std::vector<int> &indices,
+               std::vector<double> &distance2) const;
+
+    template <typename T>
+    int SearchKNN(const T &query,
+                  int knn,
+                  std::vector<int> &indices,
+                  std::vector<double> &distance2) const;
+
+    template <typename T>
+    int SearchRadius(const T &query,
+                     double radius,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2) const;
+
+    template <typename T>
+    int SearchHybrid(const T &query,
+                     double radius,
+                     int max_nn,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2) const;
+
+private:
+    struct Block {
+        std::unique_ptr<StaticKDTree<double, 3>> kdtree_;
+        /// Indices of the points of the block, in increasing order.
+        std::vector<int> indices_;
+        size_t num_removed_ = 0;
+        /// Bounds of the points of the block, including the removed ones.
+        Eigen::Vector3d min_bound_ = Eigen::Vector3d::Zero();
+        Eigen::Vector3d max_bound_ = Eigen::Vector3d::Zero();
+    };
+
+    /// Moves the buffered points into the first block that can hold them
+    /// together with the remaining points of the blocks before it.
+    void FlushBuffer();
+    /// Rebuilds the block of the given level from indices.
+    void BuildBlock(size_t level, std::vector<int> &indices);
+
+    /// Gathers the neighbors within radius that are not removed, including
+    /// at least the max_nn nearest if max_nn is not negative. indices and
+    /// distance2 hold the results of each block.
+    void SearchNeighbors(const Eigen::Vector3d &query,
+                         double radius,
+                         int max_nn,
+                         std::vector<std::pair<double, int>> &neighbors,
+                         std::vector<int> &indices,
+                         std::vector<double> &distance2) const;
+
+protected:
+    std::vector<Eigen::Vector3d> points_;
+    std::vector<bool> removed_;
+    size_t num_removed_ = 0;
+    /// Block level of each point, or -1 if the point is in buffer_.
+    std::vector<int> levels_;
+    std::vector<int> buffer_;
+    /// blocks_[l] holds at most kBufferSize * 2^l points, or is empty.
+    std::vector<Block> blocks_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -25,10 +25,14 @@
 // ----------------------------------------------------------------------------
 
 #include <Eigen/Eigenvalues>
+#include <limits>
 
+#include "Open3D/Geometry/FixedRadiusIndex.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -217,13 +221,37 @@ Eigen::Vector3d FastEigen3x3(Eigen::Matrix3d &A) {
     }
 }
 
+/// Normal of the points with the given mean moments, i.e. the mean of x, y, z,
+/// xx, xy, xz, yy, yz, zz.
+Eigen::Vector3d ComputeNormalFromCumulants(
+        const Eigen::Matrix<double, 9, 1> &cumulants,
+        bool fast_normal_computation) {
+    Eigen::Matrix3d covariance;
+    covariance(0, 0) = cumulants(3) - cumulants(0) * cumulants(0);
+    covariance(1, 1) = cumulants(6) - cumulants(1) * cumulants(1);
+    covariance(2, 2) = cumulants(8) - cumulants(2) * cumulants(2);
+    covariance(0, 1) = cumulants(4) - cumulants(0) * cumulants(1);
+    covariance(1, 0) = covariance(0, 1);
+    covariance(0, 2) = cumulants(5) - cumulants(0) * cumulants(2);
+    covariance(2, 0) = covariance(0, 2);
+    covariance(1, 2) = cumulants(7) - cumulants(1) * cumulants(2);
+    covariance(2, 1) = covariance(1, 2);
+
+    if (fast_normal_computation) {
+        return FastEigen3x3(covariance);
+    } else {
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+        solver.compute(covariance, Eigen::ComputeEigenvectors);
+        return solver.eigenvectors().col(0);
+    }
+}
+
 Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
                               const std::vector<int> &indices,
                               bool fast_normal_computation) {
     if (indices.size() == 0) {
         return Eigen::Vector3d::Zero();
     }
-    Eigen::Matrix3d covariance;
     Eigen::Matrix<double, 9, 1> cumulants;
     cumulants.setZero();
     for (size_t i = 0; i < indices.size(); i++) {
@@ -239,63 +267,249 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
         cumulants(8) += point(2) * point(2);
     }
     cumulants /= (double)indices.size();
-    covariance(0, 0) = cumulants(3) - cumulants(0) * cumulants(0);
-    covariance(1, 1) = cumulants(6) - cumulants(1) * cumulants(1);
-    covariance(2, 2) = cumulants(8) - cumulants(2) * cumulants(2);
-    covariance(0, 1) = cumulants(4) - cumulants(0) * cumulants(1);
-    covariance(1, 0) = covariance(0, 1);
-    covariance(0, 2) = cumulants(5) - cumulants(0) * cumulants(2);
-    covariance(2, 0) = covariance(0, 2);
-    covariance(1, 2) = cumulants(7) - cumulants(1) * cumulants(2);
-    covariance(2, 1) = covariance(1, 2);
+    return ComputeNormalFromCumulants(cumulants, fast_normal_computation);
+}
 
-    if (fast_normal_computation) {
-        return FastEigen3x3(covariance);
-    } else {
-        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
-        solver.compute(covariance, Eigen::ComputeEigenvectors);
-        return solver.eigenvectors().col(0);
+/// Normal of a pixel of an organized point cloud from the (unnormalized)
+/// moments of num_neighbors valid points in its window, following the
+/// conventions of PointCloud::EstimateNormals.
+Eigen::Vector3d ComputeOrganizedNormal(
+        const PointCloud &cloud,
+        int i,
+        double num_neighbors,
+        const Eigen::Matrix<double, 9, 1> &moments,
+        bool has_normal,
+        bool fast_normal_computation) {
+    if (!cloud.points_[i].allFinite()) {
+        return Eigen::Vector3d::Constant(
+                std::numeric_limits<double>::quiet_NaN());
     }
+    if (num_neighbors < 3) {
+        return Eigen::Vector3d(0.0, 0.0, 1.0);
+    }
+    Eigen::Vector3d normal = ComputeNormalFromCumulants(
+            moments / num_neighbors, fast_normal_computation);
+    if (normal.norm() == 0.0) {
+        if (has_normal) {
+            normal = cloud.normals_[i];
+        } else {
+            normal = Eigen::Vector3d(0.0, 0.0, 1.0);
+        }
+    }
+    if (has_normal && normal.dot(cloud.normals_[i]) < 0.0) {
+        normal *= -1.0;
+    }
+    return normal;
 }
 
-}  // unnamed namespace
+void AddMoments(const Eigen::Vector3d &point,
+                Eigen::Matrix<double, 9, 1> &moments) {
+    moments(0) += point(0);
+    moments(1) += point(1);
+    moments(2) += point(2);
+    moments(3) += point(0) * point(0);
+    moments(4) += point(0) * point(1);
+    moments(5) += point(0) * point(2);
+    moments(6) += point(1) * point(1);
+    moments(7) += point(1) * point(2);
+    moments(8) += point(2) * point(2);
+}
 
-namespace geometry {
+/// Computes the normals of an organized point cloud with a box filter over
+/// integral images of the point count and moments. The points are shifted by
+/// their mean to keep the moment sums well conditioned.
+void EstimateOrganizedNormalsWithIntegralImages(PointCloud &cloud,
+                                                int window_radius,
+                                                bool has_normal,
+                                                bool fast_normal_computation) {
+    typedef Eigen::Matrix<double, 10, 1> Entry;
+    const int width = cloud.width_;
+    const int height = cloud.height_;
+    const int stride = width + 1;
 
-bool PointCloud::EstimateNormals(
-        const KDTreeSearchParam &search_param /* = KDTreeSearchParamKNN()*/,
-        bool fast_normal_computation /* = true */) {
-    bool has_normal = HasNormals();
-    if (HasNormals() == false) {
-        normals_.resize(points_.size());
+    Eigen::Vector3d offset(0, 0, 0);
+    size_t num_valid = 0;
+    for (const auto &point : cloud.points_) {
+        if (point.allFinite()) {
+            offset += point;
+            num_valid++;
+        }
+    }
+    if (num_valid > 0) {
+        offset /= double(num_valid);
+    }
+
+    // integral[(v + 1) * stride + u + 1] sums the pixels in [0, u] x [0, v],
+    // entry 0 being the number of valid points.
+    std::vector<Entry, Eigen::aligned_allocator<Entry>> integral(
+            size_t(height + 1) * stride, Entry::Zero());
+    utility::ParallelFor(0, height, [&](int v) {
+        Entry row_sum = Entry::Zero();
+        for (int u = 0; u < width; u++) {
+            const Eigen::Vector3d &point = cloud.points_[v * width + u];
+            if (point.allFinite()) {
+                Eigen::Matrix<double, 9, 1> moments;
+                moments.setZero();
+                AddMoments(point - offset, moments);
+                row_sum(0) += 1.0;
+                row_sum.tail<9>() += moments;
+            }
+            integral[size_t(v + 1) * stride + u + 1] = row_sum;
+        }
+    });
+    for (int v = 1; v < height; v++) {
+        Entry *row = integral.data() + size_t(v + 1) * stride;
+        const Entry *prev_row = row - stride;
+        for (int u = 1; u <= width; u++) {
+            row[u] += prev_row[u];
+        }
     }
-    KDTreeFlann kdtree;
-    kdtree.SetGeometry(*this);
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)points_.size(); i++) {
+
+    utility::ParallelFor(0, height, [&](int v) {
+        const int v0 = std::max(v - window_radius, 0);
+        const int v1 = std::min(v + window_radius, height - 1) + 1;
+        for (int u = 0; u < width; u++) {
+            const int u0 = std::max(u - window_radius, 0);
+            const int u1 = std::min(u + window_radius, width - 1) + 1;
+            const Entry sum = integral[size_t(v1) * stride + u1] -
+                              integral[size_t(v0) * stride + u1] -
+                              integral[size_t(v1) * stride + u0] +
+                              integral[size_t(v0) * stride + u0];
+            const int i = v * width + u;
+            cloud.normals_[i] = ComputeOrganizedNormal(
+                    cloud, i, sum(0), sum.tail<9>(), has_normal,
+                    fast_normal_computation);
+        }
+    });
+}
+
+/// Computes the normals of an organized point cloud from the valid points in
+/// the pixel window that are within max_neighbor_distance of the center.
+void EstimateOrganizedNormalsInWindows(PointCloud &cloud,
+                                       int window_radius,
+                                       double max_neighbor_distance,
+                                       bool has_normal,
+                                       bool fast_normal_computation) {
+    const int width = cloud.width_;
+    const int height = cloud.height_;
+    const double max_distance2 = max_neighbor_distance * max_neighbor_distance;
+    utility::ParallelFor(0, height, [&](int v) {
+        const int v0 = std::max(v - window_radius, 0);
+        const int v1 = std::min(v + window_radius, height - 1);
+        for (int u = 0; u < width; u++) {
+            const int u0 = std::max(u - window_radius, 0);
+            const int u1 = std::min(u + window_radius, width - 1);
+            const int i = v * width + u;
+            const Eigen::Vector3d &center = cloud.points_[i];
+            Eigen::Matrix<double, 9, 1> moments;
+            moments.setZero();
+            double num_neighbors = 0;
+            if (center.allFinite()) {
+                for (int nv = v0; nv <= v1; nv++) {
+                    for (int nu = u0; nu <= u1; nu++) {
+                        // Moments relative to the center point
+                        const Eigen::Vector3d diff =
+                                cloud.points_[nv * width + nu] - center;
+                        if (diff.squaredNorm() <= max_distance2) {
+                            AddMoments(diff, moments);
+                            num_neighbors += 1;
+                        }
+                    }
+                }
+            }
+            cloud.normals_[i] =
+                    ComputeOrganizedNormal(cloud, i, num_neighbors, moments,
+                                           has_normal, fast_normal_computation);
+        }
+    });
+}
+
+/// Normals from the neighbors found in a KDTreeFlann or a FixedRadiusIndex.
+template <typename Index>
+void EstimateNormalsWithIndex(PointCloud &cloud,
+                              const Index &index,
+                              const KDTreeSearchParam &search_param,
+                              bool has_normal,
+                              bool fast_normal_computation) {
+    utility::ParallelFor(0, (int)cloud.points_.size(), [&](int i) {
         std::vector<int> indices;
         std::vector<double> distance2;
         Eigen::Vector3d normal;
-        if (kdtree.Search(points_[i], search_param, indices, distance2) >= 3) {
-            normal = ComputeNormal(*this, indices, fast_normal_computation);
+        if (index.Search(cloud.points_[i], search_param, indices,
+                         distance2) >= 3) {
+            normal = ComputeNormal(cloud, indices, fast_normal_computation);
             if (normal.norm() == 0.0) {
                 if (has_normal) {
-                    normal = normals_[i];
+                    normal = cloud.normals_[i];
                 } else {
                     normal = Eigen::Vector3d(0.0, 0.0, 1.0);
                 }
             }
-            if (has_normal && normal.dot(normals_[i]) < 0.0) {
+            if (has_normal && normal.dot(cloud.normals_[i]) < 0.0) {
                 normal *= -1.0;
             }
-            normals_[i] = normal;
+            cloud.normals_[i] = normal;
         } else {
-            normals_[i] = Eigen::Vector3d(0.0, 0.0, 1.0);
+            cloud.normals_[i] = Eigen::Vector3d(0.0, 0.0, 1.0);
         }
+    });
+}
+
+}  // unnamed namespace
+
+namespace geometry {
+
+bool PointCloud::EstimateNormals(
+        const KDTreeSearchParam &search_param /* = KDTreeSearchParamKNN()*/,
+        bool fast_normal_computation /* = true */) {
+    OPEN3D_PROFILE_ZONE("PointCloud::EstimateNormals");
+    OPEN3D_PROFILE_POINTS(points_.size());
+    bool has_normal = HasNormals();
+    if (HasNormals() == false) {
+        normals_.resize(points_.size());
+    }
+    double radius;
+    if (FixedRadiusIndex::IsSelectedBy(search_param, radius)) {
+        FixedRadiusIndex index(radius, *this);
+        EstimateNormalsWithIndex(*this, index, search_param, has_normal,
+                                 fast_normal_computation);
+    } else {
+        KDTreeFlann kdtree;
+        kdtree.SetGeometry(*this);
+        EstimateNormalsWithIndex(*this, kdtree, search_param, has_normal,
+                                 fast_normal_computation);
     }
+    return true;
+}
 
+bool PointCloud::EstimateNormalsOrganized(
+        int window_radius /* = 2*/,
+        double max_neighbor_distance /* = 0.0*/,
+        bool fast_normal_computation /* = true */) {
+    if (!IsOrganized()) {
+        utility::LogWarning(
+                "[EstimateNormalsOrganized] The point cloud is not "
+                "organized.\n");
+        return false;
+    }
+    if (window_radius < 1) {
+        utility::LogWarning(
+                "[EstimateNormalsOrganized] Illegal input parameters, window "
+                "radius must be positive.\n");
+        return false;
+    }
+    bool has_normal = HasNormals();
+    if (HasNormals() == false) {
+        normals_.resize(points_.size());
+    }
+    if (max_neighbor_distance > 0.0) {
+        EstimateOrganizedNormalsInWindows(*this, window_radius,
+                                          max_neighbor_distance, has_normal,
+                                          fast_normal_computation);
+    } else {
+        EstimateOrganizedNormalsWithIntegralImages(
+                *this, window_radius, has_normal, fast_normal_computation);
+    }
     return true;
 }
 
@@ -307,17 +521,14 @@ bool PointCloud::OrientNormalsToAlignWithDirection(
                 "[OrientNormalsToAlignWithDirection] No normals in the "
                 "PointCloud. Call EstimateNormals() first.\n");
     }
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)points_.size(); i++) {
+    utility::ParallelFor(0, (int)points_.size(), [&](int i) {
         auto &normal = normals_[i];
         if (normal.norm() == 0.0) {
             normal = orientation_reference;
         } else if (normal.dot(orientation_reference) < 0.0) {
             normal *= -1.0;
         }
-    }
+    });
     return true;
 }
 
@@ -328,10 +539,7 @@ bool PointCloud::OrientNormalsTowardsCameraLocation(
                 "[OrientNormalsTowardsCameraLocation] No normals in the "
                 "PointCloud. Call EstimateNormals() first.\n");
     }
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)points_.size(); i++) {
+    utility::ParallelFor(0, (int)points_.size(), [&](int i) {
         Eigen::Vector3d orientation_reference = camera_location - points_[i];
         auto &normal = normals_[i];
         if (normal.norm() == 0.0) {
@@ -344,7 +552,7 @@ bool PointCloud::OrientNormalsTowardsCameraLocation(
         } else if (normal.dot(orientation_reference) < 0.0) {
             normal *= -1.0;
         }
-    }
+    });
     return true;
 }
 }  // namespace geometry
@@ -0,0 +1,372 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/FixedRadiusIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+#include "Open3D/Geometry/HalfEdgeTriangleMesh.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
+
+namespace open3d {
+namespace geometry {
+
+namespace {
+
+/// Converts a floored cell coordinate to an integer. Out of range and
+/// non-finite coordinates would make the conversion undefined, so they are
+/// clamped first. The clamping is monotonic, so a range of cells still
+/// contains the clamped cell of every point within it.
+int64_t ToCellCoordinate(double cell) {
+    const double max_cell = double(int64_t(1) << 52);
+    if (!(cell > -max_cell)) {
+        return -int64_t(max_cell);
+    }
+    if (!(cell < max_cell)) {
+        return int64_t(max_cell);
+    }
+    return int64_t(cell);
+}
+
+}  // unnamed namespace
+
+FixedRadiusIndex::FixedRadiusIndex() {}
+
+FixedRadiusIndex::FixedRadiusIndex(double cell_size,
+                                   const Eigen::MatrixXd &data)
+    : cell_size_(cell_size) {
+    SetMatrixData(data);
+}
+
+FixedRadiusIndex::FixedRadiusIndex(double cell_size, const Geometry &geometry)
+    : cell_size_(cell_size) {
+    SetGeometry(geometry);
+}
+
+FixedRadiusIndex::~FixedRadiusIndex() {}
+
+bool FixedRadiusIndex::SetMatrixData(const Eigen::MatrixXd &data) {
+    return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+            data.data(), data.rows(), data.cols()));
+}
+
+bool FixedRadiusIndex::SetGeometry(const Geometry &geometry) {
+    switch (geometry.GetGeometryType()) {
+        case Geometry::GeometryType::PointCloud:
+            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+                    (const double *)((const PointCloud &)geometry)
+                            .points_.data(),
+                    3, ((const PointCloud &)geometry).points_.size()));
+        case Geometry::GeometryType::TriangleMesh:
+        case Geometry::GeometryType::HalfEdgeTriangleMesh:
+            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+                    (const double *)((const TriangleMesh &)geometry)
+                            .vertices_.data(),
+                    3, ((const TriangleMesh &)geometry).vertices_.size()));
+        case Geometry::GeometryType::Image:
+        case Geometry::GeometryType::Unspecified:
+        default:
+            utility::LogWarning(
+                    "[FixedRadiusIndex::SetGeometry] Unsupported Geometry "
+                    "type.\n");
+            return false;
+    }
+}
+
+template <typename T>
+int FixedRadiusIndex::Search(const T &query,
+                             const KDTreeSearchParam &param,
+                             std::vector<int> &indices,
+                             std::vector<double> &distance2) const {
+    switch (param.GetSearchType()) {
+        case KDTreeSearchParam::SearchType::Radius:
+            return SearchRadius(
+                    query, ((const KDTreeSearchParamRadius &)param).radius_,
+                    indices, distance2);
+        case KDTreeSearchParam::SearchType::Hybrid:
+            return SearchHybrid(
+                    query, ((const KDTreeSearchParamHybrid &)param).radius_,
+                    ((const KDTreeSearchParamHybrid &)param).max_nn_, indices,
+                    distance2);
+        case KDTreeSearchParam::SearchType::Knn:
+        default:
+            return -1;
+    }
+    return -1;
+}
+
+template <typename T>
+int FixedRadiusIndex::SearchRadius(const T &query,
+                                   double radius,
+                                   std::vector<int> &indices,
+                                   std::vector<double> &distance2) const {
+    return SearchHybrid(query, radius, std::numeric_limits<int>::max(),
+                        indices, distance2);
+}
+
+template <typename T>
+int FixedRadiusIndex::SearchHybrid(const T &query,
+                                   double radius,
+                                   int max_nn,
+                                   std::vector<int> &indices,
+                                   std::vector<double> &distance2) const {
+    indices.clear();
+    distance2.clear();
+    if (points_.empty() || max_nn < 0) {
+        return -1;
+    }
+    std::vector<std::pair<double, int>> neighbors;
+    ForEachNeighbor(query.template cast<double>(), radius,
+                    [&](int index, double dist2) {
+                        neighbors.emplace_back(dist2, index);
+                    });
+    const size_t k = std::min(neighbors.size(), size_t(max_nn));
+    std::partial_sort(neighbors.begin(), neighbors.begin() + k,
+                      neighbors.end());
+    indices.resize(k);
+    distance2.resize(k);
+    for (size_t i = 0; i < k; i++) {
+        indices[i] = neighbors[i].second;
+        distance2[i] = neighbors[i].first;
+    }
+    return int(k);
+}
+
+template <typename T>
+int FixedRadiusIndex::CountRadius(const T &query, double radius) const {
+    if (points_.empty()) {
+        return -1;
+    }
+    int count = 0;
+    ForEachNeighbor(query.template cast<double>(), radius,
+                    [&](int, double) { count++; });
+    return count;
+}
+
+bool FixedRadiusIndex::IsSelectedBy(const KDTreeSearchParam &param,
+                                    double &radius) {
+    if (param.GetIndexType() != KDTreeSearchParam::IndexType::FixedRadius) {
+        return false;
+    }
+    switch (param.GetSearchType()) {
+        case KDTreeSearchParam::SearchType::Radius:
+            radius = ((const KDTreeSearchParamRadius &)param).radius_;
+            return true;
+        case KDTreeSearchParam::SearchType::Hybrid:
+            radius = ((const KDTreeSearchParamHybrid &)param).radius_;
+            return true;
+        case KDTreeSearchParam::SearchType::Knn:
+        default:
+            utility::LogWarning(
+                    "[FixedRadiusIndex] Only supports radius and hybrid "
+                    "searches, using KDTreeFlann instead.\n");
+            return false;
+    }
+}
+
+bool FixedRadiusIndex::SetRawData(
+        const Eigen::Map<const Eigen::MatrixXd> &data) {
+    bucket_offsets_.clear();
+    points_.clear();
+    indices_.clear();
+    if (data.rows() != 3 || data.cols() == 0) {
+        utility::LogWarning(
+                "[FixedRadiusIndex::SetRawData] Failed due to no 3D data.\n");
+        return false;
+    }
+    if (!(cell_size_ > 0.0) || !std::isfinite(cell_size_)) {
+        utility::LogWarning(
+                "[FixedRadiusIndex::SetRawData] Cell size must be "
+                "positive.\n");
+        return false;
+    }
+    const int num_points = int(data.cols());
+
+    // Non-finite points are never within radius of a query, skip them
+    origin_ = Eigen::Vector3d::Constant(std::numeric_limits<double>::max());
+    for (int i = 0; i < num_points; i++) {
+        if (data.col(i).allFinite()) {
+            origin_ = origin_.cwiseMin(data.col(i));
+        }
+    }
+
+    size_t num_buckets = 1;
+    while (num_buckets < 2 * size_t(num_points)) {
+        num_buckets *= 2;
+    }
+    bucket_mask_ = num_buckets - 1;
+
+    // Counting sort of the points by bucket. The buckets are computed in
+    // parallel and the points are scattered serially, so every bucket lists
+    // its points by increasing index.
+    std::vector<size_t> point_buckets(num_points, num_buckets);
+    utility::ParallelFor(0, num_points, [&](int i) {
+        const Eigen::Vector3d point = data.col(i);
+        if (!point.allFinite()) {
+            return;
+        }
+        const Eigen::Vector3d cell =
+                ((point - origin_) / cell_size_).array().floor();
+        point_buckets[i] = HashCell(ToCellCoordinate(cell(0)),
+                                    ToCellCoordinate(cell(1)),
+                                    ToCellCoordinate(cell(2)));
+    });
+    bucket_offsets_.assign(num_buckets + 1, 0);
+    for (size_t bucket : point_buckets) {
+        if (bucket < num_buckets) {
+            bucket_offsets_[bucket + 1]++;
+        }
+    }
+    for (size_t b = 0; b < num_buckets; b++) {
+        bucket_offsets_[b + 1] += bucket_offsets_[b];
+    }
+    std::vector<size_t> next_slot(bucket_offsets_.begin(),
+                                  bucket_offsets_.end() - 1);
+    indices_.resize(bucket_offsets_.back());
+    for (int i = 0; i < num_points; i++) {
+        const size_t bucket = point_buckets[i];
+        if (bucket < num_buckets) {
+            indices_[next_slot[bucket]++] = i;
+        }
+    }
+    points_.resize(indices_.size());
+    utility::ParallelFor(0, int(indices_.size()),
+                         [&](int k) { points_[k] = data.col(indices_[k]); });
+    return true;
+}
+
+size_t FixedRadiusIndex::HashCell(int64_t x, int64_t y, int64_t z) const {
+    return size_t((uint64_t(x) * 73856093) ^ (uint64_t(y) * 19349663) ^
+                  (uint64_t(z) * 83492791)) &
+           bucket_mask_;
+}
+
+template <typename F>
+void FixedRadiusIndex::ForEachNeighbor(const Eigen::Vector3d &query,
+                                       double radius,
+                                       F f) const {
+    if (!query.allFinite() || !(radius >= 0.0)) {
+        return;
+    }
+    // Same comparison as the flann radius search used by KDTreeFlann. The
+    // cell range is padded since the rounded radius can be slightly larger.
+    const double radius2 = double(float(radius * radius));
+    const double reach = std::sqrt(radius2) * (1.0 + 1e-6);
+    const Eigen::Vector3d min_corner =
+            ((query.array() - reach - origin_.array()) / cell_size_).floor();
+    const Eigen::Vector3d max_corner =
+            ((query.array() + reach - origin_.array()) / cell_size_).floor();
+    int64_t min_cell[3], max_cell[3];
+    double total_cells = 1.0;
+    for (int axis = 0; axis < 3; axis++) {
+        min_cell[axis] = ToCellCoordinate(min_corner(axis));
+        max_cell[axis] = ToCellCoordinate(max_corner(axis));
+        total_cells *= double(max_cell[axis] - min_cell[axis]) + 1.0;
+    }
+
+    auto visit_range = [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; k++) {
+            const double dist2 = (points_[k] - query).squaredNorm();
+            if (dist2 < radius2) {
+                f(indices_[k], dist2);
+            }
+        }
+    };
+    if (total_cells >= double(bucket_mask_ + 1)) {
+        visit_range(0, points_.size());
+        return;
+    }
+
+    // Distinct cells can share a bucket, visit every bucket once
+    size_t small_buckets[64];
+    std::vector<size_t> large_buckets;
+    size_t *buckets = small_buckets;
+    if (total_cells > 64) {
+        large_buckets.resize(size_t(total_cells));
+        buckets = large_buckets.data();
+    }
+    size_t num_buckets = 0;
+    for (int64_t x = min_cell[0]; x <= max_cell[0]; x++) {
+        for (int64_t y = min_cell[1]; y <= max_cell[1]; y++) {
+            for (int64_t z = min_cell[2]; z <= max_cell[2]; z++) {
+                buckets[num_buckets++] = HashCell(x, y, z);
+            }
+        }
+    }
+    std::sort(buckets, buckets + num_buckets);
+    num_buckets = std::unique(buckets, buckets + num_buckets) - buckets;
+    for (size_t i = 0; i < num_buckets; i++) {
+        visit_range(bucket_offsets_[buckets[i]],
+                    bucket_offsets_[buckets[i] + 1]);
+    }
+}
+
+template int FixedRadiusIndex::Search<Eigen::Vector3d>(
+        const Eigen::Vector3d &query,
+        const KDTreeSearchParam &param,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int FixedRadiusIndex::SearchRadius<Eigen::Vector3d>(
+        const Eigen::Vector3d &query,
+        double radius,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int FixedRadiusIndex::SearchHybrid<Eigen::Vector3d>(
+        const Eigen::Vector3d &query,
+        double radius,
+        int max_nn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int FixedRadiusIndex::CountRadius<Eigen::Vector3d>(
+        const Eigen::Vector3d &query, double radius) const;
+
+template int FixedRadiusIndex::Search<Eigen::Vector3f>(
+        const Eigen::Vector3f &query,
+        const KDTreeSearchParam &param,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int FixedRadiusIndex::SearchRadius<Eigen::Vector3f>(
+        const Eigen::Vector3f &query,
+        double radius,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int FixedRadiusIndex::SearchHybrid<Eigen::Vector3f>(
+        const Eigen::Vector3f &query,
+        double radius,
+        int max_nn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int FixedRadiusIndex::CountRadius<Eigen::Vector3f>(
+        const Eigen::Vector3f &query, double radius) const;
+
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,120 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <vector>
+
+#include "Open3D/Geometry/Geometry.h"
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+
+namespace open3d {
+namespace geometry {
+
+/// Uniform spatial hash for fixed radius neighbor searches in 3D.
+///
+/// The points are sorted into the buckets of a hash over cells of size
+/// cell_size_, so that a search with a radius up to cell_size_ visits at most
+/// 3 x 3 x 3 cells. Use it instead of KDTreeFlann when all the queries share a
+/// known radius. Like KDTreeFlann, a point is a neighbor if its squared
+/// distance is less than the squared radius rounded to float.
+class FixedRadiusIndex {
+public:
+    FixedRadiusIndex();
+    FixedRadiusIndex(double cell_size, const Eigen::MatrixXd &data);
+    FixedRadiusIndex(double cell_size, const Geometry &geometry);
+    ~FixedRadiusIndex();
+    FixedRadiusIndex(const FixedRadiusIndex &) = delete;
+    FixedRadiusIndex &operator=(const FixedRadiusIndex &) = delete;
+
+public:
+    /// Sets the cell size used by the next SetMatrixData or SetGeometry. It
+    /// should be the radius of the searches.
+    void SetCellSize(double cell_size) { cell_size_ = cell_size; }
+    double GetCellSize() const { return cell_size_; }
+
+    /// Builds the index over the columns of a 3 x N matrix.
+    bool SetMatrixData(const Eigen::MatrixXd &data);
+    bool SetGeometry(const Geometry &geometry);
+
+    /// Radius or hybrid search, the other search types return -1.
+    template <typename T>
+    int Search(const T &query,
+               const KDTreeSearchParam &param,
+               std::vector<int> &indices,
+               std::vector<double> &distance2) const;
+
+    /// Returns the neighbors within radius, sorted by distance like
+    /// KDTreeFlann.
+    template <typename T>
+    int SearchRadius(const T &query,
+                     double radius,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2) const;
+
+    /// Returns the max_nn nearest neighbors within radius, sorted by distance.
+    template <typename T>
+    int SearchHybrid(const T &query,
+                     double radius,
+                     int max_nn,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2) const;
+
+    /// Returns the number of neighbors within radius.
+    template <typename T>
+    int CountRadius(const T &query, double radius) const;
+
+    /// Returns true if param selects the FixedRadius index type for a radius
+    /// or hybrid search, and sets radius to the search radius.
+    static bool IsSelectedBy(const KDTreeSearchParam &param, double &radius);
+
+private:
+    bool SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data);
+
+    size_t HashCell(int64_t x, int64_t y, int64_t z) const;
+
+    /// Calls f(index, distance2) for every neighbor within radius.
+    template <typename F>
+    void ForEachNeighbor(const Eigen::Vector3d &query,
+                         double radius,
+                         F f) const;
+
+protected:
+    double cell_size_ = 0;
+    Eigen::Vector3d origin_ = Eigen::Vector3d::Zero();
+    /// Number of buckets minus one, the number of buckets is a power of two.
+    size_t bucket_mask_ = 0;
+    /// The points of bucket b are [bucket_offsets_[b], bucket_offsets_[b + 1])
+    /// in points_ and indices_.
+    std::vector<size_t> bucket_offsets_;
+    /// Points sorted by bucket, and then by index.
+    std::vector<Eigen::Vector3d> points_;
+    std::vector<int> indices_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
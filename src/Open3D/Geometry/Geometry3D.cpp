@@ -109,6 +109,15 @@ void Geometry3D::TransformNormals(const Eigen::Matrix4d& transformation,
     }
 }
 
+void Geometry3D::TransformCovariances(
+        const Eigen::Matrix4d& transformation,
+        std::vector<Eigen::Matrix3d>& covariances) const {
+    const Eigen::Matrix3d R = transformation.block<3, 3>(0, 0);
+    for (auto& covariance : covariances) {
+        covariance = R * covariance * R.transpose();
+    }
+}
+
 void Geometry3D::TranslatePoints(const Eigen::Vector3d& translation,
                                  std::vector<Eigen::Vector3d>& points,
                                  bool relative) const {
@@ -157,6 +166,15 @@ void Geometry3D::RotateNormals(const Eigen::Vector3d& rotation,
     }
 }
 
+void Geometry3D::RotateCovariances(const Eigen::Vector3d& rotation,
+                                   std::vector<Eigen::Matrix3d>& covariances,
+                                   RotationType type) const {
+    const Eigen::Matrix3d R = GetRotationMatrix(rotation, type);
+    for (auto& covariance : covariances) {
+        covariance = R * covariance * R.transpose();
+    }
+}
+
 Eigen::Matrix3d Geometry3D::GetRotationMatrix(const Eigen::Vector3d& rotation,
                                               RotationType type) const {
     if (type == RotationType::XYZ) {
@@ -79,6 +79,8 @@ protected:
                          std::vector<Eigen::Vector3d>& points) const;
     void TransformNormals(const Eigen::Matrix4d& transformation,
                           std::vector<Eigen::Vector3d>& normals) const;
+    void TransformCovariances(const Eigen::Matrix4d& transformation,
+                              std::vector<Eigen::Matrix3d>& covariances) const;
     void TranslatePoints(const Eigen::Vector3d& translation,
                          std::vector<Eigen::Vector3d>& points,
                          bool relative) const;
@@ -93,6 +95,9 @@ protected:
                        std::vector<Eigen::Vector3d>& normals,
                        bool center,
                        RotationType type) const;
+    void RotateCovariances(const Eigen::Vector3d& rotation,
+                           std::vector<Eigen::Matrix3d>& covariances,
+                           RotationType type) const;
 
     Eigen::Matrix3d GetRotationMatrix(
             const Eigen::Vector3d& rotation,
@@ -25,6 +25,7 @@
 // ----------------------------------------------------------------------------
 
 #include "Open3D/Geometry/Image.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace {
 /// Isotropic 2D kernels are separable:
@@ -157,10 +158,7 @@ std::shared_ptr<Image> Image::Downsample() const {
     int half_height = (int)floor((double)height_ / 2.0);
     output->Prepare(half_width, half_height, 1, 4);
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int y = 0; y < output->height_; y++) {
+    utility::ParallelFor(0, output->height_, [&](int y) {
         for (int x = 0; x < output->width_; x++) {
             float *p1 = PointerAt<float>(x * 2, y * 2);
             float *p2 = PointerAt<float>(x * 2 + 1, y * 2);
@@ -169,7 +167,7 @@ std::shared_ptr<Image> Image::Downsample() const {
             float *p = output->PointerAt<float>(x, y);
             *p = (*p1 + *p2 + *p3 + *p4) / 4.0f;
         }
-    }
+    });
     return output;
 }
 
@@ -186,10 +184,7 @@ std::shared_ptr<Image> Image::FilterHorizontal(
     output->Prepare(width_, height_, 1, 4);
 
     const int half_kernel_size = (int)(floor((double)kernel.size() / 2.0));
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int y = 0; y < height_; y++) {
+    utility::ParallelFor(0, height_, [&](int y) {
         for (int x = 0; x < width_; x++) {
             float *po = output->PointerAt<float>(x, y, 0);
             double temp = 0;
@@ -202,7 +197,7 @@ std::shared_ptr<Image> Image::FilterHorizontal(
             }
             *po = (float)temp;
         }
-    }
+    });
     return output;
 }
 
@@ -269,16 +264,13 @@ std::shared_ptr<Image> Image::Flip() const {
     }
     output->Prepare(height_, width_, 1, 4);
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int y = 0; y < height_; y++) {
+    utility::ParallelFor(0, height_, [&](int y) {
         for (int x = 0; x < width_; x++) {
             float *pi = PointerAt<float>(x, y, 0);
             float *po = output->PointerAt<float>(y, x, 0);
             *po = *pi;
         }
-    }
+    });
     return output;
 }
 
@@ -290,10 +282,7 @@ std::shared_ptr<Image> Image::Dilate(int half_kernel_size /* = 1 */) const {
     }
     output->Prepare(width_, height_, 1, 1);
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int y = 0; y < height_; y++) {
+    utility::ParallelFor(0, height_, [&](int y) {
         for (int x = 0; x < width_; x++) {
             for (int yy = -half_kernel_size; yy <= half_kernel_size; yy++) {
                 for (int xx = -half_kernel_size; xx <= half_kernel_size; xx++) {
@@ -309,7 +298,7 @@ std::shared_ptr<Image> Image::Dilate(int half_kernel_size /* = 1 */) const {
                 }
             }
         }
-    }
+    });
     return output;
 }
 
@@ -326,10 +315,7 @@ std::shared_ptr<Image> Image::CreateDepthBoundaryMask(
     auto mask = std::make_shared<Image>();
     mask->Prepare(width, height, 1, 1);
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int v = 0; v < height; v++) {
+    utility::ParallelFor(0, height, [&](int v) {
         for (int u = 0; u < width; u++) {
             double dx = *depth_image_gradient_dx->PointerAt<float>(u, v);
             double dy = *depth_image_gradient_dy->PointerAt<float>(u, v);
@@ -340,7 +326,7 @@ std::shared_ptr<Image> Image::CreateDepthBoundaryMask(
                 *mask->PointerAt<unsigned char>(u, v) = 0;
             }
         }
-    }
+    });
     if (half_dilation_kernel_size_for_discontinuity_map >= 1) {
         auto mask_dilated =
                 mask->Dilate(half_dilation_kernel_size_for_discontinuity_map);
@@ -26,6 +26,7 @@
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/Image.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace open3d {
 namespace geometry {
@@ -50,13 +51,13 @@ std::shared_ptr<Image> Image::CreateDepthToCameraDistanceMultiplierFloatImage(
     for (int i = 0; i < intrinsic.height_; i++) {
         yy[i] = (i - fpp[1]) * ffl_inv[1];
     }
-    for (int i = 0; i < intrinsic.height_; i++) {
+    utility::ParallelFor(0, intrinsic.height_, [&](int i) {
         float *fp =
                 (float *)(fimage->data_.data() + i * fimage->BytesPerLine());
         for (int j = 0; j < intrinsic.width_; j++, fp++) {
             *fp = sqrtf(xx[j] * xx[j] + yy[i] * yy[i] + 1.0f);
         }
-    }
+    });
     return fimage;
 }
 
@@ -31,14 +31,86 @@
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 
+#include <algorithm>
+#include <cstring>
 #include <flann/flann.hpp>
 
 #include "Open3D/Geometry/HalfEdgeTriangleMesh.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
+
+namespace {
+
+/// Trailer of a snapshot, after the index written by FLANN or StaticKDTree.
+/// FLANN reads its index from the start of the file.
+struct SnapshotTrailer {
+    uint64_t dimension;
+    uint64_t size;
+    uint64_t checksum;
+    /// Checksum of the index, so that a damaged index is never loaded.
+    uint64_t index_checksum;
+    /// 0 for a StaticKDTree, 1 for a FLANN index.
+    uint32_t type;
+    uint32_t version;
+    char magic[8];
+};
+
+const char kSnapshotMagic[8] = {'O', '3', 'D', 'K', 'D', 'T', 'R', 'E'};
+const uint32_t kSnapshotVersion = 2;
+
+uint64_t ComputeChecksum(const Eigen::Map<const Eigen::MatrixXd> &data) {
+    // FNV-1a over 64-bit words, mixed down so that every bit of a coordinate
+    // affects the checksum.
+    const uint64_t prime = 1099511628211ULL;
+    uint64_t checksum = 14695981039346656037ULL;
+    checksum = (checksum ^ uint64_t(data.rows())) * prime;
+    checksum = (checksum ^ uint64_t(data.cols())) * prime;
+    const double *values = data.data();
+    for (Eigen::Index i = 0; i < data.size(); i++) {
+        uint64_t word;
+        memcpy(&word, &values[i], sizeof(word));
+        checksum = (checksum ^ word) * prime;
+        checksum ^= checksum >> 29;
+    }
+    return checksum;
+}
+
+uint64_t ComputeChecksum(const char *data, size_t size) {
+    const uint64_t prime = 1099511628211ULL;
+    uint64_t checksum = 14695981039346656037ULL;
+    checksum = (checksum ^ uint64_t(size)) * prime;
+    for (size_t i = 0; i < size; i += sizeof(uint64_t)) {
+        uint64_t word = 0;
+        memcpy(&word, data + i, std::min(sizeof(word), size - i));
+        checksum = (checksum ^ word) * prime;
+        checksum ^= checksum >> 29;
+    }
+    return checksum;
+}
+
+/// Points of a PointCloud or vertices of a TriangleMesh, or NULL.
+const std::vector<Eigen::Vector3d> *GetGeometryPoints(
+        const geometry::Geometry &geometry) {
+    switch (geometry.GetGeometryType()) {
+        case geometry::Geometry::GeometryType::PointCloud:
+            return &((const geometry::PointCloud &)geometry).points_;
+        case geometry::Geometry::GeometryType::TriangleMesh:
+        case geometry::Geometry::GeometryType::HalfEdgeTriangleMesh:
+            return &((const geometry::TriangleMesh &)geometry).vertices_;
+        case geometry::Geometry::GeometryType::Image:
+        case geometry::Geometry::GeometryType::Unspecified:
+        default:
+            return NULL;
+    }
+}
+
+}  // unnamed namespace
+
 namespace geometry {
 
 KDTreeFlann::KDTreeFlann() {}
@@ -59,31 +131,175 @@ bool KDTreeFlann::SetMatrixData(const Eigen::MatrixXd &data) {
 }
 
 bool KDTreeFlann::SetGeometry(const Geometry &geometry) {
-    switch (geometry.GetGeometryType()) {
-        case Geometry::GeometryType::PointCloud:
-            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
-                    (const double *)((const PointCloud &)geometry)
-                            .points_.data(),
-                    3, ((const PointCloud &)geometry).points_.size()));
-        case Geometry::GeometryType::TriangleMesh:
-        case Geometry::GeometryType::HalfEdgeTriangleMesh:
-            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
-                    (const double *)((const TriangleMesh &)geometry)
-                            .vertices_.data(),
-                    3, ((const TriangleMesh &)geometry).vertices_.size()));
-        case Geometry::GeometryType::Image:
-        case Geometry::GeometryType::Unspecified:
-        default:
-            utility::LogWarning(
-                    "[KDTreeFlann::SetGeometry] Unsupported Geometry type.\n");
-            return false;
+    const std::vector<Eigen::Vector3d> *points = GetGeometryPoints(geometry);
+    if (points == NULL) {
+        utility::LogWarning(
+                "[KDTreeFlann::SetGeometry] Unsupported Geometry type.\n");
+        return false;
     }
+    return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+            (const double *)points->data(), 3, points->size()));
 }
 
 bool KDTreeFlann::SetFeature(const registration::Feature &feature) {
     return SetMatrixData(feature.data_);
 }
 
+bool KDTreeFlann::WriteSnapshot(const std::string &filename) const {
+    if (dataset_size_ == 0 || (!static_kdtree_ && !flann_index_)) {
+        utility::LogWarning(
+                "[KDTreeFlann::WriteSnapshot] Failed due to no index.\n");
+        return false;
+    }
+    bool success = true;
+    if (static_kdtree_) {
+        FILE *file = fopen(filename.c_str(), "wb");
+        success = file != NULL && static_kdtree_->WriteToFile(file);
+        if (file != NULL && fclose(file) != 0) {
+            success = false;
+        }
+    } else {
+        try {
+            flann_index_->save(filename);
+        } catch (const std::exception &) {
+            success = false;
+        }
+    }
+    uint64_t index_checksum = 0;
+    if (success) {
+        utility::filesystem::MappedFile index(filename);
+        success = index.IsOpen();
+        index_checksum = ComputeChecksum(index.GetData(), index.GetSize());
+    }
+    FILE *file = success ? fopen(filename.c_str(), "ab") : NULL;
+    success = success && file != NULL;
+    if (success) {
+        SnapshotTrailer trailer;
+        trailer.dimension = dimension_;
+        trailer.size = dataset_size_;
+        trailer.checksum = checksum_;
+        trailer.index_checksum = index_checksum;
+        trailer.type = static_kdtree_ ? 0 : 1;
+        trailer.version = kSnapshotVersion;
+        memcpy(trailer.magic, kSnapshotMagic, sizeof(kSnapshotMagic));
+        success = fwrite(&trailer, sizeof(trailer), 1, file) == 1;
+    }
+    if (file != NULL && fclose(file) != 0) {
+        success = false;
+    }
+    if (!success) {
+        utility::LogWarning(
+                "[KDTreeFlann::WriteSnapshot] Failed to write {}.\n",
+                filename);
+    }
+    return success;
+}
+
+bool KDTreeFlann::ReadSnapshot(const std::string &filename,
+                               const Eigen::MatrixXd &data) {
+    return ReadRawSnapshot(filename, Eigen::Map<const Eigen::MatrixXd>(
+                                             data.data(), data.rows(),
+                                             data.cols()));
+}
+
+bool KDTreeFlann::ReadSnapshot(const std::string &filename,
+                               const Geometry &geometry) {
+    const std::vector<Eigen::Vector3d> *points = GetGeometryPoints(geometry);
+    if (points == NULL) {
+        utility::LogWarning(
+                "[KDTreeFlann::ReadSnapshot] Unsupported Geometry type.\n");
+        return false;
+    }
+    return ReadRawSnapshot(filename, Eigen::Map<const Eigen::MatrixXd>(
+                                             (const double *)points->data(),
+                                             3, points->size()));
+}
+
+bool KDTreeFlann::ReadSnapshot(const std::string &filename,
+                               const registration::Feature &feature) {
+    return ReadSnapshot(filename, feature.data_);
+}
+
+bool KDTreeFlann::ReadRawSnapshot(
+        const std::string &filename,
+        const Eigen::Map<const Eigen::MatrixXd> &data) {
+    utility::filesystem::MappedFile file(filename);
+    if (!file.IsOpen()) {
+        utility::LogDebug("[KDTreeFlann::ReadSnapshot] Unable to open {}.\n",
+                          filename);
+        return false;
+    }
+    SnapshotTrailer trailer;
+    if (file.GetSize() < sizeof(trailer)) {
+        utility::LogDebug("[KDTreeFlann::ReadSnapshot] Invalid snapshot {}.\n",
+                          filename);
+        return false;
+    }
+    const size_t index_size = file.GetSize() - sizeof(trailer);
+    memcpy(&trailer, file.GetData() + index_size, sizeof(trailer));
+    if (memcmp(trailer.magic, kSnapshotMagic, sizeof(kSnapshotMagic)) != 0 ||
+        trailer.version != kSnapshotVersion ||
+        trailer.type != (data.rows() == 3 ? 0u : 1u)) {
+        utility::LogDebug("[KDTreeFlann::ReadSnapshot] Invalid snapshot {}.\n",
+                          filename);
+        return false;
+    }
+    if (data.size() == 0 || trailer.dimension != uint64_t(data.rows()) ||
+        trailer.size != uint64_t(data.cols()) ||
+        trailer.checksum != ComputeChecksum(data)) {
+        utility::LogDebug(
+                "[KDTreeFlann::ReadSnapshot] Snapshot {} was built from other "
+                "data.\n",
+                filename);
+        return false;
+    }
+    if (trailer.index_checksum !=
+        ComputeChecksum(file.GetData(), index_size)) {
+        utility::LogDebug("[KDTreeFlann::ReadSnapshot] Damaged snapshot {}.\n",
+                          filename);
+        return false;
+    }
+
+    if (trailer.type == 0) {
+        std::unique_ptr<StaticKDTree<double, 3>> static_kdtree(
+                new StaticKDTree<double, 3>());
+        if (static_kdtree->ReadFromBuffer(file.GetData(), index_size,
+                                          int(data.cols())) != index_size) {
+            utility::LogDebug(
+                    "[KDTreeFlann::ReadSnapshot] Invalid snapshot {}.\n",
+                    filename);
+            return false;
+        }
+        data_.clear();
+        flann_dataset_.reset();
+        flann_index_.reset();
+        static_kdtree_ = std::move(static_kdtree);
+    } else {
+        std::vector<double> flann_data(data.data(), data.data() + data.size());
+        std::unique_ptr<flann::Matrix<double>> flann_dataset(
+                new flann::Matrix<double>(flann_data.data(), data.cols(),
+                                          data.rows()));
+        std::unique_ptr<flann::Index<flann::L2<double>>> flann_index;
+        try {
+            flann_index.reset(new flann::Index<flann::L2<double>>(
+                    *flann_dataset, flann::SavedIndexParams(filename)));
+        } catch (const std::exception &e) {
+            utility::LogDebug(
+                    "[KDTreeFlann::ReadSnapshot] Invalid snapshot {}: {}\n",
+                    filename, e.what());
+            return false;
+        }
+        static_kdtree_.reset();
+        data_.swap(flann_data);
+        flann_dataset_ = std::move(flann_dataset);
+        flann_index_ = std::move(flann_index);
+    }
+    dimension_ = data.rows();
+    dataset_size_ = data.cols();
+    checksum_ = trailer.checksum;
+    return true;
+}
+
 template <typename T>
 int KDTreeFlann::Search(const T &query,
                         const KDTreeSearchParam &param,
@@ -113,6 +329,9 @@ int KDTreeFlann::SearchKNN(const T &query,
                            int knn,
                            std::vector<int> &indices,
                            std::vector<double> &distance2) const {
+    if (static_kdtree_) {
+        return static_kdtree_->SearchKNN(query, knn, indices, distance2);
+    }
     // This is optimized code for heavily repeated search.
     // Other flann::Index::knnSearch() implementations lose performance due to
     // memory allocation/deallocation.
@@ -137,6 +356,10 @@ int KDTreeFlann::SearchRadius(const T &query,
                               double radius,
                               std::vector<int> &indices,
                               std::vector<double> &distance2) const {
+    if (static_kdtree_) {
+        return static_kdtree_->SearchRadius(query, radius, indices,
+                                            distance2);
+    }
     // This is optimized code for heavily repeated search.
     // Since max_nn is not given, we let flann to do its own memory management.
     // Other flann::Index::radiusSearch() implementations lose performance due
@@ -163,6 +386,10 @@ int KDTreeFlann::SearchHybrid(const T &query,
                               int max_nn,
                               std::vector<int> &indices,
                               std::vector<double> &distance2) const {
+    if (static_kdtree_) {
+        return static_kdtree_->SearchHybrid(query, radius, max_nn, indices,
+                                            distance2);
+    }
     // This is optimized code for heavily repeated search.
     // It is also the recommended setting for search.
     // Other flann::Index::radiusSearch() implementations lose performance due
@@ -187,6 +414,8 @@ int KDTreeFlann::SearchHybrid(const T &query,
 }
 
 bool KDTreeFlann::SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data) {
+    OPEN3D_PROFILE_ZONE("KDTreeFlann::SetRawData");
+    OPEN3D_PROFILE_POINTS(data.cols());
     dimension_ = data.rows();
     dataset_size_ = data.cols();
     if (dimension_ == 0 || dataset_size_ == 0) {
@@ -194,6 +423,15 @@ bool KDTreeFlann::SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data) {
                 "[KDTreeFlann::SetRawData] Failed due to no data.\n");
         return false;
     }
+    checksum_ = ComputeChecksum(data);
+    if (dimension_ == 3) {
+        data_.clear();
+        flann_dataset_.reset();
+        flann_index_.reset();
+        static_kdtree_.reset(new StaticKDTree<double, 3>());
+        return static_kdtree_->SetRawData(data);
+    }
+    static_kdtree_.reset();
     data_.resize(dataset_size_ * dimension_);
     memcpy(data_.data(), data.data(),
            dataset_size_ * dimension_ * sizeof(double));
@@ -27,11 +27,14 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "Open3D/Geometry/Geometry.h"
 #include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/StaticKDTree.h"
 #include "Open3D/Registration/Feature.h"
 
 namespace flann {
@@ -46,6 +49,8 @@ class Index;
 namespace open3d {
 namespace geometry {
 
+/// Nearest neighbor search with FLANN. 3D data, such as the points of a
+/// PointCloud, is searched with a StaticKDTree instead.
 class KDTreeFlann {
 public:
     KDTreeFlann();
@@ -61,6 +66,17 @@ public:
     bool SetGeometry(const Geometry &geometry);
     bool SetFeature(const registration::Feature &feature);
 
+    /// Writes the built index, with checksums of the index and of its data,
+    /// to a snapshot file.
+    bool WriteSnapshot(const std::string &filename) const;
+    /// Loads the index from a snapshot file, which is mapped in memory. Fails
+    /// without changing the index if the snapshot is invalid or was built
+    /// from other data.
+    bool ReadSnapshot(const std::string &filename, const Eigen::MatrixXd &data);
+    bool ReadSnapshot(const std::string &filename, const Geometry &geometry);
+    bool ReadSnapshot(const std::string &filename,
+                      const registration::Feature &feature);
+
     template <typename T>
     int Search(const T &query,
                const KDTreeSearchParam &param,
@@ -88,13 +104,18 @@ public:
 
 private:
     bool SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data);
+    bool ReadRawSnapshot(const std::string &filename,
+                         const Eigen::Map<const Eigen::MatrixXd> &data);
 
 protected:
     std::vector<double> data_;
     std::unique_ptr<flann::Matrix<double>> flann_dataset_;
     std::unique_ptr<flann::Index<flann::L2<double>>> flann_index_;
+    std::unique_ptr<StaticKDTree<double, 3>> static_kdtree_;
     size_t dimension_ = 0;
     size_t dataset_size_ = 0;
+    /// Checksum of the data the index is built from.
+    uint64_t checksum_ = 0;
 };
 
 }  // namespace geometry
@@ -37,17 +37,27 @@ public:
         Hybrid = 2,
     };
 
+    /// Index built by the functions taking search parameters. FixedRadius
+    /// (see FixedRadiusIndex) only supports radius and hybrid searches.
+    enum class IndexType {
+        KDTree = 0,
+        FixedRadius = 1,
+    };
+
 public:
     virtual ~KDTreeSearchParam() {}
 
 protected:
-    KDTreeSearchParam(SearchType type) : search_type_(type) {}
+    KDTreeSearchParam(SearchType type, IndexType index_type = IndexType::KDTree)
+        : search_type_(type), index_type_(index_type) {}
 
 public:
     SearchType GetSearchType() const { return search_type_; }
+    IndexType GetIndexType() const { return index_type_; }
 
 private:
     SearchType search_type_;
+    IndexType index_type_;
 };
 
 class KDTreeSearchParamKNN : public KDTreeSearchParam {
@@ -61,8 +71,9 @@ public:
 
 class KDTreeSearchParamRadius : public KDTreeSearchParam {
 public:
-    KDTreeSearchParamRadius(double radius)
-        : KDTreeSearchParam(SearchType::Radius), radius_(radius) {}
+    KDTreeSearchParamRadius(double radius,
+                            IndexType index_type = IndexType::KDTree)
+        : KDTreeSearchParam(SearchType::Radius, index_type), radius_(radius) {}
 
 public:
     double radius_;
@@ -70,8 +81,10 @@ public:
 
 class KDTreeSearchParamHybrid : public KDTreeSearchParam {
 public:
-    KDTreeSearchParamHybrid(double radius, int max_nn)
-        : KDTreeSearchParam(SearchType::Hybrid),
+    KDTreeSearchParamHybrid(double radius,
+                            int max_nn,
+                            IndexType index_type = IndexType::KDTree)
+        : KDTreeSearchParam(SearchType::Hybrid, index_type),
           radius_(radius),
           max_nn_(max_nn) {}
 
@@ -0,0 +1,167 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/LinearOctree.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "Open3D/Geometry/Octree.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Utility/Helper.h"
+#include "Open3D/Utility/Parallel.h"
+
+namespace open3d {
+namespace geometry {
+
+void LinearOctree::Clear() {
+    codes_.clear();
+    first_child_.clear();
+    leaf_colors_.clear();
+}
+
+bool LinearOctree::ComputeCode(const Eigen::Vector3d &point,
+                               uint64_t &code) const {
+    Eigen::Vector3d origin = origin_;
+    double size = size_;
+    if (!Octree::IsPointInBound(point, origin, size)) {
+        return false;
+    }
+    code = 0;
+    for (size_t d = 0; d < max_depth_; d++) {
+        double child_size = size / 2.0;
+        size_t x_index = point(0) < origin(0) + child_size ? 0 : 1;
+        size_t y_index = point(1) < origin(1) + child_size ? 0 : 1;
+        size_t z_index = point(2) < origin(2) + child_size ? 0 : 1;
+        origin += Eigen::Vector3d(x_index * child_size, y_index * child_size,
+                                  z_index * child_size);
+        size = child_size;
+        if (!Octree::IsPointInBound(point, origin, size)) {
+            return false;
+        }
+        code = (code << 3) | (x_index + y_index * 2 + z_index * 4);
+    }
+    return true;
+}
+
+void LinearOctree::CreateFromPointCloud(const PointCloud &point_cloud) {
+    if (max_depth_ > kMaxDepth) {
+        throw std::runtime_error("max_depth exceeds LinearOctree::kMaxDepth");
+    }
+    Clear();
+
+    // Leaf code of every point, paired with the point index. The stable sort
+    // keeps the insertion order within a leaf.
+    const int64_t num_points = (int64_t)point_cloud.points_.size();
+    std::vector<std::pair<uint64_t, size_t>> sorted_codes(num_points);
+    std::vector<uint8_t> in_bound(num_points);
+    utility::ParallelFor(0, (int)num_points, [&](int i) {
+        uint64_t code = 0;
+        in_bound[i] = ComputeCode(point_cloud.points_[i], code);
+        sorted_codes[i] = std::make_pair(code, (size_t)i);
+    });
+    size_t num_in_bound = 0;
+    for (int64_t i = 0; i < num_points; i++) {
+        if (in_bound[i]) {
+            sorted_codes[num_in_bound++] = sorted_codes[i];
+        }
+    }
+    sorted_codes.resize(num_in_bound);
+    utility::RadixSortByCode(sorted_codes, 3 * max_depth_);
+
+    // Leaves
+    codes_.resize(max_depth_ + 1);
+    first_child_.resize(max_depth_);
+    const bool has_colors = point_cloud.HasColors();
+    const std::vector<size_t> leaf_starts = utility::FindRunStarts(
+            sorted_codes.size(),
+            [&sorted_codes](size_t i) { return sorted_codes[i].first; });
+    const int64_t num_leaves = (int64_t)leaf_starts.size() - 1;
+    codes_[max_depth_].resize(num_leaves);
+    leaf_colors_.resize(num_leaves);
+    utility::ParallelFor(0, (int)num_leaves, [&](int i) {
+        const auto &last = sorted_codes[leaf_starts[i + 1] - 1];
+        codes_[max_depth_][i] = last.first;
+        leaf_colors_[i] = has_colors ? point_cloud.colors_[last.second]
+                                     : Eigen::Vector3d::Zero();
+    });
+
+    // Internal levels, bottom-up
+    for (size_t d = max_depth_; d > 0; d--) {
+        const std::vector<uint64_t> &child_codes = codes_[d];
+        first_child_[d - 1] = utility::FindRunStarts(
+                child_codes.size(),
+                [&child_codes](size_t i) { return child_codes[i] >> 3; });
+        const std::vector<size_t> &starts = first_child_[d - 1];
+        const int64_t num_nodes = (int64_t)starts.size() - 1;
+        codes_[d - 1].resize(num_nodes);
+        utility::ParallelFor(0, (int)num_nodes, [&](int i) {
+            codes_[d - 1][i] = child_codes[starts[i]] >> 3;
+        });
+    }
+}
+
+int64_t LinearOctree::LocateLeafNode(const Eigen::Vector3d &point) const {
+    uint64_t code;
+    if (IsEmpty() || !ComputeCode(point, code)) {
+        return -1;
+    }
+    const auto &leaf_codes = codes_[max_depth_];
+    auto itr = std::lower_bound(leaf_codes.begin(), leaf_codes.end(), code);
+    if (itr == leaf_codes.end() || *itr != code) {
+        return -1;
+    }
+    return itr - leaf_codes.begin();
+}
+
+std::shared_ptr<OctreeNode> LinearOctree::ToOctreeNodes() const {
+    if (IsEmpty()) {
+        return nullptr;
+    }
+    std::vector<std::shared_ptr<OctreeNode>> nodes(codes_[max_depth_].size());
+    utility::ParallelFor(0, (int)nodes.size(), [&](int i) {
+        auto leaf_node = std::make_shared<OctreeColorLeafNode>();
+        leaf_node->color_ = leaf_colors_[i];
+        nodes[i] = leaf_node;
+    });
+    for (size_t d = max_depth_; d > 0; d--) {
+        const std::vector<size_t> &first_child = first_child_[d - 1];
+        std::vector<std::shared_ptr<OctreeNode>> parents(codes_[d - 1].size());
+        utility::ParallelFor(0, (int)parents.size(), [&](int i) {
+            auto internal_node = std::make_shared<OctreeInternalNode>();
+            for (size_t j = first_child[i]; j < first_child[i + 1]; j++) {
+                internal_node->children_[codes_[d][j] & 7] = nodes[j];
+            }
+            parents[i] = internal_node;
+        });
+        nodes.swap(parents);
+    }
+    return nodes[0];
+}
+
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,99 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace open3d {
+namespace geometry {
+
+class OctreeNode;
+class PointCloud;
+
+/// Pointer-free octree with the same node layout as Octree.
+///
+/// A node at depth d is identified by its Morton code, the sequence of the
+/// child indices (see OctreeInternalNode) on the path from the root, three
+/// bits per level. The nodes of each depth are stored in a flat array sorted
+/// by code, so that the children of a node are contiguous in the next level
+/// and the leaves are in the DFS order of Octree::Traverse. Leaves only exist
+/// at max_depth_ and carry a color, like OctreeColorLeafNode.
+class LinearOctree {
+public:
+    LinearOctree() : origin_(0, 0, 0), size_(0), max_depth_(0) {}
+    LinearOctree(size_t max_depth, const Eigen::Vector3d &origin, double size)
+        : origin_(origin), size_(size), max_depth_(max_depth) {}
+    ~LinearOctree() {}
+
+public:
+    /// Maximum supported max_depth_, limited by the 64-bit codes.
+    static const size_t kMaxDepth = 21;
+
+    void Clear();
+    bool IsEmpty() const { return codes_.empty() || codes_[0].empty(); }
+
+    /// Builds the octree over the points within origin_ and size_ in
+    /// parallel: the points are sorted by code and the levels are built
+    /// bottom-up. A leaf takes the color of the last point falling into it,
+    /// matching repeated Octree::InsertPoint calls.
+    void CreateFromPointCloud(const PointCloud &point_cloud);
+
+    /// Returns the index of the leaf containing point, or -1.
+    int64_t LocateLeafNode(const Eigen::Vector3d &point) const;
+
+    /// Converts to the node based representation of Octree::root_node_, for
+    /// Octree::ConvertToNodes. Returns the root node, or nullptr if the
+    /// octree is empty.
+    std::shared_ptr<OctreeNode> ToOctreeNodes() const;
+
+    /// Computes the code of the leaf containing point, using the same
+    /// comparisons as Octree::InsertPoint. Returns false if the point is out
+    /// of bound.
+    bool ComputeCode(const Eigen::Vector3d &point, uint64_t &code) const;
+
+public:
+    /// Global min bound (include). A point is within bound iff
+    /// origin_ <= point < origin_ + size_
+    Eigen::Vector3d origin_;
+    /// Outer bounding box edge size for the whole octree.
+    double size_;
+    /// Depth of the leaves, at most kMaxDepth.
+    size_t max_depth_;
+    /// codes_[d] holds the sorted codes of the nodes at depth d.
+    std::vector<std::vector<uint64_t>> codes_;
+    /// The children of node i at depth d are the nodes
+    /// [first_child_[d][i], first_child_[d][i + 1]) at depth d + 1.
+    std::vector<std::vector<size_t>> first_child_;
+    /// Colors of the leaves, i.e. of the nodes at depth max_depth_.
+    std::vector<Eigen::Vector3d> leaf_colors_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <unordered_map>
 
+#include "Open3D/Geometry/LinearOctree.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/VoxelGrid.h"
 #include "Open3D/Utility/Console.h"
@@ -185,6 +186,11 @@ Octree::Octree(const Octree& src_octree)
       origin_(src_octree.origin_),
       size_(src_octree.size_),
       max_depth_(src_octree.max_depth_) {
+    if (!src_octree.linear_octree_.IsEmpty()) {
+        linear_octree_ = src_octree.linear_octree_;
+        return;
+    }
+
     // First traversal: clone nodes without edges
     std::unordered_map<std::shared_ptr<OctreeNode>, std::shared_ptr<OctreeNode>>
             map_src_to_dst_node;
@@ -244,6 +250,25 @@ bool Octree::operator==(const Octree& that) const {
         return rc;
     }
 
+    // The traversal of a linear octree does not keep the nodes, so these
+    // compare their arrays or are compared as nodes.
+    if (!linear_octree_.IsEmpty() && !that.linear_octree_.IsEmpty()) {
+        const LinearOctree& a = linear_octree_;
+        const LinearOctree& b = that.linear_octree_;
+        rc = a.codes_ == b.codes_ &&
+             a.leaf_colors_.size() == b.leaf_colors_.size();
+        for (size_t i = 0; rc && i < a.leaf_colors_.size(); i++) {
+            rc = a.leaf_colors_[i].isApprox(b.leaf_colors_[i]);
+        }
+        return rc;
+    } else if (!linear_octree_.IsEmpty()) {
+        Octree octree(*this);
+        octree.ConvertToNodes();
+        return octree == that;
+    } else if (!that.linear_octree_.IsEmpty()) {
+        return that == *this;
+    }
+
     // Assign and check node ids
     std::unordered_map<std::shared_ptr<OctreeNode>, size_t> map_node_to_id;
     std::unordered_map<size_t, std::shared_ptr<OctreeNode>> map_id_to_node;
@@ -331,12 +356,15 @@ bool Octree::operator==(const Octree& that) const {
 Octree& Octree::Clear() {
     // Inherited Clear function
     root_node_ = nullptr;
+    linear_octree_.Clear();
     origin_.setZero();
     size_ = 0;
     return *this;
 }
 
-bool Octree::IsEmpty() const { return root_node_ == nullptr; }
+bool Octree::IsEmpty() const {
+    return root_node_ == nullptr && linear_octree_.IsEmpty();
+}
 
 Eigen::Vector3d Octree::GetMinBound() const {
     if (IsEmpty()) {
@@ -412,19 +440,45 @@ void Octree::ConvertFromPointCloud(const geometry::PointCloud& point_cloud,
         size_ = max_half_size * 2 * (1 + size_expand);
     }
 
-    // Insert points
-    for (size_t idx = 0; idx < point_cloud.points_.size(); idx++) {
-        InsertPoint(point_cloud.points_[idx],
-                    geometry::OctreeColorLeafNode::GetInitFunction(),
-                    geometry::OctreeColorLeafNode::GetUpdateFunction(
-                            point_cloud.colors_[idx]));
+    if (max_depth_ > LinearOctree::kMaxDepth) {
+        // Insert points
+        for (size_t idx = 0; idx < point_cloud.points_.size(); idx++) {
+            InsertPoint(point_cloud.points_[idx],
+                        geometry::OctreeColorLeafNode::GetInitFunction(),
+                        geometry::OctreeColorLeafNode::GetUpdateFunction(
+                                point_cloud.HasColors()
+                                        ? point_cloud.colors_[idx]
+                                        : Eigen::Vector3d::Zero()));
+        }
+        return;
+    }
+
+    // Bulk build, the nodes stay in the linear octree
+    linear_octree_ = LinearOctree(max_depth_, origin_, size_);
+    linear_octree_.CreateFromPointCloud(point_cloud);
+    if (linear_octree_.IsEmpty() && point_cloud.HasPoints()) {
+        // InsertPoint creates the root even if no point is within bound
+        if (max_depth_ == 0) {
+            root_node_ = std::make_shared<OctreeColorLeafNode>();
+        } else {
+            root_node_ = std::make_shared<OctreeInternalNode>();
+        }
     }
 }
 
+void Octree::ConvertToNodes() {
+    if (linear_octree_.IsEmpty()) {
+        return;
+    }
+    root_node_ = linear_octree_.ToOctreeNodes();
+    linear_octree_.Clear();
+}
+
 void Octree::InsertPoint(
         const Eigen::Vector3d& point,
         const std::function<std::shared_ptr<OctreeLeafNode>()>& f_init,
         const std::function<void(std::shared_ptr<OctreeLeafNode>)>& f_update) {
+    ConvertToNodes();
     if (root_node_ == nullptr) {
         if (max_depth_ == 0) {
             root_node_ = f_init();
@@ -495,6 +549,7 @@ bool Octree::IsPointInBound(const Eigen::Vector3d& point,
 void Octree::Traverse(
         const std::function<void(const std::shared_ptr<OctreeNode>&,
                                  const std::shared_ptr<OctreeNodeInfo>&)>& f) {
+    ConvertToNodes();
     // root_node_'s child index is 0, though it isn't a child node
     TraverseRecurse(root_node_,
                     std::make_shared<OctreeNodeInfo>(origin_, size_, 0, 0), f);
@@ -505,8 +560,13 @@ void Octree::Traverse(
                                  const std::shared_ptr<OctreeNodeInfo>&)>& f)
         const {
     // root_node_'s child index is 0, though it isn't a child node
-    TraverseRecurse(root_node_,
-                    std::make_shared<OctreeNodeInfo>(origin_, size_, 0, 0), f);
+    auto root_node_info =
+            std::make_shared<OctreeNodeInfo>(origin_, size_, 0, 0);
+    if (!linear_octree_.IsEmpty()) {
+        TraverseLinearRecurse(CreateLinearNode(0, 0), 0, root_node_info, f);
+    } else {
+        TraverseRecurse(root_node_, root_node_info, f);
+    }
 }
 
 void Octree::TraverseRecurse(
@@ -545,28 +605,133 @@ void Octree::TraverseRecurse(
     }
 }
 
+std::shared_ptr<OctreeNode> Octree::CreateLinearNode(size_t depth,
+                                                    size_t index) const {
+    if (depth == linear_octree_.max_depth_) {
+        auto leaf_node = std::make_shared<OctreeColorLeafNode>();
+        leaf_node->color_ = linear_octree_.leaf_colors_[index];
+        return leaf_node;
+    }
+    return std::make_shared<OctreeInternalNode>();
+}
+
+void Octree::TraverseLinearRecurse(
+        const std::shared_ptr<OctreeNode>& node,
+        size_t index,
+        const std::shared_ptr<OctreeNodeInfo>& node_info,
+        const std::function<void(const std::shared_ptr<OctreeNode>&,
+                                 const std::shared_ptr<OctreeNodeInfo>&)>& f)
+        const {
+    const size_t depth = node_info->depth_;
+    if (depth == linear_octree_.max_depth_) {
+        f(node, node_info);
+        return;
+    }
+    // The children of node are [begin, end) at depth + 1, sorted by child
+    // index like the children visited by TraverseRecurse.
+    const size_t begin = linear_octree_.first_child_[depth][index];
+    const size_t end = linear_octree_.first_child_[depth][index + 1];
+    const std::vector<uint64_t>& child_codes = linear_octree_.codes_[depth + 1];
+    auto internal_node = std::static_pointer_cast<OctreeInternalNode>(node);
+    for (size_t j = begin; j < end; j++) {
+        internal_node->children_[child_codes[j] & 7] =
+                CreateLinearNode(depth + 1, j);
+    }
+    f(internal_node, node_info);
+    double child_size = node_info->size_ / 2.0;
+
+    for (size_t j = begin; j < end; j++) {
+        size_t child_index = child_codes[j] & 7;
+        size_t x_index = child_index % 2;
+        size_t y_index = (child_index / 2) % 2;
+        size_t z_index = (child_index / 4) % 2;
+
+        Eigen::Vector3d child_node_origin =
+                node_info->origin_ + Eigen::Vector3d(double(x_index),
+                                                     double(y_index),
+                                                     double(z_index)) *
+                                             child_size;
+        auto child_node_info = std::make_shared<OctreeNodeInfo>(
+                child_node_origin, child_size, depth + 1, child_index);
+        TraverseLinearRecurse(internal_node->children_[child_index], j,
+                              child_node_info, f);
+        // Release the visited subtree, so that at most the children of the
+        // nodes on the current path exist at a time.
+        if (auto child_internal_node =
+                    std::dynamic_pointer_cast<OctreeInternalNode>(
+                            internal_node->children_[child_index])) {
+            child_internal_node->children_.assign(8, nullptr);
+        }
+    }
+}
+
+bool Octree::ConvertLinearNodeToJsonValue(size_t depth,
+                                          size_t index,
+                                          Json::Value& value) const {
+    if (depth == linear_octree_.max_depth_) {
+        value["class_name"] = "OctreeColorLeafNode";
+        return EigenVector3dToJsonArray(linear_octree_.leaf_colors_[index],
+                                        value["color"]);
+    }
+    bool rc = true;
+    value["class_name"] = "OctreeInternalNode";
+    value["children"] = Json::arrayValue;
+    value["children"].resize(8);
+    for (int cid = 0; cid < 8; ++cid) {
+        value["children"][Json::ArrayIndex(cid)] = Json::objectValue;
+    }
+    const std::vector<uint64_t>& child_codes = linear_octree_.codes_[depth + 1];
+    for (size_t j = linear_octree_.first_child_[depth][index];
+         j < linear_octree_.first_child_[depth][index + 1]; j++) {
+        Json::Value& child_value =
+                value["children"][Json::ArrayIndex(child_codes[j] & 7)];
+        rc = rc && ConvertLinearNodeToJsonValue(depth + 1, j, child_value);
+    }
+    return rc;
+}
+
 std::pair<std::shared_ptr<OctreeLeafNode>, std::shared_ptr<OctreeNodeInfo>>
 Octree::LocateLeafNode(const Eigen::Vector3d& point) const {
-    // TODO: add early stoping to callback function when the target has been
-    //       found, i.e. add return value to callback function.
-    // TODO: consider adding node's depth as parameter to the callback
-    // function.
-    std::shared_ptr<OctreeLeafNode> target_leaf_node = nullptr;
-    std::shared_ptr<OctreeNodeInfo> target_leaf_node_info = nullptr;
-    auto f_locate_leaf_node =
-            [&target_leaf_node, &target_leaf_node_info, &point](
-                    const std::shared_ptr<OctreeNode>& node,
-                    const std::shared_ptr<OctreeNodeInfo>& node_info) -> void {
-        if (IsPointInBound(point, node_info->origin_, node_info->size_)) {
-            if (auto leaf_node =
-                        std::dynamic_pointer_cast<OctreeLeafNode>(node)) {
-                target_leaf_node = leaf_node;
-                target_leaf_node_info = node_info;
+    // Descend from the root along the children containing the point
+    auto node_info = std::make_shared<OctreeNodeInfo>(origin_, size_, 0, 0);
+    if (!linear_octree_.IsEmpty()) {
+        // The code of the leaf gathers the child indices on the way down.
+        uint64_t code = 0;
+        while (IsPointInBound(point, node_info->origin_, node_info->size_)) {
+            if (node_info->depth_ == linear_octree_.max_depth_) {
+                const std::vector<uint64_t>& leaf_codes =
+                        linear_octree_.codes_[node_info->depth_];
+                auto itr = std::lower_bound(leaf_codes.begin(),
+                                            leaf_codes.end(), code);
+                if (itr == leaf_codes.end() || *itr != code) {
+                    break;
+                }
+                auto leaf_node = std::static_pointer_cast<OctreeLeafNode>(
+                        CreateLinearNode(node_info->depth_,
+                                         itr - leaf_codes.begin()));
+                return std::make_pair(leaf_node, node_info);
             }
+            node_info = OctreeInternalNode::GetInsertionNodeInfo(node_info,
+                                                                 point);
+            code = (code << 3) | node_info->child_index_;
         }
-    };
-    Traverse(f_locate_leaf_node);
-    return std::make_pair(target_leaf_node, target_leaf_node_info);
+        return std::make_pair(nullptr, nullptr);
+    }
+    std::shared_ptr<OctreeNode> node = root_node_;
+    while (node != nullptr &&
+           IsPointInBound(point, node_info->origin_, node_info->size_)) {
+        if (auto leaf_node = std::dynamic_pointer_cast<OctreeLeafNode>(node)) {
+            return std::make_pair(leaf_node, node_info);
+        }
+        auto internal_node =
+                std::dynamic_pointer_cast<OctreeInternalNode>(node);
+        if (internal_node == nullptr) {
+            throw std::runtime_error("Internal error: unknown node type");
+        }
+        node_info = OctreeInternalNode::GetInsertionNodeInfo(node_info, point);
+        node = internal_node->children_[node_info->child_index_];
+    }
+    return std::make_pair(nullptr, nullptr);
 }
 
 std::shared_ptr<geometry::VoxelGrid> Octree::ToVoxelGrid() const {
@@ -581,7 +746,9 @@ bool Octree::ConvertToJsonValue(Json::Value& value) const {
     value["size"] = size_;
     value["max_depth"] = Json::Int64(max_depth_);
     rc = rc && EigenVector3dToJsonArray(origin_, value["origin"]);
-    if (root_node_ == nullptr) {
+    if (!linear_octree_.IsEmpty()) {
+        rc = rc && ConvertLinearNodeToJsonValue(0, 0, value["tree"]);
+    } else if (root_node_ == nullptr) {
         value["tree"] = Json::objectValue;
     } else {
         rc = rc && root_node_->ConvertToJsonValue(value["tree"]);
@@ -606,6 +773,7 @@ bool Octree::ConvertFromJsonValue(const Json::Value& value) {
     max_depth_ = value.get("max_depth", 0).asInt64();
 
     // Create nodes
+    linear_octree_.Clear();
     root_node_ = OctreeNode::ConstructFromJsonValue(value["tree"]);
     return rc;
 }
@@ -31,6 +31,7 @@
 #include <vector>
 
 #include "Open3D/Geometry/Geometry3D.h"
+#include "Open3D/Geometry/LinearOctree.h"
 #include "Open3D/Utility/IJsonConvertible.h"
 
 namespace open3d {
@@ -167,12 +168,24 @@ public:
     bool ConvertFromJsonValue(const Json::Value& value) override;
 
 public:
+    /// Builds the octree in linear_octree_, without root_node_.
     void ConvertFromPointCloud(const geometry::PointCloud& point_cloud,
                                double size_expand = 0.01);
 
-    /// Root of the octree
+    /// Moves the nodes of linear_octree_ to root_node_, so that they can be
+    /// edited.
+    void ConvertToNodes();
+
+    /// Root of the octree, unless its nodes are in linear_octree_
     std::shared_ptr<OctreeNode> root_node_ = nullptr;
 
+    /// Nodes of an octree built by ConvertFromPointCloud: the codes of the
+    /// nodes of every depth, the offsets of their children and the colors of
+    /// the leaves, in flat arrays. The const Traverse, LocateLeafNode and the
+    /// JSON IO read them through temporary nodes, the edits (InsertPoint and
+    /// the non-const Traverse) first call ConvertToNodes.
+    LinearOctree linear_octree_;
+
     /// Global min bound (include). A point is within bound iff
     /// origin_ <= point < origin_ + size_
     Eigen::Vector3d origin_;
@@ -193,14 +206,16 @@ public:
                     f_update);
 
     /// DFS traversal of Octree from the root, with callback function called
-    /// for each node
+    /// for each node. Calls ConvertToNodes, so that f may edit the nodes.
     void Traverse(
             const std::function<void(const std::shared_ptr<OctreeNode>&,
                                      const std::shared_ptr<OctreeNodeInfo>&)>&
                     f);
 
     /// Const version of Traverse. DFS traversal of Octree from the root, with
-    /// callback function called for each node
+    /// callback function called for each node. The nodes of linear_octree_
+    /// are created on the fly, and an internal node only holds its
+    /// grandchildren until its subtree has been visited.
     void Traverse(
             const std::function<void(const std::shared_ptr<OctreeNode>&,
                                      const std::shared_ptr<OctreeNodeInfo>&)>&
@@ -232,6 +247,24 @@ private:
                                      const std::shared_ptr<OctreeNodeInfo>&)>&
                     f);
 
+    /// Creates the node index of depth of linear_octree_, without children.
+    std::shared_ptr<OctreeNode> CreateLinearNode(size_t depth,
+                                                 size_t index) const;
+
+    void TraverseLinearRecurse(
+            const std::shared_ptr<OctreeNode>& node,
+            size_t index,
+            const std::shared_ptr<OctreeNodeInfo>& node_info,
+            const std::function<void(const std::shared_ptr<OctreeNode>&,
+                                     const std::shared_ptr<OctreeNodeInfo>&)>&
+                    f) const;
+
+    /// Writes node index of depth of linear_octree_ as the JSON value of an
+    /// OctreeNode.
+    bool ConvertLinearNodeToJsonValue(size_t depth,
+                                      size_t index,
+                                      Json::Value& value) const;
+
     void InsertPointRecurse(
             const std::shared_ptr<OctreeNode>& node,
             const std::shared_ptr<OctreeNodeInfo>& node_info,
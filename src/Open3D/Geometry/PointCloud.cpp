@@ -33,6 +33,7 @@
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/Qhull.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace open3d {
 namespace geometry {
@@ -41,6 +42,9 @@ PointCloud &PointCloud::Clear() {
     points_.clear();
     normals_.clear();
     colors_.clear();
+    covariances_.clear();
+    width_ = 0;
+    height_ = 0;
     return *this;
 }
 
@@ -67,6 +71,7 @@ OrientedBoundingBox PointCloud::GetOrientedBoundingBox() const {
 PointCloud &PointCloud::Transform(const Eigen::Matrix4d &transformation) {
     TransformPoints(transformation, points_);
     TransformNormals(transformation, normals_);
+    TransformCovariances(transformation, covariances_);
     return *this;
 }
 
@@ -78,6 +83,9 @@ PointCloud &PointCloud::Translate(const Eigen::Vector3d &translation,
 
 PointCloud &PointCloud::Scale(const double scale, bool center) {
     ScalePoints(scale, points_, center);
+    for (auto &covariance : covariances_) {
+        covariance *= scale * scale;
+    }
     return *this;
 }
 
@@ -86,6 +94,7 @@ PointCloud &PointCloud::Rotate(const Eigen::Vector3d &rotation,
                                RotationType type) {
     RotatePoints(rotation, points_, center, type);
     RotateNormals(rotation, normals_, center, type);
+    RotateCovariances(rotation, covariances_, type);
     return *this;
 }
 
@@ -93,6 +102,14 @@ PointCloud &PointCloud::operator+=(const PointCloud &cloud) {
     // We do not use std::vector::insert to combine std::vector because it will
     // crash if the pointcloud is added to itself.
     if (cloud.IsEmpty()) return (*this);
+    // The concatenation of two clouds has no image layout
+    if (HasPoints()) {
+        width_ = 0;
+        height_ = 0;
+    } else {
+        width_ = cloud.width_;
+        height_ = cloud.height_;
+    }
     size_t old_vert_num = points_.size();
     size_t add_vert_num = cloud.points_.size();
     size_t new_vert_num = old_vert_num + add_vert_num;
@@ -110,6 +127,13 @@ PointCloud &PointCloud::operator+=(const PointCloud &cloud) {
     } else {
         colors_.clear();
     }
+    if ((!HasPoints() || HasCovariances()) && cloud.HasCovariances()) {
+        covariances_.resize(new_vert_num);
+        for (size_t i = 0; i < add_vert_num; i++)
+            covariances_[old_vert_num + i] = cloud.covariances_[i];
+    } else {
+        covariances_.clear();
+    }
     points_.resize(new_vert_num);
     for (size_t i = 0; i < add_vert_num; i++)
         points_[old_vert_num + i] = cloud.points_[i];
@@ -125,10 +149,7 @@ std::vector<double> PointCloud::ComputePointCloudDistance(
     std::vector<double> distances(points_.size());
     KDTreeFlann kdtree;
     kdtree.SetGeometry(target);
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)points_.size(); i++) {
+    utility::ParallelFor(0, (int)points_.size(), [&](int i) {
         std::vector<int> indices(1);
         std::vector<double> dists(1);
         if (kdtree.SearchKNN(points_[i], 1, indices, dists) == 0) {
@@ -139,7 +160,7 @@ std::vector<double> PointCloud::ComputePointCloudDistance(
         } else {
             distances[i] = std::sqrt(dists[0]);
         }
-    }
+    });
     return distances;
 }
 
@@ -147,6 +168,7 @@ PointCloud &PointCloud::RemoveNoneFinitePoints(bool remove_nan,
                                                bool remove_infinite) {
     bool has_normal = HasNormals();
     bool has_color = HasColors();
+    bool has_covariance = HasCovariances();
     size_t old_point_num = points_.size();
     size_t k = 0;                                 // new index
     for (size_t i = 0; i < old_point_num; i++) {  // old index
@@ -160,12 +182,14 @@ PointCloud &PointCloud::RemoveNoneFinitePoints(bool remove_nan,
             points_[k] = points_[i];
             if (has_normal) normals_[k] = normals_[i];
             if (has_color) colors_[k] = colors_[i];
+            if (has_covariance) covariances_[k] = covariances_[i];
             k++;
         }
     }
     points_.resize(k);
     if (has_normal) normals_.resize(k);
     if (has_color) colors_.resize(k);
+    if (has_covariance) covariances_.resize(k);
     utility::LogDebug(
             "[RemoveNoneFinitePoints] {:d} nan points have been removed.\n",
             (int)(old_point_num - k));
@@ -215,23 +239,17 @@ std::vector<double> PointCloud::ComputeMahalanobisDistance() const {
     Eigen::Matrix3d covariance;
     std::tie(mean, covariance) = ComputeMeanAndCovariance();
     Eigen::Matrix3d cov_inv = covariance.inverse();
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)points_.size(); i++) {
+    utility::ParallelFor(0, (int)points_.size(), [&](int i) {
         Eigen::Vector3d p = points_[i] - mean;
         mahalanobis[i] = std::sqrt(p.transpose() * cov_inv * p);
-    }
+    });
     return mahalanobis;
 }
 
 std::vector<double> PointCloud::ComputeNearestNeighborDistance() const {
     std::vector<double> nn_dis(points_.size());
     KDTreeFlann kdtree(*this);
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)points_.size(); i++) {
+    utility::ParallelFor(0, (int)points_.size(), [&](int i) {
         std::vector<int> indices(2);
         std::vector<double> dists(2);
         if (kdtree.SearchKNN(points_[i], 2, indices, dists) <= 1) {
@@ -242,7 +260,7 @@ std::vector<double> PointCloud::ComputeNearestNeighborDistance() const {
         } else {
             nn_dis[i] = std::sqrt(dists[1]);
         }
-    }
+    });
     return nn_dis;
 }
 
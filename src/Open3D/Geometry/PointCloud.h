@@ -49,7 +49,10 @@ class VoxelGrid;
 
 class PointCloud : public Geometry3D {
 public:
-    PointCloud() : Geometry3D(Geometry::GeometryType::PointCloud) {}
+    PointCloud()
+        : Geometry3D(Geometry::GeometryType::PointCloud),
+          width_(0),
+          height_(0) {}
     ~PointCloud() override {}
 
 public:
@@ -81,6 +84,17 @@ public:
         return points_.size() > 0 && colors_.size() == points_.size();
     }
 
+    bool HasCovariances() const {
+        return points_.size() > 0 && covariances_.size() == points_.size();
+    }
+
+    /// An organized point cloud stores one point per pixel of a width_ x
+    /// height_ image in row-major order, with NaN points at invalid pixels.
+    bool IsOrganized() const {
+        return width_ > 0 && height_ > 0 &&
+               points_.size() == size_t(width_) * size_t(height_);
+    }
+
     PointCloud &NormalizeNormals() {
         for (size_t i = 0; i < normals_.size(); i++) {
             normals_[i].normalize();
@@ -124,6 +138,11 @@ public:
     /// uniformly \param every_k_points indicates the sample rate.
     std::shared_ptr<PointCloud> UniformDownSample(size_t every_k_points) const;
 
+    /// Function to downsample an organized point cloud by averaging the valid
+    /// points, normals and colors of every \param factor x factor block of
+    /// pixels. The output is organized, with NaN points for empty blocks.
+    std::shared_ptr<PointCloud> OrganizedDownSample(int factor) const;
+
     /// Function to crop \param input pointcloud into output pointcloud
     /// All points with coordinates less than \param min_bound or larger than
     /// \param max_bound are clipped.
@@ -135,6 +154,15 @@ public:
     std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
     RemoveRadiusOutliers(size_t nb_points, double search_radius) const;
 
+    /// Function to remove points of an organized point cloud that have less
+    /// than \param nb_points within \param search_radius, only considering
+    /// the pixels within \param window_radius. The output stays organized,
+    /// with the outliers set to NaN, and the indices are of the inliers.
+    std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
+    RemoveOrganizedRadiusOutliers(size_t nb_points,
+                                  double search_radius,
+                                  int window_radius = 2) const;
+
     /// Function to remove points that are further away from their
     /// \param nb_neighbor neighbors in average.
     std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
@@ -149,6 +177,16 @@ public:
             const KDTreeSearchParam &search_param = KDTreeSearchParamKNN(),
             bool fast_normal_computation = true);
 
+    /// Function to compute the normals of an organized point cloud from the
+    /// valid pixels in a (2 * \param window_radius + 1)^2 window. If
+    /// \param max_neighbor_distance is positive, neighbors further away from
+    /// the center point are ignored, which keeps normals sharp across depth
+    /// discontinuities. Otherwise the covariances are summed with integral
+    /// images in constant time per pixel. Invalid pixels get NaN normals.
+    bool EstimateNormalsOrganized(int window_radius = 2,
+                                  double max_neighbor_distance = 0.0,
+                                  bool fast_normal_computation = true);
+
     /// Function to orient the normals of a point cloud
     /// \param cloud is the input point cloud. It must have normals.
     /// Normals are oriented with respect to \param orientation_reference
@@ -200,23 +238,29 @@ public:
     /// The input depth image can be either a float image, or a uint16_t image.
     /// In the latter case, the depth is scaled by 1 / depth_scale, and
     /// truncated at depth_trunc distance. The depth image is also sampled with
-    /// stride, in order to support (fast) coarse point cloud extraction. Return
-    /// an empty pointcloud if the conversion fails.
+    /// stride, in order to support (fast) coarse point cloud extraction. If
+    /// \param project_valid_depth_only is false, the output is organized with
+    /// one point per sampled pixel and NaN points at invalid depth. Return an
+    /// empty pointcloud if the conversion fails.
     static std::shared_ptr<PointCloud> CreateFromDepthImage(
             const Image &depth,
             const camera::PinholeCameraIntrinsic &intrinsic,
             const Eigen::Matrix4d &extrinsic = Eigen::Matrix4d::Identity(),
             double depth_scale = 1000.0,
             double depth_trunc = 1000.0,
-            int stride = 1);
+            int stride = 1,
+            bool project_valid_depth_only = true);
 
     /// Factory function to create a pointcloud from an RGB-D image and a camera
     /// model (PointCloudFactory.cpp)
+    /// If \param project_valid_depth_only is false, the output is organized
+    /// as in CreateFromDepthImage.
     /// Return an empty pointcloud if the conversion fails.
     static std::shared_ptr<PointCloud> CreateFromRGBDImage(
             const RGBDImage &image,
             const camera::PinholeCameraIntrinsic &intrinsic,
-            const Eigen::Matrix4d &extrinsic = Eigen::Matrix4d::Identity());
+            const Eigen::Matrix4d &extrinsic = Eigen::Matrix4d::Identity(),
+            bool project_valid_depth_only = true);
 
     /// Function to create a PointCloud from a VoxelGrid.
     /// It transforms the voxel centers to 3D points using the original point
@@ -228,6 +272,12 @@ public:
     std::vector<Eigen::Vector3d> points_;
     std::vector<Eigen::Vector3d> normals_;
     std::vector<Eigen::Vector3d> colors_;
+    /// Per-point 3x3 covariances, e.g. of the local surface as used by
+    /// Generalized ICP. They follow rigid transformations of the cloud.
+    std::vector<Eigen::Matrix3d> covariances_;
+    /// Image layout of an organized point cloud, see IsOrganized().
+    int width_;
+    int height_;
 };
 
 }  // namespace geometry
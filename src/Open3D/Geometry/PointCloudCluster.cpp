@@ -27,9 +27,10 @@
 #include "Open3D/Geometry/PointCloud.h"
 
 #include <Eigen/Dense>
-#include <unordered_set>
+#include <algorithm>
+#include <atomic>
 
-#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/FixedRadiusIndex.h"
 #include "Open3D/Utility/Console.h"
 
 #ifdef _OPENMP
@@ -37,79 +38,151 @@
 #endif
 
 namespace open3d {
-namespace geometry {
-
-std::vector<int> PointCloud::ClusterDBSCAN(double eps,
-                                           size_t min_points,
-                                           bool print_progress) const {
-    KDTreeFlann kdtree(*this);
 
-    // precompute all neighbours
-    utility::LogDebug("Precompute Neighbours\n");
-    utility::ConsoleProgressBar progress_bar(
-            points_.size(), "Precompute Neighbours", print_progress);
-    std::vector<std::vector<int>> nbs(points_.size());
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int idx = 0; idx < int(points_.size()); ++idx) {
-        std::vector<double> dists2;
-        kdtree.SearchRadius(points_[idx], eps, nbs[idx], dists2);
+namespace {
 
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        { ++progress_bar; }
+/// Union-find over point indices that can be updated from several threads.
+/// Sets are always linked to the smaller root, so the root of a set is its
+/// smallest index.
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(size_t size) : parents_(size) {
+        for (size_t i = 0; i < size; i++) {
+            parents_[i].store(int(i));
+        }
     }
-    utility::LogDebug("Done Precompute Neighbours\n");
 
-    // set all labels to undefined (-2)
-    utility::LogDebug("Compute Clusters\n");
-    progress_bar.reset(points_.size(), "Clustering", print_progress);
-    std::vector<int> labels(points_.size(), -2);
-    int cluster_label = 0;
-    for (size_t idx = 0; idx < points_.size(); ++idx) {
-        if (labels[idx] != -2) {  // label is not undefined
-            continue;
+    int Find(int x) {
+        while (true) {
+            int parent = parents_[x].load();
+            if (parent == x) {
+                return x;
+            }
+            int grandparent = parents_[parent].load();
+            if (grandparent != parent) {
+                // Path halving, only ever moves x closer to its root
+                parents_[x].compare_exchange_weak(parent, grandparent);
+            }
+            x = grandparent;
         }
+    }
 
-        // check density
-        if (nbs[idx].size() < min_points) {
-            labels[idx] = -1;
-            continue;
+    void Union(int a, int b) {
+        while (true) {
+            a = Find(a);
+            b = Find(b);
+            if (a == b) {
+                return;
+            }
+            if (a < b) {
+                std::swap(a, b);
+            }
+            // Fails if a stopped being a root in the meantime
+            int expected = a;
+            if (parents_[a].compare_exchange_strong(expected, b)) {
+                return;
+            }
         }
+    }
 
-        std::unordered_set<int> nbs_next(nbs[idx].begin(), nbs[idx].end());
-        std::unordered_set<int> nbs_visited;
-        nbs_visited.insert(int(idx));
+private:
+    std::vector<std::atomic<int>> parents_;
+};
 
-        labels[idx] = cluster_label;
-        ++progress_bar;
-        while (!nbs_next.empty()) {
-            int nb = *nbs_next.begin();
-            nbs_next.erase(nbs_next.begin());
-            nbs_visited.insert(nb);
+}  // unnamed namespace
 
-            if (labels[nb] == -1) {  // noise label
-                labels[nb] = cluster_label;
-                ++progress_bar;
-            }
-            if (labels[nb] != -2) {  // not undefined label
-                continue;
-            }
-            labels[nb] = cluster_label;
-            ++progress_bar;
+namespace geometry {
+
+std::vector<int> PointCloud::ClusterDBSCAN(double eps,
+                                           size_t min_points,
+                                           bool print_progress) const {
+    const int num_points = int(points_.size());
+    if (num_points == 0) {
+        return std::vector<int>();
+    }
+    FixedRadiusIndex index(eps, *this);
+
+    // The neighbors are queried once and streamed instead of being stored.
+    // Core points (at least min_points neighbors, including themselves) are
+    // merged with a concurrent union-find. An edge between two core points is
+    // handled by whichever end sees the other one classified first: each
+    // point publishes its own state before reading its neighbors' states, so
+    // at least one end does. Edges to non-core points are kept to label the
+    // border points at the end; there are less than min_points per non-core
+    // point.
+    enum State : uint8_t { Unknown = 0, Core = 1, NonCore = 2 };
+    std::vector<std::atomic<uint8_t>> states(num_points);
+    for (auto &state : states) {
+        state.store(Unknown);
+    }
+    ConcurrentUnionFind union_find(num_points);
+    std::vector<std::pair<int, int>> border_edges;
 
-            if (nbs[nb].size() >= min_points) {
-                for (int qnb : nbs[nb]) {
-                    if (nbs_visited.count(qnb) == 0) {
-                        nbs_next.insert(qnb);
+    utility::LogDebug("Compute Clusters\n");
+    const int block_size = 1024;
+    const int num_blocks = (num_points + block_size - 1) / block_size;
+    utility::ConsoleProgressBar progress_bar(num_blocks, "Clustering",
+                                             print_progress);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        std::vector<int> indices;
+        std::vector<double> dists2;
+        std::vector<std::pair<int, int>> border_edges_private;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic) nowait
+#endif
+        for (int block = 0; block < num_blocks; block++) {
+            const int end = std::min((block + 1) * block_size, num_points);
+            for (int idx = block * block_size; idx < end; idx++) {
+                index.SearchRadius(points_[idx], eps, indices, dists2);
+                const bool is_core = indices.size() >= min_points;
+                states[idx].store(is_core ? Core : NonCore);
+                for (int nb : indices) {
+                    const uint8_t nb_state = states[nb].load();
+                    if (nb == idx || nb_state == Unknown) {
+                        continue;
+                    }
+                    if (is_core && nb_state == Core) {
+                        union_find.Union(idx, nb);
+                    } else if (is_core) {
+                        border_edges_private.emplace_back(nb, idx);
+                    } else if (nb_state == Core) {
+                        border_edges_private.emplace_back(idx, nb);
                     }
                 }
             }
+            ++progress_bar;
         }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            border_edges.insert(border_edges.end(),
+                                border_edges_private.begin(),
+                                border_edges_private.end());
+        }  //    omp critical
+    }      //    omp parallel
+
+    // Number the clusters in the order of their smallest core point, which is
+    // the order in which they are expanded by a serial DBSCAN.
+    std::vector<int> labels(num_points, -1);
+    int cluster_label = 0;
+    for (int idx = 0; idx < num_points; idx++) {
+        if (states[idx].load() == Core) {
+            int root = union_find.Find(idx);
+            labels[idx] = root == idx ? cluster_label++ : labels[root];
+        }
+    }
 
-        cluster_label++;
+    // A border point joins the first cluster reaching it, the one with the
+    // smallest label among its core neighbors. Others are noise (-1).
+    for (const auto &edge : border_edges) {
+        int &label = labels[edge.first];
+        if (label == -1 || labels[edge.second] < label) {
+            label = labels[edge.second];
+        }
     }
 
     utility::LogDebug("Done Compute Clusters: {:d}\n", cluster_label);
@@ -25,6 +25,9 @@
 // ----------------------------------------------------------------------------
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/Image.h"
@@ -32,49 +35,86 @@
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/Geometry/VoxelGrid.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace open3d {
 
 namespace {
 using namespace geometry;
 
-int CountValidDepthPixels(const Image &depth, int stride) {
-    int num_valid_pixels = 0;
-    for (int i = 0; i < depth.height_; i += stride) {
+/// Returns the exclusive prefix sum of the number of valid depth pixels on
+/// every sampled row, i.e. the output offset of each row. The last entry is the
+/// total number of valid pixels.
+std::vector<int> ComputeValidDepthRowOffsets(const Image &depth, int stride) {
+    const int num_rows = (depth.height_ + stride - 1) / stride;
+    std::vector<int> offsets(num_rows + 1, 0);
+    utility::ParallelFor(0, num_rows, [&](int r) {
+        const float *p = depth.PointerAt<float>(0, r * stride);
+        int num_valid_pixels = 0;
         for (int j = 0; j < depth.width_; j += stride) {
-            const float *p = depth.PointerAt<float>(j, i);
-            if (*p > 0) num_valid_pixels += 1;
+            if (p[j] > 0) num_valid_pixels += 1;
         }
+        offsets[r + 1] = num_valid_pixels;
+    });
+    for (int r = 0; r < num_rows; r++) {
+        offsets[r + 1] += offsets[r];
     }
-    return num_valid_pixels;
+    return offsets;
+}
+
+/// Returns the output offset of every sampled row of an organized point cloud,
+/// which keeps one point per sampled pixel.
+std::vector<int> ComputeOrganizedRowOffsets(const Image &depth, int stride) {
+    const int num_rows = (depth.height_ + stride - 1) / stride;
+    const int num_cols = (depth.width_ + stride - 1) / stride;
+    std::vector<int> offsets(num_rows + 1);
+    for (int r = 0; r <= num_rows; r++) {
+        offsets[r] = r * num_cols;
+    }
+    return offsets;
 }
 
 std::shared_ptr<PointCloud> CreatePointCloudFromFloatDepthImage(
         const Image &depth,
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic,
-        int stride) {
+        int stride,
+        bool project_valid_depth_only) {
     auto pointcloud = std::make_shared<PointCloud>();
     Eigen::Matrix4d camera_pose = extrinsic.inverse();
     auto focal_length = intrinsic.GetFocalLength();
     auto principal_point = intrinsic.GetPrincipalPoint();
-    int num_valid_pixels = CountValidDepthPixels(depth, stride);
-    pointcloud->points_.resize(num_valid_pixels);
-    int cnt = 0;
-    for (int i = 0; i < depth.height_; i += stride) {
+    const Eigen::Vector3d invalid_point =
+            Eigen::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN());
+    stride = std::max(stride, 1);
+    const std::vector<int> offsets =
+            project_valid_depth_only
+                    ? ComputeValidDepthRowOffsets(depth, stride)
+                    : ComputeOrganizedRowOffsets(depth, stride);
+    const int num_rows = int(offsets.size()) - 1;
+    pointcloud->points_.resize(offsets.back());
+    if (!project_valid_depth_only) {
+        pointcloud->width_ = (depth.width_ + stride - 1) / stride;
+        pointcloud->height_ = num_rows;
+    }
+    utility::ParallelFor(0, num_rows, [&](int r) {
+        const int i = r * stride;
+        const float *p = depth.PointerAt<float>(0, i);
+        int cnt = offsets[r];
         for (int j = 0; j < depth.width_; j += stride) {
-            const float *p = depth.PointerAt<float>(j, i);
-            if (*p > 0) {
-                double z = (double)(*p);
+            if (p[j] > 0) {
+                double z = (double)p[j];
                 double x = (j - principal_point.first) * z / focal_length.first;
                 double y =
                         (i - principal_point.second) * z / focal_length.second;
                 Eigen::Vector4d point =
                         camera_pose * Eigen::Vector4d(x, y, z, 1.0);
                 pointcloud->points_[cnt++] = point.block<3, 1>(0, 0);
+            } else if (!project_valid_depth_only) {
+                pointcloud->points_[cnt++] = invalid_point;
             }
         }
-    }
+    });
     return pointcloud;
 }
 
@@ -82,21 +122,31 @@ template <typename TC, int NC>
 std::shared_ptr<PointCloud> CreatePointCloudFromRGBDImageT(
         const RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
-        const Eigen::Matrix4d &extrinsic) {
+        const Eigen::Matrix4d &extrinsic,
+        bool project_valid_depth_only) {
     auto pointcloud = std::make_shared<PointCloud>();
     Eigen::Matrix4d camera_pose = extrinsic.inverse();
     auto focal_length = intrinsic.GetFocalLength();
     auto principal_point = intrinsic.GetPrincipalPoint();
+    const Eigen::Vector3d invalid_point =
+            Eigen::Vector3d::Constant(std::numeric_limits<double>::quiet_NaN());
     double scale = (sizeof(TC) == 1) ? 255.0 : 1.0;
-    int num_valid_pixels = CountValidDepthPixels(image.depth_, 1);
-    pointcloud->points_.resize(num_valid_pixels);
-    pointcloud->colors_.resize(num_valid_pixels);
-    int cnt = 0;
-    for (int i = 0; i < image.depth_.height_; i++) {
-        float *p = (float *)(image.depth_.data_.data() +
-                             i * image.depth_.BytesPerLine());
-        TC *pc = (TC *)(image.color_.data_.data() +
-                        i * image.color_.BytesPerLine());
+    const std::vector<int> offsets =
+            project_valid_depth_only
+                    ? ComputeValidDepthRowOffsets(image.depth_, 1)
+                    : ComputeOrganizedRowOffsets(image.depth_, 1);
+    pointcloud->points_.resize(offsets.back());
+    pointcloud->colors_.resize(offsets.back());
+    if (!project_valid_depth_only) {
+        pointcloud->width_ = image.depth_.width_;
+        pointcloud->height_ = image.depth_.height_;
+    }
+    utility::ParallelFor(0, image.depth_.height_, [&](int i) {
+        const float *p = (const float *)(image.depth_.data_.data() +
+                                         i * image.depth_.BytesPerLine());
+        const TC *pc = (const TC *)(image.color_.data_.data() +
+                                    i * image.color_.BytesPerLine());
+        int cnt = offsets[i];
         for (int j = 0; j < image.depth_.width_; j++, p++, pc += NC) {
             if (*p > 0) {
                 double z = (double)(*p);
@@ -109,9 +159,14 @@ std::shared_ptr<PointCloud> CreatePointCloudFromRGBDImageT(
                 pointcloud->colors_[cnt++] =
                         Eigen::Vector3d(pc[0], pc[(NC - 1) / 2], pc[NC - 1]) /
                         scale;
+            } else if (!project_valid_depth_only) {
+                pointcloud->points_[cnt] = invalid_point;
+                pointcloud->colors_[cnt++] =
+                        Eigen::Vector3d(pc[0], pc[(NC - 1) / 2], pc[NC - 1]) /
+                        scale;
             }
         }
-    }
+    });
     return pointcloud;
 }
 
@@ -124,16 +179,19 @@ std::shared_ptr<PointCloud> PointCloud::CreateFromDepthImage(
         const Eigen::Matrix4d &extrinsic /* = Eigen::Matrix4d::Identity()*/,
         double depth_scale /* = 1000.0*/,
         double depth_trunc /* = 1000.0*/,
-        int stride /* = 1*/) {
+        int stride /* = 1*/,
+        bool project_valid_depth_only /* = true*/) {
     if (depth.num_of_channels_ == 1) {
         if (depth.bytes_per_channel_ == 2) {
             auto float_depth =
                     depth.ConvertDepthToFloatImage(depth_scale, depth_trunc);
-            return CreatePointCloudFromFloatDepthImage(*float_depth, intrinsic,
-                                                       extrinsic, stride);
+            return CreatePointCloudFromFloatDepthImage(
+                    *float_depth, intrinsic, extrinsic, stride,
+                    project_valid_depth_only);
         } else if (depth.bytes_per_channel_ == 4) {
-            return CreatePointCloudFromFloatDepthImage(depth, intrinsic,
-                                                       extrinsic, stride);
+            return CreatePointCloudFromFloatDepthImage(
+                    depth, intrinsic, extrinsic, stride,
+                    project_valid_depth_only);
         }
     }
     utility::LogWarning(
@@ -144,17 +202,18 @@ std::shared_ptr<PointCloud> PointCloud::CreateFromDepthImage(
 std::shared_ptr<PointCloud> PointCloud::CreateFromRGBDImage(
         const RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
-        const Eigen::Matrix4d &extrinsic /* = Eigen::Matrix4d::Identity()*/) {
+        const Eigen::Matrix4d &extrinsic /* = Eigen::Matrix4d::Identity()*/,
+        bool project_valid_depth_only /* = true*/) {
     if (image.depth_.num_of_channels_ == 1 &&
         image.depth_.bytes_per_channel_ == 4) {
         if (image.color_.bytes_per_channel_ == 1 &&
             image.color_.num_of_channels_ == 3) {
-            return CreatePointCloudFromRGBDImageT<uint8_t, 3>(image, intrinsic,
-                                                              extrinsic);
+            return CreatePointCloudFromRGBDImageT<uint8_t, 3>(
+                    image, intrinsic, extrinsic, project_valid_depth_only);
         } else if (image.color_.bytes_per_channel_ == 4 &&
                    image.color_.num_of_channels_ == 1) {
-            return CreatePointCloudFromRGBDImageT<float, 1>(image, intrinsic,
-                                                            extrinsic);
+            return CreatePointCloudFromRGBDImageT<float, 1>(
+                    image, intrinsic, extrinsic, project_valid_depth_only);
         }
     }
     utility::LogWarning(
@@ -0,0 +1,578 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/StaticKDTree.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "Open3D/Geometry/HalfEdgeTriangleMesh.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
+
+namespace open3d {
+
+namespace {
+
+bool IsCloser(double dist2_a, int index_a, double dist2_b, int index_b) {
+    return dist2_a < dist2_b || (dist2_a == dist2_b && index_a < index_b);
+}
+
+/// Restores the max heap of (distance2, index) below i, farthest first.
+void SiftDown(double *distance2, int *indices, int size, int i) {
+    while (true) {
+        int farthest = i;
+        for (int child = 2 * i + 1; child <= 2 * i + 2 && child < size;
+             child++) {
+            if (IsCloser(distance2[farthest], indices[farthest],
+                         distance2[child], indices[child])) {
+                farthest = child;
+            }
+        }
+        if (farthest == i) {
+            return;
+        }
+        std::swap(distance2[farthest], distance2[i]);
+        std::swap(indices[farthest], indices[i]);
+        i = farthest;
+    }
+}
+
+/// Sorts a heap by increasing distance, and then index.
+void SortHeap(double *distance2, int *indices, int size) {
+    for (int end = size - 1; end > 0; end--) {
+        std::swap(distance2[0], distance2[end]);
+        std::swap(indices[0], indices[end]);
+        SiftDown(distance2, indices, end, 0);
+    }
+}
+
+/// Keeps the knn nearest neighbors closer than sqrt(radius2), sorted by
+/// insertion since knn is small.
+class KNNResultSet {
+public:
+    KNNResultSet(double radius2,
+                 int knn,
+                 std::vector<int> &indices,
+                 std::vector<double> &distance2)
+        : radius2_(radius2),
+          knn_(knn),
+          indices_(indices),
+          distance2_(distance2) {
+        indices_.resize(knn);
+        distance2_.resize(knn);
+    }
+
+    double Bound() const {
+        return size_ < knn_ ? radius2_ : distance2_[knn_ - 1];
+    }
+
+    void AddPoint(double dist2, int index) {
+        int i;
+        if (size_ < knn_) {
+            if (!(dist2 < radius2_)) {
+                return;
+            }
+            i = size_++;
+        } else if (IsCloser(dist2, index, distance2_[knn_ - 1],
+                            indices_[knn_ - 1])) {
+            i = knn_ - 1;
+        } else {
+            return;
+        }
+        for (; i > 0 && IsCloser(dist2, index, distance2_[i - 1],
+                                 indices_[i - 1]);
+             i--) {
+            distance2_[i] = distance2_[i - 1];
+            indices_[i] = indices_[i - 1];
+        }
+        distance2_[i] = dist2;
+        indices_[i] = index;
+    }
+
+    int Finalize() {
+        indices_.resize(size_);
+        distance2_.resize(size_);
+        return size_;
+    }
+
+private:
+    double radius2_;
+    int knn_;
+    int size_ = 0;
+    std::vector<int> &indices_;
+    std::vector<double> &distance2_;
+};
+
+/// Keeps all the neighbors closer than sqrt(radius2).
+class RadiusResultSet {
+public:
+    RadiusResultSet(double radius2,
+                    std::vector<int> &indices,
+                    std::vector<double> &distance2)
+        : radius2_(radius2), indices_(indices), distance2_(distance2) {
+        indices_.clear();
+        distance2_.clear();
+    }
+
+    double Bound() const { return radius2_; }
+
+    void AddPoint(double dist2, int index) {
+        if (dist2 < radius2_) {
+            distance2_.push_back(dist2);
+            indices_.push_back(index);
+        }
+    }
+
+    int Finalize() {
+        int size = int(indices_.size());
+        for (int i = size / 2 - 1; i >= 0; i--) {
+            SiftDown(distance2_.data(), indices_.data(), size, i);
+        }
+        SortHeap(distance2_.data(), indices_.data(), size);
+        return size;
+    }
+
+private:
+    double radius2_;
+    std::vector<int> &indices_;
+    std::vector<double> &distance2_;
+};
+
+}  // unnamed namespace
+
+namespace geometry {
+
+template <typename Scalar, int Dim>
+StaticKDTree<Scalar, Dim>::StaticKDTree() {}
+
+template <typename Scalar, int Dim>
+StaticKDTree<Scalar, Dim>::StaticKDTree(const Eigen::MatrixXd &data) {
+    SetMatrixData(data);
+}
+
+template <typename Scalar, int Dim>
+StaticKDTree<Scalar, Dim>::StaticKDTree(const Geometry &geometry) {
+    SetGeometry(geometry);
+}
+
+template <typename Scalar, int Dim>
+StaticKDTree<Scalar, Dim>::~StaticKDTree() {}
+
+template <typename Scalar, int Dim>
+bool StaticKDTree<Scalar, Dim>::SetMatrixData(const Eigen::MatrixXd &data) {
+    return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+            data.data(), data.rows(), data.cols()));
+}
+
+template <typename Scalar, int Dim>
+bool StaticKDTree<Scalar, Dim>::SetGeometry(const Geometry &geometry) {
+    switch (geometry.GetGeometryType()) {
+        case Geometry::GeometryType::PointCloud:
+            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+                    (const double *)((const PointCloud &)geometry)
+                            .points_.data(),
+                    3, ((const PointCloud &)geometry).points_.size()));
+        case Geometry::GeometryType::TriangleMesh:
+        case Geometry::GeometryType::HalfEdgeTriangleMesh:
+            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+                    (const double *)((const TriangleMesh &)geometry)
+                            .vertices_.data(),
+                    3, ((const TriangleMesh &)geometry).vertices_.size()));
+        case Geometry::GeometryType::Image:
+        case Geometry::GeometryType::Unspecified:
+        default:
+            utility::LogWarning(
+                    "[StaticKDTree::SetGeometry] Unsupported Geometry type.\n");
+            return false;
+    }
+}
+
+template <typename Scalar, int Dim>
+bool StaticKDTree<Scalar, Dim>::SetRawData(
+        const Eigen::Map<const Eigen::MatrixXd> &data) {
+    nodes_.clear();
+    indices_.clear();
+    if (data.rows() != Dim) {
+        utility::LogWarning(
+                "[StaticKDTree::SetRawData] Failed due to dimension {:d} "
+                "instead of {:d}.\n",
+                data.rows(), Dim);
+        return false;
+    }
+    if (data.cols() == 0) {
+        utility::LogWarning(
+                "[StaticKDTree::SetRawData] Failed due to no data.\n");
+        return false;
+    }
+    std::vector<IndexedPoint> points;
+    points.reserve(data.cols());
+    for (int i = 0; i < int(data.cols()); i++) {
+        if (data.col(i).allFinite()) {
+            points.emplace_back(data.col(i).template cast<Scalar>(), i);
+        }
+    }
+    size_t num_points = points.size();
+
+    // The leaves of a tree of depth l hold at most ceil(n / 2^l) points.
+    int depth = 0;
+    while (((num_points + (size_t(1) << depth) - 1) >> depth) >
+           size_t(kLeafSize)) {
+        depth++;
+    }
+    nodes_.resize((size_t(2) << depth) - 1);
+    first_leaf_ = (1 << depth) - 1;
+    nodes_[0].begin = 0;
+    nodes_[0].end = int(num_points);
+    // The split dimension is chosen from the bounds of the node, which are
+    // the bounds of the points at the root and are cut by the splits below.
+    std::vector<Bounds> bounds(first_leaf_ + 1);
+    if (num_points > 0) {
+        bounds[0] = Bounds(points[0].first, points[0].first);
+        for (const auto &point : points) {
+            bounds[0].first = bounds[0].first.cwiseMin(point.first);
+            bounds[0].second = bounds[0].second.cwiseMax(point.first);
+        }
+    }
+    for (int level = 0; level < depth; level++) {
+        utility::ParallelFor((1 << level) - 1, (2 << level) - 1, [&](int i) {
+            SplitNode(i, points, bounds);
+        });
+    }
+
+    indices_.resize(num_points);
+    for (int d = 0; d < Dim; d++) {
+        coordinates_[d].resize(num_points);
+    }
+    utility::ParallelFor(0, int(num_points), [&](int i) {
+        indices_[i] = points[i].second;
+        for (int d = 0; d < Dim; d++) {
+            coordinates_[d][i] = points[i].first(d);
+        }
+    });
+    return true;
+}
+
+template <typename Scalar, int Dim>
+bool StaticKDTree<Scalar, Dim>::WriteToFile(FILE *file) const {
+    const int64_t header[3] = {int64_t(first_leaf_), int64_t(nodes_.size()),
+                               int64_t(indices_.size())};
+    bool success = fwrite(header, sizeof(header), 1, file) == 1 &&
+                   fwrite(nodes_.data(), sizeof(Node), nodes_.size(), file) ==
+                           nodes_.size() &&
+                   fwrite(indices_.data(), sizeof(int), indices_.size(),
+                          file) == indices_.size();
+    for (int d = 0; d < Dim && success; d++) {
+        success = fwrite(coordinates_[d].data(), sizeof(Scalar),
+                         coordinates_[d].size(),
+                         file) == coordinates_[d].size();
+    }
+    return success;
+}
+
+template <typename Scalar, int Dim>
+size_t StaticKDTree<Scalar, Dim>::ReadFromBuffer(const char *buffer,
+                                                 size_t size,
+                                                 int num_points) {
+    int64_t header[3];
+    if (size < sizeof(header)) {
+        return 0;
+    }
+    memcpy(header, buffer, sizeof(header));
+    const int64_t first_leaf = header[0];
+    const int64_t num_nodes = header[1];
+    const int64_t num_indices = header[2];
+    // The tree is perfect, so first_leaf + 1 is a power of two.
+    if (first_leaf < 0 || first_leaf >= (int64_t(1) << 30) ||
+        ((first_leaf + 1) & first_leaf) != 0 ||
+        num_nodes != 2 * first_leaf + 1 || num_indices < 0 ||
+        num_indices > int64_t(num_points)) {
+        return 0;
+    }
+    const size_t nodes_bytes = size_t(num_nodes) * sizeof(Node);
+    const size_t indices_bytes = size_t(num_indices) * sizeof(int);
+    const size_t coordinates_bytes = size_t(num_indices) * sizeof(Scalar);
+    const size_t total_bytes = sizeof(header) + nodes_bytes + indices_bytes +
+                               Dim * coordinates_bytes;
+    if (size < total_bytes) {
+        return 0;
+    }
+
+    std::vector<Node> nodes(num_nodes);
+    std::vector<int> indices(num_indices);
+    const char *data = buffer + sizeof(header);
+    memcpy(nodes.data(), data, nodes_bytes);
+    data += nodes_bytes;
+    memcpy(indices.data(), data, indices_bytes);
+    data += indices_bytes;
+    // The children of every node split its points, which makes the root
+    // hold all of them. Leaves larger than kLeafSize would overflow the
+    // distance buffer of SearchNode.
+    if (nodes[0].begin != 0 || nodes[0].end != int(num_indices)) {
+        return 0;
+    }
+    for (int64_t i = 0; i < num_nodes; i++) {
+        const Node &node = nodes[i];
+        if (node.begin > node.end || node.split_dim < 0 ||
+            node.split_dim >= Dim) {
+            return 0;
+        }
+        if (i >= first_leaf) {
+            if (node.end - node.begin > kLeafSize) {
+                return 0;
+            }
+        } else if (nodes[2 * i + 1].begin != node.begin ||
+                   nodes[2 * i + 1].end != nodes[2 * i + 2].begin ||
+                   nodes[2 * i + 2].end != node.end) {
+            return 0;
+        }
+    }
+    for (int index : indices) {
+        if (index < 0 || index >= num_points) {
+            return 0;
+        }
+    }
+
+    nodes_.swap(nodes);
+    indices_.swap(indices);
+    first_leaf_ = int(first_leaf);
+    for (int d = 0; d < Dim; d++) {
+        coordinates_[d].resize(num_indices);
+        memcpy(coordinates_[d].data(), data, coordinates_bytes);
+        data += coordinates_bytes;
+    }
+    return total_bytes;
+}
+
+template <typename Scalar, int Dim>
+void StaticKDTree<Scalar, Dim>::SplitNode(int node_id,
+                                          std::vector<IndexedPoint> &points,
+                                          std::vector<Bounds> &bounds) {
+    Node &node = nodes_[node_id];
+    int mid = node.begin + (node.end - node.begin) / 2;
+    nodes_[2 * node_id + 1].begin = node.begin;
+    nodes_[2 * node_id + 1].end = mid;
+    nodes_[2 * node_id + 2].begin = mid;
+    nodes_[2 * node_id + 2].end = node.end;
+    if (node.begin == node.end) {
+        return;
+    }
+
+    int split_dim;
+    (bounds[node_id].second - bounds[node_id].first).maxCoeff(&split_dim);
+
+    std::nth_element(points.begin() + node.begin, points.begin() + mid,
+                     points.begin() + node.end,
+                     [split_dim](const IndexedPoint &a, const IndexedPoint &b) {
+                         return a.first(split_dim) < b.first(split_dim);
+                     });
+    node.split_dim = split_dim;
+    node.split_high = points[mid].first(split_dim);
+    node.split_low = node.split_high;
+    if (mid > node.begin) {
+        node.split_low = points[node.begin].first(split_dim);
+        for (int i = node.begin + 1; i < mid; i++) {
+            node.split_low =
+                    std::max(node.split_low, points[i].first(split_dim));
+        }
+    }
+    if (2 * node_id + 2 < int(bounds.size())) {
+        bounds[2 * node_id + 1] = bounds[node_id];
+        bounds[2 * node_id + 1].second(split_dim) = node.split_low;
+        bounds[2 * node_id + 2] = bounds[node_id];
+        bounds[2 * node_id + 2].first(split_dim) = node.split_high;
+    }
+}
+
+template <typename Scalar, int Dim>
+template <typename ResultSet>
+void StaticKDTree<Scalar, Dim>::SearchNode(int node_id,
+                                           const Scalar *query,
+                                           Scalar *offsets,
+                                           ResultSet &result) const {
+    const Node &node = nodes_[node_id];
+    if (node_id >= first_leaf_) {
+        // The squared distances are summed in the order of flann::L2.
+        Scalar dist2[kLeafSize];
+        int size = node.end - node.begin;
+        for (int i = 0; i < size; i++) {
+            dist2[i] = 0;
+        }
+        for (int d = 0; d < Dim; d++) {
+            const Scalar q = query[d];
+            const Scalar *coordinates = coordinates_[d].data() + node.begin;
+            for (int i = 0; i < size; i++) {
+                const Scalar diff = q - coordinates[i];
+                dist2[i] += diff * diff;
+            }
+        }
+        for (int i = 0; i < size; i++) {
+            result.AddPoint(double(dist2[i]), indices_[node.begin + i]);
+        }
+        return;
+    }
+
+    // Visit the child on the side of the query first. The offsets bound the
+    // distance along each dimension to the points of the far child, and their
+    // squared sum never exceeds the distance to any of those points.
+    const int d = node.split_dim;
+    const Scalar diff_low = query[d] - node.split_low;
+    const Scalar diff_high = query[d] - node.split_high;
+    int near_child = 2 * node_id + 1;
+    int far_child = 2 * node_id + 2;
+    Scalar cut = diff_high;
+    if (diff_low + diff_high >= 0) {
+        std::swap(near_child, far_child);
+        cut = diff_low;
+    }
+    SearchNode(near_child, query, offsets, result);
+    const Scalar old_offset = offsets[d];
+    offsets[d] = cut;
+    Scalar rd = 0;
+    for (int k = 0; k < Dim; k++) {
+        rd += offsets[k] * offsets[k];
+    }
+    if (double(rd) <= result.Bound()) {
+        SearchNode(far_child, query, offsets, result);
+    }
+    offsets[d] = old_offset;
+}
+
+template <typename Scalar, int Dim>
+template <typename T>
+int StaticKDTree<Scalar, Dim>::Search(const T &query,
+                                      const KDTreeSearchParam &param,
+                                      std::vector<int> &indices,
+                                      std::vector<double> &distance2) const {
+    switch (param.GetSearchType()) {
+        case KDTreeSearchParam::SearchType::Knn:
+            return SearchKNN(query, ((const KDTreeSearchParamKNN &)param).knn_,
+                             indices, distance2);
+        case KDTreeSearchParam::SearchType::Radius:
+            return SearchRadius(
+                    query, ((const KDTreeSearchParamRadius &)param).radius_,
+                    indices, distance2);
+        case KDTreeSearchParam::SearchType::Hybrid:
+            return SearchHybrid(
+                    query, ((const KDTreeSearchParamHybrid &)param).radius_,
+                    ((const KDTreeSearchParamHybrid &)param).max_nn_, indices,
+                    distance2);
+        default:
+            return -1;
+    }
+    return -1;
+}
+
+template <typename Scalar, int Dim>
+template <typename T>
+int StaticKDTree<Scalar, Dim>::SearchKNN(
+        const T &query,
+        int knn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const {
+    return SearchHybrid(query, std::numeric_limits<double>::infinity(), knn,
+                        indices, distance2);
+}
+
+template <typename Scalar, int Dim>
+template <typename T>
+int StaticKDTree<Scalar, Dim>::SearchRadius(
+        const T &query,
+        double radius,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const {
+    if (nodes_.empty() || query.rows() != Dim) {
+        return -1;
+    }
+    Scalar query_data[Dim];
+    Scalar offsets[Dim];
+    for (int d = 0; d < Dim; d++) {
+        query_data[d] = Scalar(query(d));
+        offsets[d] = 0;
+    }
+    RadiusResultSet result(double(float(radius * radius)), indices,
+                           distance2);
+    SearchNode(0, query_data, offsets, result);
+    return result.Finalize();
+}
+
+template <typename Scalar, int Dim>
+template <typename T>
+int StaticKDTree<Scalar, Dim>::SearchHybrid(
+        const T &query,
+        double radius,
+        int max_nn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const {
+    if (nodes_.empty() || query.rows() != Dim || max_nn < 0) {
+        return -1;
+    }
+    Scalar query_data[Dim];
+    Scalar offsets[Dim];
+    for (int d = 0; d < Dim; d++) {
+        query_data[d] = Scalar(query(d));
+        offsets[d] = 0;
+    }
+    KNNResultSet result(double(float(radius * radius)), max_nn, indices,
+                        distance2);
+    if (max_nn > 0) {
+        SearchNode(0, query_data, offsets, result);
+    }
+    return result.Finalize();
+}
+
+template class StaticKDTree<double, 3>;
+template class StaticKDTree<float, 3>;
+
+#define INSTANTIATE_STATIC_KDTREE_SEARCH(Scalar, T)                           \
+    template int StaticKDTree<Scalar, 3>::Search<T>(                          \
+            const T &query, const KDTreeSearchParam &param,                   \
+            std::vector<int> &indices, std::vector<double> &distance2) const; \
+    template int StaticKDTree<Scalar, 3>::SearchKNN<T>(                       \
+            const T &query, int knn, std::vector<int> &indices,               \
+            std::vector<double> &distance2) const;                            \
+    template int StaticKDTree<Scalar, 3>::SearchRadius<T>(                    \
+            const T &query, double radius, std::vector<int> &indices,         \
+            std::vector<double> &distance2) const;                            \
+    template int StaticKDTree<Scalar, 3>::SearchHybrid<T>(                    \
+            const T &query, double radius, int max_nn,                        \
+            std::vector<int> &indices, std::vector<double> &distance2) const;
+
+INSTANTIATE_STATIC_KDTREE_SEARCH(double, Eigen::Vector3d)
+INSTANTIATE_STATIC_KDTREE_SEARCH(double, Eigen::Vector3f)
+INSTANTIATE_STATIC_KDTREE_SEARCH(double, Eigen::VectorXd)
+INSTANTIATE_STATIC_KDTREE_SEARCH(float, Eigen::Vector3d)
+INSTANTIATE_STATIC_KDTREE_SEARCH(float, Eigen::Vector3f)
+INSTANTIATE_STATIC_KDTREE_SEARCH(float, Eigen::VectorXd)
+
+#undef INSTANTIATE_STATIC_KDTREE_SEARCH
+
+}  // namespace geometry
+}  // namespace open3d
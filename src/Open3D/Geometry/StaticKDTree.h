@@ -0,0 +1,144 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+#include "Open3D/Geometry/Geometry.h"
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+
+namespace open3d {
+namespace geometry {
+
+/// KD-tree over points of a compile-time dimension, stored as Scalar.
+///
+/// The tree is a perfect binary tree kept in a flat node array. It is built
+/// level by level in parallel with median splits, until every leaf holds at
+/// most kLeafSize points. The points are stored by leaf, one array per
+/// coordinate, so the distances of a leaf are computed in one vectorizable
+/// loop. Results are sorted by distance and then by index. As in KDTreeFlann,
+/// a point is within radius if its squared distance is less than the squared
+/// radius rounded to float. Non-finite points are never returned.
+template <typename Scalar, int Dim>
+class StaticKDTree {
+public:
+    static const int kLeafSize = 16;
+
+public:
+    StaticKDTree();
+    StaticKDTree(const Eigen::MatrixXd &data);
+    StaticKDTree(const Geometry &geometry);
+    ~StaticKDTree();
+    StaticKDTree(const StaticKDTree &) = delete;
+    StaticKDTree &operator=(const StaticKDTree &) = delete;
+
+public:
+    bool SetMatrixData(const Eigen::MatrixXd &data);
+    bool SetGeometry(const Geometry &geometry);
+    /// Builds the tree over the columns of a Dim x N matrix.
+    bool SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data);
+
+    /// Writes the built tree to file, to save a snapshot of it.
+    bool WriteToFile(FILE *file) const;
+    /// Restores a tree written by WriteToFile over num_points points from
+    /// memory, such as a mapped snapshot. Returns the number of bytes read, or
+    /// 0 if buffer does not hold a valid tree.
+    size_t ReadFromBuffer(const char *buffer, size_t size, int num_points);
+
+    template <typename T>
+    int Search(const T &query,
+               const KDTreeSearchParam &param,
+               std::vector<int> &indices,
+               std::vector<double> &distance2) const;
+
+    /// The knn nearest neighbors are kept sorted in indices and distance2, so
+    /// the search does not allocate once they have grown.
+    template <typename T>
+    int SearchKNN(const T &query,
+                  int knn,
+                  std::vector<int> &indices,
+                  std::vector<double> &distance2) const;
+
+    template <typename T>
+    int SearchRadius(const T &query,
+                     double radius,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2) const;
+
+    template <typename T>
+    int SearchHybrid(const T &query,
+                     double radius,
+                     int max_nn,
+                     std::vector<int> &indices,
+                     std::vector<double> &distance2) const;
+
+private:
+    struct Node {
+        /// The points of the node are [begin, end) in indices_.
+        int begin;
+        int end;
+        int split_dim;
+        /// Largest coordinate of the left child along split_dim.
+        Scalar split_low;
+        /// Smallest coordinate of the right child along split_dim.
+        Scalar split_high;
+    };
+
+    typedef std::pair<Eigen::Matrix<Scalar, Dim, 1>, int> IndexedPoint;
+    typedef std::pair<Eigen::Matrix<Scalar, Dim, 1>,
+                      Eigen::Matrix<Scalar, Dim, 1>>
+            Bounds;
+
+    /// Splits the points of a node at their median along the dimension in
+    /// which its bounds are the largest, and sets the bounds of its children.
+    void SplitNode(int node_id,
+                   std::vector<IndexedPoint> &points,
+                   std::vector<Bounds> &bounds);
+
+    /// Visits the leaves that may hold points closer than result.Bound().
+    template <typename ResultSet>
+    void SearchNode(int node_id,
+                    const Scalar *query,
+                    Scalar *offsets,
+                    ResultSet &result) const;
+
+protected:
+    /// Nodes of level l are [2^l - 1, 2^(l + 1) - 1), the children of node i
+    /// are 2i + 1 and 2i + 2.
+    std::vector<Node> nodes_;
+    int first_leaf_ = 0;
+    /// Point indices sorted by leaf.
+    std::vector<int> indices_;
+    /// coordinates_[d][i] is coordinate d of point indices_[i].
+    std::vector<Scalar> coordinates_[Dim];
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -25,149 +25,195 @@
 // ----------------------------------------------------------------------------
 
 #include "Open3D/Geometry/IntersectionTest.h"
-#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/FixedRadiusIndex.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
 
 #include <Eigen/Dense>
 
+#include <deque>
 #include <iostream>
-#include <list>
+#include <memory>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace open3d {
 namespace geometry {
 
-class BallPivotingVertex;
-class BallPivotingEdge;
-class BallPivotingTriangle;
-
-typedef std::shared_ptr<BallPivotingVertex> BallPivotingVertexPtr;
-typedef std::shared_ptr<BallPivotingEdge> BallPivotingEdgePtr;
-typedef std::shared_ptr<BallPivotingTriangle> BallPivotingTrianglePtr;
+// All BPA primitives live in flat pools owned by BallPivoting and refer to
+// each other by index. A vertex's incident edges form an intrusive singly
+// linked list threaded through the edge pool, so no per-vertex container is
+// allocated.
+//
+// The seeding pass is split over the cells of a coarse grid. Each cell is
+// triangulated by its own BallPivoting, which shares the points, the index and
+// the vertices with the root one but only creates triangles between the
+// vertices of the cell, so the cells are expanded in parallel. The pivots that
+// reach another cell are deferred, and the root merges the cells and stitches
+// their borders serially in cell order.
 
 class BallPivotingVertex {
 public:
     enum Type { Orphan = 0, Front = 1, Inner = 2 };
 
-    BallPivotingVertex(int idx,
-                       const Eigen::Vector3d& point,
-                       const Eigen::Vector3d& normal)
-        : idx_(idx), point_(point), normal_(normal), type_(Orphan) {}
-
-    void UpdateType();
+    BallPivotingVertex() : first_edge_(-1), type_(Orphan), orphan_until_(-1) {}
 
 public:
-    int idx_;
-    const Eigen::Vector3d& point_;
-    const Eigen::Vector3d& normal_;
-    std::unordered_set<BallPivotingEdgePtr> edges_;
+    int first_edge_;
     Type type_;
+    /// Number of triangles in the mesh when the vertex stopped being an
+    /// orphan, -1 while it is still one.
+    int orphan_until_;
 };
 
 class BallPivotingEdge {
 public:
     enum Type { Border = 0, Front = 1, Inner = 2 };
 
-    BallPivotingEdge(BallPivotingVertexPtr source, BallPivotingVertexPtr target)
-        : source_(source), target_(target), type_(Type::Front) {}
-
-    void AddAdjacentTriangle(BallPivotingTrianglePtr triangle);
-    BallPivotingVertexPtr GetOppositeVertex();
+    BallPivotingEdge(int source, int target)
+        : source_(source),
+          target_(target),
+          next_source_(-1),
+          next_target_(-1),
+          triangle0_(-1),
+          triangle1_(-1),
+          type_(Type::Front) {}
+
+    int GetNextEdge(int vidx) const {
+        return source_ == vidx ? next_source_ : next_target_;
+    }
+    int GetOtherVertex(int vidx) const {
+        return source_ == vidx ? target_ : source_;
+    }
 
 public:
-    BallPivotingVertexPtr source_;
-    BallPivotingVertexPtr target_;
-    BallPivotingTrianglePtr triangle0_;
-    BallPivotingTrianglePtr triangle1_;
+    int source_;
+    int target_;
+    /// Next edge in the incidence list of source_ (resp. target_).
+    int next_source_;
+    int next_target_;
+    int triangle0_;
+    int triangle1_;
     Type type_;
 };
 
 class BallPivotingTriangle {
 public:
-    BallPivotingTriangle(BallPivotingVertexPtr vert0,
-                         BallPivotingVertexPtr vert1,
-                         BallPivotingVertexPtr vert2,
-                         Eigen::Vector3d ball_center)
+    BallPivotingTriangle(int vert0,
+                         int vert1,
+                         int vert2,
+                         const Eigen::Vector3d& ball_center)
         : vert0_(vert0),
           vert1_(vert1),
           vert2_(vert2),
           ball_center_(ball_center) {}
 
 public:
-    BallPivotingVertexPtr vert0_;
-    BallPivotingVertexPtr vert1_;
-    BallPivotingVertexPtr vert2_;
+    int vert0_;
+    int vert1_;
+    int vert2_;
     Eigen::Vector3d ball_center_;
 };
 
-void BallPivotingVertex::UpdateType() {
-    if (edges_.empty()) {
-        type_ = Type::Orphan;
-    } else {
-        for (const BallPivotingEdgePtr& edge : edges_) {
-            if (edge->type_ != BallPivotingEdge::Type::Inner) {
-                type_ = Type::Front;
-                return;
-            }
-        }
-        type_ = Type::Inner;
+class BallPivoting {
+public:
+    BallPivoting(const PointCloud& pcd)
+        : has_normals_(pcd.HasNormals()),
+          pcd_(pcd),
+          points_(pcd.points_),
+          normals_(pcd.normals_),
+          index_(own_index_),
+          vertices(own_vertices_),
+          point_partitions_(own_point_partitions_) {
+        mesh_ = std::make_shared<TriangleMesh>();
+        mesh_->vertices_ = pcd.points_;
+        mesh_->vertex_normals_ = pcd.normals_;
+        mesh_->vertex_colors_ = pcd.colors_;
+        vertices.resize(pcd.points_.size());
     }
-}
 
-void BallPivotingEdge::AddAdjacentTriangle(BallPivotingTrianglePtr triangle) {
-    if (triangle != triangle0_ && triangle != triangle1_) {
-        if (triangle0_ == nullptr) {
-            triangle0_ = triangle;
-            type_ = Type::Front;
-            // update orientation
-            BallPivotingVertexPtr opp = GetOppositeVertex();
-            Eigen::Vector3d tr_norm =
-                    (target_->point_ - source_->point_)
-                            .cross(opp->point_ - source_->point_);
-            tr_norm /= tr_norm.norm();
-            Eigen::Vector3d pt_norm =
-                    source_->normal_ + target_->normal_ + opp->normal_;
-            pt_norm /= pt_norm.norm();
-            if (pt_norm.dot(tr_norm) < 0) {
-                std::swap(target_, source_);
+    /// Creates the BallPivoting of a partition of root.
+    BallPivoting(BallPivoting& root, int partition)
+        : has_normals_(root.has_normals_),
+          pcd_(root.pcd_),
+          points_(root.points_),
+          normals_(root.normals_),
+          index_(root.index_),
+          vertices(root.vertices),
+          partition_(partition),
+          point_partitions_(root.point_partitions_) {
+        mesh_ = std::make_shared<TriangleMesh>();
+    }
+
+    bool IsOwned(int vidx) const {
+        return partition_ < 0 || point_partitions_[vidx] == partition_;
+    }
+
+    void UpdateVertexType(int vidx) {
+        BallPivotingVertex& vertex = vertices[vidx];
+        if (vertex.first_edge_ < 0) {
+            vertex.type_ = BallPivotingVertex::Type::Orphan;
+            return;
+        }
+        if (vertex.type_ == BallPivotingVertex::Type::Orphan) {
+            vertex.orphan_until_ = int(triangles_.size());
+        }
+        for (int eidx = vertex.first_edge_; eidx >= 0;
+             eidx = edges_[eidx].GetNextEdge(vidx)) {
+            if (edges_[eidx].type_ != BallPivotingEdge::Type::Inner) {
+                vertex.type_ = BallPivotingVertex::Type::Front;
+                return;
             }
-        } else if (triangle1_ == nullptr) {
-            triangle1_ = triangle;
-            type_ = Type::Inner;
-        } else {
-            utility::LogDebug("!!! This case should not happen\n");
         }
+        vertex.type_ = BallPivotingVertex::Type::Inner;
     }
-}
 
-BallPivotingVertexPtr BallPivotingEdge::GetOppositeVertex() {
-    if (triangle0_ != nullptr) {
-        if (triangle0_->vert0_->idx_ != source_->idx_ &&
-            triangle0_->vert0_->idx_ != target_->idx_) {
-            return triangle0_->vert0_;
-        } else if (triangle0_->vert1_->idx_ != source_->idx_ &&
-                   triangle0_->vert1_->idx_ != target_->idx_) {
-            return triangle0_->vert1_;
+    int GetOppositeVertex(int eidx) const {
+        const BallPivotingEdge& edge = edges_[eidx];
+        if (edge.triangle0_ < 0) {
+            return -1;
+        }
+        const BallPivotingTriangle& triangle = triangles_[edge.triangle0_];
+        if (triangle.vert0_ != edge.source_ &&
+            triangle.vert0_ != edge.target_) {
+            return triangle.vert0_;
+        } else if (triangle.vert1_ != edge.source_ &&
+                   triangle.vert1_ != edge.target_) {
+            return triangle.vert1_;
         } else {
-            return triangle0_->vert2_;
+            return triangle.vert2_;
         }
-    } else {
-        return nullptr;
     }
-}
 
-class BallPivoting {
-public:
-    BallPivoting(const PointCloud& pcd)
-        : has_normals_(pcd.HasNormals()), kdtree_(pcd) {
-        mesh_ = std::make_shared<TriangleMesh>();
-        mesh_->vertices_ = pcd.points_;
-        mesh_->vertex_normals_ = pcd.normals_;
-        mesh_->vertex_colors_ = pcd.colors_;
-        for (size_t vidx = 0; vidx < pcd.points_.size(); ++vidx) {
-            vertices.emplace_back(std::make_shared<BallPivotingVertex>(
-                    vidx, pcd.points_[vidx], pcd.normals_[vidx]));
+    void AddAdjacentTriangle(int eidx, int tidx) {
+        BallPivotingEdge& edge = edges_[eidx];
+        if (tidx != edge.triangle0_ && tidx != edge.triangle1_) {
+            if (edge.triangle0_ < 0) {
+                edge.triangle0_ = tidx;
+                edge.type_ = BallPivotingEdge::Type::Front;
+                // update orientation
+                int opp = GetOppositeVertex(eidx);
+                const Eigen::Vector3d& src = points_[edge.source_];
+                Eigen::Vector3d tr_norm =
+                        (points_[edge.target_] - src).cross(points_[opp] - src);
+                tr_norm /= tr_norm.norm();
+                Eigen::Vector3d pt_norm = normals_[edge.source_] +
+                                          normals_[edge.target_] +
+                                          normals_[opp];
+                pt_norm /= pt_norm.norm();
+                if (pt_norm.dot(tr_norm) < 0) {
+                    std::swap(edge.target_, edge.source_);
+                    std::swap(edge.next_target_, edge.next_source_);
+                }
+            } else if (edge.triangle1_ < 0) {
+                edge.triangle1_ = tidx;
+                edge.type_ = BallPivotingEdge::Type::Inner;
+            } else {
+                utility::LogDebug("!!! This case should not happen\n");
+            }
         }
     }
 
@@ -175,10 +221,10 @@ public:
                            int vidx2,
                            int vidx3,
                            double radius,
-                           Eigen::Vector3d& center) {
-        const Eigen::Vector3d& v1 = vertices[vidx1]->point_;
-        const Eigen::Vector3d& v2 = vertices[vidx2]->point_;
-        const Eigen::Vector3d& v3 = vertices[vidx3]->point_;
+                           Eigen::Vector3d& center) const {
+        const Eigen::Vector3d& v1 = points_[vidx1];
+        const Eigen::Vector3d& v2 = points_[vidx2];
+        const Eigen::Vector3d& v3 = points_[vidx3];
         double c = (v2 - v1).squaredNorm();
         double b = (v1 - v3).squaredNorm();
         double a = (v3 - v2).squaredNorm();
@@ -209,9 +255,8 @@ public:
         if (height >= 0.0) {
             Eigen::Vector3d tr_norm = (v2 - v1).cross(v3 - v1);
             tr_norm /= tr_norm.norm();
-            Eigen::Vector3d pt_norm = vertices[vidx1]->normal_ +
-                                      vertices[vidx2]->normal_ +
-                                      vertices[vidx3]->normal_;
+            Eigen::Vector3d pt_norm =
+                    normals_[vidx1] + normals_[vidx2] + normals_[vidx3];
             pt_norm /= pt_norm.norm();
             if (tr_norm.dot(pt_norm) < 0) {
                 tr_norm *= -1;
@@ -224,72 +269,58 @@ public:
         return false;
     }
 
-    BallPivotingEdgePtr GetLinkingEdge(const BallPivotingVertexPtr& v0,
-                                       const BallPivotingVertexPtr& v1) {
-        for (BallPivotingEdgePtr edge0 : v0->edges_) {
-            for (BallPivotingEdgePtr edge1 : v1->edges_) {
-                if (edge0->source_->idx_ == edge1->source_->idx_ &&
-                    edge0->target_->idx_ == edge1->target_->idx_) {
-                    return edge0;
-                }
+    int GetLinkingEdge(int v0, int v1) const {
+        for (int eidx = vertices[v0].first_edge_; eidx >= 0;
+             eidx = edges_[eidx].GetNextEdge(v0)) {
+            if (edges_[eidx].GetOtherVertex(v0) == v1) {
+                return eidx;
             }
         }
-        return nullptr;
+        return -1;
     }
 
-    void CreateTriangle(const BallPivotingVertexPtr& v0,
-                        const BallPivotingVertexPtr& v1,
-                        const BallPivotingVertexPtr& v2,
-                        const Eigen::Vector3d& center) {
-        utility::LogDebug(
-                "[CreateTriangle] with v0.idx={}, v1.idx={}, v2.idx={}\n",
-                v0->idx_, v1->idx_, v2->idx_);
-        BallPivotingTrianglePtr triangle =
-                std::make_shared<BallPivotingTriangle>(v0, v1, v2, center);
-
-        BallPivotingEdgePtr e0 = GetLinkingEdge(v0, v1);
-        if (e0 == nullptr) {
-            e0 = std::make_shared<BallPivotingEdge>(v0, v1);
+    int GetOrCreateLinkingEdge(int v0, int v1) {
+        int eidx = GetLinkingEdge(v0, v1);
+        if (eidx < 0) {
+            eidx = int(edges_.size());
+            edges_.emplace_back(v0, v1);
+            BallPivotingEdge& edge = edges_.back();
+            edge.next_source_ = vertices[v0].first_edge_;
+            edge.next_target_ = vertices[v1].first_edge_;
+            vertices[v0].first_edge_ = eidx;
+            vertices[v1].first_edge_ = eidx;
         }
-        e0->AddAdjacentTriangle(triangle);
-        v0->edges_.insert(e0);
-        v1->edges_.insert(e0);
+        return eidx;
+    }
 
-        BallPivotingEdgePtr e1 = GetLinkingEdge(v1, v2);
-        if (e1 == nullptr) {
-            e1 = std::make_shared<BallPivotingEdge>(v1, v2);
-        }
-        e1->AddAdjacentTriangle(triangle);
-        v1->edges_.insert(e1);
-        v2->edges_.insert(e1);
+    void CreateTriangle(int v0, int v1, int v2, const Eigen::Vector3d& center) {
+        utility::LogDebug(
+                "[CreateTriangle] with v0.idx={}, v1.idx={}, v2.idx={}\n", v0,
+                v1, v2);
+        int tidx = int(triangles_.size());
+        triangles_.emplace_back(v0, v1, v2, center);
 
-        BallPivotingEdgePtr e2 = GetLinkingEdge(v2, v0);
-        if (e2 == nullptr) {
-            e2 = std::make_shared<BallPivotingEdge>(v2, v0);
-        }
-        e2->AddAdjacentTriangle(triangle);
-        v2->edges_.insert(e2);
-        v0->edges_.insert(e2);
+        AddAdjacentTriangle(GetOrCreateLinkingEdge(v0, v1), tidx);
+        AddAdjacentTriangle(GetOrCreateLinkingEdge(v1, v2), tidx);
+        AddAdjacentTriangle(GetOrCreateLinkingEdge(v2, v0), tidx);
 
-        v0->UpdateType();
-        v1->UpdateType();
-        v2->UpdateType();
+        UpdateVertexType(v0);
+        UpdateVertexType(v1);
+        UpdateVertexType(v2);
 
         Eigen::Vector3d face_normal =
-                ComputeFaceNormal(v0->point_, v1->point_, v2->point_);
-        if (face_normal.dot(v0->normal_) > -1e-16) {
-            mesh_->triangles_.emplace_back(
-                    Eigen::Vector3i(v0->idx_, v1->idx_, v2->idx_));
+                ComputeFaceNormal(points_[v0], points_[v1], points_[v2]);
+        if (face_normal.dot(normals_[v0]) > -1e-16) {
+            mesh_->triangles_.emplace_back(Eigen::Vector3i(v0, v1, v2));
         } else {
-            mesh_->triangles_.emplace_back(
-                    Eigen::Vector3i(v0->idx_, v2->idx_, v1->idx_));
+            mesh_->triangles_.emplace_back(Eigen::Vector3i(v0, v2, v1));
         }
         mesh_->triangle_normals_.push_back(face_normal);
     }
 
     Eigen::Vector3d ComputeFaceNormal(const Eigen::Vector3d& v0,
                                       const Eigen::Vector3d& v1,
-                                      const Eigen::Vector3d& v2) {
+                                      const Eigen::Vector3d& v2) const {
         Eigen::Vector3d normal = (v1 - v0).cross(v2 - v0);
         double norm = normal.norm();
         if (norm > 0) {
@@ -298,123 +329,113 @@ public:
         return normal;
     }
 
-    bool IsCompatible(const BallPivotingVertexPtr& v0,
-                      const BallPivotingVertexPtr& v1,
-                      const BallPivotingVertexPtr& v2) {
+    bool IsCompatible(int v0, int v1, int v2) const {
         utility::LogDebug("[IsCompatible] v0.idx={}, v1.idx={}, v2.idx={}\n",
-                          v0->idx_, v1->idx_, v2->idx_);
+                          v0, v1, v2);
         Eigen::Vector3d normal =
-                ComputeFaceNormal(v0->point_, v1->point_, v2->point_);
-        if (normal.dot(v0->normal_) < -1e-16) {
+                ComputeFaceNormal(points_[v0], points_[v1], points_[v2]);
+        if (normal.dot(normals_[v0]) < -1e-16) {
             normal *= -1;
         }
-        bool ret = normal.dot(v0->normal_) > -1e-16 &&
-                   normal.dot(v1->normal_) > -1e-16 &&
-                   normal.dot(v2->normal_) > -1e-16;
+        bool ret = normal.dot(normals_[v0]) > -1e-16 &&
+                   normal.dot(normals_[v1]) > -1e-16 &&
+                   normal.dot(normals_[v2]) > -1e-16;
         utility::LogDebug("[IsCompatible] retuns = {}\n", ret);
         return ret;
     }
 
-    BallPivotingVertexPtr FindCandidateVertex(
-            const BallPivotingEdgePtr& edge,
-            double radius,
-            Eigen::Vector3d& candidate_center) {
+    int FindCandidateVertex(int eidx,
+                            double radius,
+                            Eigen::Vector3d& candidate_center) {
+        const int src = edges_[eidx].source_;
+        const int tgt = edges_[eidx].target_;
         utility::LogDebug("[FindCandidateVertex] edge=({}, {}), radius={}\n",
-                          edge->source_->idx_, edge->target_->idx_, radius);
-        BallPivotingVertexPtr src = edge->source_;
-        BallPivotingVertexPtr tgt = edge->target_;
-
-        const BallPivotingVertexPtr opp = edge->GetOppositeVertex();
-        utility::LogDebug("[FindCandidateVertex] edge=({}, {}), opp={}\n",
-                          src->idx_, tgt->idx_, opp->idx_);
-        utility::LogDebug("[FindCandidateVertex] src={} => {}\n", src->idx_,
-                          src->point_.transpose());
-        utility::LogDebug("[FindCandidateVertex] tgt={} => {}\n", tgt->idx_,
-                          tgt->point_.transpose());
-        utility::LogDebug("[FindCandidateVertex] src={} => {}\n", opp->idx_,
-                          opp->point_.transpose());
-
-        Eigen::Vector3d mp = 0.5 * (src->point_ + tgt->point_);
-        utility::LogDebug("[FindCandidateVertex] edge=({}, {}), mp={}\n",
-                          edge->source_->idx_, edge->target_->idx_,
-                          mp.transpose());
-
-        BallPivotingTrianglePtr triangle = edge->triangle0_;
-        const Eigen::Vector3d& center = triangle->ball_center_;
+                          src, tgt, radius);
+
+        const int opp = GetOppositeVertex(eidx);
+        utility::LogDebug("[FindCandidateVertex] edge=({}, {}), opp={}\n", src,
+                          tgt, opp);
+        utility::LogDebug("[FindCandidateVertex] src={} => {}\n", src,
+                          points_[src].transpose());
+        utility::LogDebug("[FindCandidateVertex] tgt={} => {}\n", tgt,
+                          points_[tgt].transpose());
+        utility::LogDebug("[FindCandidateVertex] src={} => {}\n", opp,
+                          points_[opp].transpose());
+
+        Eigen::Vector3d mp = 0.5 * (points_[src] + points_[tgt]);
+        utility::LogDebug("[FindCandidateVertex] edge=({}, {}), mp={}\n", src,
+                          tgt, mp.transpose());
+
+        const Eigen::Vector3d& center =
+                triangles_[edges_[eidx].triangle0_].ball_center_;
         utility::LogDebug("[FindCandidateVertex] edge=({}, {}), center={}\n",
-                          edge->source_->idx_, edge->target_->idx_,
-                          center.transpose());
+                          src, tgt, center.transpose());
 
-        Eigen::Vector3d v = tgt->point_ - src->point_;
+        Eigen::Vector3d v = points_[tgt] - points_[src];
         v /= v.norm();
 
         Eigen::Vector3d a = center - mp;
         a /= a.norm();
 
-        std::vector<int> indices;
-        std::vector<double> dists2;
-        kdtree_.SearchRadius(mp, 2 * radius, indices, dists2);
+        index_.SearchRadius(mp, 2 * radius, indices_, dists2_);
         utility::LogDebug(
                 "[FindCandidateVertex] found {} potential candidates\n",
-                indices.size());
+                indices_.size());
 
-        BallPivotingVertexPtr min_candidate = nullptr;
+        int min_candidate = -1;
         double min_angle = 2 * M_PI;
-        for (auto nbidx : indices) {
+        for (auto nbidx : indices_) {
             utility::LogDebug("[FindCandidateVertex] nbidx {:d}\n", nbidx);
-            const BallPivotingVertexPtr& candidate = vertices[nbidx];
-            if (candidate->idx_ == src->idx_ || candidate->idx_ == tgt->idx_ ||
-                candidate->idx_ == opp->idx_) {
+            if (nbidx == src || nbidx == tgt || nbidx == opp) {
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} is a triangle "
                         "vertex of the edge\n",
-                        candidate->idx_);
+                        nbidx);
                 continue;
             }
+            const Eigen::Vector3d& candidate = points_[nbidx];
             utility::LogDebug("[FindCandidateVertex] candidate={:d} => {}\n",
-                              candidate->idx_, candidate->point_.transpose());
+                              nbidx, candidate.transpose());
 
             bool coplanar = IntersectionTest::PointsCoplanar(
-                    src->point_, tgt->point_, opp->point_, candidate->point_);
+                    points_[src], points_[tgt], points_[opp], candidate);
             if (coplanar && (IntersectionTest::LineSegmentsMinimumDistance(
-                                     mp, candidate->point_, src->point_,
-                                     opp->point_) < 1e-12 ||
+                                     mp, candidate, points_[src],
+                                     points_[opp]) < 1e-12 ||
                              IntersectionTest::LineSegmentsMinimumDistance(
-                                     mp, candidate->point_, tgt->point_,
-                                     opp->point_) < 1e-12)) {
+                                     mp, candidate, points_[tgt],
+                                     points_[opp]) < 1e-12)) {
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} is interesecting "
                         "the existing triangle\n",
-                        candidate->idx_);
+                        nbidx);
                 continue;
             }
 
             Eigen::Vector3d new_center;
-            if (!ComputeBallCenter(src->idx_, tgt->idx_, candidate->idx_,
-                                   radius, new_center)) {
+            if (!ComputeBallCenter(src, tgt, nbidx, radius, new_center)) {
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} can not compute "
                         "ball\n",
-                        candidate->idx_);
+                        nbidx);
                 continue;
             }
             utility::LogDebug(
-                    "[FindCandidateVertex] candidate {:d} center={}\n",
-                    candidate->idx_, new_center.transpose());
+                    "[FindCandidateVertex] candidate {:d} center={}\n", nbidx,
+                    new_center.transpose());
 
             Eigen::Vector3d b = new_center - mp;
             b /= b.norm();
             utility::LogDebug(
                     "[FindCandidateVertex] candidate {:d} v={}, a={}, b={}\n",
-                    candidate->idx_, v.transpose(), a.transpose(),
-                    b.transpose());
+                    nbidx, v.transpose(), a.transpose(), b.transpose());
 
             double cosinus = a.dot(b);
             cosinus = std::min(cosinus, 1.0);
             cosinus = std::max(cosinus, -1.0);
             utility::LogDebug(
                     "[FindCandidateVertex] candidate {:d} cosinus={:f}\n",
-                    candidate->idx_, cosinus);
+                    nbidx, cosinus);
 
             double angle = std::acos(cosinus);
 
@@ -427,22 +448,20 @@ public:
                 utility::LogDebug(
                         "[FindCandidateVertex] candidate {:d} angle {:f} > "
                         "min_angle {:f}\n",
-                        candidate->idx_, angle, min_angle);
+                        nbidx, angle, min_angle);
                 continue;
             }
 
             bool empty_ball = true;
-            for (auto nbidx2 : indices) {
-                const BallPivotingVertexPtr& nb = vertices[nbidx2];
-                if (nb->idx_ == src->idx_ || nb->idx_ == tgt->idx_ ||
-                    nb->idx_ == candidate->idx_) {
+            for (auto nbidx2 : indices_) {
+                if (nbidx2 == src || nbidx2 == tgt || nbidx2 == nbidx) {
                     continue;
                 }
-                if ((new_center - nb->point_).norm() < radius - 1e-16) {
+                if ((new_center - points_[nbidx2]).norm() < radius - 1e-16) {
                     utility::LogDebug(
                             "[FindCandidateVertex] candidate {:d} not an empty "
                             "ball\n",
-                            candidate->idx_);
+                            nbidx);
                     empty_ball = false;
                     break;
                 }
@@ -450,96 +469,102 @@ public:
 
             if (empty_ball) {
                 utility::LogDebug(
-                        "[FindCandidateVertex] candidate {:d} works\n",
-                        candidate->idx_);
+                        "[FindCandidateVertex] candidate {:d} works\n", nbidx);
                 min_angle = angle;
-                min_candidate = vertices[nbidx];
+                min_candidate = nbidx;
                 candidate_center = new_center;
             }
         }
 
-        if (min_candidate == nullptr) {
+        if (min_candidate < 0) {
             utility::LogDebug("[FindCandidateVertex] returns nullptr\n");
         } else {
             utility::LogDebug("[FindCandidateVertex] returns {:d}\n",
-                              min_candidate->idx_);
+                              min_candidate);
         }
         return min_candidate;
     }
 
+    void PushFrontIfFront(int eidx) {
+        if (edges_[eidx].type_ == BallPivotingEdge::Type::Front) {
+            edge_front_.push_front(eidx);
+        }
+    }
+
     void ExpandTriangulation(double radius) {
         utility::LogDebug("[ExpandTriangulation] radius={}\n", radius);
         while (!edge_front_.empty()) {
-            BallPivotingEdgePtr edge = edge_front_.front();
+            int eidx = edge_front_.front();
             edge_front_.pop_front();
-            if (edge->type_ != BallPivotingEdge::Front) {
+            if (edges_[eidx].type_ != BallPivotingEdge::Front) {
                 continue;
             }
 
             Eigen::Vector3d center;
-            BallPivotingVertexPtr candidate =
-                    FindCandidateVertex(edge, radius, center);
-            if (candidate == nullptr ||
-                candidate->type_ == BallPivotingVertex::Type::Inner ||
-                !IsCompatible(candidate, edge->source_, edge->target_)) {
-                edge->type_ = BallPivotingEdge::Type::Border;
-                border_edges_.push_back(edge);
+            int candidate = FindCandidateVertex(eidx, radius, center);
+            if (candidate >= 0 && !IsOwned(candidate)) {
+                deferred_edges_.push_back(eidx);
+                continue;
+            }
+            const int src = edges_[eidx].source_;
+            const int tgt = edges_[eidx].target_;
+            if (candidate < 0 ||
+                vertices[candidate].type_ == BallPivotingVertex::Type::Inner ||
+                !IsCompatible(candidate, src, tgt)) {
+                edges_[eidx].type_ = BallPivotingEdge::Type::Border;
+                border_edges_.push_back(eidx);
                 continue;
             }
 
-            BallPivotingEdgePtr e0 = GetLinkingEdge(candidate, edge->source_);
-            BallPivotingEdgePtr e1 = GetLinkingEdge(candidate, edge->target_);
-            if ((e0 != nullptr && e0->type_ != BallPivotingEdge::Type::Front) ||
-                (e1 != nullptr && e1->type_ != BallPivotingEdge::Type::Front)) {
-                edge->type_ = BallPivotingEdge::Type::Border;
-                border_edges_.push_back(edge);
+            int e0 = GetLinkingEdge(candidate, src);
+            int e1 = GetLinkingEdge(candidate, tgt);
+            if ((e0 >= 0 &&
+                 edges_[e0].type_ != BallPivotingEdge::Type::Front) ||
+                (e1 >= 0 &&
+                 edges_[e1].type_ != BallPivotingEdge::Type::Front)) {
+                edges_[eidx].type_ = BallPivotingEdge::Type::Border;
+                border_edges_.push_back(eidx);
                 continue;
             }
 
-            CreateTriangle(edge->source_, edge->target_, candidate, center);
+            CreateTriangle(src, tgt, candidate, center);
 
-            e0 = GetLinkingEdge(candidate, edge->source_);
-            e1 = GetLinkingEdge(candidate, edge->target_);
-            if (e0->type_ == BallPivotingEdge::Type::Front) {
-                edge_front_.push_front(e0);
-            }
-            if (e1->type_ == BallPivotingEdge::Type::Front) {
-                edge_front_.push_front(e1);
-            }
+            PushFrontIfFront(GetLinkingEdge(candidate, src));
+            PushFrontIfFront(GetLinkingEdge(candidate, tgt));
         }
     }
 
-    bool TryTriangleSeed(const BallPivotingVertexPtr& v0,
-                         const BallPivotingVertexPtr& v1,
-                         const BallPivotingVertexPtr& v2,
+    bool TryTriangleSeed(int v0,
+                         int v1,
+                         int v2,
                          const std::vector<int>& nb_indices,
                          double radius,
-                         Eigen::Vector3d& center) {
+                         Eigen::Vector3d& center) const {
         utility::LogDebug(
                 "[TryTriangleSeed] v0.idx={}, v1.idx={}, v2.idx={}, "
                 "radius={}\n",
-                v0->idx_, v1->idx_, v2->idx_, radius);
+                v0, v1, v2, radius);
 
         if (!IsCompatible(v0, v1, v2)) {
             return false;
         }
 
-        BallPivotingEdgePtr e0 = GetLinkingEdge(v0, v2);
-        BallPivotingEdgePtr e1 = GetLinkingEdge(v1, v2);
-        if (e0 != nullptr && e0->type_ == BallPivotingEdge::Type::Inner) {
+        int e0 = GetLinkingEdge(v0, v2);
+        int e1 = GetLinkingEdge(v1, v2);
+        if (e0 >= 0 && edges_[e0].type_ == BallPivotingEdge::Type::Inner) {
             utility::LogDebug(
                     "[TryTriangleSeed] returns {} because e0 is inner edge\n",
                     false);
             return false;
         }
-        if (e1 != nullptr && e1->type_ == BallPivotingEdge::Type::Inner) {
+        if (e1 >= 0 && edges_[e1].type_ == BallPivotingEdge::Type::Inner) {
             utility::LogDebug(
                     "[TryTriangleSeed] returns {} because e1 is inner edge\n",
                     false);
             return false;
         }
 
-        if (!ComputeBallCenter(v0->idx_, v1->idx_, v2->idx_, radius, center)) {
+        if (!ComputeBallCenter(v0, v1, v2, radius, center)) {
             utility::LogDebug(
                     "[TryTriangleSeed] returns {} could not compute ball "
                     "center\n",
@@ -549,12 +574,10 @@ public:
 
         // test if no other point is within the ball
         for (const auto& nbidx : nb_indices) {
-            const BallPivotingVertexPtr& v = vertices[nbidx];
-            if (v->idx_ == v0->idx_ || v->idx_ == v1->idx_ ||
-                v->idx_ == v2->idx_) {
+            if (nbidx == v0 || nbidx == v1 || nbidx == v2) {
                 continue;
             }
-            if ((center - v->point_).norm() < radius - 1e-16) {
+            if ((center - points_[nbidx]).norm() < radius - 1e-16) {
                 utility::LogDebug(
                         "[TryTriangleSeed] returns {} computed ball is not "
                         "empty\n",
@@ -567,99 +590,276 @@ public:
         return true;
     }
 
-    bool TrySeed(BallPivotingVertexPtr& v, double radius) {
-        utility::LogDebug("[TrySeed] with v.idx={}, radius={}\n", v->idx_,
-                          radius);
-        std::vector<int> indices;
-        std::vector<double> dists2;
-        kdtree_.SearchRadius(v->point_, 2 * radius, indices, dists2);
+    /// Searches the first seed triangle (vidx, nb0, nb1) among the owned
+    /// orphan vertices in indices. Only reads the vertex types, so it is safe
+    /// to run concurrently as long as no triangle is created meanwhile.
+    bool FindSeedTriangle(int vidx,
+                          const std::vector<int>& indices,
+                          double radius,
+                          int& nb0,
+                          int& nb1,
+                          Eigen::Vector3d& center) const {
         if (indices.size() < 3u) {
             return false;
         }
-
         for (size_t nbidx0 = 0; nbidx0 < indices.size(); ++nbidx0) {
-            const BallPivotingVertexPtr& nb0 = vertices[indices[nbidx0]];
-            if (nb0->type_ != BallPivotingVertex::Type::Orphan) {
+            nb0 = indices[nbidx0];
+            if (!IsOwned(nb0) ||
+                vertices[nb0].type_ != BallPivotingVertex::Type::Orphan) {
                 continue;
             }
-            if (nb0->idx_ == v->idx_) {
+            if (nb0 == vidx) {
                 continue;
             }
-
-            int candidate_vidx2 = -1;
-            Eigen::Vector3d center;
             for (size_t nbidx1 = nbidx0 + 1; nbidx1 < indices.size();
                  ++nbidx1) {
-                const BallPivotingVertexPtr& nb1 = vertices[indices[nbidx1]];
-                if (nb1->type_ != BallPivotingVertex::Type::Orphan) {
+                nb1 = indices[nbidx1];
+                if (!IsOwned(nb1) ||
+                    vertices[nb1].type_ != BallPivotingVertex::Type::Orphan) {
                     continue;
                 }
-                if (nb1->idx_ == v->idx_) {
+                if (nb1 == vidx) {
                     continue;
                 }
-                if (TryTriangleSeed(v, nb0, nb1, indices, radius, center)) {
-                    candidate_vidx2 = nb1->idx_;
-                    break;
+                if (TryTriangleSeed(vidx, nb0, nb1, indices, radius, center)) {
+                    return true;
                 }
             }
+        }
+        return false;
+    }
 
-            if (candidate_vidx2 >= 0) {
-                const BallPivotingVertexPtr& nb1 = vertices[candidate_vidx2];
+    void CreateSeedTriangle(int vidx,
+                            int nb0,
+                            int nb1,
+                            const Eigen::Vector3d& center) {
+        // All three vertices are orphans, hence the three edges are new and
+        // of type Front after the triangle is created.
+        CreateTriangle(vidx, nb0, nb1, center);
+        PushFrontIfFront(GetLinkingEdge(vidx, nb1));
+        PushFrontIfFront(GetLinkingEdge(nb0, nb1));
+        PushFrontIfFront(GetLinkingEdge(vidx, nb0));
+    }
 
-                BallPivotingEdgePtr e0 = GetLinkingEdge(v, nb1);
-                if (e0 != nullptr &&
-                    e0->type_ != BallPivotingEdge::Type::Front) {
-                    continue;
+    /// Seed candidate of an orphan vertex, computed speculatively in parallel
+    /// against the mesh state at seed_epoch_.
+    struct SeedCandidate {
+        int vidx_;
+        bool found_;
+        int nb0_;
+        int nb1_;
+        Eigen::Vector3d center_;
+        std::vector<int> indices_;
+    };
+
+    /// A speculative seed is still exact if none of the vertices it looked
+    /// at has left the orphan state since it was computed.
+    bool IsSeedCandidateValid(const SeedCandidate& seed) const {
+        for (int nbidx : seed.indices_) {
+            int until = vertices[nbidx].orphan_until_;
+            if (until > seed_epoch_) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void FindSeedTriangles(double radius) {
+        // Vertices are visited in index order exactly as in a serial sweep.
+        // The seed searches of a chunk of orphan vertices are evaluated in
+        // parallel and then committed serially. The sweep restarts at the
+        // first candidate whose neighborhood was touched by an expansion, so
+        // the output does not depend on the number of threads. The chunk
+        // grows while speculation succeeds and shrinks back after a restart.
+#ifdef _OPENMP
+        const int min_chunk_size = omp_get_max_threads();
+#else
+        const int min_chunk_size = 1;
+#endif
+        const int max_chunk_size = 4096;
+        int chunk_size = min_chunk_size;
+        std::vector<SeedCandidate> seeds;
+        int vidx = 0;
+        while (vidx < int(vertices.size())) {
+            seeds.clear();
+            for (; vidx < int(vertices.size()) &&
+                   int(seeds.size()) < chunk_size;
+                 ++vidx) {
+                if (vertices[vidx].type_ == BallPivotingVertex::Type::Orphan) {
+                    seeds.emplace_back();
+                    seeds.back().vidx_ = vidx;
                 }
-                BallPivotingEdgePtr e1 = GetLinkingEdge(nb0, nb1);
-                if (e1 != nullptr &&
-                    e1->type_ != BallPivotingEdge::Type::Front) {
+            }
+            seed_epoch_ = int(triangles_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+            for (int sidx = 0; sidx < int(seeds.size()); sidx++) {
+                SeedCandidate& seed = seeds[sidx];
+                std::vector<double> dists2;
+                index_.SearchRadius(points_[seed.vidx_], 2 * radius,
+                                     seed.indices_, dists2);
+                seed.found_ = FindSeedTriangle(seed.vidx_, seed.indices_,
+                                               radius, seed.nb0_, seed.nb1_,
+                                               seed.center_);
+            }
+
+            chunk_size = std::min(2 * chunk_size, max_chunk_size);
+            for (const SeedCandidate& seed : seeds) {
+                utility::LogDebug(
+                        "[FindSeedTriangles] with radius={}, vidx={}\n",
+                        radius, seed.vidx_);
+                if (vertices[seed.vidx_].type_ !=
+                    BallPivotingVertex::Type::Orphan) {
                     continue;
                 }
-                BallPivotingEdgePtr e2 = GetLinkingEdge(v, nb0);
-                if (e2 != nullptr &&
-                    e2->type_ != BallPivotingEdge::Type::Front) {
-                    continue;
+                if (!IsSeedCandidateValid(seed)) {
+                    vidx = seed.vidx_;
+                    chunk_size = min_chunk_size;
+                    break;
                 }
+                if (seed.found_) {
+                    CreateSeedTriangle(seed.vidx_, seed.nb0_, seed.nb1_,
+                                       seed.center_);
+                    ExpandTriangulation(radius);
+                }
+            }
+        }
+    }
 
-                CreateTriangle(v, nb0, nb1, center);
+    /// Serial seeding and expansion of the vertices of a partition.
+    void FindPartitionSeedTriangles(double radius) {
+        for (int vidx : partition_vertices_) {
+            if (vertices[vidx].type_ != BallPivotingVertex::Type::Orphan) {
+                continue;
+            }
+            index_.SearchRadius(points_[vidx], 2 * radius, indices_, dists2_);
+            int nb0, nb1;
+            Eigen::Vector3d center;
+            if (FindSeedTriangle(vidx, indices_, radius, nb0, nb1, center)) {
+                CreateSeedTriangle(vidx, nb0, nb1, center);
+                ExpandTriangulation(radius);
+            }
+        }
+    }
 
-                e0 = GetLinkingEdge(v, nb1);
-                e1 = GetLinkingEdge(nb0, nb1);
-                e2 = GetLinkingEdge(v, nb0);
-                if (e0->type_ == BallPivotingEdge::Type::Front) {
-                    edge_front_.push_front(e0);
-                }
-                if (e1->type_ == BallPivotingEdge::Type::Front) {
-                    edge_front_.push_front(e1);
-                }
-                if (e2->type_ == BallPivotingEdge::Type::Front) {
-                    edge_front_.push_front(e2);
-                }
+    /// Assigns the points to the cells of a grid that is coarse compared to
+    /// the radius and returns the vertices of each non-empty cell.
+    std::vector<std::vector<int>> ComputePartitions(double radius) {
+        const int max_cells_per_axis = 8;
+        const double min_cell_size = 32 * radius;
+        const Eigen::Vector3d min_bound = pcd_.GetMinBound();
+        const Eigen::Vector3d extent = pcd_.GetMaxBound() - min_bound;
+        const double cell_size = std::max(
+                min_cell_size, extent.maxCoeff() / max_cells_per_axis);
+        Eigen::Vector3i dims;
+        for (int axis = 0; axis < 3; axis++) {
+            dims(axis) = std::min(int(extent(axis) / cell_size),
+                                  max_cells_per_axis - 1) +
+                         1;
+        }
+        std::vector<std::vector<int>> partition_vertices;
+        if (dims.prod() <= 1) {
+            return partition_vertices;
+        }
 
-                if (edge_front_.size() > 0) {
-                    utility::LogDebug(
-                            "[TrySeed] edge_front_.size() > 0 => return "
-                            "true\n");
-                    return true;
-                }
+        // Cells are numbered in the order of their keys, independently of
+        // the number of threads.
+        std::vector<int> cell_partitions(dims.prod(), -1);
+        own_point_partitions_.resize(points_.size());
+        for (size_t vidx = 0; vidx < points_.size(); vidx++) {
+            Eigen::Vector3i cell =
+                    ((points_[vidx] - min_bound) / cell_size).cast<int>();
+            cell = cell.cwiseMax(0).cwiseMin(dims - Eigen::Vector3i::Ones());
+            own_point_partitions_[vidx] =
+                    cell(0) + dims(0) * (cell(1) + dims(1) * cell(2));
+        }
+        for (int key : own_point_partitions_) {
+            cell_partitions[key] = 0;
+        }
+        int num_partitions = 0;
+        for (int& partition : cell_partitions) {
+            if (partition >= 0) {
+                partition = num_partitions++;
             }
         }
+        partition_vertices.resize(num_partitions);
+        for (size_t vidx = 0; vidx < points_.size(); vidx++) {
+            int& partition = own_point_partitions_[vidx];
+            partition = cell_partitions[partition];
+            partition_vertices[partition].push_back(int(vidx));
+        }
+        return partition_vertices;
+    }
 
-        utility::LogDebug("[TrySeed] return false\n");
-        return false;
+    /// Appends the primitives of a partition to the pools. The partition
+    /// only touched its own vertices, so only their links are shifted.
+    void MergePartition(const BallPivoting& partition) {
+        const int edge_offset = int(edges_.size());
+        const int triangle_offset = int(triangles_.size());
+        auto shift = [](int idx, int offset) {
+            return idx < 0 ? idx : idx + offset;
+        };
+        for (BallPivotingEdge edge : partition.edges_) {
+            edge.next_source_ = shift(edge.next_source_, edge_offset);
+            edge.next_target_ = shift(edge.next_target_, edge_offset);
+            edge.triangle0_ = shift(edge.triangle0_, triangle_offset);
+            edge.triangle1_ = shift(edge.triangle1_, triangle_offset);
+            edges_.push_back(edge);
+        }
+        triangles_.insert(triangles_.end(), partition.triangles_.begin(),
+                          partition.triangles_.end());
+        for (int vidx : partition.partition_vertices_) {
+            BallPivotingVertex& vertex = vertices[vidx];
+            vertex.first_edge_ = shift(vertex.first_edge_, edge_offset);
+            vertex.orphan_until_ =
+                    shift(vertex.orphan_until_, triangle_offset);
+        }
+        for (int eidx : partition.border_edges_) {
+            border_edges_.push_back(eidx + edge_offset);
+        }
+        for (int eidx : partition.deferred_edges_) {
+            edge_front_.push_back(eidx + edge_offset);
+        }
+        mesh_->triangles_.insert(mesh_->triangles_.end(),
+                                 partition.mesh_->triangles_.begin(),
+                                 partition.mesh_->triangles_.end());
+        mesh_->triangle_normals_.insert(
+                mesh_->triangle_normals_.end(),
+                partition.mesh_->triangle_normals_.begin(),
+                partition.mesh_->triangle_normals_.end());
     }
 
-    void FindSeedTriangle(double radius) {
-        for (size_t vidx = 0; vidx < vertices.size(); ++vidx) {
-            utility::LogDebug("[FindSeedTriangle] with radius={}, vidx={}\n",
-                              radius, vidx);
-            if (vertices[vidx]->type_ == BallPivotingVertex::Type::Orphan) {
-                if (TrySeed(vertices[vidx], radius)) {
-                    ExpandTriangulation(radius);
-                }
-            }
+    /// Seeds and expands the partitions in parallel, then stitches them along
+    /// the deferred edges. The partitions have their own edge pools, so this
+    /// only runs before the first triangle is created, and does nothing if
+    /// the points fit in one partition.
+    void ExpandPartitions(double radius) {
+        if (!edges_.empty()) {
+            return;
+        }
+        std::vector<std::vector<int>> partition_vertices =
+                ComputePartitions(radius);
+        const int num_partitions = int(partition_vertices.size());
+        if (num_partitions <= 1) {
+            return;
         }
+        std::vector<std::unique_ptr<BallPivoting>> partitions(num_partitions);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (int pidx = 0; pidx < num_partitions; pidx++) {
+            partitions[pidx].reset(new BallPivoting(*this, pidx));
+            partitions[pidx]->partition_vertices_ =
+                    std::move(partition_vertices[pidx]);
+            partitions[pidx]->FindPartitionSeedTriangles(radius);
+        }
+        for (const auto& partition : partitions) {
+            MergePartition(*partition);
+        }
+        utility::LogDebug("[ExpandPartitions] stitching {:d} edges\n",
+                          edge_front_.size());
+        ExpandTriangulation(radius);
     }
 
     std::shared_ptr<TriangleMesh> Run(const std::vector<double>& radii) {
@@ -679,29 +879,29 @@ public:
                 return mesh_;
             }
 
+            // All searches use radius or 2 * radius
+            index_.SetCellSize(2 * radius);
+            index_.SetGeometry(pcd_);
+
             // update radius => update border edges
-            for (auto it = border_edges_.begin(); it != border_edges_.end();) {
-                BallPivotingEdgePtr edge = *it;
-                BallPivotingTrianglePtr triangle = edge->triangle0_;
+            size_t num_border_edges = 0;
+            for (int eidx : border_edges_) {
+                const BallPivotingTriangle& triangle =
+                        triangles_[edges_[eidx].triangle0_];
                 utility::LogDebug(
                         "[Run] try edge {:d}-{:d} of triangle {:d}-{:d}-{:d}\n",
-                        edge->source_->idx_, edge->target_->idx_,
-                        triangle->vert0_->idx_, triangle->vert1_->idx_,
-                        triangle->vert2_->idx_);
+                        edges_[eidx].source_, edges_[eidx].target_,
+                        triangle.vert0_, triangle.vert1_, triangle.vert2_);
 
                 Eigen::Vector3d center;
-                if (ComputeBallCenter(triangle->vert0_->idx_,
-                                      triangle->vert1_->idx_,
-                                      triangle->vert2_->idx_, radius, center)) {
+                if (ComputeBallCenter(triangle.vert0_, triangle.vert1_,
+                                      triangle.vert2_, radius, center)) {
                     utility::LogDebug("[Run]   yes, we can work on this\n");
-                    std::vector<int> indices;
-                    std::vector<double> dists2;
-                    kdtree_.SearchRadius(center, radius, indices, dists2);
+                    index_.SearchRadius(center, radius, indices_, dists2_);
                     bool empty_ball = true;
-                    for (auto idx : indices) {
-                        if (idx != triangle->vert0_->idx_ &&
-                            idx != triangle->vert1_->idx_ &&
-                            idx != triangle->vert2_->idx_) {
+                    for (auto idx : indices_) {
+                        if (idx != triangle.vert0_ && idx != triangle.vert1_ &&
+                            idx != triangle.vert2_) {
                             utility::LogDebug(
                                     "[Run]   but no, the ball is not empty\n");
                             empty_ball = false;
@@ -713,18 +913,19 @@ public:
                         utility::LogDebug(
                                 "[Run]   yeah, add edge to edge_front_: {:d}\n",
                                 edge_front_.size());
-                        edge->type_ = BallPivotingEdge::Type::Front;
-                        edge_front_.push_back(edge);
-                        it = border_edges_.erase(it);
+                        edges_[eidx].type_ = BallPivotingEdge::Type::Front;
+                        edge_front_.push_back(eidx);
                         continue;
                     }
                 }
-                ++it;
+                border_edges_[num_border_edges++] = eidx;
             }
+            border_edges_.resize(num_border_edges);
 
             // do the reconstruction
             if (edge_front_.empty()) {
-                FindSeedTriangle(radius);
+                ExpandPartitions(radius);
+                FindSeedTriangles(radius);
             } else {
                 ExpandTriangulation(radius);
             }
@@ -738,10 +939,30 @@ public:
 
 private:
     bool has_normals_;
-    KDTreeFlann kdtree_;
-    std::list<BallPivotingEdgePtr> edge_front_;
-    std::list<BallPivotingEdgePtr> border_edges_;
-    std::vector<BallPivotingVertexPtr> vertices;
+    const PointCloud& pcd_;
+    const std::vector<Eigen::Vector3d>& points_;
+    const std::vector<Eigen::Vector3d>& normals_;
+    // owned by the root, shared with its partitions
+    FixedRadiusIndex own_index_;
+    std::vector<BallPivotingVertex> own_vertices_;
+    FixedRadiusIndex& index_;
+    std::vector<BallPivotingVertex>& vertices;
+    /// Partition of the vertices triangulated by this instance, -1 for all.
+    int partition_ = -1;
+    std::vector<int> own_point_partitions_;
+    const std::vector<int>& point_partitions_;
+    std::vector<BallPivotingEdge> edges_;
+    std::vector<BallPivotingTriangle> triangles_;
+    std::deque<int> edge_front_;
+    std::vector<int> border_edges_;
+    /// Vertices of the partition, in increasing order.
+    std::vector<int> partition_vertices_;
+    /// Front edges whose pivot reaches the vertex of another partition.
+    std::vector<int> deferred_edges_;
+    int seed_epoch_ = 0;
+    // scratch buffers for the serial neighbor queries
+    std::vector<int> indices_;
+    std::vector<double> dists2_;
     std::shared_ptr<TriangleMesh> mesh_;
 };
 
@@ -28,13 +28,16 @@
 #include "Open3D/Geometry/BoundingVolume.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Geometry/VertexWelding.h"
 
 #include <Eigen/Dense>
+#include <algorithm>
 #include <array>
 #include <numeric>
 #include <tuple>
 
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace open3d {
 namespace geometry {
@@ -158,35 +161,23 @@ TetraMesh TetraMesh::operator+(const TetraMesh &mesh) const {
     return (TetraMesh(*this) += mesh);
 }
 
-TetraMesh &TetraMesh::RemoveDuplicatedVertices() {
-    typedef decltype(tetras_)::value_type::Scalar Index;
-    typedef std::tuple<double, double, double> Coordinate3;
-    std::unordered_map<Coordinate3, size_t,
-                       utility::hash_tuple::hash<Coordinate3>>
-            point_to_old_index;
-    std::vector<Index> index_old_to_new(vertices_.size());
+TetraMesh &TetraMesh::RemoveDuplicatedVertices(double epsilon /* = 0.0 */) {
     size_t old_vertex_num = vertices_.size();
-    size_t k = 0;                                  // new index
-    for (size_t i = 0; i < old_vertex_num; i++) {  // old index
-        Coordinate3 coord = std::make_tuple(vertices_[i](0), vertices_[i](1),
-                                            vertices_[i](2));
-        if (point_to_old_index.find(coord) == point_to_old_index.end()) {
-            point_to_old_index[coord] = i;
-            vertices_[k] = vertices_[i];
-            index_old_to_new[i] = (Index)k;
-            k++;
-        } else {
-            index_old_to_new[i] = index_old_to_new[point_to_old_index[coord]];
-        }
-    }
-    vertices_.resize(k);
+    std::vector<int> index_old_to_new, group_offsets, group_members;
+    size_t k = VertexWelding::GroupVertices(vertices_, epsilon,
+                                            index_old_to_new, group_offsets,
+                                            group_members);
     if (k < old_vertex_num) {
-        for (auto &tetra : tetras_) {
+        vertices_ = VertexWelding::MergeGroups(vertices_, group_offsets,
+                                               group_members, epsilon > 0.0);
+
+        utility::ParallelFor(0, (int)tetras_.size(), [&](int t) {
+            Eigen::Vector4i &tetra = tetras_[t];
             tetra(0) = index_old_to_new[tetra(0)];
             tetra(1) = index_old_to_new[tetra(1)];
             tetra(2) = index_old_to_new[tetra(2)];
             tetra(3) = index_old_to_new[tetra(3)];
-        }
+        });
     }
     utility::LogDebug(
             "[RemoveDuplicatedVertices] {:d} vertices have been removed.\n",
@@ -198,22 +189,26 @@ TetraMesh &TetraMesh::RemoveDuplicatedVertices() {
 TetraMesh &TetraMesh::RemoveDuplicatedTetras() {
     typedef decltype(tetras_)::value_type::Scalar Index;
     typedef std::tuple<Index, Index, Index, Index> Index4;
-    std::unordered_map<Index4, size_t, utility::hash_tuple::hash<Index4>>
-            tetra_to_old_index;
     size_t old_tetra_num = tetras_.size();
-    size_t k = 0;
-    for (size_t i = 0; i < old_tetra_num; i++) {
-        Index4 index;
+    std::vector<Index4> indices(old_tetra_num);
+    utility::ParallelFor(0, (int)old_tetra_num, [&](int i) {
         std::array<Index, 4> t{tetras_[i](0), tetras_[i](1), tetras_[i](2),
                                tetras_[i](3)};
 
         // We sort the indices to find duplicates, because tetra (0-1-2-3)
         // and tetra (2-0-3-1) are the same.
         std::sort(t.begin(), t.end());
-        index = std::make_tuple(t[0], t[1], t[2], t[3]);
-
-        if (tetra_to_old_index.find(index) == tetra_to_old_index.end()) {
-            tetra_to_old_index[index] = i;
+        indices[i] = std::make_tuple(t[0], t[1], t[2], t[3]);
+    });
+    std::vector<int> first_equal = utility::FindFirstEqual(
+            old_tetra_num,
+            [&](int i) {
+                return utility::hash_tuple::hash<Index4>()(indices[i]);
+            },
+            [&](int i, int j) { return indices[i] == indices[j]; });
+    size_t k = 0;
+    for (size_t i = 0; i < old_tetra_num; i++) {
+        if (first_equal[i] == (int)i) {
             tetras_[k] = tetras_[i];
             k++;
         }
@@ -67,8 +67,10 @@ public:
     TetraMesh operator+(const TetraMesh &mesh) const;
 
     /// Function that removes duplicated verties, i.e., vertices that have
-    /// identical coordinates.
-    TetraMesh &RemoveDuplicatedVertices();
+    /// identical coordinates. With a positive \param epsilon, vertices that
+    /// fall into the same grid cell of that size are welded instead, and
+    /// their positions are averaged.
+    TetraMesh &RemoveDuplicatedVertices(double epsilon = 0.0);
 
     /// Function that removes duplicated tetrahedra, i.e., removes tetrahedra
     /// that reference the same four vertices, independent of their order.
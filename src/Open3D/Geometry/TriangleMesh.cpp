@@ -30,16 +30,46 @@
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/Qhull.h"
+#include "Open3D/Geometry/VertexWelding.h"
 
 #include <Eigen/Dense>
+#include <algorithm>
 #include <numeric>
 #include <queue>
 #include <random>
 #include <tuple>
 
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace open3d {
+
+namespace {
+
+/// Lists the triangles of every vertex in compressed sparse row form with a
+/// counting sort, so each list is in increasing triangle order.
+void ComputeVertexTriangles(const std::vector<Eigen::Vector3i> &triangles,
+                            size_t num_vertices,
+                            std::vector<int> &offsets,
+                            std::vector<int> &vertex_triangles) {
+    offsets.assign(num_vertices + 1, 0);
+    for (const auto &triangle : triangles) {
+        offsets[triangle(0) + 1]++;
+        offsets[triangle(1) + 1]++;
+        offsets[triangle(2) + 1]++;
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    vertex_triangles.resize(offsets.back());
+    std::vector<int> positions(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < triangles.size(); i++) {
+        vertex_triangles[positions[triangles[i](0)]++] = int(i);
+        vertex_triangles[positions[triangles[i](1)]++] = int(i);
+        vertex_triangles[positions[triangles[i](2)]++] = int(i);
+    }
+}
+
+}  // unnamed namespace
+
 namespace geometry {
 
 TriangleMesh &TriangleMesh::Clear() {
@@ -49,6 +79,8 @@ TriangleMesh &TriangleMesh::Clear() {
     triangles_.clear();
     triangle_normals_.clear();
     adjacency_list_.clear();
+    adjacency_offsets_.clear();
+    adjacency_indices_.clear();
     return *this;
 }
 
@@ -143,6 +175,8 @@ TriangleMesh &TriangleMesh::operator+=(const TriangleMesh &mesh) {
     }
     if (HasAdjacencyList()) {
         ComputeAdjacencyList();
+    } else if (adjacency_offsets_.size() == old_vert_num + 1) {
+        ComputeAdjacencyCSR();
     }
     return (*this);
 }
@@ -154,12 +188,12 @@ TriangleMesh TriangleMesh::operator+(const TriangleMesh &mesh) const {
 TriangleMesh &TriangleMesh::ComputeTriangleNormals(
         bool normalized /* = true*/) {
     triangle_normals_.resize(triangles_.size());
-    for (size_t i = 0; i < triangles_.size(); i++) {
+    utility::ParallelFor(0, int(triangles_.size()), [&](int i) {
         auto &triangle = triangles_[i];
         Eigen::Vector3d v01 = vertices_[triangle(1)] - vertices_[triangle(0)];
         Eigen::Vector3d v02 = vertices_[triangle(2)] - vertices_[triangle(0)];
         triangle_normals_[i] = v01.cross(v02);
-    }
+    });
     if (normalized) {
         NormalizeNormals();
     }
@@ -171,12 +205,17 @@ TriangleMesh &TriangleMesh::ComputeVertexNormals(bool normalized /* = true*/) {
         ComputeTriangleNormals(false);
     }
     vertex_normals_.resize(vertices_.size(), Eigen::Vector3d::Zero());
-    for (size_t i = 0; i < triangles_.size(); i++) {
-        auto &triangle = triangles_[i];
-        vertex_normals_[triangle(0)] += triangle_normals_[i];
-        vertex_normals_[triangle(1)] += triangle_normals_[i];
-        vertex_normals_[triangle(2)] += triangle_normals_[i];
-    }
+    // Each vertex gathers the normals of its triangles, in triangle order as
+    // a serial scatter would add them.
+    std::vector<int> offsets;
+    std::vector<int> vertex_triangles;
+    ComputeVertexTriangles(triangles_, vertices_.size(), offsets,
+                           vertex_triangles);
+    utility::ParallelFor(0, int(vertices_.size()), [&](int v) {
+        for (int j = offsets[v]; j < offsets[v + 1]; j++) {
+            vertex_normals_[v] += triangle_normals_[vertex_triangles[j]];
+        }
+    });
     if (normalized) {
         NormalizeNormals();
     }
@@ -184,16 +223,53 @@ TriangleMesh &TriangleMesh::ComputeVertexNormals(bool normalized /* = true*/) {
 }
 
 TriangleMesh &TriangleMesh::ComputeAdjacencyList() {
+    ComputeAdjacencyCSR();
     adjacency_list_.clear();
     adjacency_list_.resize(vertices_.size());
-    for (const auto &triangle : triangles_) {
-        adjacency_list_[triangle(0)].insert(triangle(1));
-        adjacency_list_[triangle(0)].insert(triangle(2));
-        adjacency_list_[triangle(1)].insert(triangle(0));
-        adjacency_list_[triangle(1)].insert(triangle(2));
-        adjacency_list_[triangle(2)].insert(triangle(0));
-        adjacency_list_[triangle(2)].insert(triangle(1));
-    }
+    utility::ParallelFor(0, int(vertices_.size()), [&](int v) {
+        adjacency_list_[v].insert(
+                adjacency_indices_.begin() + adjacency_offsets_[v],
+                adjacency_indices_.begin() + adjacency_offsets_[v + 1]);
+    });
+    return *this;
+}
+
+TriangleMesh &TriangleMesh::ComputeAdjacencyCSR() {
+    // Bucket the two neighbors of each vertex of each triangle by vertex.
+    std::vector<int> offsets;
+    std::vector<int> vertex_triangles;
+    ComputeVertexTriangles(triangles_, vertices_.size(), offsets,
+                           vertex_triangles);
+    int num_vertices = int(vertices_.size());
+    std::vector<int> neighbors(vertex_triangles.size() * 2);
+    std::vector<int> degrees(num_vertices);
+    utility::ParallelFor(0, num_vertices, [&](int v) {
+        int *begin = neighbors.data() + 2 * offsets[v];
+        int *end = begin;
+        for (int j = offsets[v]; j < offsets[v + 1]; j++) {
+            const auto &triangle = triangles_[vertex_triangles[j]];
+            for (int k = 0; k < 3; k++) {
+                if (triangle(k) == v) {
+                    *end++ = triangle((k + 1) % 3);
+                    *end++ = triangle((k + 2) % 3);
+                    break;
+                }
+            }
+        }
+        std::sort(begin, end);
+        degrees[v] = int(std::unique(begin, end) - begin);
+    });
+
+    adjacency_offsets_.resize(num_vertices + 1);
+    adjacency_offsets_[0] = 0;
+    std::partial_sum(degrees.begin(), degrees.end(),
+                     adjacency_offsets_.begin() + 1);
+    adjacency_indices_.resize(adjacency_offsets_.back());
+    utility::ParallelFor(0, num_vertices, [&](int v) {
+        std::copy(neighbors.begin() + 2 * offsets[v],
+                  neighbors.begin() + 2 * offsets[v] + degrees[v],
+                  adjacency_indices_.begin() + adjacency_offsets_[v]);
+    });
     return *this;
 }
 
@@ -218,16 +294,21 @@ std::shared_ptr<TriangleMesh> TriangleMesh::FilterSharpen(
     mesh->vertex_colors_.resize(vertex_colors_.size());
     mesh->triangles_ = triangles_;
     mesh->adjacency_list_ = adjacency_list_;
-    if (!mesh->HasAdjacencyList()) {
-        mesh->ComputeAdjacencyList();
+    mesh->adjacency_offsets_ = adjacency_offsets_;
+    mesh->adjacency_indices_ = adjacency_indices_;
+    if (!mesh->HasAdjacencyCSR()) {
+        mesh->ComputeAdjacencyCSR();
     }
+    const std::vector<int> &offsets = mesh->adjacency_offsets_;
+    const std::vector<int> &indices = mesh->adjacency_indices_;
 
     for (int iter = 0; iter < number_of_iterations; ++iter) {
-        for (size_t vidx = 0; vidx < mesh->vertices_.size(); ++vidx) {
+        utility::ParallelFor(0, int(mesh->vertices_.size()), [&](int vidx) {
             Eigen::Vector3d vertex_sum(0, 0, 0);
             Eigen::Vector3d normal_sum(0, 0, 0);
             Eigen::Vector3d color_sum(0, 0, 0);
-            for (int nbidx : mesh->adjacency_list_[vidx]) {
+            for (int j = offsets[vidx]; j < offsets[vidx + 1]; j++) {
+                int nbidx = indices[j];
                 if (filter_vertex) {
                     vertex_sum += prev_vertices[nbidx];
                 }
@@ -239,7 +320,7 @@ std::shared_ptr<TriangleMesh> TriangleMesh::FilterSharpen(
                 }
             }
 
-            size_t nb_size = mesh->adjacency_list_[vidx].size();
+            size_t nb_size = size_t(offsets[vidx + 1] - offsets[vidx]);
             if (filter_vertex) {
                 mesh->vertices_[vidx] =
                         prev_vertices[vidx] +
@@ -257,7 +338,7 @@ std::shared_ptr<TriangleMesh> TriangleMesh::FilterSharpen(
                         strength * (prev_vertex_colors[vidx] * nb_size -
                                     color_sum);
             }
-        }
+        });
         if (iter < number_of_iterations - 1) {
             std::swap(mesh->vertices_, prev_vertices);
             std::swap(mesh->vertex_normals_, prev_vertex_normals);
@@ -289,16 +370,21 @@ std::shared_ptr<TriangleMesh> TriangleMesh::FilterSmoothSimple(
     mesh->vertex_colors_.resize(vertex_colors_.size());
     mesh->triangles_ = triangles_;
     mesh->adjacency_list_ = adjacency_list_;
-    if (!mesh->HasAdjacencyList()) {
-        mesh->ComputeAdjacencyList();
+    mesh->adjacency_offsets_ = adjacency_offsets_;
+    mesh->adjacency_indices_ = adjacency_indices_;
+    if (!mesh->HasAdjacencyCSR()) {
+        mesh->ComputeAdjacencyCSR();
     }
+    const std::vector<int> &offsets = mesh->adjacency_offsets_;
+    const std::vector<int> &indices = mesh->adjacency_indices_;
 
     for (int iter = 0; iter < number_of_iterations; ++iter) {
-        for (size_t vidx = 0; vidx < mesh->vertices_.size(); ++vidx) {
+        utility::ParallelFor(0, int(mesh->vertices_.size()), [&](int vidx) {
             Eigen::Vector3d vertex_sum(0, 0, 0);
             Eigen::Vector3d normal_sum(0, 0, 0);
             Eigen::Vector3d color_sum(0, 0, 0);
-            for (int nbidx : mesh->adjacency_list_[vidx]) {
+            for (int j = offsets[vidx]; j < offsets[vidx + 1]; j++) {
+                int nbidx = indices[j];
                 if (filter_vertex) {
                     vertex_sum += prev_vertices[nbidx];
                 }
@@ -310,7 +396,7 @@ std::shared_ptr<TriangleMesh> TriangleMesh::FilterSmoothSimple(
                 }
             }
 
-            size_t nb_size = mesh->adjacency_list_[vidx].size();
+            size_t nb_size = size_t(offsets[vidx + 1] - offsets[vidx]);
             if (filter_vertex) {
                 mesh->vertices_[vidx] =
                         (prev_vertices[vidx] + vertex_sum) / (1 + nb_size);
@@ -324,7 +410,7 @@ std::shared_ptr<TriangleMesh> TriangleMesh::FilterSmoothSimple(
                 mesh->vertex_colors_[vidx] =
                         (prev_vertex_colors[vidx] + color_sum) / (1 + nb_size);
             }
-        }
+        });
         if (iter < number_of_iterations - 1) {
             std::swap(mesh->vertices_, prev_vertices);
             std::swap(mesh->vertex_normals_, prev_vertex_normals);
@@ -339,17 +425,19 @@ void TriangleMesh::FilterSmoothLaplacianHelper(
         const std::vector<Eigen::Vector3d> &prev_vertices,
         const std::vector<Eigen::Vector3d> &prev_vertex_normals,
         const std::vector<Eigen::Vector3d> &prev_vertex_colors,
-        const std::vector<std::unordered_set<int>> &adjacency_list,
         double lambda,
         bool filter_vertex,
         bool filter_normal,
         bool filter_color) const {
-    for (size_t vidx = 0; vidx < mesh->vertices_.size(); ++vidx) {
+    const std::vector<int> &offsets = mesh->adjacency_offsets_;
+    const std::vector<int> &indices = mesh->adjacency_indices_;
+    utility::ParallelFor(0, int(mesh->vertices_.size()), [&](int vidx) {
         Eigen::Vector3d vertex_sum(0, 0, 0);
         Eigen::Vector3d normal_sum(0, 0, 0);
         Eigen::Vector3d color_sum(0, 0, 0);
         double total_weight = 0;
-        for (int nbidx : mesh->adjacency_list_[vidx]) {
+        for (int j = offsets[vidx]; j < offsets[vidx + 1]; j++) {
+            int nbidx = indices[j];
             auto diff = prev_vertices[vidx] - prev_vertices[nbidx];
             double dist = diff.norm();
             double weight = 1. / (dist + 1e-12);
@@ -381,7 +469,7 @@ void TriangleMesh::FilterSmoothLaplacianHelper(
                                          lambda * (color_sum / total_weight -
                                                    prev_vertex_colors[vidx]);
         }
-    }
+    });
 }
 
 std::shared_ptr<TriangleMesh> TriangleMesh::FilterSmoothLaplacian(
@@ -405,15 +493,16 @@ std::shared_ptr<TriangleMesh> TriangleMesh::FilterSmoothLaplacian(
     mesh->vertex_colors_.resize(vertex_colors_.size());
     mesh->triangles_ = triangles_;
     mesh->adjacency_list_ = adjacency_list_;
-    if (!mesh->HasAdjacencyList()) {
-        mesh->ComputeAdjacencyList();
+    mesh->adjacency_offsets_ = adjacency_offsets_;
+    mesh->adjacency_indices_ = adjacency_indices_;
+    if (!mesh->HasAdjacencyCSR()) {
+        mesh->ComputeAdjacencyCSR();
     }
 
     for (int iter = 0; iter < number_of_iterations; ++iter) {
         FilterSmoothLaplacianHelper(mesh, prev_vertices, prev_vertex_normals,
-                                    prev_vertex_colors, mesh->adjacency_list_,
-                                    lambda, filter_vertex, filter_normal,
-                                    filter_color);
+                                    prev_vertex_colors, lambda, filter_vertex,
+                                    filter_normal, filter_color);
         if (iter < number_of_iterations - 1) {
             std::swap(mesh->vertices_, prev_vertices);
             std::swap(mesh->vertex_normals_, prev_vertex_normals);
@@ -447,21 +536,21 @@ std::shared_ptr<TriangleMesh> TriangleMesh::FilterSmoothTaubin(
     mesh->vertex_colors_.resize(vertex_colors_.size());
     mesh->triangles_ = triangles_;
     mesh->adjacency_list_ = adjacency_list_;
-    if (!mesh->HasAdjacencyList()) {
-        mesh->ComputeAdjacencyList();
+    mesh->adjacency_offsets_ = adjacency_offsets_;
+    mesh->adjacency_indices_ = adjacency_indices_;
+    if (!mesh->HasAdjacencyCSR()) {
+        mesh->ComputeAdjacencyCSR();
     }
     for (int iter = 0; iter < number_of_iterations; ++iter) {
         FilterSmoothLaplacianHelper(mesh, prev_vertices, prev_vertex_normals,
-                                    prev_vertex_colors, mesh->adjacency_list_,
-                                    lambda, filter_vertex, filter_normal,
-                                    filter_color);
+                                    prev_vertex_colors, lambda, filter_vertex,
+                                    filter_normal, filter_color);
         std::swap(mesh->vertices_, prev_vertices);
         std::swap(mesh->vertex_normals_, prev_vertex_normals);
         std::swap(mesh->vertex_colors_, prev_vertex_colors);
         FilterSmoothLaplacianHelper(mesh, prev_vertices, prev_vertex_normals,
-                                    prev_vertex_colors, mesh->adjacency_list_,
-                                    mu, filter_vertex, filter_normal,
-                                    filter_color);
+                                    prev_vertex_colors, mu, filter_vertex,
+                                    filter_normal, filter_color);
         if (iter < number_of_iterations - 1) {
             std::swap(mesh->vertices_, prev_vertices);
             std::swap(mesh->vertex_normals_, prev_vertex_normals);
@@ -697,41 +786,49 @@ std::shared_ptr<PointCloud> TriangleMesh::SamplePointsPoissonDisk(
     return pcl;
 }
 
-TriangleMesh &TriangleMesh::RemoveDuplicatedVertices() {
-    typedef std::tuple<double, double, double> Coordinate3;
-    std::unordered_map<Coordinate3, size_t,
-                       utility::hash_tuple::hash<Coordinate3>>
-            point_to_old_index;
-    std::vector<int> index_old_to_new(vertices_.size());
+TriangleMesh &TriangleMesh::RemoveDuplicatedVertices(
+        double epsilon /* = 0.0 */) {
     bool has_vert_normal = HasVertexNormals();
     bool has_vert_color = HasVertexColors();
     size_t old_vertex_num = vertices_.size();
-    size_t k = 0;                                  // new index
-    for (size_t i = 0; i < old_vertex_num; i++) {  // old index
-        Coordinate3 coord = std::make_tuple(vertices_[i](0), vertices_[i](1),
-                                            vertices_[i](2));
-        if (point_to_old_index.find(coord) == point_to_old_index.end()) {
-            point_to_old_index[coord] = i;
-            vertices_[k] = vertices_[i];
-            if (has_vert_normal) vertex_normals_[k] = vertex_normals_[i];
-            if (has_vert_color) vertex_colors_[k] = vertex_colors_[i];
-            index_old_to_new[i] = (int)k;
-            k++;
-        } else {
-            index_old_to_new[i] = index_old_to_new[point_to_old_index[coord]];
-        }
-    }
-    vertices_.resize(k);
-    if (has_vert_normal) vertex_normals_.resize(k);
-    if (has_vert_color) vertex_colors_.resize(k);
+    std::vector<int> index_old_to_new, group_offsets, group_members;
+    size_t k = VertexWelding::GroupVertices(vertices_, epsilon,
+                                            index_old_to_new, group_offsets,
+                                            group_members);
     if (k < old_vertex_num) {
-        for (auto &triangle : triangles_) {
+        // With a tolerance the merged attributes are averaged, otherwise the
+        // first occurrence is kept as is.
+        const bool average = epsilon > 0.0;
+        vertices_ = VertexWelding::MergeGroups(vertices_, group_offsets,
+                                               group_members, average);
+        if (has_vert_normal) {
+            vertex_normals_ = VertexWelding::MergeGroups(
+                    vertex_normals_, group_offsets, group_members, average);
+            if (average) {
+                utility::ParallelFor(0, (int)k, [&](int v) {
+                    double norm = vertex_normals_[v].norm();
+                    if (group_offsets[v + 1] - group_offsets[v] > 1 &&
+                        norm > 0) {
+                        vertex_normals_[v] /= norm;
+                    }
+                });
+            }
+        }
+        if (has_vert_color) {
+            vertex_colors_ = VertexWelding::MergeGroups(
+                    vertex_colors_, group_offsets, group_members, average);
+        }
+
+        utility::ParallelFor(0, (int)triangles_.size(), [&](int t) {
+            Eigen::Vector3i &triangle = triangles_[t];
             triangle(0) = index_old_to_new[triangle(0)];
             triangle(1) = index_old_to_new[triangle(1)];
             triangle(2) = index_old_to_new[triangle(2)];
-        }
+        });
         if (HasAdjacencyList()) {
             ComputeAdjacencyList();
+        } else if (adjacency_offsets_.size() == old_vertex_num + 1) {
+            ComputeAdjacencyCSR();
         }
     }
     utility::LogDebug(
@@ -743,34 +840,40 @@ TriangleMesh &TriangleMesh::RemoveDuplicatedVertices() {
 
 TriangleMesh &TriangleMesh::RemoveDuplicatedTriangles() {
     typedef std::tuple<int, int, int> Index3;
-    std::unordered_map<Index3, size_t, utility::hash_tuple::hash<Index3>>
-            triangle_to_old_index;
     bool has_tri_normal = HasTriangleNormals();
     size_t old_triangle_num = triangles_.size();
-    size_t k = 0;
-    for (size_t i = 0; i < old_triangle_num; i++) {
-        Index3 index;
+    std::vector<Index3> indices(old_triangle_num);
+    utility::ParallelFor(0, (int)old_triangle_num, [&](int i) {
+        const Eigen::Vector3i &triangle = triangles_[i];
         // We first need to find the minimum index. Because triangle (0-1-2)
         // and triangle (2-0-1) are the same.
-        if (triangles_[i](0) <= triangles_[i](1)) {
-            if (triangles_[i](0) <= triangles_[i](2)) {
-                index = std::make_tuple(triangles_[i](0), triangles_[i](1),
-                                        triangles_[i](2));
+        if (triangle(0) <= triangle(1)) {
+            if (triangle(0) <= triangle(2)) {
+                indices[i] = std::make_tuple(triangle(0), triangle(1),
+                                             triangle(2));
             } else {
-                index = std::make_tuple(triangles_[i](2), triangles_[i](0),
-                                        triangles_[i](1));
+                indices[i] = std::make_tuple(triangle(2), triangle(0),
+                                             triangle(1));
             }
         } else {
-            if (triangles_[i](1) <= triangles_[i](2)) {
-                index = std::make_tuple(triangles_[i](1), triangles_[i](2),
-                                        triangles_[i](0));
+            if (triangle(1) <= triangle(2)) {
+                indices[i] = std::make_tuple(triangle(1), triangle(2),
+                                             triangle(0));
             } else {
-                index = std::make_tuple(triangles_[i](2), triangles_[i](0),
-                                        triangles_[i](1));
+                indices[i] = std::make_tuple(triangle(2), triangle(0),
+                                             triangle(1));
             }
         }
-        if (triangle_to_old_index.find(index) == triangle_to_old_index.end()) {
-            triangle_to_old_index[index] = i;
+    });
+    std::vector<int> first_equal = utility::FindFirstEqual(
+            old_triangle_num,
+            [&](int i) {
+                return utility::hash_tuple::hash<Index3>()(indices[i]);
+            },
+            [&](int i, int j) { return indices[i] == indices[j]; });
+    size_t k = 0;
+    for (size_t i = 0; i < old_triangle_num; i++) {
+        if (first_equal[i] == (int)i) {
             triangles_[k] = triangles_[i];
             if (has_tri_normal) triangle_normals_[k] = triangle_normals_[i];
             k++;
@@ -780,6 +883,8 @@ TriangleMesh &TriangleMesh::RemoveDuplicatedTriangles() {
     if (has_tri_normal) triangle_normals_.resize(k);
     if (k < old_triangle_num && HasAdjacencyList()) {
         ComputeAdjacencyList();
+    } else if (k < old_triangle_num && HasAdjacencyCSR()) {
+        ComputeAdjacencyCSR();
     }
     utility::LogDebug(
             "[RemoveDuplicatedTriangles] {:d} triangles have been removed.\n",
@@ -822,6 +927,8 @@ TriangleMesh &TriangleMesh::RemoveUnreferencedVertices() {
         }
         if (HasAdjacencyList()) {
             ComputeAdjacencyList();
+        } else if (adjacency_offsets_.size() == old_vertex_num + 1) {
+            ComputeAdjacencyCSR();
         }
     }
     utility::LogDebug(
@@ -848,6 +955,8 @@ TriangleMesh &TriangleMesh::RemoveDegenerateTriangles() {
     if (has_tri_normal) triangle_normals_.resize(k);
     if (k < old_triangle_num && HasAdjacencyList()) {
         ComputeAdjacencyList();
+    } else if (k < old_triangle_num && HasAdjacencyCSR()) {
+        ComputeAdjacencyCSR();
     }
     utility::LogDebug(
             "[RemoveDegenerateTriangles] {:d} triangles have been "
@@ -91,9 +91,17 @@ public:
     /// Function to compute adjacency list, call before adjacency list is needed
     TriangleMesh &ComputeAdjacencyList();
 
+    /// Function to compute the vertex adjacency in compressed sparse row form,
+    /// which the filters use. It is built in parallel and takes two ints per
+    /// adjacent vertex pair.
+    TriangleMesh &ComputeAdjacencyCSR();
+
     /// Function that removes duplicated verties, i.e., vertices that have
-    /// identical coordinates.
-    TriangleMesh &RemoveDuplicatedVertices();
+    /// identical coordinates. With a positive \param epsilon, vertices that
+    /// fall into the same grid cell of that size are welded instead, and
+    /// their positions, normals and colors are averaged. Welding can leave
+    /// degenerate triangles, see RemoveDegenerateTriangles.
+    TriangleMesh &RemoveDuplicatedVertices(double epsilon = 0.0);
 
     /// Function that removes duplicated triangles, i.e., removes triangles
     /// that reference the same three vertices, independent of their order.
@@ -185,6 +193,11 @@ public:
                adjacency_list_.size() == vertices_.size();
     }
 
+    bool HasAdjacencyCSR() const {
+        return vertices_.size() > 0 &&
+               adjacency_offsets_.size() == vertices_.size() + 1;
+    }
+
     TriangleMesh &NormalizeNormals() {
         for (size_t i = 0; i < vertex_normals_.size(); i++) {
             vertex_normals_[i].normalize();
@@ -349,6 +362,14 @@ public:
     std::shared_ptr<TriangleMesh> SimplifyQuadricDecimation(
             int target_number_of_triangles) const;
 
+    /// Function to simplify mesh using Quadric Error Metric Decimation with
+    /// multiple choice edge selection instead of a global priority queue.
+    /// Each collapse picks the cheapest of \param number_of_choices randomly
+    /// drawn edges. Cf. "Fast Mesh Decimation by Multiple-Choice Techniques"
+    /// by Wu and Kobbelt.
+    std::shared_ptr<TriangleMesh> SimplifyQuadricDecimationMultipleChoice(
+            int target_number_of_triangles, int number_of_choices = 8) const;
+
     /// Function to select points from \param input TriangleMesh into
     /// \return output TriangleMesh
     /// Vertices with indices in \param indices are selected.
@@ -486,7 +507,6 @@ protected:
             const std::vector<Eigen::Vector3d> &prev_vertices,
             const std::vector<Eigen::Vector3d> &prev_vertex_normals,
             const std::vector<Eigen::Vector3d> &prev_vertex_colors,
-            const std::vector<std::unordered_set<int>> &adjacency_list,
             double lambda,
             bool filter_vertex,
             bool filter_normal,
@@ -499,6 +519,10 @@ public:
     std::vector<Eigen::Vector3i> triangles_;
     std::vector<Eigen::Vector3d> triangle_normals_;
     std::vector<std::unordered_set<int>> adjacency_list_;
+    /// The adjacent vertices of vertex i are adjacency_indices_[j] for j in
+    /// [adjacency_offsets_[i], adjacency_offsets_[i + 1]), sorted.
+    std::vector<int> adjacency_offsets_;
+    std::vector<int> adjacency_indices_;
 };
 
 }  // namespace geometry
@@ -27,10 +27,12 @@
 #include "Open3D/Geometry/TriangleMesh.h"
 
 #include <Eigen/Dense>
-#include <queue>
-#include <tuple>
+#include <algorithm>
+#include <cstdint>
+#include <random>
 
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace open3d {
 namespace geometry {
@@ -263,201 +265,222 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyVertexClustering(
     return mesh;
 }
 
-std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyQuadricDecimation(
-        int target_number_of_triangles) const {
-    typedef std::tuple<double, int, int> CostEdge;
+namespace {
 
-    auto mesh = std::make_shared<TriangleMesh>();
-    mesh->vertices_ = vertices_;
-    mesh->vertex_normals_ = vertex_normals_;
-    mesh->vertex_colors_ = vertex_colors_;
-    mesh->triangles_ = triangles_;
+/// Binary min-heap over edge indices whose keys can be changed in place, so
+/// that re-costed edges are moved instead of being pushed a second time.
+class IndexedMinHeap {
+public:
+    IndexedMinHeap(const std::vector<double>& keys)
+        : keys_(keys), positions_(keys.size(), -1) {}
+
+    bool IsEmpty() const { return heap_.empty(); }
+    bool Contains(int idx) const { return positions_[idx] >= 0; }
+    int Top() const { return heap_[0]; }
+
+    /// Fills the heap with all indices in O(n).
+    void Build() {
+        heap_.resize(keys_.size());
+        for (int idx = 0; idx < int(keys_.size()); ++idx) {
+            heap_[idx] = idx;
+            positions_[idx] = idx;
+        }
+        for (int pos = int(heap_.size()) / 2 - 1; pos >= 0; --pos) {
+            SiftDown(pos);
+        }
+    }
 
-    std::vector<bool> vertices_deleted(vertices_.size(), false);
-    std::vector<bool> triangles_deleted(triangles_.size(), false);
+    /// Inserts idx, or restores the heap order after keys_[idx] changed.
+    void Update(int idx) {
+        if (!Contains(idx)) {
+            positions_[idx] = int(heap_.size());
+            heap_.push_back(idx);
+            SiftUp(positions_[idx]);
+        } else {
+            SiftDown(SiftUp(positions_[idx]));
+        }
+    }
 
-    // Map vertices to triangles and compute triangle planes and areas
-    std::vector<std::unordered_set<int>> vert_to_triangles(vertices_.size());
-    std::vector<Eigen::Vector4d> triangle_planes(triangles_.size());
-    std::vector<double> triangle_areas(triangles_.size());
-    for (size_t tidx = 0; tidx < triangles_.size(); ++tidx) {
-        vert_to_triangles[triangles_[tidx](0)].emplace(tidx);
-        vert_to_triangles[triangles_[tidx](1)].emplace(tidx);
-        vert_to_triangles[triangles_[tidx](2)].emplace(tidx);
+    void Remove(int idx) {
+        int pos = positions_[idx];
+        if (pos < 0) {
+            return;
+        }
+        positions_[idx] = -1;
+        int last = heap_.back();
+        heap_.pop_back();
+        if (last != idx) {
+            heap_[pos] = last;
+            positions_[last] = pos;
+            SiftDown(SiftUp(pos));
+        }
+    }
 
-        triangle_planes[tidx] = GetTrianglePlane(tidx);
-        triangle_areas[tidx] = GetTriangleArea(tidx);
+private:
+    bool Less(int idx0, int idx1) const {
+        return keys_[idx0] < keys_[idx1] ||
+               (keys_[idx0] == keys_[idx1] && idx0 < idx1);
     }
 
-    // Compute the error metric per vertex
-    std::vector<Quadric> Qs(vertices_.size());
-    for (size_t vidx = 0; vidx < vertices_.size(); ++vidx) {
-        for (int tidx : vert_to_triangles[vidx]) {
-            Qs[vidx] += Quadric(triangle_planes[tidx], triangle_areas[tidx]);
-        }
+    void Place(int pos, int idx) {
+        heap_[pos] = idx;
+        positions_[idx] = pos;
     }
 
-    // For boundary edges add perpendicular plane quadric
-    auto edge_triangle_count = GetEdgeToTrianglesMap();
-    auto AddPerpPlaneQuadric = [&](int vidx0, int vidx1, int vidx2,
-                                   double area) {
-        int min = std::min(vidx0, vidx1);
-        int max = std::max(vidx0, vidx1);
-        Eigen::Vector2i edge(min, max);
-        if (edge_triangle_count[edge].size() != 1) {
-            return;
+    int SiftUp(int pos) {
+        int idx = heap_[pos];
+        while (pos > 0) {
+            int parent = (pos - 1) / 2;
+            if (!Less(idx, heap_[parent])) {
+                break;
+            }
+            Place(pos, heap_[parent]);
+            pos = parent;
         }
-        const auto& vert0 = mesh->vertices_[vidx0];
-        const auto& vert1 = mesh->vertices_[vidx1];
-        const auto& vert2 = mesh->vertices_[vidx2];
-        Eigen::Vector3d vert2p = (vert2 - vert0).cross(vert2 - vert1);
-        Eigen::Vector4d plane = ComputeTrianglePlane(vert0, vert1, vert2p);
-        Quadric quad(plane, area);
-        Qs[vidx0] += quad;
-        Qs[vidx1] += quad;
-    };
-    for (size_t tidx = 0; tidx < triangles_.size(); ++tidx) {
-        const auto& tria = triangles_[tidx];
-        double area = triangle_areas[tidx];
-        AddPerpPlaneQuadric(tria(0), tria(1), tria(2), area);
-        AddPerpPlaneQuadric(tria(1), tria(2), tria(0), area);
-        AddPerpPlaneQuadric(tria(2), tria(0), tria(1), area);
-    }
-
-    // Get valid edges and compute cost
-    // Note: We could also select all vertex pairs as edges with dist < eps
-    std::unordered_map<Eigen::Vector2i, Eigen::Vector3d,
-                       utility::hash_eigen::hash<Eigen::Vector2i>>
-            vbars;
-    std::unordered_map<Eigen::Vector2i, double,
-                       utility::hash_eigen::hash<Eigen::Vector2i>>
-            costs;
-    auto CostEdgeComp = [](const CostEdge& a, const CostEdge& b) {
-        return std::get<0>(a) > std::get<0>(b);
-    };
-    std::priority_queue<CostEdge, std::vector<CostEdge>, decltype(CostEdgeComp)>
-            queue(CostEdgeComp);
-
-    auto AddEdge = [&](int vidx0, int vidx1, bool update) {
-        int min = std::min(vidx0, vidx1);
-        int max = std::max(vidx0, vidx1);
-        Eigen::Vector2i edge(min, max);
-        if (update || vbars.count(edge) == 0) {
-            const Quadric& Q0 = Qs[min];
-            const Quadric& Q1 = Qs[max];
-            Quadric Qbar = Q0 + Q1;
-            double cost;
-            Eigen::Vector3d vbar;
-            if (Qbar.IsInvertible()) {
-                vbar = Qbar.Minimum();
-                cost = Qbar.Eval(vbar);
-            } else {
-                const Eigen::Vector3d& v0 = mesh->vertices_[vidx0];
-                const Eigen::Vector3d& v1 = mesh->vertices_[vidx0];
-                Eigen::Vector3d vmid = (v0 + v1) / 2;
-                double cost0 = Qbar.Eval(v0);
-                double cost1 = Qbar.Eval(v1);
-                double costmid = Qbar.Eval(vbar);
-                cost = std::min(cost0, std::min(cost1, costmid));
-                if (cost == costmid) {
-                    vbar = vmid;
-                } else if (cost == cost0) {
-                    vbar = v0;
-                } else {
-                    vbar = v1;
-                }
+        Place(pos, idx);
+        return pos;
+    }
+
+    int SiftDown(int pos) {
+        int idx = heap_[pos];
+        int size = int(heap_.size());
+        while (2 * pos + 1 < size) {
+            int child = 2 * pos + 1;
+            if (child + 1 < size && Less(heap_[child + 1], heap_[child])) {
+                child++;
             }
-            vbars[edge] = vbar;
-            costs[edge] = cost;
-            queue.push(CostEdge(cost, min, max));
+            if (!Less(heap_[child], idx)) {
+                break;
+            }
+            Place(pos, heap_[child]);
+            pos = child;
         }
-    };
+        Place(pos, idx);
+        return pos;
+    }
 
-    // add all edges to priority queue
-    for (const auto& triangle : triangles_) {
-        AddEdge(triangle(0), triangle(1), false);
-        AddEdge(triangle(1), triangle(2), false);
-        AddEdge(triangle(2), triangle(0), false);
+private:
+    const std::vector<double>& keys_;
+    std::vector<int> heap_;
+    std::vector<int> positions_;
+};
+
+/// Iterative edge collapse driven by the quadric error metric. Vertex to
+/// triangle and vertex to edge adjacency are stored in compressed rows (CSR).
+/// When vertex vidx1 is merged into vidx0 the rows of vidx1 are chained to
+/// the rows of vidx0 instead of being copied, so the adjacency is never
+/// reallocated during decimation.
+class QuadricDecimation {
+public:
+    QuadricDecimation(const TriangleMesh& input, TriangleMesh& mesh)
+        : mesh_(mesh),
+          n_triangles_(int(mesh.triangles_.size())),
+          has_vert_normal_(mesh.HasVertexNormals()),
+          has_vert_color_(mesh.HasVertexColors()) {
+        const int n_vertices = int(mesh_.vertices_.size());
+        const int n_triangles = int(mesh_.triangles_.size());
+        vertices_deleted_.resize(n_vertices, false);
+        triangles_deleted_.resize(n_triangles, false);
+        next_row_.resize(n_vertices, -1);
+        last_row_.resize(n_vertices);
+        for (int vidx = 0; vidx < n_vertices; ++vidx) {
+            last_row_[vidx] = vidx;
+        }
+        neighbor_stamp_.resize(n_vertices, -1);
+
+        BuildVertexTriangles();
+        BuildEdges();
+        ComputeQuadrics(input);
+
+        // Compute the initial optimal positions and costs of all edges
+        utility::ParallelFor(0, int(edges_.size()), [&](int eidx) {
+            ComputeEdgeCost(eidx);
+        });
     }
 
-    // perform incremental edge collapse
-    bool has_vert_normal = HasVertexNormals();
-    bool has_vert_color = HasVertexColors();
-    int n_triangles = int(triangles_.size());
-    while (n_triangles > target_number_of_triangles && !queue.empty()) {
-        // retrieve edge from queue
-        double cost;
-        int vidx0, vidx1;
-        std::tie(cost, vidx0, vidx1) = queue.top();
-        queue.pop();
-
-        // test if the edge has been updated (reinserted into queue)
-        Eigen::Vector2i edge(vidx0, vidx1);
-        bool valid = !vertices_deleted[vidx0] && !vertices_deleted[vidx1] &&
-                     cost == costs[edge];
-        if (!valid) {
-            continue;
+    int NumberOfTriangles() const { return n_triangles_; }
+    const std::vector<double>& EdgeCosts() const { return costs_; }
+    size_t NumberOfEdges() const { return edges_.size(); }
+
+    /// Collapses edge eidx. Returns false if the collapse would create a
+    /// non-manifold edge or flip a triangle, in which case the mesh is left
+    /// unchanged.
+    template <typename EdgeRemovedFunc, typename EdgeUpdatedFunc>
+    bool Collapse(int eidx,
+                  EdgeRemovedFunc OnEdgeRemoved,
+                  EdgeUpdatedFunc OnEdgeUpdated) {
+        const int vidx0 = edges_[eidx](0);
+        const int vidx1 = edges_[eidx](1);
+        const Eigen::Vector3d vbar = vbars_[eidx];
+        // A rejected collapse leaves its marks behind, so every collapse
+        // marks with a stamp of its own.
+        const int stamp = ++collapse_stamp_;
+
+        // avoid non-manifold edges: every common neighbor of vidx0 and vidx1
+        // has to be the opposite vertex of a triangle containing the edge
+        ForEachEdge(vidx0, [&](int fidx) {
+            int other = edges_[fidx](0) == vidx0 ? edges_[fidx](1)
+                                                 : edges_[fidx](0);
+            neighbor_stamp_[other] = stamp;
+        });
+        int n_common_neighbors = 0;
+        ForEachEdge(vidx1, [&](int fidx) {
+            int other = edges_[fidx](0) == vidx1 ? edges_[fidx](1)
+                                                 : edges_[fidx](0);
+            if (neighbor_stamp_[other] == stamp) {
+                n_common_neighbors++;
+            }
+        });
+        int n_edge_triangles = 0;
+        ForEachTriangle(vidx1, [&](int tidx) {
+            if (HasVertex(mesh_.triangles_[tidx], vidx0)) {
+                n_edge_triangles++;
+            }
+        });
+        if (n_common_neighbors > n_edge_triangles) {
+            return false;
         }
 
         // avoid flip of triangle normal
         bool flipped = false;
-        for (int tidx : vert_to_triangles[vidx1]) {
-            if (triangles_deleted[tidx]) {
-                continue;
+        ForEachTriangle(vidx1, [&](int tidx) {
+            const Eigen::Vector3i& tria = mesh_.triangles_[tidx];
+            if (flipped || HasVertex(tria, vidx0)) {
+                return;
             }
 
-            const Eigen::Vector3i& tria = mesh->triangles_[tidx];
-            bool has_vidx0 =
-                    vidx0 == tria(0) || vidx0 == tria(1) || vidx0 == tria(2);
-            bool has_vidx1 =
-                    vidx1 == tria(0) || vidx1 == tria(1) || vidx1 == tria(2);
-            if (has_vidx0 && has_vidx1) {
-                continue;
-            }
-
-            Eigen::Vector3d vert0 = mesh->vertices_[tria(0)];
-            Eigen::Vector3d vert1 = mesh->vertices_[tria(1)];
-            Eigen::Vector3d vert2 = mesh->vertices_[tria(2)];
+            Eigen::Vector3d vert0 = mesh_.vertices_[tria(0)];
+            Eigen::Vector3d vert1 = mesh_.vertices_[tria(1)];
+            Eigen::Vector3d vert2 = mesh_.vertices_[tria(2)];
             Eigen::Vector3d norm_before = (vert1 - vert0).cross(vert2 - vert0);
             norm_before /= norm_before.norm();
 
             if (vidx1 == tria(0)) {
-                vert0 = vbars[edge];
+                vert0 = vbar;
             } else if (vidx1 == tria(1)) {
-                vert1 = vbars[edge];
+                vert1 = vbar;
             } else if (vidx1 == tria(2)) {
-                vert2 = vbars[edge];
+                vert2 = vbar;
             }
 
             Eigen::Vector3d norm_after = (vert1 - vert0).cross(vert2 - vert0);
             norm_after /= norm_after.norm();
             if (norm_before.dot(norm_after) < 0) {
                 flipped = true;
-                break;
             }
-        }
+        });
         if (flipped) {
-            continue;
+            return false;
         }
 
         // Connect triangles from vidx1 to vidx0, or mark deleted
-        for (int tidx : vert_to_triangles[vidx1]) {
-            if (triangles_deleted[tidx]) {
-                continue;
-            }
-
-            Eigen::Vector3i& tria = mesh->triangles_[tidx];
-            bool has_vidx0 =
-                    vidx0 == tria(0) || vidx0 == tria(1) || vidx0 == tria(2);
-            bool has_vidx1 =
-                    vidx1 == tria(0) || vidx1 == tria(1) || vidx1 == tria(2);
-
-            if (has_vidx0 && has_vidx1) {
-                triangles_deleted[tidx] = true;
-                n_triangles--;
-                continue;
+        ForEachTriangle(vidx1, [&](int tidx) {
+            Eigen::Vector3i& tria = mesh_.triangles_[tidx];
+            if (HasVertex(tria, vidx0)) {
+                triangles_deleted_[tidx] = true;
+                n_triangles_--;
+                return;
             }
-
             if (vidx1 == tria(0)) {
                 tria(0) = vidx0;
             } else if (vidx1 == tria(1)) {
@@ -465,75 +488,397 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyQuadricDecimation(
             } else if (vidx1 == tria(2)) {
                 tria(2) = vidx0;
             }
-            vert_to_triangles[vidx0].insert(tidx);
-        }
+        });
 
         // update vertex vidx0 to vbar
-        mesh->vertices_[vidx0] = vbars[edge];
-        Qs[vidx0] += Qs[vidx1];
-        if (has_vert_normal) {
-            mesh->vertex_normals_[vidx0] = 0.5 * (mesh->vertex_normals_[vidx0] +
-                                                  mesh->vertex_normals_[vidx1]);
+        mesh_.vertices_[vidx0] = vbar;
+        Qs_[vidx0] += Qs_[vidx1];
+        if (has_vert_normal_) {
+            mesh_.vertex_normals_[vidx0] = 0.5 * (mesh_.vertex_normals_[vidx0] +
+                                                  mesh_.vertex_normals_[vidx1]);
+        }
+        if (has_vert_color_) {
+            mesh_.vertex_colors_[vidx0] = 0.5 * (mesh_.vertex_colors_[vidx0] +
+                                                 mesh_.vertex_colors_[vidx1]);
+        }
+        vertices_deleted_[vidx1] = true;
+
+        // Redirect the edges of vidx1 to vidx0 and drop the ones that would
+        // duplicate an existing edge of vidx0, which are still marked in
+        // neighbor_stamp_
+        ForEachEdge(vidx1, [&](int fidx) {
+            Eigen::Vector2i& edge = edges_[fidx];
+            int other = edge(0) == vidx1 ? edge(1) : edge(0);
+            if (other == vidx0 || neighbor_stamp_[other] == stamp) {
+                edge = Eigen::Vector2i(-1, -1);
+                OnEdgeRemoved(fidx);
+            } else {
+                edge = Eigen::Vector2i(std::min(vidx0, other),
+                                       std::max(vidx0, other));
+            }
+        });
+        next_row_[last_row_[vidx0]] = vidx1;
+        last_row_[vidx0] = last_row_[vidx1];
+
+        // Update edge costs for all edges connecting to vidx0
+        ForEachEdge(vidx0, [&](int fidx) {
+            ComputeEdgeCost(fidx);
+            OnEdgeUpdated(fidx);
+        });
+        return true;
+    }
+
+    /// Removes the deleted vertices and triangles from the mesh.
+    void Compact() {
+        int next_free = 0;
+        std::vector<int> vert_remapping(mesh_.vertices_.size(), -1);
+        for (size_t idx = 0; idx < mesh_.vertices_.size(); ++idx) {
+            if (!vertices_deleted_[idx]) {
+                vert_remapping[idx] = next_free;
+                mesh_.vertices_[next_free] = mesh_.vertices_[idx];
+                if (has_vert_normal_) {
+                    mesh_.vertex_normals_[next_free] =
+                            mesh_.vertex_normals_[idx];
+                }
+                if (has_vert_color_) {
+                    mesh_.vertex_colors_[next_free] = mesh_.vertex_colors_[idx];
+                }
+                next_free++;
+            }
         }
-        if (has_vert_color) {
-            mesh->vertex_colors_[vidx0] = 0.5 * (mesh->vertex_colors_[vidx0] +
-                                                 mesh->vertex_colors_[vidx1]);
+        mesh_.vertices_.resize(next_free);
+        if (has_vert_normal_) {
+            mesh_.vertex_normals_.resize(next_free);
+        }
+        if (has_vert_color_) {
+            mesh_.vertex_colors_.resize(next_free);
         }
-        vertices_deleted[vidx1] = true;
 
-        // Update edge costs for all triangles connecting to vidx0
-        for (const auto& tidx : vert_to_triangles[vidx0]) {
-            if (triangles_deleted[tidx]) {
+        next_free = 0;
+        for (size_t idx = 0; idx < mesh_.triangles_.size(); ++idx) {
+            if (!triangles_deleted_[idx]) {
+                Eigen::Vector3i tria = mesh_.triangles_[idx];
+                mesh_.triangles_[next_free](0) = vert_remapping[tria(0)];
+                mesh_.triangles_[next_free](1) = vert_remapping[tria(1)];
+                mesh_.triangles_[next_free](2) = vert_remapping[tria(2)];
+                next_free++;
+            }
+        }
+        mesh_.triangles_.resize(next_free);
+    }
+
+private:
+    static bool HasVertex(const Eigen::Vector3i& tria, int vidx) {
+        return vidx == tria(0) || vidx == tria(1) || vidx == tria(2);
+    }
+
+    /// Builds the CSR offsets for rows of the given sizes.
+    static void PrefixSum(const std::vector<int>& counts,
+                          std::vector<int>& offsets) {
+        offsets.resize(counts.size() + 1);
+        offsets[0] = 0;
+        for (size_t idx = 0; idx < counts.size(); ++idx) {
+            offsets[idx + 1] = offsets[idx] + counts[idx];
+        }
+    }
+
+    void BuildVertexTriangles() {
+        const auto& triangles = mesh_.triangles_;
+        std::vector<int> counts(mesh_.vertices_.size(), 0);
+        for (const auto& tria : triangles) {
+            counts[tria(0)]++;
+            counts[tria(1)]++;
+            counts[tria(2)]++;
+        }
+        PrefixSum(counts, vert_tria_offsets_);
+        vert_tria_indices_.resize(vert_tria_offsets_.back());
+        std::vector<int> fill(vert_tria_offsets_.begin(),
+                              vert_tria_offsets_.end() - 1);
+        for (int tidx = 0; tidx < int(triangles.size()); ++tidx) {
+            vert_tria_indices_[fill[triangles[tidx](0)]++] = tidx;
+            vert_tria_indices_[fill[triangles[tidx](1)]++] = tidx;
+            vert_tria_indices_[fill[triangles[tidx](2)]++] = tidx;
+        }
+    }
+
+    void BuildEdges() {
+        // Sort all triangle edges by their vertex pair to find the unique
+        // edges and the number of triangles adjacent to each of them.
+        const auto& triangles = mesh_.triangles_;
+        std::vector<uint64_t> keys(triangles.size() * 3);
+        utility::ParallelFor(0, int(triangles.size()), [&](int tidx) {
+            const Eigen::Vector3i& tria = triangles[tidx];
+            for (int i = 0; i < 3; ++i) {
+                int vidx0 = std::min(tria(i), tria((i + 1) % 3));
+                int vidx1 = std::max(tria(i), tria((i + 1) % 3));
+                keys[3 * tidx + i] = (uint64_t(vidx0) << 32) | uint64_t(vidx1);
+            }
+        });
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<int> counts(mesh_.vertices_.size(), 0);
+        for (size_t kidx = 0; kidx < keys.size();) {
+            size_t end = kidx + 1;
+            while (end < keys.size() && keys[end] == keys[kidx]) {
+                end++;
+            }
+            Eigen::Vector2i edge(int(keys[kidx] >> 32),
+                                 int(keys[kidx] & 0xffffffff));
+            if (edge(0) == edge(1)) {
+                // skip edges of degenerate triangles
+                kidx = end;
                 continue;
             }
-            const Eigen::Vector3i& tria = mesh->triangles_[tidx];
-            if (tria(0) == vidx0 || tria(1) == vidx0) {
-                AddEdge(tria(0), tria(1), true);
+            edges_.push_back(edge);
+            edge_boundary_.push_back(end - kidx == 1);
+            counts[edge(0)]++;
+            counts[edge(1)]++;
+            kidx = end;
+        }
+        vbars_.resize(edges_.size());
+        costs_.resize(edges_.size());
+
+        PrefixSum(counts, vert_edge_offsets_);
+        vert_edge_indices_.resize(vert_edge_offsets_.back());
+        std::vector<int> fill(vert_edge_offsets_.begin(),
+                              vert_edge_offsets_.end() - 1);
+        for (int eidx = 0; eidx < int(edges_.size()); ++eidx) {
+            vert_edge_indices_[fill[edges_[eidx](0)]++] = eidx;
+            vert_edge_indices_[fill[edges_[eidx](1)]++] = eidx;
+        }
+    }
+
+    bool IsBoundaryEdge(int vidx0, int vidx1) const {
+        for (int k = vert_edge_offsets_[vidx0];
+             k < vert_edge_offsets_[vidx0 + 1]; ++k) {
+            const Eigen::Vector2i& edge = edges_[vert_edge_indices_[k]];
+            if (edge(0) == vidx1 || edge(1) == vidx1) {
+                return edge_boundary_[vert_edge_indices_[k]];
+            }
+        }
+        return false;
+    }
+
+    void ComputeQuadrics(const TriangleMesh& input) {
+        const int n_triangles = int(mesh_.triangles_.size());
+        std::vector<Eigen::Vector4d> triangle_planes(n_triangles);
+        std::vector<double> triangle_areas(n_triangles);
+        utility::ParallelFor(0, n_triangles, [&](int tidx) {
+            triangle_planes[tidx] = input.GetTrianglePlane(tidx);
+            triangle_areas[tidx] = input.GetTriangleArea(tidx);
+        });
+
+        // Compute the error metric per vertex. For boundary edges add a
+        // perpendicular plane quadric to both edge vertices.
+        const auto& vertices = mesh_.vertices_;
+        Qs_.resize(vertices.size());
+        utility::ParallelFor(0, int(vertices.size()), [&](int vidx) {
+            Quadric& Q = Qs_[vidx];
+            for (int k = vert_tria_offsets_[vidx];
+                 k < vert_tria_offsets_[vidx + 1]; ++k) {
+                int tidx = vert_tria_indices_[k];
+                Q += Quadric(triangle_planes[tidx], triangle_areas[tidx]);
             }
-            if (tria(1) == vidx0 || tria(2) == vidx0) {
-                AddEdge(tria(1), tria(2), true);
+            for (int k = vert_tria_offsets_[vidx];
+                 k < vert_tria_offsets_[vidx + 1]; ++k) {
+                int tidx = vert_tria_indices_[k];
+                const Eigen::Vector3i& tria = mesh_.triangles_[tidx];
+                for (int i = 0; i < 3; ++i) {
+                    int vidx0 = tria(i);
+                    int vidx1 = tria((i + 1) % 3);
+                    int vidx2 = tria((i + 2) % 3);
+                    if ((vidx0 != vidx && vidx1 != vidx) ||
+                        !IsBoundaryEdge(vidx0, vidx1)) {
+                        continue;
+                    }
+                    const auto& vert0 = vertices[vidx0];
+                    const auto& vert1 = vertices[vidx1];
+                    const auto& vert2 = vertices[vidx2];
+                    Eigen::Vector3d vert2p =
+                            (vert2 - vert0).cross(vert2 - vert1);
+                    Eigen::Vector4d plane = TriangleMesh::ComputeTrianglePlane(
+                            vert0, vert1, vert2p);
+                    Q += Quadric(plane, triangle_areas[tidx]);
+                }
             }
-            if (tria(2) == vidx0 || tria(0) == vidx0) {
-                AddEdge(tria(2), tria(0), true);
+        });
+    }
+
+    void ComputeEdgeCost(int eidx) {
+        const int vidx0 = edges_[eidx](0);
+        const int vidx1 = edges_[eidx](1);
+        Quadric Qbar = Qs_[vidx0] + Qs_[vidx1];
+        double cost;
+        Eigen::Vector3d vbar;
+        if (Qbar.IsInvertible()) {
+            vbar = Qbar.Minimum();
+            cost = Qbar.Eval(vbar);
+        } else {
+            const Eigen::Vector3d& v0 = mesh_.vertices_[vidx0];
+            const Eigen::Vector3d& v1 = mesh_.vertices_[vidx1];
+            Eigen::Vector3d vmid = (v0 + v1) / 2;
+            double cost0 = Qbar.Eval(v0);
+            double cost1 = Qbar.Eval(v1);
+            double costmid = Qbar.Eval(vmid);
+            cost = std::min(cost0, std::min(cost1, costmid));
+            if (cost == costmid) {
+                vbar = vmid;
+            } else if (cost == cost0) {
+                vbar = v0;
+            } else {
+                vbar = v1;
             }
         }
+        vbars_[eidx] = vbar;
+        costs_[eidx] = cost;
     }
 
-    // Apply changes to the triangle mesh
-    int next_free = 0;
-    std::unordered_map<int, int> vert_remapping;
-    for (size_t idx = 0; idx < mesh->vertices_.size(); ++idx) {
-        if (!vertices_deleted[idx]) {
-            vert_remapping[int(idx)] = next_free;
-            mesh->vertices_[next_free] = mesh->vertices_[idx];
-            if (has_vert_normal) {
-                mesh->vertex_normals_[next_free] = mesh->vertex_normals_[idx];
+    /// Calls func for every not deleted triangle adjacent to vidx.
+    template <typename Func>
+    void ForEachTriangle(int vidx, Func func) const {
+        for (int row = vidx; row >= 0; row = next_row_[row]) {
+            for (int k = vert_tria_offsets_[row];
+                 k < vert_tria_offsets_[row + 1]; ++k) {
+                if (!triangles_deleted_[vert_tria_indices_[k]]) {
+                    func(vert_tria_indices_[k]);
+                }
             }
-            if (has_vert_color) {
-                mesh->vertex_colors_[next_free] = mesh->vertex_colors_[idx];
+        }
+    }
+
+    /// Calls func for every not deleted edge adjacent to vidx.
+    template <typename Func>
+    void ForEachEdge(int vidx, Func func) const {
+        for (int row = vidx; row >= 0; row = next_row_[row]) {
+            for (int k = vert_edge_offsets_[row];
+                 k < vert_edge_offsets_[row + 1]; ++k) {
+                if (edges_[vert_edge_indices_[k]](0) >= 0) {
+                    func(vert_edge_indices_[k]);
+                }
             }
-            next_free++;
         }
     }
-    mesh->vertices_.resize(next_free);
-    if (has_vert_normal) {
-        mesh->vertex_normals_.resize(next_free);
+
+private:
+    TriangleMesh& mesh_;
+    int n_triangles_;
+    bool has_vert_normal_;
+    bool has_vert_color_;
+    std::vector<bool> vertices_deleted_;
+    std::vector<bool> triangles_deleted_;
+    std::vector<Quadric> Qs_;
+
+    std::vector<int> vert_tria_offsets_;
+    std::vector<int> vert_tria_indices_;
+    std::vector<int> vert_edge_offsets_;
+    std::vector<int> vert_edge_indices_;
+    /// Rows of merged vertices form a linked list starting at the surviving
+    /// vertex.
+    std::vector<int> next_row_;
+    std::vector<int> last_row_;
+    /// Scratch buffer to mark the neighbors of the surviving vertex with the
+    /// stamp of the current collapse.
+    std::vector<int> neighbor_stamp_;
+    int collapse_stamp_ = 0;
+
+    /// Edges as sorted vertex pairs, (-1, -1) if deleted.
+    std::vector<Eigen::Vector2i> edges_;
+    std::vector<bool> edge_boundary_;
+    std::vector<Eigen::Vector3d> vbars_;
+    std::vector<double> costs_;
+};
+
+}  // unnamed namespace
+
+std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyQuadricDecimation(
+        int target_number_of_triangles) const {
+    auto mesh = std::make_shared<TriangleMesh>();
+    mesh->vertices_ = vertices_;
+    mesh->vertex_normals_ = vertex_normals_;
+    mesh->vertex_colors_ = vertex_colors_;
+    mesh->triangles_ = triangles_;
+
+    QuadricDecimation decimation(*this, *mesh);
+    IndexedMinHeap queue(decimation.EdgeCosts());
+    queue.Build();
+
+    // perform incremental edge collapse
+    while (decimation.NumberOfTriangles() > target_number_of_triangles &&
+           !queue.IsEmpty()) {
+        int eidx = queue.Top();
+        queue.Remove(eidx);
+        decimation.Collapse(
+                eidx, [&](int fidx) { queue.Remove(fidx); },
+                [&](int fidx) { queue.Update(fidx); });
     }
-    if (has_vert_color) {
-        mesh->vertex_colors_.resize(next_free);
+    decimation.Compact();
+
+    if (HasTriangleNormals()) {
+        mesh->ComputeTriangleNormals();
+    }
+
+    return mesh;
+}
+
+std::shared_ptr<TriangleMesh>
+TriangleMesh::SimplifyQuadricDecimationMultipleChoice(
+        int target_number_of_triangles, int number_of_choices) const {
+    auto mesh = std::make_shared<TriangleMesh>();
+    mesh->vertices_ = vertices_;
+    mesh->vertex_normals_ = vertex_normals_;
+    mesh->vertex_colors_ = vertex_colors_;
+    mesh->triangles_ = triangles_;
+    if (number_of_choices < 1) {
+        utility::LogWarning(
+                "[SimplifyQuadricDecimationMultipleChoice] "
+                "number_of_choices < 1.\n");
+        return mesh;
     }
 
-    next_free = 0;
-    for (size_t idx = 0; idx < mesh->triangles_.size(); ++idx) {
-        if (!triangles_deleted[idx]) {
-            Eigen::Vector3i tria = mesh->triangles_[idx];
-            mesh->triangles_[next_free](0) = vert_remapping[tria(0)];
-            mesh->triangles_[next_free](1) = vert_remapping[tria(1)];
-            mesh->triangles_[next_free](2) = vert_remapping[tria(2)];
-            next_free++;
+    QuadricDecimation decimation(*this, *mesh);
+    const std::vector<double>& costs = decimation.EdgeCosts();
+
+    // Edges that are candidates for a collapse, with O(1) removal
+    std::vector<int> candidates(decimation.NumberOfEdges());
+    std::vector<int> positions(decimation.NumberOfEdges());
+    for (int eidx = 0; eidx < int(candidates.size()); ++eidx) {
+        candidates[eidx] = eidx;
+        positions[eidx] = eidx;
+    }
+    auto RemoveCandidate = [&](int eidx) {
+        int pos = positions[eidx];
+        if (pos < 0) {
+            return;
+        }
+        int last = candidates.back();
+        candidates[pos] = last;
+        positions[last] = pos;
+        candidates.pop_back();
+        positions[eidx] = -1;
+    };
+    auto AddCandidate = [&](int eidx) {
+        if (positions[eidx] < 0) {
+            positions[eidx] = int(candidates.size());
+            candidates.push_back(eidx);
+        }
+    };
+
+    // Fixed seed to get reproducible results
+    std::mt19937 rng(0);
+    while (decimation.NumberOfTriangles() > target_number_of_triangles &&
+           !candidates.empty()) {
+        std::uniform_int_distribution<int> dist(0, int(candidates.size()) - 1);
+        int eidx = candidates[dist(rng)];
+        for (int choice = 1; choice < number_of_choices; ++choice) {
+            int fidx = candidates[dist(rng)];
+            if (costs[fidx] < costs[eidx]) {
+                eidx = fidx;
+            }
         }
+        RemoveCandidate(eidx);
+        decimation.Collapse(eidx, RemoveCandidate, AddCandidate);
     }
-    mesh->triangles_.resize(next_free);
+    decimation.Compact();
 
     if (HasTriangleNormals()) {
         mesh->ComputeTriangleNormals();
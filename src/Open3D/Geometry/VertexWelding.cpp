@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/VertexWelding.h"
+
+#include <Eigen/Dense>
+#include <numeric>
+#include <tuple>
+
+#include "Open3D/Utility/Helper.h"
+#include "Open3D/Utility/Parallel.h"
+
+namespace open3d {
+namespace geometry {
+
+size_t VertexWelding::GroupVertices(
+        const std::vector<Eigen::Vector3d>& vertices,
+        double epsilon,
+        std::vector<int>& index_old_to_new,
+        std::vector<int>& group_offsets,
+        std::vector<int>& group_members) {
+    typedef std::tuple<double, double, double> Coordinate3;
+    const size_t n = vertices.size();
+
+    // Cells stay in floating point, so that extreme or non-finite coordinates
+    // need no integer cast; NaN cells never compare equal and stay unique.
+    std::vector<Eigen::Vector3d> cells;
+    if (epsilon > 0.0) {
+        cells.resize(n);
+        utility::ParallelFor(0, (int)n, [&](int i) {
+            cells[i] = (vertices[i] / epsilon).array().floor();
+        });
+    }
+    const std::vector<Eigen::Vector3d>& keys = epsilon > 0.0 ? cells : vertices;
+    const std::vector<int> first_equal = utility::FindFirstEqual(
+            n,
+            [&keys](int i) {
+                return utility::hash_tuple::hash<Coordinate3>()(
+                        std::make_tuple(keys[i](0), keys[i](1), keys[i](2)));
+            },
+            [&keys](int i, int j) { return keys[i] == keys[j]; });
+
+    index_old_to_new.resize(n);
+    group_offsets.assign(1, 0);
+    for (size_t i = 0; i < n; i++) {
+        if (first_equal[i] == (int)i) {
+            index_old_to_new[i] = (int)group_offsets.size() - 1;
+            group_offsets.push_back(0);
+        } else {
+            index_old_to_new[i] = index_old_to_new[first_equal[i]];
+        }
+        group_offsets[index_old_to_new[i] + 1]++;
+    }
+    std::partial_sum(group_offsets.begin(), group_offsets.end(),
+                     group_offsets.begin());
+    group_members.resize(n);
+    std::vector<int> fill(group_offsets.begin(), group_offsets.end() - 1);
+    for (size_t i = 0; i < n; i++) {
+        group_members[fill[index_old_to_new[i]]++] = (int)i;
+    }
+    return group_offsets.size() - 1;
+}
+
+std::vector<Eigen::Vector3d> VertexWelding::MergeGroups(
+        const std::vector<Eigen::Vector3d>& values,
+        const std::vector<int>& group_offsets,
+        const std::vector<int>& group_members,
+        bool average) {
+    std::vector<Eigen::Vector3d> merged(group_offsets.size() - 1);
+    utility::ParallelFor(0, (int)merged.size(), [&](int g) {
+        const int begin = group_offsets[g];
+        const int end = group_offsets[g + 1];
+        if (!average || end - begin == 1) {
+            merged[g] = values[group_members[begin]];
+            return;
+        }
+        Eigen::Vector3d sum = Eigen::Vector3d::Zero();
+        for (int m = begin; m < end; m++) {
+            sum += values[group_members[m]];
+        }
+        merged[g] = sum / (end - begin);
+    });
+    return merged;
+}
+
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,60 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2019 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <vector>
+
+namespace open3d {
+namespace geometry {
+
+/// Groups duplicated mesh vertices; shared by the RemoveDuplicatedVertices
+/// implementations of TriangleMesh and TetraMesh.
+class VertexWelding {
+public:
+    /// Assigns every vertex to a group of equal vertices or, if epsilon > 0,
+    /// of vertices in the same grid cell of size epsilon. Groups are numbered
+    /// in the order of their first vertex. Returns the number of groups and
+    /// fills index_old_to_new; group_offsets (one entry per group plus one)
+    /// and group_members list the vertices of each group in index order.
+    static size_t GroupVertices(const std::vector<Eigen::Vector3d>& vertices,
+                                double epsilon,
+                                std::vector<int>& index_old_to_new,
+                                std::vector<int>& group_offsets,
+                                std::vector<int>& group_members);
+
+    /// Returns one value per group: the mean of its members if average is
+    /// set, the value of its first member otherwise.
+    static std::vector<Eigen::Vector3d> MergeGroups(
+            const std::vector<Eigen::Vector3d>& values,
+            const std::vector<int>& group_offsets,
+            const std::vector<int>& group_members,
+            bool average);
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -26,19 +26,71 @@
 
 #include "Open3D/IO/ClassIO/FeatureIO.h"
 
+#include <unordered_map>
+
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
 
 namespace open3d {
+
+namespace {
+using namespace io;
+
+/// BIN has no compression, so the flag only warns.
+bool WriteFeatureToBINIgnoringCompression(const std::string &filename,
+                                          const registration::Feature &feature,
+                                          bool compressed) {
+    if (compressed) {
+        utility::LogWarning(
+                "Write BIN: compression is not supported, the feature is "
+                "written uncompressed.\n");
+    }
+    return WriteFeatureToBIN(filename, feature);
+}
+
+static const std::unordered_map<
+        std::string,
+        std::function<bool(const std::string &, registration::Feature &)>>
+        file_extension_to_feature_read_function{
+                {"bin", ReadFeatureFromBIN},
+                {"o3db", ReadFeatureFromO3DB},
+        };
+
+static const std::unordered_map<
+        std::string,
+        std::function<bool(const std::string &,
+                           const registration::Feature &,
+                           const bool)>>
+        file_extension_to_feature_write_function{
+                {"bin", WriteFeatureToBINIgnoringCompression},
+                {"o3db", WriteFeatureToO3DB},
+        };
+
+}  // unnamed namespace
+
 namespace io {
 
 bool ReadFeature(const std::string &filename, registration::Feature &feature) {
-    return ReadFeatureFromBIN(filename, feature);
+    std::string filename_ext =
+            utility::filesystem::GetFileExtensionInLowerCase(filename);
+    auto map_itr = file_extension_to_feature_read_function.find(filename_ext);
+    if (map_itr == file_extension_to_feature_read_function.end()) {
+        return ReadFeatureFromBIN(filename, feature);
+    }
+    return map_itr->second(filename, feature);
 }
 
 bool WriteFeature(const std::string &filename,
-                  const registration::Feature &feature) {
-    return WriteFeatureToBIN(filename, feature);
+                  const registration::Feature &feature,
+                  bool compressed /* = false*/) {
+    std::string filename_ext =
+            utility::filesystem::GetFileExtensionInLowerCase(filename);
+    auto map_itr = file_extension_to_feature_write_function.find(filename_ext);
+    if (map_itr == file_extension_to_feature_write_function.end()) {
+        return WriteFeatureToBINIgnoringCompression(filename, feature,
+                                                    compressed);
+    }
+    return map_itr->second(filename, feature, compressed);
 }
 
 }  // namespace io
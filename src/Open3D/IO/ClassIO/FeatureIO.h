@@ -34,13 +34,19 @@ namespace open3d {
 namespace io {
 
 /// The general entrance for reading a Feature from a file
+/// The function calls read functions based on the extension name of filename,
+/// files with other extensions are read as BIN.
 /// \return If the read function is successful.
 bool ReadFeature(const std::string &filename, registration::Feature &feature);
 
 /// The general entrance for writing a Feature to a file
+/// The function calls write functions based on the extension name of filename,
+/// files with other extensions are written as BIN. \param compressed is used
+/// by O3DB, BIN is always written uncompressed.
 /// \return If the write function is successful.
 bool WriteFeature(const std::string &filename,
-                  const registration::Feature &feature);
+                  const registration::Feature &feature,
+                  bool compressed = false);
 
 bool ReadFeatureFromBIN(const std::string &filename,
                         registration::Feature &feature);
@@ -48,5 +54,12 @@ bool ReadFeatureFromBIN(const std::string &filename,
 bool WriteFeatureToBIN(const std::string &filename,
                        const registration::Feature &feature);
 
+bool ReadFeatureFromO3DB(const std::string &filename,
+                         registration::Feature &feature);
+
+bool WriteFeatureToO3DB(const std::string &filename,
+                        const registration::Feature &feature,
+                        bool compressed = false);
+
 }  // namespace io
 }  // namespace open3d
@@ -0,0 +1,74 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/IO/ClassIO/KDTreeFlannIO.h"
+
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace io {
+
+bool ReadKDTreeFlann(const std::string &filename,
+                     const Eigen::MatrixXd &data,
+                     geometry::KDTreeFlann &kdtree) {
+    if (kdtree.ReadSnapshot(filename, data)) {
+        return true;
+    }
+    utility::LogDebug("Rebuilding KDTreeFlann snapshot {}.\n", filename);
+    if (!kdtree.SetMatrixData(data)) {
+        return false;
+    }
+    WriteKDTreeFlann(filename, kdtree);
+    return true;
+}
+
+bool ReadKDTreeFlann(const std::string &filename,
+                     const geometry::Geometry &geometry,
+                     geometry::KDTreeFlann &kdtree) {
+    if (kdtree.ReadSnapshot(filename, geometry)) {
+        return true;
+    }
+    utility::LogDebug("Rebuilding KDTreeFlann snapshot {}.\n", filename);
+    if (!kdtree.SetGeometry(geometry)) {
+        return false;
+    }
+    WriteKDTreeFlann(filename, kdtree);
+    return true;
+}
+
+bool ReadKDTreeFlann(const std::string &filename,
+                     const registration::Feature &feature,
+                     geometry::KDTreeFlann &kdtree) {
+    return ReadKDTreeFlann(filename, feature.data_, kdtree);
+}
+
+bool WriteKDTreeFlann(const std::string &filename,
+                      const geometry::KDTreeFlann &kdtree) {
+    return kdtree.WriteSnapshot(filename);
+}
+
+}  // namespace io
+}  // namespace open3d
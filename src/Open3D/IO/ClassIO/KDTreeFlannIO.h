@@ -0,0 +1,63 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <string>
+
+#include "Open3D/Geometry/Geometry.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Registration/Feature.h"
+
+namespace open3d {
+namespace io {
+
+/// The general entrance for loading the KDTreeFlann of data from a snapshot
+/// written by WriteKDTreeFlann. If the snapshot is missing, invalid or was
+/// built from other data, the index is rebuilt from data and the snapshot is
+/// rewritten.
+/// \return return true if the index is ready, false otherwise.
+bool ReadKDTreeFlann(const std::string &filename,
+                     const Eigen::MatrixXd &data,
+                     geometry::KDTreeFlann &kdtree);
+
+bool ReadKDTreeFlann(const std::string &filename,
+                     const geometry::Geometry &geometry,
+                     geometry::KDTreeFlann &kdtree);
+
+bool ReadKDTreeFlann(const std::string &filename,
+                     const registration::Feature &feature,
+                     geometry::KDTreeFlann &kdtree);
+
+/// The general entrance for writing a snapshot of a built KDTreeFlann and of
+/// the checksum of its data.
+/// \return return true if the write function is successful, false otherwise.
+bool WriteKDTreeFlann(const std::string &filename,
+                      const geometry::KDTreeFlann &kdtree);
+
+}  // namespace io
+}  // namespace open3d
@@ -41,6 +41,7 @@ static const std::unordered_map<
         std::function<bool(const std::string &, geometry::LineSet &, bool)>>
         file_extension_to_lineset_read_function{
                 {"ply", ReadLineSetFromPLY},
+                {"o3db", ReadLineSetFromO3DB},
         };
 
 static const std::unordered_map<std::string,
@@ -51,6 +52,7 @@ static const std::unordered_map<std::string,
                                                    const bool)>>
         file_extension_to_lineset_write_function{
                 {"ply", WriteLineSetToPLY},
+                {"o3db", WriteLineSetToO3DB},
         };
 }  // unnamed namespace
 
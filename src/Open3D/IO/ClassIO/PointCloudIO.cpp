@@ -46,6 +46,7 @@ static const std::unordered_map<
                 {"ply", ReadPointCloudFromPLY},
                 {"pcd", ReadPointCloudFromPCD},
                 {"pts", ReadPointCloudFromPTS},
+                {"o3db", ReadPointCloudFromO3DB},
         };
 
 static const std::unordered_map<std::string,
@@ -61,6 +62,7 @@ static const std::unordered_map<std::string,
                 {"ply", WritePointCloudToPLY},
                 {"pcd", WritePointCloudToPCD},
                 {"pts", WritePointCloudToPTS},
+                {"o3db", WritePointCloudToO3DB},
         };
 }  // unnamed namespace
 
@@ -121,5 +121,15 @@ bool WritePointCloudToPTS(const std::string &filename,
                           bool compressed = false,
                           bool print_progress = false);
 
+bool ReadPointCloudFromO3DB(const std::string &filename,
+                            geometry::PointCloud &pointcloud,
+                            bool print_progress = false);
+
+bool WritePointCloudToO3DB(const std::string &filename,
+                           const geometry::PointCloud &pointcloud,
+                           bool write_ascii = false,
+                           bool compressed = false,
+                           bool print_progress = false);
+
 }  // namespace io
 }  // namespace open3d
@@ -28,7 +28,6 @@
 
 #include <unordered_map>
 
-#include "Open3D/IO/ClassIO/IJsonConvertibleIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
 
@@ -37,29 +36,22 @@ namespace open3d {
 namespace {
 using namespace io;
 
-bool ReadPoseGraphFromJSON(const std::string &filename,
-                           registration::PoseGraph &pose_graph) {
-    return ReadIJsonConvertible(filename, pose_graph);
-}
-
-bool WritePoseGraphToJSON(const std::string &filename,
-                          const registration::PoseGraph &pose_graph) {
-    return WriteIJsonConvertibleToJSON(filename, pose_graph);
-}
-
 static const std::unordered_map<
         std::string,
         std::function<bool(const std::string &, registration::PoseGraph &)>>
         file_extension_to_pose_graph_read_function{
                 {"json", ReadPoseGraphFromJSON},
+                {"pgb", ReadPoseGraphFromPGB},
         };
 
 static const std::unordered_map<
         std::string,
         std::function<bool(const std::string &,
-                           const registration::PoseGraph &)>>
+                           const registration::PoseGraph &,
+                           const bool)>>
         file_extension_to_pose_graph_write_function{
                 {"json", WritePoseGraphToJSON},
+                {"pgb", WritePoseGraphToPGB},
         };
 
 }  // unnamed namespace
@@ -94,7 +86,8 @@ bool ReadPoseGraph(const std::string &filename,
 }
 
 bool WritePoseGraph(const std::string &filename,
-                    const registration::PoseGraph &pose_graph) {
+                    const registration::PoseGraph &pose_graph,
+                    bool compressed /* = false*/) {
     std::string filename_ext =
             utility::filesystem::GetFileExtensionInLowerCase(filename);
     if (filename_ext.empty()) {
@@ -111,7 +104,7 @@ bool WritePoseGraph(const std::string &filename,
                 "extension.\n");
         return false;
     }
-    return map_itr->second(filename, pose_graph);
+    return map_itr->second(filename, pose_graph, compressed);
 }
 
 }  // namespace io
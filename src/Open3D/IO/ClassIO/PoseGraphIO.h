@@ -47,9 +47,33 @@ bool ReadPoseGraph(const std::string &filename,
 
 /// The general entrance for writing a PoseGraph to a file.
 /// The function calls write functions based on the extension name of filename.
+/// \param compressed enables the LZF compression of the binary .pgb format,
+/// .json files are always written uncompressed.
 /// \return return true if the write function is successful, false otherwise.
 bool WritePoseGraph(const std::string &filename,
-                    const registration::PoseGraph &pose_graph);
+                    const registration::PoseGraph &pose_graph,
+                    bool compressed = false);
+
+/// Reads the JSON written by WritePoseGraphToJSON or jsoncpp directly into the
+/// PoseGraph, and falls back to jsoncpp for other JSON layouts.
+bool ReadPoseGraphFromJSON(const std::string &filename,
+                           registration::PoseGraph &pose_graph);
+
+/// Writes the PoseGraph as JSON. Fails if the PoseGraph has NaN or infinite
+/// values, which JSON cannot represent. \param compressed is not supported
+/// and only logs a warning.
+bool WritePoseGraphToJSON(const std::string &filename,
+                          const registration::PoseGraph &pose_graph,
+                          bool compressed = false);
+
+/// Binary pose graph format: a versioned header followed by the nodes and
+/// edges as contiguous arrays, optionally LZF-compressed.
+bool ReadPoseGraphFromPGB(const std::string &filename,
+                          registration::PoseGraph &pose_graph);
+
+bool WritePoseGraphToPGB(const std::string &filename,
+                         const registration::PoseGraph &pose_graph,
+                         bool compressed = false);
 
 }  // namespace io
 }  // namespace open3d
@@ -47,6 +47,7 @@ static const std::unordered_map<
                 {"off", ReadTriangleMeshFromOFF},
                 {"gltf", ReadTriangleMeshFromGLTF},
                 {"glb", ReadTriangleMeshFromGLTF},
+                {"o3db", ReadTriangleMeshFromO3DB},
         };
 
 static const std::unordered_map<
@@ -65,6 +66,7 @@ static const std::unordered_map<
                 {"off", WriteTriangleMeshToOFF},
                 {"gltf", WriteTriangleMeshToGLTF},
                 {"glb", WriteTriangleMeshToGLTF},
+                {"o3db", WriteTriangleMeshToO3DB},
         };
 
 }  // unnamed namespace
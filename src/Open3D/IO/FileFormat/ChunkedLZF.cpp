@@ -0,0 +1,157 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/IO/FileFormat/ChunkedLZF.h"
+
+#include <liblzf/lzf.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+#include "Open3D/Utility/Parallel.h"
+
+namespace open3d {
+namespace io {
+
+void CompressChunkedLZF(const char *data,
+                        size_t size,
+                        uint64_t chunk_size,
+                        std::vector<char> &compressed) {
+    const int num_chunks = int((size + chunk_size - 1) / chunk_size);
+    std::vector<std::vector<char>> chunks(num_chunks);
+    utility::ParallelFor(0, num_chunks, [&](int c) {
+        const uint64_t begin = c * chunk_size;
+        const unsigned int in_size =
+                (unsigned int)std::min(chunk_size, size - begin);
+        std::vector<char> &out = chunks[c];
+        out.resize(in_size);
+        // Leaves the chunk uncompressed if the output would not be smaller.
+        const unsigned int out_size =
+                lzf_compress(data + begin, in_size, out.data(), in_size - 1);
+        if (out_size == 0) {
+            memcpy(out.data(), data + begin, in_size);
+        } else {
+            out.resize(out_size);
+        }
+    });
+    size_t total_size = num_chunks * sizeof(uint32_t);
+    for (const auto &chunk : chunks) {
+        total_size += chunk.size();
+    }
+    compressed.resize(total_size);
+    char *ptr = compressed.data();
+    for (const auto &chunk : chunks) {
+        const uint32_t chunk_stored_size = (uint32_t)chunk.size();
+        memcpy(ptr, &chunk_stored_size, sizeof(chunk_stored_size));
+        ptr += sizeof(chunk_stored_size);
+    }
+    for (const auto &chunk : chunks) {
+        memcpy(ptr, chunk.data(), chunk.size());
+        ptr += chunk.size();
+    }
+}
+
+namespace {
+
+/// A back-reference of LZF takes at least 3 bytes and expands to at most 264.
+const uint64_t kLZFMaxExpansion = 88;
+
+/// Reads the chunk table and fills \param offsets with the offset of every
+/// chunk in \param data, plus the end of the last one.
+bool ReadChunkTable(const char *data,
+                    size_t size,
+                    uint64_t chunk_size,
+                    uint64_t output_size,
+                    std::vector<uint64_t> &offsets) {
+    if (chunk_size == 0) {
+        return false;
+    }
+    const uint64_t num_chunks =
+            output_size / chunk_size + (output_size % chunk_size != 0);
+    if (num_chunks > size / sizeof(uint32_t)) {
+        return false;
+    }
+    const uint64_t table_size = num_chunks * sizeof(uint32_t);
+    if (output_size / kLZFMaxExpansion > size - table_size) {
+        return false;
+    }
+    offsets.resize(num_chunks + 1);
+    offsets[0] = table_size;
+    for (uint64_t c = 0; c < num_chunks; c++) {
+        uint32_t chunk_stored_size;
+        memcpy(&chunk_stored_size, data + c * sizeof(uint32_t),
+               sizeof(uint32_t));
+        // Chunks that do not shrink are stored as is, so none is larger.
+        const uint64_t out_size =
+                std::min(chunk_size, output_size - c * chunk_size);
+        if (chunk_stored_size == 0 || chunk_stored_size > out_size ||
+            out_size / kLZFMaxExpansion > chunk_stored_size) {
+            return false;
+        }
+        offsets[c + 1] = offsets[c] + chunk_stored_size;
+    }
+    return offsets[num_chunks] == size;
+}
+
+}  // unnamed namespace
+
+bool CheckChunkedLZF(const char *data,
+                     size_t size,
+                     uint64_t chunk_size,
+                     uint64_t output_size) {
+    std::vector<uint64_t> offsets;
+    return ReadChunkTable(data, size, chunk_size, output_size, offsets);
+}
+
+bool DecompressChunkedLZF(const char *data,
+                          size_t size,
+                          uint64_t chunk_size,
+                          char *output,
+                          uint64_t output_size) {
+    std::vector<uint64_t> offsets;
+    if (!ReadChunkTable(data, size, chunk_size, output_size, offsets)) {
+        return false;
+    }
+    const uint64_t num_chunks = offsets.size() - 1;
+    std::atomic<bool> success(true);
+    utility::ParallelFor(0, (int)num_chunks, [&](int c) {
+        const uint64_t begin = c * chunk_size;
+        const unsigned int out_size =
+                (unsigned int)std::min(chunk_size, output_size - begin);
+        const unsigned int in_size =
+                (unsigned int)(offsets[c + 1] - offsets[c]);
+        if (in_size == out_size) {
+            memcpy(output + begin, data + offsets[c], in_size);
+        } else if (lzf_decompress(data + offsets[c], in_size, output + begin,
+                                  out_size) != out_size) {
+            success = false;
+        }
+    });
+    return success;
+}
+
+}  // namespace io
+}  // namespace open3d
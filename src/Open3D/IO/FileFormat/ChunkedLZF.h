@@ -0,0 +1,65 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Helpers shared by the binary formats (PGB, O3DB) that compress their data
+// with LZF in independent chunks, so that both directions run in parallel.
+
+namespace open3d {
+namespace io {
+
+/// Compresses \param size bytes of \param data in chunks of \param chunk_size
+/// bytes. The output is the compressed size of every chunk as uint32_t,
+/// followed by the chunks. A chunk that LZF cannot shrink is stored as is.
+void CompressChunkedLZF(const char *data,
+                        size_t size,
+                        uint64_t chunk_size,
+                        std::vector<char> &compressed);
+
+/// Returns true if \param size bytes of \param data can be the output of
+/// CompressChunkedLZF() for \param output_size bytes. Only the chunk table is
+/// read, so readers can call it before they allocate the output.
+bool CheckChunkedLZF(const char *data,
+                     size_t size,
+                     uint64_t chunk_size,
+                     uint64_t output_size);
+
+/// Decompresses the output of CompressChunkedLZF() into \param output, which
+/// must hold \param output_size bytes. Returns false if the chunk table does
+/// not match the data.
+bool DecompressChunkedLZF(const char *data,
+                          size_t size,
+                          uint64_t chunk_size,
+                          char *output,
+                          uint64_t output_size);
+
+}  // namespace io
+}  // namespace open3d
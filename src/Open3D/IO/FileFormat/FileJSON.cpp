@@ -25,10 +25,17 @@
 // ----------------------------------------------------------------------------
 
 #include <json/json.h>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
+#include <iterator>
 #include <sstream>
 
 #include "Open3D/IO/ClassIO/IJsonConvertibleIO.h"
+#include "Open3D/IO/ClassIO/PoseGraphIO.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -65,6 +72,322 @@ bool WriteIJsonConvertibleToJSONStream(
     return true;
 }
 
+/// Parser that reads the JSON of a PoseGraph directly into its nodes and
+/// edges, without building a Json::Value tree. It accepts the layout written
+/// by WritePoseGraphToJSON and the jsoncpp writer; anything it does not
+/// expect (e.g. escaped strings) makes Parse return false, and the caller
+/// falls back to jsoncpp, which also reports the errors.
+class PoseGraphJSONParser {
+public:
+    /// \param json must be null-terminated.
+    explicit PoseGraphJSONParser(const char *json) : ptr_(json) {}
+
+    bool Parse(registration::PoseGraph &pose_graph) {
+        std::string class_name;
+        int version_major = 1, version_minor = 0;
+        std::vector<registration::PoseGraphNode> nodes;
+        std::vector<registration::PoseGraphEdge> edges;
+        const bool success =
+                ParseObject([&](const std::string &key) -> bool {
+                    if (key == "class_name") {
+                        return ParseString(class_name);
+                    } else if (key == "version_major") {
+                        return ParseInt(version_major);
+                    } else if (key == "version_minor") {
+                        return ParseInt(version_minor);
+                    } else if (key == "nodes") {
+                        return ParseArray([&]() -> bool {
+                            nodes.emplace_back();
+                            return ParseNode(nodes.back());
+                        });
+                    } else if (key == "edges") {
+                        return ParseArray([&]() -> bool {
+                            edges.emplace_back();
+                            return ParseEdge(edges.back());
+                        });
+                    }
+                    return SkipValue();
+                }) &&
+                SkipSpace() == '\0';
+        if (!success || class_name != "PoseGraph" || version_major != 1 ||
+            version_minor != 0 || nodes.empty() || edges.empty()) {
+            return false;
+        }
+        pose_graph.nodes_ = std::move(nodes);
+        pose_graph.edges_ = std::move(edges);
+        return true;
+    }
+
+private:
+    bool ParseNode(registration::PoseGraphNode &node) {
+        std::string class_name;
+        int version_major = 1, version_minor = 0;
+        bool has_pose = false;
+        return ParseObject([&](const std::string &key) -> bool {
+                   if (key == "class_name") {
+                       return ParseString(class_name);
+                   } else if (key == "version_major") {
+                       return ParseInt(version_major);
+                   } else if (key == "version_minor") {
+                       return ParseInt(version_minor);
+                   } else if (key == "pose") {
+                       has_pose = true;
+                       return ParseDoubles(node.pose_.data(), 16);
+                   }
+                   return SkipValue();
+               }) &&
+               class_name == "PoseGraphNode" && version_major == 1 &&
+               version_minor == 0 && has_pose;
+    }
+
+    bool ParseEdge(registration::PoseGraphEdge &edge) {
+        std::string class_name;
+        int version_major = 1, version_minor = 0;
+        bool has_transformation = false, has_information = false;
+        edge.source_node_id_ = -1;
+        edge.target_node_id_ = -1;
+        edge.uncertain_ = false;
+        edge.confidence_ = 1.0;
+        return ParseObject([&](const std::string &key) -> bool {
+                   if (key == "class_name") {
+                       return ParseString(class_name);
+                   } else if (key == "version_major") {
+                       return ParseInt(version_major);
+                   } else if (key == "version_minor") {
+                       return ParseInt(version_minor);
+                   } else if (key == "source_node_id") {
+                       return ParseInt(edge.source_node_id_);
+                   } else if (key == "target_node_id") {
+                       return ParseInt(edge.target_node_id_);
+                   } else if (key == "uncertain") {
+                       return ParseBool(edge.uncertain_);
+                   } else if (key == "confidence") {
+                       return ParseDouble(edge.confidence_);
+                   } else if (key == "transformation") {
+                       has_transformation = true;
+                       return ParseDoubles(edge.transformation_.data(), 16);
+                   } else if (key == "information") {
+                       has_information = true;
+                       return ParseDoubles(edge.information_.data(), 36);
+                   }
+                   return SkipValue();
+               }) &&
+               class_name == "PoseGraphEdge" && version_major == 1 &&
+               version_minor == 0 && has_transformation && has_information;
+    }
+
+    /// Skips white space and returns the next character.
+    char SkipSpace() {
+        while (*ptr_ == ' ' || *ptr_ == '\t' || *ptr_ == '\n' ||
+               *ptr_ == '\r') {
+            ptr_++;
+        }
+        return *ptr_;
+    }
+
+    bool Consume(char c) {
+        if (SkipSpace() != c) {
+            return false;
+        }
+        ptr_++;
+        return true;
+    }
+
+    /// Calls \param parse_value(key) for every member, which must consume
+    /// the value.
+    template <typename FuncType>
+    bool ParseObject(const FuncType &parse_value) {
+        if (!Consume('{')) {
+            return false;
+        }
+        if (SkipSpace() == '}') {
+            ptr_++;
+            return true;
+        }
+        std::string key;
+        do {
+            if (!ParseString(key) || !Consume(':') || !parse_value(key)) {
+                return false;
+            }
+        } while (Consume(','));
+        return Consume('}');
+    }
+
+    /// Calls \param parse_element() for every element.
+    template <typename FuncType>
+    bool ParseArray(const FuncType &parse_element) {
+        if (!Consume('[')) {
+            return false;
+        }
+        if (SkipSpace() == ']') {
+            ptr_++;
+            return true;
+        }
+        do {
+            if (!parse_element()) {
+                return false;
+            }
+        } while (Consume(','));
+        return Consume(']');
+    }
+
+    bool ParseString(std::string &str) {
+        if (!Consume('"')) {
+            return false;
+        }
+        const char *begin = ptr_;
+        while (*ptr_ != '"') {
+            if (*ptr_ == '\\' || *ptr_ == '\0') {
+                return false;
+            }
+            ptr_++;
+        }
+        str.assign(begin, ptr_);
+        ptr_++;
+        return true;
+    }
+
+    bool ParseDouble(double &value) {
+        SkipSpace();
+        char *end;
+        value = std::strtod(ptr_, &end);
+        if (end == ptr_) {
+            return false;
+        }
+        ptr_ = end;
+        return true;
+    }
+
+    bool ParseInt(int &value) {
+        double number;
+        if (!ParseDouble(number) || number != std::floor(number) ||
+            std::abs(number) > INT_MAX) {
+            return false;
+        }
+        value = int(number);
+        return true;
+    }
+
+    bool ParseBool(bool &value) {
+        SkipSpace();
+        if (strncmp(ptr_, "true", 4) == 0) {
+            value = true;
+            ptr_ += 4;
+            return true;
+        } else if (strncmp(ptr_, "false", 5) == 0) {
+            value = false;
+            ptr_ += 5;
+            return true;
+        }
+        return false;
+    }
+
+    bool ParseDoubles(double *values, int n) {
+        int i = 0;
+        return ParseArray([&]() {
+                   return i < n && ParseDouble(values[i++]);
+               }) &&
+               i == n;
+    }
+
+    bool SkipValue() {
+        const char c = SkipSpace();
+        if (c == '{') {
+            return ParseObject(
+                    [&](const std::string &) { return SkipValue(); });
+        } else if (c == '[') {
+            return ParseArray([&]() { return SkipValue(); });
+        } else if (c == '"') {
+            std::string ignored;
+            return ParseString(ignored);
+        } else if (c == 't' || c == 'f') {
+            bool ignored;
+            return ParseBool(ignored);
+        } else if (strncmp(ptr_, "null", 4) == 0) {
+            ptr_ += 4;
+            return true;
+        }
+        double ignored;
+        return ParseDouble(ignored);
+    }
+
+private:
+    const char *ptr_;
+};
+
+void WriteDoubles(std::string &buffer,
+                  const char *indent,
+                  const double *values,
+                  int n) {
+    auto out = std::back_inserter(buffer);
+    buffer.push_back('[');
+    for (int i = 0; i < n; i++) {
+        fmt::format_to(out, "{}\n{}\t{:.17g}", i == 0 ? "" : ",", indent,
+                       values[i]);
+    }
+    fmt::format_to(out, "\n{}]", indent);
+}
+
+/// JSON has no literals for NaN and infinities, so such values cannot be
+/// written.
+bool IsPoseGraphFinite(const registration::PoseGraph &pose_graph) {
+    for (const auto &node : pose_graph.nodes_) {
+        if (!node.pose_.allFinite()) {
+            return false;
+        }
+    }
+    for (const auto &edge : pose_graph.edges_) {
+        if (!edge.transformation_.allFinite() ||
+            !edge.information_.allFinite() ||
+            !std::isfinite(edge.confidence_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WritePoseGraphToJSONBuffer(std::string &buffer,
+                                const registration::PoseGraph &pose_graph) {
+    // Keys in the order of the jsoncpp writer, which sorts them.
+    auto out = std::back_inserter(buffer);
+    fmt::format_to(out, "{{\n\t\"class_name\" : \"PoseGraph\",\n");
+    fmt::format_to(out, "\t\"edges\" : \n\t[");
+    for (size_t i = 0; i < pose_graph.edges_.size(); i++) {
+        const registration::PoseGraphEdge &edge = pose_graph.edges_[i];
+        fmt::format_to(out,
+                       "{}\n\t\t{{\n\t\t\t\"class_name\" : \"PoseGraphEdge\",\n"
+                       "\t\t\t\"confidence\" : {:.17g},\n"
+                       "\t\t\t\"information\" : ",
+                       i == 0 ? "" : ",", edge.confidence_);
+        WriteDoubles(buffer, "\t\t\t", edge.information_.data(), 36);
+        fmt::format_to(out,
+                       ",\n\t\t\t\"source_node_id\" : {},\n"
+                       "\t\t\t\"target_node_id\" : {},\n"
+                       "\t\t\t\"transformation\" : ",
+                       edge.source_node_id_, edge.target_node_id_);
+        WriteDoubles(buffer, "\t\t\t", edge.transformation_.data(), 16);
+        fmt::format_to(out,
+                       ",\n\t\t\t\"uncertain\" : {},\n"
+                       "\t\t\t\"version_major\" : 1,\n"
+                       "\t\t\t\"version_minor\" : 0\n\t\t}}",
+                       edge.uncertain_ ? "true" : "false");
+    }
+    fmt::format_to(out, "\n\t],\n\t\"nodes\" : \n\t[");
+    for (size_t i = 0; i < pose_graph.nodes_.size(); i++) {
+        fmt::format_to(out,
+                       "{}\n\t\t{{\n\t\t\t\"class_name\" : \"PoseGraphNode\",\n"
+                       "\t\t\t\"pose\" : ",
+                       i == 0 ? "" : ",");
+        WriteDoubles(buffer, "\t\t\t", pose_graph.nodes_[i].pose_.data(), 16);
+        fmt::format_to(out,
+                       ",\n\t\t\t\"version_major\" : 1,\n"
+                       "\t\t\t\"version_minor\" : 0\n\t\t}}");
+    }
+    fmt::format_to(out,
+                   "\n\t],\n\t\"version_major\" : 1,\n"
+                   "\t\"version_minor\" : 0\n}}");
+}
+
 }  // unnamed namespace
 
 namespace io {
@@ -109,5 +432,57 @@ bool WriteIJsonConvertibleToJSONString(
     return success;
 }
 
+bool ReadPoseGraphFromJSON(const std::string &filename,
+                           registration::PoseGraph &pose_graph) {
+    FILE *file = fopen(filename.c_str(), "rb");
+    if (file == NULL) {
+        utility::LogWarning("Read JSON failed: unable to open file: {}\n",
+                            filename);
+        return false;
+    }
+    std::string json;
+    char buffer[DEFAULT_IO_BUFFER_SIZE * 64];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        json.append(buffer, size);
+    }
+    fclose(file);
+    if (PoseGraphJSONParser(json.c_str()).Parse(pose_graph)) {
+        return true;
+    }
+    return ReadIJsonConvertibleFromJSONString(json, pose_graph);
+}
+
+bool WritePoseGraphToJSON(const std::string &filename,
+                          const registration::PoseGraph &pose_graph,
+                          bool compressed /* = false*/) {
+    if (compressed) {
+        utility::LogWarning(
+                "Write JSON: compression is not supported, the pose graph "
+                "is written uncompressed.\n");
+    }
+    if (!IsPoseGraphFinite(pose_graph)) {
+        utility::LogWarning(
+                "Write JSON failed: the pose graph has non-finite values.\n");
+        return false;
+    }
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        utility::LogWarning("Write JSON failed: unable to open file: {}\n",
+                            filename);
+        return false;
+    }
+    std::string json;
+    WritePoseGraphToJSONBuffer(json, pose_graph);
+    bool success = fwrite(json.data(), 1, json.size(), file) == json.size();
+    if (fclose(file) != 0) {
+        success = false;
+    }
+    if (!success) {
+        utility::LogWarning("Write JSON failed: unexpected error.\n");
+    }
+    return success;
+}
+
 }  // namespace io
 }  // namespace open3d
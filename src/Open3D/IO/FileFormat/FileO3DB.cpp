@@ -0,0 +1,658 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Open3D/IO/ClassIO/FeatureIO.h"
+#include "Open3D/IO/ClassIO/LineSetIO.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/ClassIO/TriangleMeshIO.h"
+#include "Open3D/IO/ClassIO/VoxelGridIO.h"
+#include "Open3D/IO/FileFormat/ChunkedLZF.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Parallel.h"
+
+// O3DB is the native binary container of Open3D geometries: a versioned
+// header, a table of named attribute blocks and the blocks. A block is an
+// array of fixed-size elements in native byte order with the memory layout of
+// the matching std::vector, starts at a 64-byte aligned offset and has a
+// checksum. Blocks can be compressed with LZF in independent chunks. Reading
+// maps the file, so an uncompressed block costs a single memcpy.
+
+namespace open3d {
+
+namespace {
+using namespace io;
+
+enum class O3DBGeometryType : uint32_t {
+    PointCloud = 1,
+    TriangleMesh = 2,
+    LineSet = 3,
+    VoxelGrid = 4,
+    Feature = 5,
+};
+
+enum class O3DBScalarType : uint32_t {
+    Float64 = 1,
+    Int32 = 2,
+};
+
+struct O3DBHeader {
+    char magic[8];
+    uint32_t version_major;
+    uint32_t version_minor;
+    uint32_t geometry_type;
+    uint32_t num_blocks;
+};
+
+struct O3DBBlockHeader {
+    char name[24];
+    uint32_t scalar_type;
+    uint32_t num_components;
+    uint64_t num_elements;
+    /// Offset of the block from the beginning of the file
+    uint64_t offset;
+    uint64_t stored_size;
+    /// Size of the chunks of the block when it is compressed, 0 otherwise
+    uint64_t chunk_size;
+    /// Checksum of the uncompressed data
+    uint64_t checksum;
+};
+
+const char kO3DBMagic[8] = {'O', '3', 'D', 'B', 'G', 'E', 'O', 'M'};
+const uint32_t kO3DBVersionMajor = 1;
+const uint32_t kO3DBVersionMinor = 0;
+const uint64_t kO3DBAlignment = 64;
+const uint64_t kO3DBChunkSize = 1 << 20;
+const uint64_t kO3DBMaxChunkSize = 1 << 30;
+const uint32_t kO3DBMaxBlocks = 1024;
+const uint32_t kO3DBMaxComponents = 1 << 16;
+
+uint64_t GetScalarSize(uint32_t scalar_type) {
+    switch ((O3DBScalarType)scalar_type) {
+        case O3DBScalarType::Float64:
+            return sizeof(double);
+        case O3DBScalarType::Int32:
+            return sizeof(int32_t);
+        default:
+            return 0;
+    }
+}
+
+template <typename Scalar>
+O3DBScalarType GetScalarType();
+template <>
+O3DBScalarType GetScalarType<double>() {
+    return O3DBScalarType::Float64;
+}
+template <>
+O3DBScalarType GetScalarType<int>() {
+    return O3DBScalarType::Int32;
+}
+
+uint64_t ComputeChecksum(const char *data, uint64_t size) {
+    // FNV-1a over the 64-bit words of every chunk, mixed down so that every
+    // bit affects the checksum. The chunk checksums are computed in parallel
+    // and combined with FNV-1a.
+    const uint64_t prime = 1099511628211ULL;
+    const uint64_t basis = 14695981039346656037ULL;
+    const int num_chunks = int((size + kO3DBChunkSize - 1) / kO3DBChunkSize);
+    std::vector<uint64_t> chunk_checksums(num_chunks);
+    utility::ParallelFor(0, num_chunks, [&](int c) {
+        const uint64_t begin = c * kO3DBChunkSize;
+        const uint64_t end = std::min(size, begin + kO3DBChunkSize);
+        uint64_t checksum = basis;
+        uint64_t i = begin;
+        for (; i + sizeof(uint64_t) <= end; i += sizeof(uint64_t)) {
+            uint64_t word;
+            memcpy(&word, data + i, sizeof(word));
+            checksum = (checksum ^ word) * prime;
+            checksum ^= checksum >> 29;
+        }
+        for (; i < end; i++) {
+            checksum = (checksum ^ uint64_t(uint8_t(data[i]))) * prime;
+        }
+        chunk_checksums[c] = checksum;
+    });
+    uint64_t checksum = (basis ^ size) * prime;
+    for (uint64_t chunk_checksum : chunk_checksums) {
+        checksum = (checksum ^ chunk_checksum) * prime;
+    }
+    return checksum;
+}
+
+/// An attribute array to be written, pointing to the memory of the geometry.
+struct O3DBBlock {
+    std::string name;
+    O3DBScalarType scalar_type;
+    uint32_t num_components;
+    uint64_t num_elements;
+    const char *data;
+};
+
+/// Block of the elements of \param v, which must be fixed-size Eigen vectors
+/// or matrices stored contiguously.
+template <typename T, typename A>
+O3DBBlock MakeBlock(const std::string &name, const std::vector<T, A> &v) {
+    typedef typename T::Scalar Scalar;
+    static_assert(sizeof(T) == T::SizeAtCompileTime * sizeof(Scalar),
+                  "Elements must be stored contiguously.");
+    return O3DBBlock{name, GetScalarType<Scalar>(),
+                     (uint32_t)T::SizeAtCompileTime, (uint64_t)v.size(),
+                     (const char *)v.data()};
+}
+
+bool WriteO3DB(const std::string &filename,
+               O3DBGeometryType geometry_type,
+               const std::vector<O3DBBlock> &blocks,
+               bool compressed) {
+    O3DBHeader header;
+    memcpy(header.magic, kO3DBMagic, sizeof(kO3DBMagic));
+    header.version_major = kO3DBVersionMajor;
+    header.version_minor = kO3DBVersionMinor;
+    header.geometry_type = (uint32_t)geometry_type;
+    header.num_blocks = (uint32_t)blocks.size();
+
+    std::vector<O3DBBlockHeader> block_headers(blocks.size());
+    std::vector<std::vector<char>> compressed_data(blocks.size());
+    uint64_t offset = sizeof(header) + blocks.size() * sizeof(O3DBBlockHeader);
+    for (size_t i = 0; i < blocks.size(); i++) {
+        const O3DBBlock &block = blocks[i];
+        O3DBBlockHeader &block_header = block_headers[i];
+        memset(&block_header, 0, sizeof(block_header));
+        memcpy(block_header.name, block.name.c_str(),
+               std::min(block.name.size(), sizeof(block_header.name) - 1));
+        block_header.scalar_type = (uint32_t)block.scalar_type;
+        block_header.num_components = block.num_components;
+        block_header.num_elements = block.num_elements;
+        const uint64_t size = block.num_elements * block.num_components *
+                              GetScalarSize(block_header.scalar_type);
+        block_header.checksum = ComputeChecksum(block.data, size);
+        if (compressed && size > 0) {
+            CompressChunkedLZF(block.data, size, kO3DBChunkSize,
+                               compressed_data[i]);
+            block_header.chunk_size = kO3DBChunkSize;
+            block_header.stored_size = compressed_data[i].size();
+        } else {
+            block_header.chunk_size = 0;
+            block_header.stored_size = size;
+        }
+        offset = (offset + kO3DBAlignment - 1) / kO3DBAlignment *
+                 kO3DBAlignment;
+        block_header.offset = offset;
+        offset += block_header.stored_size;
+    }
+
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        utility::LogWarning("Write O3DB failed: unable to open file: {}\n",
+                            filename);
+        return false;
+    }
+    bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+    if (!block_headers.empty()) {
+        success = success && fwrite(block_headers.data(),
+                                    sizeof(O3DBBlockHeader),
+                                    block_headers.size(),
+                                    file) == block_headers.size();
+    }
+    uint64_t position =
+            sizeof(header) + blocks.size() * sizeof(O3DBBlockHeader);
+    const char padding[kO3DBAlignment] = {0};
+    for (size_t i = 0; i < blocks.size() && success; i++) {
+        const O3DBBlockHeader &block_header = block_headers[i];
+        const size_t padding_size = size_t(block_header.offset - position);
+        const char *data = block_header.chunk_size > 0
+                                   ? compressed_data[i].data()
+                                   : blocks[i].data;
+        const size_t size = size_t(block_header.stored_size);
+        success = fwrite(padding, 1, padding_size, file) == padding_size &&
+                  fwrite(data, 1, size, file) == size;
+        position = block_header.offset + block_header.stored_size;
+    }
+    if (fclose(file) != 0) {
+        success = false;
+    }
+    if (!success) {
+        utility::LogWarning("Write O3DB failed: unexpected error.\n");
+    }
+    return success;
+}
+
+/// Reads the blocks of a memory-mapped O3DB file. Uncompressed blocks are
+/// copied straight from the mapping, compressed ones are decompressed
+/// straight into the output.
+class O3DBReader {
+public:
+    O3DBReader(const std::string &filename) : file_(filename) {}
+
+public:
+    /// Validates the header and the block table.
+    bool Open(O3DBGeometryType geometry_type) {
+        if (!file_.IsOpen()) {
+            utility::LogWarning("Read O3DB failed: unable to open file.\n");
+            return false;
+        }
+        O3DBHeader header;
+        if (file_.GetSize() < sizeof(header)) {
+            utility::LogWarning("Read O3DB failed: unexpected EOF.\n");
+            return false;
+        }
+        memcpy(&header, file_.GetData(), sizeof(header));
+        if (memcmp(header.magic, kO3DBMagic, sizeof(kO3DBMagic)) != 0) {
+            utility::LogWarning("Read O3DB failed: not an O3DB file.\n");
+            return false;
+        }
+        if (header.version_major != kO3DBVersionMajor) {
+            utility::LogWarning(
+                    "Read O3DB failed: unsupported version {:d}.{:d}.\n",
+                    header.version_major, header.version_minor);
+            return false;
+        }
+        if (header.geometry_type != (uint32_t)geometry_type) {
+            utility::LogWarning(
+                    "Read O3DB failed: the file stores another geometry "
+                    "type.\n");
+            return false;
+        }
+        const uint64_t table_size =
+                uint64_t(header.num_blocks) * sizeof(O3DBBlockHeader);
+        if (header.num_blocks > kO3DBMaxBlocks ||
+            file_.GetSize() < sizeof(header) + table_size) {
+            utility::LogWarning("Read O3DB failed: unexpected EOF.\n");
+            return false;
+        }
+        blocks_.resize(header.num_blocks);
+        if (header.num_blocks > 0) {
+            memcpy(blocks_.data(), file_.GetData() + sizeof(header),
+                   table_size);
+        }
+        for (auto &block : blocks_) {
+            block.name[sizeof(block.name) - 1] = '\0';
+            const uint64_t scalar_size = GetScalarSize(block.scalar_type);
+            const uint64_t element_size = scalar_size * block.num_components;
+            // Also rejects sizes that would overflow.
+            if (scalar_size == 0 ||
+                block.num_components > kO3DBMaxComponents ||
+                block.num_elements > uint64_t(INT32_MAX) ||
+                block.offset % kO3DBAlignment != 0 ||
+                block.offset > file_.GetSize() ||
+                block.stored_size > file_.GetSize() - block.offset ||
+                block.chunk_size > kO3DBMaxChunkSize ||
+                (block.chunk_size == 0 &&
+                 block.stored_size != block.num_elements * element_size) ||
+                (block.chunk_size > 0 &&
+                 !CheckChunkedLZF(file_.GetData() + block.offset,
+                                  block.stored_size, block.chunk_size,
+                                  block.num_elements * element_size))) {
+                utility::LogWarning("Read O3DB failed: invalid block {}.\n",
+                                    block.name);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Returns the block named \param name, or NULL if there is none or its
+    /// elements are not \param num_components scalars of \param scalar_type.
+    /// Any number of components is accepted if \param num_components is 0.
+    const O3DBBlockHeader *GetBlock(const std::string &name,
+                                    O3DBScalarType scalar_type,
+                                    uint32_t num_components) const {
+        for (const auto &block : blocks_) {
+            if (name != block.name) {
+                continue;
+            }
+            if (block.scalar_type != (uint32_t)scalar_type ||
+                (num_components > 0 &&
+                 block.num_components != num_components)) {
+                utility::LogWarning(
+                        "Read O3DB failed: block {} has unexpected "
+                        "elements.\n",
+                        name);
+                return NULL;
+            }
+            return &block;
+        }
+        return NULL;
+    }
+
+    /// Reads \param block into \param output, which must hold the
+    /// uncompressed block.
+    bool ReadBlock(const O3DBBlockHeader &block, char *output) const {
+        const uint64_t size = block.num_elements * block.num_components *
+                              GetScalarSize(block.scalar_type);
+        const char *data = file_.GetData() + block.offset;
+        if (block.chunk_size == 0) {
+            if (size > 0) {
+                memcpy(output, data, size);
+            }
+        } else if (!DecompressChunkedLZF(data, block.stored_size,
+                                         block.chunk_size, output, size)) {
+            utility::LogWarning("Read O3DB failed: corrupted block {}.\n",
+                                block.name);
+            return false;
+        }
+        if (ComputeChecksum(output, size) != block.checksum) {
+            utility::LogWarning(
+                    "Read O3DB failed: checksum mismatch in block {}.\n",
+                    block.name);
+            return false;
+        }
+        return true;
+    }
+
+    /// Reads the block named \param name into \param v. A missing block
+    /// leaves \param v empty and is an error only if \param required.
+    template <typename T, typename A>
+    bool Read(const std::string &name,
+              std::vector<T, A> &v,
+              bool required = false) const {
+        typedef typename T::Scalar Scalar;
+        v.clear();
+        const O3DBBlockHeader *block =
+                GetBlock(name, GetScalarType<Scalar>(),
+                         (uint32_t)T::SizeAtCompileTime);
+        if (block == NULL) {
+            if (HasBlock(name)) {
+                return false;
+            }
+            if (required) {
+                utility::LogWarning("Read O3DB failed: missing block {}.\n",
+                                    name);
+                return false;
+            }
+            return true;
+        }
+        v.resize(block->num_elements);
+        return ReadBlock(*block, (char *)v.data());
+    }
+
+    bool HasBlock(const std::string &name) const {
+        for (const auto &block : blocks_) {
+            if (name == block.name) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    utility::filesystem::MappedFile file_;
+    std::vector<O3DBBlockHeader> blocks_;
+};
+
+/// Returns false if the optional attribute \param v is neither empty nor of
+/// \param size elements.
+template <typename T, typename A>
+bool CheckAttributeSize(const std::string &name,
+                        const std::vector<T, A> &v,
+                        size_t size) {
+    if (!v.empty() && v.size() != size) {
+        utility::LogWarning("Read O3DB failed: block {} has {:d} elements.\n",
+                            name, (int)v.size());
+        return false;
+    }
+    return true;
+}
+
+}  // unnamed namespace
+
+namespace io {
+
+bool ReadPointCloudFromO3DB(const std::string &filename,
+                            geometry::PointCloud &pointcloud,
+                            bool print_progress /* = false*/) {
+    pointcloud.Clear();
+    O3DBReader reader(filename);
+    std::vector<Eigen::Vector2i> image_size;
+    if (!reader.Open(O3DBGeometryType::PointCloud) ||
+        !reader.Read("points", pointcloud.points_, true) ||
+        !reader.Read("normals", pointcloud.normals_) ||
+        !reader.Read("colors", pointcloud.colors_) ||
+        !reader.Read("covariances", pointcloud.covariances_) ||
+        !reader.Read("image_size", image_size)) {
+        pointcloud.Clear();
+        return false;
+    }
+    const size_t num_points = pointcloud.points_.size();
+    if (!CheckAttributeSize("normals", pointcloud.normals_, num_points) ||
+        !CheckAttributeSize("colors", pointcloud.colors_, num_points) ||
+        !CheckAttributeSize("covariances", pointcloud.covariances_,
+                            num_points) ||
+        !CheckAttributeSize("image_size", image_size, 1)) {
+        pointcloud.Clear();
+        return false;
+    }
+    if (!image_size.empty()) {
+        pointcloud.width_ = image_size[0](0);
+        pointcloud.height_ = image_size[0](1);
+    }
+    return true;
+}
+
+bool WritePointCloudToO3DB(const std::string &filename,
+                           const geometry::PointCloud &pointcloud,
+                           bool write_ascii /* = false*/,
+                           bool compressed /* = false*/,
+                           bool print_progress /* = false*/) {
+    std::vector<O3DBBlock> blocks;
+    blocks.push_back(MakeBlock("points", pointcloud.points_));
+    if (pointcloud.HasNormals()) {
+        blocks.push_back(MakeBlock("normals", pointcloud.normals_));
+    }
+    if (pointcloud.HasColors()) {
+        blocks.push_back(MakeBlock("colors", pointcloud.colors_));
+    }
+    if (pointcloud.HasCovariances()) {
+        blocks.push_back(MakeBlock("covariances", pointcloud.covariances_));
+    }
+    const std::vector<Eigen::Vector2i> image_size{
+            Eigen::Vector2i(pointcloud.width_, pointcloud.height_)};
+    blocks.push_back(MakeBlock("image_size", image_size));
+    return WriteO3DB(filename, O3DBGeometryType::PointCloud, blocks,
+                     compressed);
+}
+
+bool ReadTriangleMeshFromO3DB(const std::string &filename,
+                              geometry::TriangleMesh &mesh,
+                              bool print_progress /* = false*/) {
+    mesh.Clear();
+    O3DBReader reader(filename);
+    if (!reader.Open(O3DBGeometryType::TriangleMesh) ||
+        !reader.Read("vertices", mesh.vertices_, true) ||
+        !reader.Read("vertex_normals", mesh.vertex_normals_) ||
+        !reader.Read("vertex_colors", mesh.vertex_colors_) ||
+        !reader.Read("triangles", mesh.triangles_, true) ||
+        !reader.Read("triangle_normals", mesh.triangle_normals_)) {
+        mesh.Clear();
+        return false;
+    }
+    if (!CheckAttributeSize("vertex_normals", mesh.vertex_normals_,
+                            mesh.vertices_.size()) ||
+        !CheckAttributeSize("vertex_colors", mesh.vertex_colors_,
+                            mesh.vertices_.size()) ||
+        !CheckAttributeSize("triangle_normals", mesh.triangle_normals_,
+                            mesh.triangles_.size())) {
+        mesh.Clear();
+        return false;
+    }
+    return true;
+}
+
+bool WriteTriangleMeshToO3DB(const std::string &filename,
+                             const geometry::TriangleMesh &mesh,
+                             bool write_ascii /* = false*/,
+                             bool compressed /* = false*/,
+                             bool write_vertex_normals /* = true*/,
+                             bool write_vertex_colors /* = true*/,
+                             bool print_progress /* = false*/) {
+    std::vector<O3DBBlock> blocks;
+    blocks.push_back(MakeBlock("vertices", mesh.vertices_));
+    if (write_vertex_normals && mesh.HasVertexNormals()) {
+        blocks.push_back(MakeBlock("vertex_normals", mesh.vertex_normals_));
+    }
+    if (write_vertex_colors && mesh.HasVertexColors()) {
+        blocks.push_back(MakeBlock("vertex_colors", mesh.vertex_colors_));
+    }
+    blocks.push_back(MakeBlock("triangles", mesh.triangles_));
+    if (mesh.HasTriangleNormals()) {
+        blocks.push_back(
+                MakeBlock("triangle_normals", mesh.triangle_normals_));
+    }
+    return WriteO3DB(filename, O3DBGeometryType::TriangleMesh, blocks,
+                     compressed);
+}
+
+bool ReadLineSetFromO3DB(const std::string &filename,
+                         geometry::LineSet &lineset,
+                         bool print_progress /* = false*/) {
+    lineset.Clear();
+    O3DBReader reader(filename);
+    if (!reader.Open(O3DBGeometryType::LineSet) ||
+        !reader.Read("points", lineset.points_, true) ||
+        !reader.Read("lines", lineset.lines_, true) ||
+        !reader.Read("colors", lineset.colors_)) {
+        lineset.Clear();
+        return false;
+    }
+    if (!CheckAttributeSize("colors", lineset.colors_,
+                            lineset.lines_.size())) {
+        lineset.Clear();
+        return false;
+    }
+    return true;
+}
+
+bool WriteLineSetToO3DB(const std::string &filename,
+                        const geometry::LineSet &lineset,
+                        bool write_ascii /* = false*/,
+                        bool compressed /* = false*/,
+                        bool print_progress /* = false*/) {
+    std::vector<O3DBBlock> blocks;
+    blocks.push_back(MakeBlock("points", lineset.points_));
+    blocks.push_back(MakeBlock("lines", lineset.lines_));
+    if (lineset.HasColors()) {
+        blocks.push_back(MakeBlock("colors", lineset.colors_));
+    }
+    return WriteO3DB(filename, O3DBGeometryType::LineSet, blocks, compressed);
+}
+
+bool ReadVoxelGridFromO3DB(const std::string &filename,
+                           geometry::VoxelGrid &voxelgrid,
+                           bool print_progress /* = false*/) {
+    voxelgrid.Clear();
+    O3DBReader reader(filename);
+    std::vector<Eigen::Matrix<double, 1, 1>> voxel_size;
+    std::vector<Eigen::Vector3d> origin;
+    std::vector<Eigen::Vector3i> grid_indices;
+    std::vector<Eigen::Vector3d> colors;
+    if (!reader.Open(O3DBGeometryType::VoxelGrid) ||
+        !reader.Read("voxel_size", voxel_size, true) ||
+        !reader.Read("origin", origin, true) ||
+        !reader.Read("grid_indices", grid_indices, true) ||
+        !reader.Read("colors", colors, true)) {
+        voxelgrid.Clear();
+        return false;
+    }
+    if (!CheckAttributeSize("voxel_size", voxel_size, 1) ||
+        !CheckAttributeSize("origin", origin, 1) ||
+        !CheckAttributeSize("colors", colors, grid_indices.size())) {
+        voxelgrid.Clear();
+        return false;
+    }
+    voxelgrid.voxel_size_ = voxel_size[0](0);
+    voxelgrid.origin_ = origin[0];
+    voxelgrid.voxels_.resize(grid_indices.size());
+    utility::ParallelFor(0, (int)grid_indices.size(), [&](int i) {
+        voxelgrid.voxels_[i] = geometry::Voxel(grid_indices[i], colors[i]);
+    });
+    return true;
+}
+
+bool WriteVoxelGridToO3DB(const std::string &filename,
+                          const geometry::VoxelGrid &voxelgrid,
+                          bool write_ascii /* = false*/,
+                          bool compressed /* = false*/,
+                          bool print_progress /* = false*/) {
+    // Voxels interleave an integer index and a color, so they are split into
+    // two blocks.
+    const std::vector<Eigen::Matrix<double, 1, 1>> voxel_size{
+            Eigen::Matrix<double, 1, 1>(voxelgrid.voxel_size_)};
+    const std::vector<Eigen::Vector3d> origin{voxelgrid.origin_};
+    std::vector<Eigen::Vector3i> grid_indices(voxelgrid.voxels_.size());
+    std::vector<Eigen::Vector3d> colors(voxelgrid.voxels_.size());
+    utility::ParallelFor(0, (int)voxelgrid.voxels_.size(), [&](int i) {
+        grid_indices[i] = voxelgrid.voxels_[i].grid_index_;
+        colors[i] = voxelgrid.voxels_[i].color_;
+    });
+    std::vector<O3DBBlock> blocks;
+    blocks.push_back(MakeBlock("voxel_size", voxel_size));
+    blocks.push_back(MakeBlock("origin", origin));
+    blocks.push_back(MakeBlock("grid_indices", grid_indices));
+    blocks.push_back(MakeBlock("colors", colors));
+    return WriteO3DB(filename, O3DBGeometryType::VoxelGrid, blocks,
+                     compressed);
+}
+
+bool ReadFeatureFromO3DB(const std::string &filename,
+                         registration::Feature &feature) {
+    O3DBReader reader(filename);
+    if (!reader.Open(O3DBGeometryType::Feature)) {
+        return false;
+    }
+    const O3DBBlockHeader *block =
+            reader.GetBlock("data", O3DBScalarType::Float64, 0);
+    if (block == NULL) {
+        utility::LogWarning("Read O3DB failed: missing block data.\n");
+        return false;
+    }
+    feature.data_.resize(block->num_components, block->num_elements);
+    if (!reader.ReadBlock(*block, (char *)feature.data_.data())) {
+        feature.data_.resize(0, 0);
+        return false;
+    }
+    return true;
+}
+
+bool WriteFeatureToO3DB(const std::string &filename,
+                        const registration::Feature &feature,
+                        bool compressed /* = false*/) {
+    // The columns of the column-major matrix are the elements of the block.
+    const O3DBBlock block{"data", O3DBScalarType::Float64,
+                          (uint32_t)feature.Dimension(),
+                          (uint64_t)feature.Num(),
+                          (const char *)feature.data_.data()};
+    return WriteO3DB(filename, O3DBGeometryType::Feature, {block}, compressed);
+}
+
+}  // namespace io
+}  // namespace open3d
@@ -25,6 +25,8 @@
 // ----------------------------------------------------------------------------
 
 #include <liblzf/lzf.h>
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <cstdio>
 #include <sstream>
@@ -32,6 +34,7 @@
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Helper.h"
+#include "Open3D/Utility/Parallel.h"
 
 // References for PCD file IO
 // http://pointclouds.org/documentation/tutorials/pcd_file_format.php
@@ -233,65 +236,149 @@ bool ReadPCDHeader(FILE *file, PCDHeader &header) {
     return true;
 }
 
-double UnpackBinaryPCDElement(const char *data_ptr,
-                              const char type,
-                              const int size) {
-    if (type == 'I') {
-        if (size == 1) {
-            std::int8_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else if (size == 2) {
-            std::int16_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else if (size == 4) {
-            std::int32_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else {
-            return 0.0;
-        }
-    } else if (type == 'U') {
-        if (size == 1) {
-            std::uint8_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else if (size == 2) {
-            std::uint16_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else if (size == 4) {
-            std::uint32_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
+/// Size in bytes of the uncompressed pieces binary PCD data is read, written,
+/// compressed and decompressed in. Pieces are processed in parallel and bound
+/// the temporary memory needed.
+const int kPCDChunkSize = 1 << 20;
+
+template <typename T>
+void UnpackBinaryPCDColumn(const char *data_ptr,
+                           int stride,
+                           int num,
+                           Eigen::Vector3d *dst,
+                           int component) {
+    utility::ParallelFor(0, num, [&](int i) {
+        T data;
+        memcpy(&data, data_ptr + (size_t)i * stride, sizeof(data));
+        dst[i](component) = (double)data;
+    });
+}
+
+void UnpackBinaryPCDColorColumn(const char *data_ptr,
+                                int stride,
+                                int num,
+                                Eigen::Vector3d *dst) {
+    utility::ParallelFor(0, num, [&](int i) {
+        std::uint8_t data[4];
+        memcpy(data, data_ptr + (size_t)i * stride, 4);
+        // color data is packed in BGR order.
+        dst[i] = Eigen::Vector3d((double)data[2] / 255.0,
+                                 (double)data[1] / 255.0,
+                                 (double)data[0] / 255.0);
+    });
+}
+
+/// Unpacks num values of field that are stride bytes apart, starting at
+/// data_ptr, into pointcloud starting at point index begin. The element type
+/// is dispatched once per column rather than once per element.
+void UnpackBinaryPCDField(const PCLPointField &field,
+                          const char *data_ptr,
+                          int stride,
+                          int begin,
+                          int num,
+                          geometry::PointCloud &pointcloud) {
+    Eigen::Vector3d *dst = nullptr;
+    int component = 0;
+    if (field.name == "x" || field.name == "y" || field.name == "z") {
+        dst = pointcloud.points_.data() + begin;
+        component = field.name[0] - 'x';
+    } else if (field.name == "normal_x" || field.name == "normal_y" ||
+               field.name == "normal_z") {
+        dst = pointcloud.normals_.data() + begin;
+        component = field.name[7] - 'x';
+    } else if (field.name == "rgb" || field.name == "rgba") {
+        dst = pointcloud.colors_.data() + begin;
+        if (field.size == 4) {
+            UnpackBinaryPCDColorColumn(data_ptr, stride, num, dst);
         } else {
-            return 0.0;
+            std::fill(dst, dst + num, Eigen::Vector3d::Zero());
         }
-    } else if (type == 'F') {
-        if (size == 4) {
-            std::float_t data;
-            memcpy(&data, data_ptr, sizeof(data));
-            return (double)data;
-        } else {
-            return 0.0;
+        return;
+    } else {
+        return;
+    }
+    if (field.type == 'I' && field.size == 1) {
+        UnpackBinaryPCDColumn<std::int8_t>(data_ptr, stride, num, dst,
+                                           component);
+    } else if (field.type == 'I' && field.size == 2) {
+        UnpackBinaryPCDColumn<std::int16_t>(data_ptr, stride, num, dst,
+                                            component);
+    } else if (field.type == 'I' && field.size == 4) {
+        UnpackBinaryPCDColumn<std::int32_t>(data_ptr, stride, num, dst,
+                                            component);
+    } else if (field.type == 'U' && field.size == 1) {
+        UnpackBinaryPCDColumn<std::uint8_t>(data_ptr, stride, num, dst,
+                                            component);
+    } else if (field.type == 'U' && field.size == 2) {
+        UnpackBinaryPCDColumn<std::uint16_t>(data_ptr, stride, num, dst,
+                                             component);
+    } else if (field.type == 'U' && field.size == 4) {
+        UnpackBinaryPCDColumn<std::uint32_t>(data_ptr, stride, num, dst,
+                                             component);
+    } else if (field.type == 'F' && field.size == 4) {
+        UnpackBinaryPCDColumn<std::float_t>(data_ptr, stride, num, dst,
+                                            component);
+    } else {
+        for (int i = 0; i < num; i++) {
+            dst[i](component) = 0.0;
         }
     }
-    return 0.0;
 }
 
-Eigen::Vector3d UnpackBinaryPCDColor(const char *data_ptr,
-                                     const char type,
-                                     const int size) {
-    if (size == 4) {
-        std::uint8_t data[4];
-        memcpy(data, data_ptr, 4);
-        // color data is packed in BGR order.
-        return Eigen::Vector3d((double)data[2] / 255.0, (double)data[1] / 255.0,
-                               (double)data[0] / 255.0);
-    } else {
-        return Eigen::Vector3d::Zero();
+/// Decompresses an LZF stream. A stream that is the concatenation of
+/// independently compressed kPCDChunkSize pieces, as written by WritePCDData,
+/// is split at the piece boundaries and decompressed in parallel. Any other
+/// stream is decompressed serially.
+bool DecompressPCDData(const char *compressed,
+                       std::uint32_t compressed_size,
+                       char *uncompressed,
+                       std::uint32_t uncompressed_size) {
+    // Walk the LZF instructions to find the input offsets at which the output
+    // offset is a multiple of kPCDChunkSize.
+    std::vector<std::uint32_t> input_offsets(1, 0);
+    std::uint32_t ip = 0, op = 0;
+    while (ip < compressed_size) {
+        unsigned int ctrl = (unsigned char)compressed[ip++];
+        if (ctrl < (1 << 5)) {
+            ip += ctrl + 1;
+            op += ctrl + 1;
+        } else {
+            unsigned int len = ctrl >> 5;
+            if (len == 7 && ip < compressed_size) {
+                len += (unsigned char)compressed[ip++];
+            }
+            ip++;
+            op += len + 2;
+        }
+        if (op % kPCDChunkSize == 0 && ip < compressed_size) {
+            if (op / kPCDChunkSize != input_offsets.size()) {
+                break;
+            }
+            input_offsets.push_back(ip);
+        }
+    }
+    input_offsets.push_back(compressed_size);
+    const int num_chunks = (int)input_offsets.size() - 1;
+    if ((std::uint64_t)(num_chunks - 1) * kPCDChunkSize < uncompressed_size &&
+        (std::uint64_t)num_chunks * kPCDChunkSize >= uncompressed_size) {
+        std::atomic<bool> success(true);
+        utility::ParallelFor(0, num_chunks, [&](int c) {
+            const std::uint32_t begin = (std::uint32_t)c * kPCDChunkSize;
+            const std::uint32_t size = std::min(
+                    (std::uint32_t)kPCDChunkSize, uncompressed_size - begin);
+            // Fails if a back reference crosses the chunk boundary.
+            if (lzf_decompress(compressed + input_offsets[c],
+                               input_offsets[c + 1] - input_offsets[c],
+                               uncompressed + begin, size) != size) {
+                success = false;
+            }
+        });
+        if (success) {
+            return true;
+        }
     }
+    return lzf_decompress(compressed, compressed_size, uncompressed,
+                          uncompressed_size) == uncompressed_size;
 }
 
 double UnpackASCIIPCDElement(const char *data_ptr,
@@ -394,44 +481,21 @@ bool ReadPCDData(FILE *file,
             idx++;
         }
     } else if (header.datatype == PCD_DATA_BINARY) {
-        std::unique_ptr<char[]> buffer(new char[header.pointsize]);
-        for (int i = 0; i < header.points; i++) {
-            if (fread(buffer.get(), header.pointsize, 1, file) != 1) {
+        const int chunk_points = std::max(kPCDChunkSize / header.pointsize, 1);
+        std::unique_ptr<char[]> buffer(
+                new char[(size_t)chunk_points * header.pointsize]);
+        for (int begin = 0; begin < header.points; begin += chunk_points) {
+            const int num = std::min(chunk_points, header.points - begin);
+            if (fread(buffer.get(), header.pointsize, num, file) !=
+                (size_t)num) {
                 utility::LogWarning(
                         "[ReadPCDData] Failed to read data record.\n");
                 pointcloud.Clear();
                 return false;
             }
             for (const auto &field : header.fields) {
-                if (field.name == "x") {
-                    pointcloud.points_[i](0) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "y") {
-                    pointcloud.points_[i](1) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "z") {
-                    pointcloud.points_[i](2) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_x") {
-                    pointcloud.normals_[i](0) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_y") {
-                    pointcloud.normals_[i](1) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "normal_z") {
-                    pointcloud.normals_[i](2) =
-                            UnpackBinaryPCDElement(buffer.get() + field.offset,
-                                                   field.type, field.size);
-                } else if (field.name == "rgb" || field.name == "rgba") {
-                    pointcloud.colors_[i] =
-                            UnpackBinaryPCDColor(buffer.get() + field.offset,
-                                                 field.type, field.size);
-                }
+                UnpackBinaryPCDField(field, buffer.get() + field.offset,
+                                     header.pointsize, begin, num, pointcloud);
             }
         }
     } else if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
@@ -448,7 +512,7 @@ bool ReadPCDData(FILE *file,
             pointcloud.Clear();
             return false;
         }
-        utility::LogWarning(
+        utility::LogDebug(
                 "PCD data with {:d} compressed size, and {:d} uncompressed "
                 "size.\n",
                 compressed_size, uncompressed_size);
@@ -459,60 +523,24 @@ bool ReadPCDData(FILE *file,
             pointcloud.Clear();
             return false;
         }
-        std::unique_ptr<char[]> buffer(new char[uncompressed_size]);
-        if (lzf_decompress(buffer_compressed.get(),
-                           (unsigned int)compressed_size, buffer.get(),
-                           (unsigned int)uncompressed_size) !=
+        if ((std::uint64_t)header.pointsize * header.points >
             uncompressed_size) {
+            utility::LogWarning("[ReadPCDData] Failed to read data record.\n");
+            pointcloud.Clear();
+            return false;
+        }
+        std::unique_ptr<char[]> buffer(new char[uncompressed_size]);
+        if (!DecompressPCDData(buffer_compressed.get(), compressed_size,
+                               buffer.get(), uncompressed_size)) {
             utility::LogWarning("[ReadPCDData] Uncompression failed.\n");
             pointcloud.Clear();
             return false;
         }
         for (const auto &field : header.fields) {
-            const char *base_ptr = buffer.get() + field.offset * header.points;
-            if (field.name == "x") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](0) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "y") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](1) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "z") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.points_[i](2) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_x") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](0) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_y") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](1) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "normal_z") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.normals_[i](2) = UnpackBinaryPCDElement(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            } else if (field.name == "rgb" || field.name == "rgba") {
-                for (int i = 0; i < header.points; i++) {
-                    pointcloud.colors_[i] = UnpackBinaryPCDColor(
-                            base_ptr + i * field.size * field.count, field.type,
-                            field.size);
-                }
-            }
+            const char *base_ptr =
+                    buffer.get() + (size_t)field.offset * header.points;
+            UnpackBinaryPCDField(field, base_ptr, field.size * field.count, 0,
+                                 header.points, pointcloud);
         }
     }
     return true;
@@ -624,6 +652,22 @@ float ConvertRGBToFloat(const Eigen::Vector3d &color) {
     return value;
 }
 
+/// Returns element c of point i as written by WritePCDData: x, y, z, then
+/// the normal and the packed color if present.
+float GetPCDElement(const geometry::PointCloud &pointcloud, int c, int i) {
+    if (c < 3) {
+        return (float)pointcloud.points_[i](c);
+    }
+    c -= 3;
+    if (pointcloud.HasNormals()) {
+        if (c < 3) {
+            return (float)pointcloud.normals_[i](c);
+        }
+        c -= 3;
+    }
+    return ConvertRGBToFloat(pointcloud.colors_[i]);
+}
+
 bool WritePCDData(FILE *file,
                   const PCDHeader &header,
                   const geometry::PointCloud &pointcloud) {
@@ -645,64 +689,94 @@ bool WritePCDData(FILE *file,
             fprintf(file, "\n");
         }
     } else if (header.datatype == PCD_DATA_BINARY) {
-        std::unique_ptr<float[]> data(new float[header.elementnum]);
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
-            data[0] = (float)point(0);
-            data[1] = (float)point(1);
-            data[2] = (float)point(2);
-            int idx = 3;
-            if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
-                data[idx + 0] = (float)normal(0);
-                data[idx + 1] = (float)normal(1);
-                data[idx + 2] = (float)normal(2);
-                idx += 3;
-            }
-            if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                data[idx] = ConvertRGBToFloat(color);
+        const int chunk_points = std::max(kPCDChunkSize / header.pointsize, 1);
+        std::unique_ptr<float[]> buffer(
+                new float[(size_t)chunk_points * header.elementnum]);
+        for (int begin = 0; begin < header.points; begin += chunk_points) {
+            const int num = std::min(chunk_points, header.points - begin);
+            utility::ParallelFor(0, num, [&](int k) {
+                float *data = buffer.get() + (size_t)k * header.elementnum;
+                for (int c = 0; c < header.elementnum; c++) {
+                    data[c] = GetPCDElement(pointcloud, c, begin + k);
+                }
+            });
+            if (fwrite(buffer.get(), header.pointsize, num, file) !=
+                (size_t)num) {
+                utility::LogWarning("[WritePCDData] Failed to write data.\n");
+                return false;
             }
-            fwrite(data.get(), sizeof(float), header.elementnum, file);
         }
     } else if (header.datatype == PCD_DATA_BINARY_COMPRESSED) {
-        int strip_size = header.points;
-        std::uint32_t buffer_size =
-                (std::uint32_t)(header.elementnum * header.points);
-        std::unique_ptr<float[]> buffer(new float[buffer_size]);
-        std::unique_ptr<float[]> buffer_compressed(new float[buffer_size * 2]);
-        for (size_t i = 0; i < pointcloud.points_.size(); i++) {
-            const auto &point = pointcloud.points_[i];
-            buffer[0 * strip_size + i] = (float)point(0);
-            buffer[1 * strip_size + i] = (float)point(1);
-            buffer[2 * strip_size + i] = (float)point(2);
-            int idx = 3;
-            if (has_normal) {
-                const auto &normal = pointcloud.normals_[i];
-                buffer[(idx + 0) * strip_size + i] = (float)normal(0);
-                buffer[(idx + 1) * strip_size + i] = (float)normal(1);
-                buffer[(idx + 2) * strip_size + i] = (float)normal(2);
-                idx += 3;
+        // The column-major data is cut into kPCDChunkSize pieces that are
+        // packed and compressed independently and in parallel, a batch at a
+        // time. The concatenation of the compressed pieces is a valid LZF
+        // stream of the whole data, and the pieces are split again on read.
+        const std::uint64_t num_elements =
+                (std::uint64_t)header.elementnum * header.points;
+        const std::uint64_t buffer_size_in_bytes64 =
+                num_elements * sizeof(float);
+        if (buffer_size_in_bytes64 > UINT32_MAX) {
+            utility::LogWarning("[WritePCDData] Too much data to compress.\n");
+            return false;
+        }
+        const std::uint32_t buffer_size_in_bytes =
+                (std::uint32_t)buffer_size_in_bytes64;
+        const int chunk_elements = kPCDChunkSize / sizeof(float);
+        const int num_chunks = (int)((num_elements + chunk_elements - 1) /
+                                     chunk_elements);
+        const int batch_size = 16;
+        const long size_position = ftell(file);
+        std::uint32_t size_compressed = 0;
+        fwrite(&size_compressed, sizeof(size_compressed), 1, file);
+        fwrite(&buffer_size_in_bytes, sizeof(buffer_size_in_bytes), 1, file);
+        std::vector<std::vector<char>> compressed(batch_size);
+        for (int batch = 0; batch < num_chunks; batch += batch_size) {
+            const int batch_end = std::min(batch + batch_size, num_chunks);
+            std::atomic<bool> success(true);
+            utility::ParallelFor(batch, batch_end, [&](int c) {
+                const std::uint64_t begin = (std::uint64_t)c * chunk_elements;
+                const int num = (int)std::min<std::uint64_t>(
+                        chunk_elements, num_elements - begin);
+                std::vector<float> buffer(num);
+                for (int k = 0; k < num;) {
+                    const int field = (int)((begin + k) / header.points);
+                    const int i = (int)((begin + k) % header.points);
+                    const int run = std::min(num - k, header.points - i);
+                    for (int r = 0; r < run; r++) {
+                        buffer[k + r] =
+                                GetPCDElement(pointcloud, field, i + r);
+                    }
+                    k += run;
+                }
+                const unsigned int in_size = num * sizeof(float);
+                // LZF expands incompressible data by at most one byte in 32.
+                std::vector<char> &out = compressed[c - batch];
+                out.resize(in_size + in_size / 16 + 64);
+                const unsigned int out_size = lzf_compress(
+                        buffer.data(), in_size, out.data(), (int)out.size());
+                if (out_size == 0) {
+                    success = false;
+                }
+                out.resize(out_size);
+            });
+            if (!success) {
+                utility::LogWarning(
+                        "[WritePCDData] Failed to compress data.\n");
+                return false;
             }
-            if (has_color) {
-                const auto &color = pointcloud.colors_[i];
-                buffer[idx * strip_size + i] = ConvertRGBToFloat(color);
+            for (int c = batch; c < batch_end; c++) {
+                const auto &out = compressed[c - batch];
+                fwrite(out.data(), 1, out.size(), file);
+                size_compressed += (std::uint32_t)out.size();
             }
         }
-        std::uint32_t buffer_size_in_bytes = buffer_size * sizeof(float);
-        std::uint32_t size_compressed =
-                lzf_compress(buffer.get(), buffer_size_in_bytes,
-                             buffer_compressed.get(), buffer_size_in_bytes * 2);
-        if (size_compressed == 0) {
-            utility::LogWarning("[WritePCDData] Failed to compress data.\n");
-            return false;
-        }
         utility::LogDebug(
                 "[WritePCDData] {:d} bytes data compressed into {:d} bytes.\n",
                 buffer_size_in_bytes, size_compressed);
+        const long end_position = ftell(file);
+        fseek(file, size_position, SEEK_SET);
         fwrite(&size_compressed, sizeof(size_compressed), 1, file);
-        fwrite(&buffer_size_in_bytes, sizeof(buffer_size_in_bytes), 1, file);
-        fwrite(buffer_compressed.get(), 1, size_compressed, file);
+        fseek(file, end_position, SEEK_SET);
     }
     return true;
 }
@@ -0,0 +1,261 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "Open3D/IO/ClassIO/PoseGraphIO.h"
+#include "Open3D/IO/FileFormat/ChunkedLZF.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
+#include "Open3D/Utility/Parallel.h"
+
+// PGB is a binary pose graph format: a versioned header followed by the node
+// and edge fields as contiguous arrays (native byte order). The arrays can be
+// compressed with LZF in independent chunks.
+
+namespace open3d {
+
+namespace {
+using namespace io;
+
+struct PGBHeader {
+    char magic[8];
+    uint32_t version_major;
+    uint32_t version_minor;
+    uint64_t num_nodes;
+    uint64_t num_edges;
+    /// Size of the chunks of the payload when it is compressed, 0 otherwise
+    uint64_t chunk_size;
+    uint64_t payload_size;
+};
+
+const char kPGBMagic[8] = {'O', '3', 'D', 'P', 'G', 'R', 'P', 'H'};
+const uint32_t kPGBVersionMajor = 1;
+const uint32_t kPGBVersionMinor = 0;
+const uint64_t kPGBChunkSize = 1 << 20;
+const uint64_t kPGBMaxChunkSize = 1 << 30;
+
+/// Offsets of the arrays of the payload: poses, source ids, target ids,
+/// uncertain flags, confidences, transformations and information matrices.
+class PGBLayout {
+public:
+    PGBLayout(uint64_t num_nodes, uint64_t num_edges) {
+        poses_ = 0;
+        source_ids_ = poses_ + num_nodes * 16 * sizeof(double);
+        target_ids_ = source_ids_ + num_edges * sizeof(int32_t);
+        uncertain_ = target_ids_ + num_edges * sizeof(int32_t);
+        // Keep the doubles 8-byte aligned.
+        confidences_ = (uncertain_ + num_edges + 7) / 8 * 8;
+        transformations_ = confidences_ + num_edges * sizeof(double);
+        informations_ = transformations_ + num_edges * 16 * sizeof(double);
+        size_ = informations_ + num_edges * 36 * sizeof(double);
+    }
+
+public:
+    uint64_t poses_;
+    uint64_t source_ids_;
+    uint64_t target_ids_;
+    uint64_t uncertain_;
+    uint64_t confidences_;
+    uint64_t transformations_;
+    uint64_t informations_;
+    uint64_t size_;
+};
+
+void PackPoseGraph(const registration::PoseGraph &pose_graph,
+                   const PGBLayout &layout,
+                   char *payload) {
+    const int num_nodes = (int)pose_graph.nodes_.size();
+    const int num_edges = (int)pose_graph.edges_.size();
+    utility::ParallelFor(0, num_nodes, [&](int i) {
+        const size_t k = i;
+        memcpy(payload + layout.poses_ + k * 16 * sizeof(double),
+               pose_graph.nodes_[i].pose_.data(), 16 * sizeof(double));
+    });
+    utility::ParallelFor(0, num_edges, [&](int i) {
+        const registration::PoseGraphEdge &edge = pose_graph.edges_[i];
+        const size_t k = i;
+        const int32_t source = edge.source_node_id_;
+        const int32_t target = edge.target_node_id_;
+        const uint8_t uncertain = edge.uncertain_ ? 1 : 0;
+        memcpy(payload + layout.source_ids_ + k * sizeof(int32_t), &source,
+               sizeof(int32_t));
+        memcpy(payload + layout.target_ids_ + k * sizeof(int32_t), &target,
+               sizeof(int32_t));
+        payload[layout.uncertain_ + k] = (char)uncertain;
+        memcpy(payload + layout.confidences_ + k * sizeof(double),
+               &edge.confidence_, sizeof(double));
+        memcpy(payload + layout.transformations_ + k * 16 * sizeof(double),
+               edge.transformation_.data(), 16 * sizeof(double));
+        memcpy(payload + layout.informations_ + k * 36 * sizeof(double),
+               edge.information_.data(), 36 * sizeof(double));
+    });
+}
+
+void UnpackPoseGraph(const char *payload,
+                     const PGBLayout &layout,
+                     registration::PoseGraph &pose_graph) {
+    const int num_nodes = (int)pose_graph.nodes_.size();
+    const int num_edges = (int)pose_graph.edges_.size();
+    utility::ParallelFor(0, num_nodes, [&](int i) {
+        const size_t k = i;
+        memcpy(pose_graph.nodes_[i].pose_.data(),
+               payload + layout.poses_ + k * 16 * sizeof(double),
+               16 * sizeof(double));
+    });
+    utility::ParallelFor(0, num_edges, [&](int i) {
+        registration::PoseGraphEdge &edge = pose_graph.edges_[i];
+        const size_t k = i;
+        int32_t source, target;
+        memcpy(&source, payload + layout.source_ids_ + k * sizeof(int32_t),
+               sizeof(int32_t));
+        memcpy(&target, payload + layout.target_ids_ + k * sizeof(int32_t),
+               sizeof(int32_t));
+        edge.source_node_id_ = source;
+        edge.target_node_id_ = target;
+        edge.uncertain_ = payload[layout.uncertain_ + k] != 0;
+        memcpy(&edge.confidence_,
+               payload + layout.confidences_ + k * sizeof(double),
+               sizeof(double));
+        memcpy(edge.transformation_.data(),
+               payload + layout.transformations_ + k * 16 * sizeof(double),
+               16 * sizeof(double));
+        memcpy(edge.information_.data(),
+               payload + layout.informations_ + k * 36 * sizeof(double),
+               36 * sizeof(double));
+    });
+}
+
+}  // unnamed namespace
+
+namespace io {
+
+bool ReadPoseGraphFromPGB(const std::string &filename,
+                          registration::PoseGraph &pose_graph) {
+    utility::filesystem::MappedFile file(filename);
+    if (!file.IsOpen()) {
+        utility::LogWarning("Read PGB failed: unable to open file: {}\n",
+                            filename);
+        return false;
+    }
+    PGBHeader header;
+    if (file.GetSize() < sizeof(header)) {
+        utility::LogWarning("Read PGB failed: unexpected EOF.\n");
+        return false;
+    }
+    memcpy(&header, file.GetData(), sizeof(header));
+    if (memcmp(header.magic, kPGBMagic, sizeof(kPGBMagic)) != 0) {
+        utility::LogWarning("Read PGB failed: not a PGB file: {}\n",
+                            filename);
+        return false;
+    }
+    if (header.version_major != kPGBVersionMajor) {
+        utility::LogWarning("Read PGB failed: unsupported version {:d}.{:d}.\n",
+                            header.version_major, header.version_minor);
+        return false;
+    }
+    // Also rejects counts whose arrays would overflow the layout.
+    if (header.num_nodes > uint64_t(INT32_MAX) ||
+        header.num_edges > uint64_t(INT32_MAX)) {
+        utility::LogWarning("Read PGB failed: invalid header.\n");
+        return false;
+    }
+    const PGBLayout layout(header.num_nodes, header.num_edges);
+    const char *data = file.GetData() + sizeof(header);
+    const size_t size = file.GetSize() - sizeof(header);
+    if (header.payload_size != layout.size_ ||
+        header.chunk_size > kPGBMaxChunkSize ||
+        (header.chunk_size == 0 && size != layout.size_)) {
+        utility::LogWarning("Read PGB failed: unexpected EOF.\n");
+        return false;
+    }
+    // Checks the counts against the compressed payload before allocating it.
+    if (header.chunk_size > 0 &&
+        !CheckChunkedLZF(data, size, header.chunk_size, layout.size_)) {
+        utility::LogWarning("Read PGB failed: corrupted data.\n");
+        return false;
+    }
+
+    std::vector<char> payload;
+    if (header.chunk_size > 0) {
+        payload.resize(layout.size_);
+        if (!DecompressChunkedLZF(data, size, header.chunk_size,
+                                  payload.data(), layout.size_)) {
+            utility::LogWarning("Read PGB failed: corrupted data.\n");
+            return false;
+        }
+        data = payload.data();
+    }
+    pose_graph.nodes_.resize(header.num_nodes);
+    pose_graph.edges_.resize(header.num_edges);
+    UnpackPoseGraph(data, layout, pose_graph);
+    return true;
+}
+
+bool WritePoseGraphToPGB(const std::string &filename,
+                         const registration::PoseGraph &pose_graph,
+                         bool compressed /* = false*/) {
+    PGBHeader header;
+    memcpy(header.magic, kPGBMagic, sizeof(kPGBMagic));
+    header.version_major = kPGBVersionMajor;
+    header.version_minor = kPGBVersionMinor;
+    header.num_nodes = pose_graph.nodes_.size();
+    header.num_edges = pose_graph.edges_.size();
+    const PGBLayout layout(header.num_nodes, header.num_edges);
+    header.chunk_size = compressed ? kPGBChunkSize : 0;
+    header.payload_size = layout.size_;
+
+    std::vector<char> payload(layout.size_, 0);
+    PackPoseGraph(pose_graph, layout, payload.data());
+    std::vector<char> compressed_payload;
+    if (compressed) {
+        CompressChunkedLZF(payload.data(), payload.size(), kPGBChunkSize,
+                           compressed_payload);
+    }
+    const std::vector<char> &data = compressed ? compressed_payload : payload;
+
+    FILE *file = fopen(filename.c_str(), "wb");
+    if (file == NULL) {
+        utility::LogWarning("Write PGB failed: unable to open file: {}\n",
+                            filename);
+        return false;
+    }
+    bool success = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   fwrite(data.data(), 1, data.size(), file) == data.size();
+    if (fclose(file) != 0) {
+        success = false;
+    }
+    if (!success) {
+        utility::LogWarning("Write PGB failed: unexpected error.\n");
+    }
+    return success;
+}
+
+}  // namespace io
+}  // namespace open3d
@@ -26,12 +26,15 @@
 
 #include "Open3D/Integration/ScalableTSDFVolume.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Integration/MarchingCubesConst.h"
 #include "Open3D/Integration/UniformTSDFVolume.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 namespace integration {
@@ -54,6 +57,10 @@ void ScalableTSDFVolume::Integrate(
         const geometry::RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic) {
+    OPEN3D_PROFILE_ZONE("ScalableTSDFVolume::Integrate");
+    OPEN3D_PROFILE_POINTS(image.depth_.width_ * image.depth_.height_);
+    OPEN3D_PROFILE_BYTES(image.depth_.data_.size() +
+                         image.color_.data_.size());
     if ((image.depth_.num_of_channels_ != 1) ||
         (image.depth_.bytes_per_channel_ != 4) ||
         (image.depth_.width_ != intrinsic.width_) ||
@@ -74,39 +81,99 @@ void ScalableTSDFVolume::Integrate(
                 "[ScalableTSDFVolume::Integrate] Unsupported image format.\n");
         return;
     }
-    auto depth2cameradistance =
-            geometry::Image::CreateDepthToCameraDistanceMultiplierFloatImage(
-                    intrinsic);
-    auto pointcloud = geometry::PointCloud::CreateFromDepthImage(
-            image.depth_, intrinsic, extrinsic, 1000.0, 1000.0,
-            depth_sampling_stride_);
+    UpdateIntrinsicCache(intrinsic);
+
+    // Unproject the sampled depth pixels and collect the volume units within
+    // sdf_trunc_ of any of them. Rows are processed in parallel into private
+    // sets, which are merged and sorted so that units are opened in a
+    // deterministic order.
+    const Eigen::Matrix4d camera_pose = extrinsic.inverse();
+    const Eigen::Matrix3d R = camera_pose.block<3, 3>(0, 0);
+    const Eigen::Vector3d t = camera_pose.block<3, 1>(0, 3);
+    const Eigen::Vector3d trunc(sdf_trunc_, sdf_trunc_, sdf_trunc_);
+    const int stride = std::max(depth_sampling_stride_, 1);
+    const int num_rows = (image.depth_.height_ + stride - 1) / stride;
     std::unordered_set<Eigen::Vector3i,
                        utility::hash_eigen::hash<Eigen::Vector3i>>
-            touched_volume_units_;
-    for (const auto &point : pointcloud->points_) {
-        auto min_bound = LocateVolumeUnit(
-                point - Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
-        auto max_bound = LocateVolumeUnit(
-                point + Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
-        for (auto x = min_bound(0); x <= max_bound(0); x++) {
-            for (auto y = min_bound(1); y <= max_bound(1); y++) {
-                for (auto z = min_bound(2); z <= max_bound(2); z++) {
-                    auto loc = Eigen::Vector3i(x, y, z);
-                    if (touched_volume_units_.find(loc) ==
-                        touched_volume_units_.end()) {
-                        touched_volume_units_.insert(loc);
-                        auto volume = OpenVolumeUnit(Eigen::Vector3i(x, y, z));
-                        volume->IntegrateWithDepthToCameraDistanceMultiplier(
-                                image, intrinsic, extrinsic,
-                                *depth2cameradistance);
+            touched_volume_units;
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        std::unordered_set<Eigen::Vector3i,
+                           utility::hash_eigen::hash<Eigen::Vector3i>>
+                touched_volume_units_private;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (int row = 0; row < num_rows; row++) {
+            const int v = row * stride;
+            const float *p = image.depth_.PointerAt<float>(0, v);
+            Eigen::Vector3i last_min_bound(1, 1, 1), last_max_bound(0, 0, 0);
+            for (int u = 0; u < image.depth_.width_; u += stride) {
+                if (!(p[u] > 0)) {
+                    continue;
+                }
+                const double d = (double)p[u];
+                const Eigen::Vector3d point =
+                        R * Eigen::Vector3d(ray_x_[u] * d, ray_y_[v] * d, d) +
+                        t;
+                const Eigen::Vector3i min_bound =
+                        LocateVolumeUnit(point - trunc);
+                const Eigen::Vector3i max_bound =
+                        LocateVolumeUnit(point + trunc);
+                // Neighbouring pixels usually touch the same units.
+                if (min_bound == last_min_bound &&
+                    max_bound == last_max_bound) {
+                    continue;
+                }
+                last_min_bound = min_bound;
+                last_max_bound = max_bound;
+                for (auto x = min_bound(0); x <= max_bound(0); x++) {
+                    for (auto y = min_bound(1); y <= max_bound(1); y++) {
+                        for (auto z = min_bound(2); z <= max_bound(2); z++) {
+                            touched_volume_units_private.insert(
+                                    Eigen::Vector3i(x, y, z));
+                        }
                     }
                 }
             }
         }
+#ifdef _OPENMP
+#pragma omp critical
+        {
+#endif
+            touched_volume_units.insert(touched_volume_units_private.begin(),
+                                        touched_volume_units_private.end());
+#ifdef _OPENMP
+        }  //    omp critical
+    }      //    omp parallel
+#endif
+
+    std::vector<Eigen::Vector3i> sorted_volume_units(
+            touched_volume_units.begin(), touched_volume_units.end());
+    std::sort(sorted_volume_units.begin(), sorted_volume_units.end(),
+              [](const Eigen::Vector3i &a, const Eigen::Vector3i &b) {
+                  return std::lexicographical_compare(a.data(), a.data() + 3,
+                                                      b.data(), b.data() + 3);
+              });
+    std::vector<std::shared_ptr<UniformTSDFVolume>> volumes(
+            sorted_volume_units.size());
+    for (size_t i = 0; i < sorted_volume_units.size(); i++) {
+        volumes[i] = OpenVolumeUnit(sorted_volume_units[i]);
     }
+
+    // Volume units do not share voxels, so they can be integrated in parallel.
+    const geometry::Image &depth2cameradistance =
+            *depth_to_camera_distance_multiplier_;
+    utility::ParallelFor(0, (int)volumes.size(), [&](int i) {
+        volumes[i]->IntegrateWithDepthToCameraDistanceMultiplier(
+                image, intrinsic, extrinsic, depth2cameradistance);
+    });
 }
 
 std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
+    OPEN3D_PROFILE_ZONE("ScalableTSDFVolume::ExtractPointCloud");
     auto pointcloud = std::make_shared<geometry::PointCloud>();
     double half_voxel_length = voxel_length_ * 0.5;
     float w0, w1, f0, f1;
@@ -210,6 +277,7 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
 
 std::shared_ptr<geometry::TriangleMesh>
 ScalableTSDFVolume::ExtractTriangleMesh() {
+    OPEN3D_PROFILE_ZONE("ScalableTSDFVolume::ExtractTriangleMesh");
     // implementation of marching cubes, based on
     // http://paulbourke.net/geometry/polygonise/
     auto mesh = std::make_shared<geometry::TriangleMesh>();
@@ -0,0 +1,57 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/TSDFVolume.h"
+
+namespace open3d {
+namespace integration {
+
+void TSDFVolume::UpdateIntrinsicCache(
+        const camera::PinholeCameraIntrinsic &intrinsic) {
+    if (depth_to_camera_distance_multiplier_ &&
+        cached_intrinsic_.width_ == intrinsic.width_ &&
+        cached_intrinsic_.height_ == intrinsic.height_ &&
+        cached_intrinsic_.intrinsic_matrix_ == intrinsic.intrinsic_matrix_) {
+        return;
+    }
+    cached_intrinsic_ = intrinsic;
+    depth_to_camera_distance_multiplier_ =
+            geometry::Image::CreateDepthToCameraDistanceMultiplierFloatImage(
+                    intrinsic);
+    const auto focal_length = intrinsic.GetFocalLength();
+    const auto principal_point = intrinsic.GetPrincipalPoint();
+    ray_x_.resize(intrinsic.width_);
+    ray_y_.resize(intrinsic.height_);
+    for (int u = 0; u < intrinsic.width_; u++) {
+        ray_x_[u] = (u - principal_point.first) / focal_length.first;
+    }
+    for (int v = 0; v < intrinsic.height_; v++) {
+        ray_y_[v] = (v - principal_point.second) / focal_length.second;
+    }
+}
+
+}  // namespace integration
+}  // namespace open3d
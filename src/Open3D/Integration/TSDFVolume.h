@@ -26,6 +26,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/RGBDImage.h"
@@ -77,6 +80,23 @@ public:
     double voxel_length_;
     double sdf_trunc_;
     TSDFVolumeColorType color_type_;
+
+protected:
+    /// Function to (re)build the per-intrinsic lookup tables below. The tables
+    /// are kept across Integrate() calls and only recomputed when the
+    /// intrinsic differs from the one they were built for.
+    void UpdateIntrinsicCache(const camera::PinholeCameraIntrinsic &intrinsic);
+
+protected:
+    /// Depth to camera distance multiplier image of the cached intrinsic.
+    std::shared_ptr<geometry::Image> depth_to_camera_distance_multiplier_;
+    /// (u - cx) / fx for every image column of the cached intrinsic.
+    std::vector<double> ray_x_;
+    /// (v - cy) / fy for every image row of the cached intrinsic.
+    std::vector<double> ray_y_;
+
+private:
+    camera::PinholeCameraIntrinsic cached_intrinsic_;
 };
 
 }  // namespace integration
@@ -26,6 +26,7 @@
 
 #include "Open3D/Integration/UniformTSDFVolume.h"
 
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <unordered_map>
@@ -33,10 +34,229 @@
 #include "Open3D/Geometry/VoxelGrid.h"
 #include "Open3D/Integration/MarchingCubesConst.h"
 #include "Open3D/Utility/Helper.h"
+#include "Open3D/Utility/Parallel.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 namespace integration {
 
+namespace {
+
+/// Edge length, in cubes, of the blocks of the coarse occupancy grid. It is
+/// also the thickness of the x-slabs the extractors run in parallel over.
+const int kBlockSize = 8;
+
+/// Coarse occupancy grid over blocks of kBlockSize^3 cubes. A block is active
+/// if the observed voxels of its own and of its next neighboring blocks, which
+/// include every voxel a cube of the block touches, hold TSDF values of both
+/// signs. Cubes and voxel pairs in inactive blocks can never produce a surface
+/// and are skipped.
+class OccupancyGrid {
+public:
+    OccupancyGrid(const UniformTSDFVolume &volume)
+        : num_blocks_((volume.resolution_ + kBlockSize - 1) / kBlockSize) {
+        const int resolution = volume.resolution_;
+        const int num_blocks = num_blocks_;
+        const int num_blocks2 = num_blocks * num_blocks;
+        // Sign bits (1: negative, 2: non-negative) of the observed voxels of
+        // every block, each voxel visited once.
+        std::vector<uint8_t> signs(num_blocks2 * num_blocks, 0);
+        utility::ParallelFor(0, (int)signs.size(), [&](int b) {
+            const int x0 = b / num_blocks2 * kBlockSize;
+            const int y0 = b / num_blocks % num_blocks * kBlockSize;
+            const int z0 = b % num_blocks * kBlockSize;
+            const int x1 = std::min(x0 + kBlockSize, resolution);
+            const int y1 = std::min(y0 + kBlockSize, resolution);
+            const int z1 = std::min(z0 + kBlockSize, resolution);
+            uint8_t sign = 0;
+            for (int x = x0; x < x1 && sign != 3; x++) {
+                for (int y = y0; y < y1 && sign != 3; y++) {
+                    const geometry::TSDFVoxel *voxel =
+                            &volume.voxels_[volume.IndexOf(x, y, z0)];
+                    for (int z = z0; z < z1; z++, voxel++) {
+                        if (voxel->weight_ != 0.0f) {
+                            sign |= voxel->tsdf_ < 0.0f ? 1 : 2;
+                        }
+                    }
+                }
+            }
+            signs[b] = sign;
+        });
+        active_.resize(signs.size());
+        utility::ParallelFor(0, (int)signs.size(), [&](int b) {
+            const int bx = b / num_blocks2;
+            const int by = b / num_blocks % num_blocks;
+            const int bz = b % num_blocks;
+            uint8_t sign = 0;
+            for (int x = bx; x <= std::min(bx + 1, num_blocks - 1); x++) {
+                for (int y = by; y <= std::min(by + 1, num_blocks - 1); y++) {
+                    for (int z = bz; z <= std::min(bz + 1, num_blocks - 1);
+                         z++) {
+                        sign |= signs[(x * num_blocks + y) * num_blocks + z];
+                    }
+                }
+            }
+            active_[b] = sign == 3;
+        });
+    }
+
+    bool IsActive(int x, int y, int z) const {
+        return active_[(x / kBlockSize * num_blocks_ + y / kBlockSize) *
+                               num_blocks_ +
+                       z / kBlockSize] != 0;
+    }
+
+private:
+    int num_blocks_;
+    std::vector<uint8_t> active_;
+};
+
+/// Output of the marching cubes pass over one x-slab. Vertex indices are local
+/// to the slab. Vertices created on the first plane of the slab may duplicate
+/// vertices of the previous slab; they are listed in first_plane_ and merged
+/// when the slabs are stitched together.
+struct MarchingCubesSlab {
+    std::vector<Eigen::Vector3d> vertices_;
+    std::vector<Eigen::Vector3d> vertex_colors_;
+    std::vector<Eigen::Vector3i> triangles_;
+    /// (edge index within the plane, local vertex index) pairs of the vertices
+    /// on the first and on the one-past-last plane of the slab.
+    std::vector<std::pair<int, int>> first_plane_;
+    std::vector<std::pair<int, int>> last_plane_;
+    /// Local to global vertex index, -1 until stitched.
+    std::vector<int> global_index_;
+};
+
+/// Runs marching cubes over x-slabs of a volume. Owns the two planes of edge
+/// caches, so one instance is reused for all slabs handled by a thread.
+class MarchingCubesSlabExtractor {
+public:
+    MarchingCubesSlabExtractor(const UniformTSDFVolume &volume,
+                               const OccupancyGrid &occupancy)
+        : volume_(volume),
+          occupancy_(occupancy),
+          plane0_(volume.resolution_ * volume.resolution_ * 3, -1),
+          plane1_(volume.resolution_ * volume.resolution_ * 3, -1) {}
+
+    /// Extracts the cubes with x in [x0, x1) into slab.
+    void Extract(int x0, int x1, MarchingCubesSlab &slab) {
+        const int resolution = volume_.resolution_;
+        const int num_cubes = resolution - 1;
+        const double voxel_length = volume_.voxel_length_;
+        const double half_voxel_length = voxel_length * 0.5;
+        const TSDFVolumeColorType color_type = volume_.color_type_;
+        int edge_to_index[12];
+        for (int x = x0; x < x1; x++) {
+            for (int y = 0; y < num_cubes; y++) {
+                for (int z = 0; z < num_cubes; z++) {
+                    if (!occupancy_.IsActive(x, y, z)) {
+                        z += kBlockSize - 1 - z % kBlockSize;
+                        continue;
+                    }
+                    int cube_index = 0;
+                    float f[8];
+                    Eigen::Vector3d c[8];
+                    for (int i = 0; i < 8; i++) {
+                        const geometry::TSDFVoxel &voxel =
+                                volume_.voxels_[volume_.IndexOf(
+                                        x + shift[i](0), y + shift[i](1),
+                                        z + shift[i](2))];
+                        if (voxel.weight_ == 0.0f) {
+                            cube_index = 0;
+                            break;
+                        } else {
+                            f[i] = voxel.tsdf_;
+                            if (f[i] < 0.0f) {
+                                cube_index |= (1 << i);
+                            }
+                            if (color_type == TSDFVolumeColorType::RGB8) {
+                                c[i] = voxel.color_.cast<double>() / 255.0;
+                            } else if (color_type ==
+                                       TSDFVolumeColorType::Gray32) {
+                                c[i] = voxel.color_.cast<double>();
+                            }
+                        }
+                    }
+                    if (cube_index == 0 || cube_index == 255) {
+                        continue;
+                    }
+                    for (int i = 0; i < 12; i++) {
+                        if (!(edge_table[cube_index] & (1 << i))) {
+                            continue;
+                        }
+                        const Eigen::Vector4i edge_index =
+                                Eigen::Vector4i(x, y, z, 0) + edge_shift[i];
+                        const int plane_index =
+                                (edge_index(1) * resolution + edge_index(2)) *
+                                        3 +
+                                edge_index(3);
+                        const bool on_plane0 = edge_index(0) == x;
+                        int &vertex_index = on_plane0 ? plane0_[plane_index]
+                                                      : plane1_[plane_index];
+                        if (vertex_index < 0) {
+                            vertex_index = (int)slab.vertices_.size();
+                            (on_plane0 ? touched0_ : touched1_)
+                                    .push_back(plane_index);
+                            if (on_plane0 && x == x0 && edge_index(3) != 0) {
+                                slab.first_plane_.emplace_back(plane_index,
+                                                               vertex_index);
+                            }
+                            Eigen::Vector3d pt(
+                                    half_voxel_length +
+                                            voxel_length * edge_index(0),
+                                    half_voxel_length +
+                                            voxel_length * edge_index(1),
+                                    half_voxel_length +
+                                            voxel_length * edge_index(2));
+                            double f0 = std::abs((double)f[edge_to_vert[i][0]]);
+                            double f1 = std::abs((double)f[edge_to_vert[i][1]]);
+                            pt(edge_index(3)) += f0 * voxel_length / (f0 + f1);
+                            slab.vertices_.push_back(pt + volume_.origin_);
+                            if (color_type != TSDFVolumeColorType::None) {
+                                const auto &c0 = c[edge_to_vert[i][0]];
+                                const auto &c1 = c[edge_to_vert[i][1]];
+                                slab.vertex_colors_.push_back(
+                                        (f1 * c0 + f0 * c1) / (f0 + f1));
+                            }
+                        }
+                        edge_to_index[i] = vertex_index;
+                    }
+                    for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
+                        slab.triangles_.push_back(Eigen::Vector3i(
+                                edge_to_index[tri_table[cube_index][i]],
+                                edge_to_index[tri_table[cube_index][i + 2]],
+                                edge_to_index[tri_table[cube_index][i + 1]]));
+                    }
+                }
+            }
+            // Advance the caches by one plane.
+            for (int plane_index : touched0_) {
+                plane0_[plane_index] = -1;
+            }
+            touched0_.clear();
+            std::swap(plane0_, plane1_);
+            std::swap(touched0_, touched1_);
+        }
+        for (int plane_index : touched0_) {
+            slab.last_plane_.emplace_back(plane_index, plane0_[plane_index]);
+            plane0_[plane_index] = -1;
+        }
+        touched0_.clear();
+        std::sort(slab.first_plane_.begin(), slab.first_plane_.end());
+        std::sort(slab.last_plane_.begin(), slab.last_plane_.end());
+    }
+
+private:
+    const UniformTSDFVolume &volume_;
+    const OccupancyGrid &occupancy_;
+    /// Edge caches of the planes x and x + 1, indexed by
+    /// (y * resolution + z) * 3 + direction, and their set entries.
+    std::vector<int> plane0_, plane1_;
+    std::vector<int> touched0_, touched1_;
+};
+
+}  // unnamed namespace
+
 UniformTSDFVolume::UniformTSDFVolume(
         double length,
         int resolution,
@@ -59,6 +279,10 @@ void UniformTSDFVolume::Integrate(
         const geometry::RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic) {
+    OPEN3D_PROFILE_ZONE("UniformTSDFVolume::Integrate");
+    OPEN3D_PROFILE_POINTS(image.depth_.width_ * image.depth_.height_);
+    OPEN3D_PROFILE_BYTES(image.depth_.data_.size() +
+                         image.color_.data_.size());
     // This function goes through the voxels, and scan convert the relative
     // depth/color value into the voxel.
     // The following implementation is a highly optimized version.
@@ -82,152 +306,187 @@ void UniformTSDFVolume::Integrate(
                 "[UniformTSDFVolume::Integrate] Unsupported image format.\n");
         return;
     }
-    auto depth2cameradistance =
-            geometry::Image::CreateDepthToCameraDistanceMultiplierFloatImage(
-                    intrinsic);
-    IntegrateWithDepthToCameraDistanceMultiplier(image, intrinsic, extrinsic,
-                                                 *depth2cameradistance);
+    UpdateIntrinsicCache(intrinsic);
+    IntegrateWithDepthToCameraDistanceMultiplier(
+            image, intrinsic, extrinsic, *depth_to_camera_distance_multiplier_);
 }
 
 std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
+    OPEN3D_PROFILE_ZONE("UniformTSDFVolume::ExtractPointCloud");
     auto pointcloud = std::make_shared<geometry::PointCloud>();
+    if (resolution_ < 3) {
+        return pointcloud;
+    }
     double half_voxel_length = voxel_length_ * 0.5;
-    for (int x = 1; x < resolution_ - 1; x++) {
-        for (int y = 1; y < resolution_ - 1; y++) {
-            for (int z = 1; z < resolution_ - 1; z++) {
-                Eigen::Vector3i idx0(x, y, z);
-                float w0 = voxels_[IndexOf(idx0)].weight_;
-                float f0 = voxels_[IndexOf(idx0)].tsdf_;
-                const Eigen::Vector3d &c0 = voxels_[IndexOf(idx0)].color_;
-
-                if (!(w0 != 0.0f && f0 < 0.98f && f0 >= -0.98f)) {
-                    continue;
-                }
-                Eigen::Vector3d p0(half_voxel_length + voxel_length_ * x,
-                                   half_voxel_length + voxel_length_ * y,
-                                   half_voxel_length + voxel_length_ * z);
-                for (int i = 0; i < 3; i++) {
-                    Eigen::Vector3d p1 = p0;
-                    p1(i) += voxel_length_;
-                    Eigen::Vector3i idx1 = idx0;
-                    idx1(i) += 1;
-                    if (idx1(i) < resolution_ - 1) {
-                        float w1 = voxels_[IndexOf(idx1)].weight_;
-                        float f1 = voxels_[IndexOf(idx1)].tsdf_;
-                        const Eigen::Vector3d &c1 =
-                                voxels_[IndexOf(idx1)].color_;
-                        if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
-                            f0 * f1 < 0) {
-                            float r0 = std::fabs(f0);
-                            float r1 = std::fabs(f1);
-                            Eigen::Vector3d p = p0;
-                            p(i) = (p0(i) * r1 + p1(i) * r0) / (r0 + r1);
-                            pointcloud->points_.push_back(p + origin_);
-                            if (color_type_ == TSDFVolumeColorType::RGB8) {
-                                pointcloud->colors_.push_back(
-                                        ((c0 * r1 + c1 * r0) / (r0 + r1) /
-                                         255.0f)
-                                                .cast<double>());
-                            } else if (color_type_ ==
-                                       TSDFVolumeColorType::Gray32) {
-                                pointcloud->colors_.push_back(
-                                        ((c0 * r1 + c1 * r0) / (r0 + r1))
-                                                .cast<double>());
+    // The x-slabs are processed in parallel and concatenated in order.
+    const int num_slabs = (resolution_ - 2 + kBlockSize - 1) / kBlockSize;
+    const OccupancyGrid occupancy(*this);
+    std::vector<geometry::PointCloud> slabs(num_slabs);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int s = 0; s < num_slabs; s++) {
+        geometry::PointCloud &slab = slabs[s];
+        const int x_begin = 1 + s * kBlockSize;
+        const int x_end = std::min(x_begin + kBlockSize, resolution_ - 1);
+        for (int x = x_begin; x < x_end; x++) {
+            for (int y = 1; y < resolution_ - 1; y++) {
+                for (int z = 1; z < resolution_ - 1; z++) {
+                    if (!occupancy.IsActive(x, y, z)) {
+                        z += kBlockSize - 1 - z % kBlockSize;
+                        continue;
+                    }
+                    Eigen::Vector3i idx0(x, y, z);
+                    float w0 = voxels_[IndexOf(idx0)].weight_;
+                    float f0 = voxels_[IndexOf(idx0)].tsdf_;
+                    const Eigen::Vector3d &c0 = voxels_[IndexOf(idx0)].color_;
+
+                    if (!(w0 != 0.0f && f0 < 0.98f && f0 >= -0.98f)) {
+                        continue;
+                    }
+                    Eigen::Vector3d p0(half_voxel_length + voxel_length_ * x,
+                                       half_voxel_length + voxel_length_ * y,
+                                       half_voxel_length + voxel_length_ * z);
+                    for (int i = 0; i < 3; i++) {
+                        Eigen::Vector3d p1 = p0;
+                        p1(i) += voxel_length_;
+                        Eigen::Vector3i idx1 = idx0;
+                        idx1(i) += 1;
+                        if (idx1(i) < resolution_ - 1) {
+                            float w1 = voxels_[IndexOf(idx1)].weight_;
+                            float f1 = voxels_[IndexOf(idx1)].tsdf_;
+                            const Eigen::Vector3d &c1 =
+                                    voxels_[IndexOf(idx1)].color_;
+                            if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
+                                f0 * f1 < 0) {
+                                float r0 = std::fabs(f0);
+                                float r1 = std::fabs(f1);
+                                Eigen::Vector3d p = p0;
+                                p(i) = (p0(i) * r1 + p1(i) * r0) / (r0 + r1);
+                                slab.points_.push_back(p + origin_);
+                                if (color_type_ == TSDFVolumeColorType::RGB8) {
+                                    slab.colors_.push_back(
+                                            ((c0 * r1 + c1 * r0) / (r0 + r1) /
+                                             255.0f)
+                                                    .cast<double>());
+                                } else if (color_type_ ==
+                                           TSDFVolumeColorType::Gray32) {
+                                    slab.colors_.push_back(
+                                            ((c0 * r1 + c1 * r0) / (r0 + r1))
+                                                    .cast<double>());
+                                }
+                                // has_normal
+                                slab.normals_.push_back(GetNormalAt(p));
                             }
-                            // has_normal
-                            pointcloud->normals_.push_back(GetNormalAt(p));
                         }
                     }
                 }
             }
         }
     }
+    for (const auto &slab : slabs) {
+        pointcloud->points_.insert(pointcloud->points_.end(),
+                                   slab.points_.begin(), slab.points_.end());
+        pointcloud->colors_.insert(pointcloud->colors_.end(),
+                                   slab.colors_.begin(), slab.colors_.end());
+        pointcloud->normals_.insert(pointcloud->normals_.end(),
+                                    slab.normals_.begin(), slab.normals_.end());
+    }
     return pointcloud;
 }
 
 std::shared_ptr<geometry::TriangleMesh>
 UniformTSDFVolume::ExtractTriangleMesh() {
+    OPEN3D_PROFILE_ZONE("UniformTSDFVolume::ExtractTriangleMesh");
     // implementation of marching cubes, based on
     // http://paulbourke.net/geometry/polygonise/
+    // The cubes are processed in x-slabs in parallel. Within a slab, vertices
+    // are shared through two planes of edge caches instead of a global hash
+    // map. Stitching the slabs in order reproduces the vertex order of a
+    // serial x-y-z scan.
     auto mesh = std::make_shared<geometry::TriangleMesh>();
-    double half_voxel_length = voxel_length_ * 0.5;
-    // Map of "edge_index = (x, y, z, 0) + edge_shift" to "global vertex index"
-    std::unordered_map<
-            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
-            std::equal_to<Eigen::Vector4i>,
-            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
-            edgeindex_to_vertexindex;
-    int edge_to_index[12];
-    for (int x = 0; x < resolution_ - 1; x++) {
-        for (int y = 0; y < resolution_ - 1; y++) {
-            for (int z = 0; z < resolution_ - 1; z++) {
-                int cube_index = 0;
-                float f[8];
-                Eigen::Vector3d c[8];
-                for (int i = 0; i < 8; i++) {
-                    Eigen::Vector3i idx = Eigen::Vector3i(x, y, z) + shift[i];
-
-                    if (voxels_[IndexOf(idx)].weight_ == 0.0f) {
-                        cube_index = 0;
-                        break;
-                    } else {
-                        f[i] = voxels_[IndexOf(idx)].tsdf_;
-                        if (f[i] < 0.0f) {
-                            cube_index |= (1 << i);
-                        }
-                        if (color_type_ == TSDFVolumeColorType::RGB8) {
-                            c[i] = voxels_[IndexOf(idx)].color_.cast<double>() /
-                                   255.0;
-                        } else if (color_type_ == TSDFVolumeColorType::Gray32) {
-                            c[i] = voxels_[IndexOf(idx)].color_.cast<double>();
-                        }
-                    }
-                }
-                if (cube_index == 0 || cube_index == 255) {
-                    continue;
-                }
-                for (int i = 0; i < 12; i++) {
-                    if (edge_table[cube_index] & (1 << i)) {
-                        Eigen::Vector4i edge_index =
-                                Eigen::Vector4i(x, y, z, 0) + edge_shift[i];
-                        if (edgeindex_to_vertexindex.find(edge_index) ==
-                            edgeindex_to_vertexindex.end()) {
-                            edge_to_index[i] = (int)mesh->vertices_.size();
-                            edgeindex_to_vertexindex[edge_index] =
-                                    (int)mesh->vertices_.size();
-                            Eigen::Vector3d pt(
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(0),
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(1),
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(2));
-                            double f0 = std::abs((double)f[edge_to_vert[i][0]]);
-                            double f1 = std::abs((double)f[edge_to_vert[i][1]]);
-                            pt(edge_index(3)) += f0 * voxel_length_ / (f0 + f1);
-                            mesh->vertices_.push_back(pt + origin_);
-                            if (color_type_ != TSDFVolumeColorType::None) {
-                                const auto &c0 = c[edge_to_vert[i][0]];
-                                const auto &c1 = c[edge_to_vert[i][1]];
-                                mesh->vertex_colors_.push_back(
-                                        (f1 * c0 + f0 * c1) / (f0 + f1));
-                            }
-                        } else {
-                            edge_to_index[i] =
-                                    edgeindex_to_vertexindex.find(edge_index)
-                                            ->second;
-                        }
-                    }
+    if (resolution_ < 2) {
+        return mesh;
+    }
+    const int num_cubes = resolution_ - 1;
+    const int num_slabs = (num_cubes + kBlockSize - 1) / kBlockSize;
+    const OccupancyGrid occupancy(*this);
+    std::vector<MarchingCubesSlab> slabs(num_slabs);
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        MarchingCubesSlabExtractor extractor(*this, occupancy);
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int s = 0; s < num_slabs; s++) {
+            extractor.Extract(s * kBlockSize,
+                              std::min((s + 1) * kBlockSize, num_cubes),
+                              slabs[s]);
+        }
+#ifdef _OPENMP
+    }  //    omp parallel
+#endif
+
+    // Stitch: a vertex on the first plane of a slab that the previous slab
+    // already created is replaced by the previous one; all other vertices get
+    // consecutive global indices in slab order.
+    std::vector<size_t> vertex_offsets(num_slabs + 1, 0);
+    std::vector<size_t> triangle_offsets(num_slabs + 1, 0);
+    for (int s = 0; s < num_slabs; s++) {
+        MarchingCubesSlab &slab = slabs[s];
+        slab.global_index_.assign(slab.vertices_.size(), -1);
+        if (s > 0) {
+            const MarchingCubesSlab &prev = slabs[s - 1];
+            auto prev_itr = prev.last_plane_.begin();
+            for (const auto &entry : slab.first_plane_) {
+                while (prev_itr != prev.last_plane_.end() &&
+                       prev_itr->first < entry.first) {
+                    prev_itr++;
                 }
-                for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
-                    mesh->triangles_.push_back(Eigen::Vector3i(
-                            edge_to_index[tri_table[cube_index][i]],
-                            edge_to_index[tri_table[cube_index][i + 2]],
-                            edge_to_index[tri_table[cube_index][i + 1]]));
+                if (prev_itr != prev.last_plane_.end() &&
+                    prev_itr->first == entry.first) {
+                    slab.global_index_[entry.second] =
+                            prev.global_index_[prev_itr->second];
                 }
             }
         }
+        int next_index = (int)vertex_offsets[s];
+        for (auto &index : slab.global_index_) {
+            if (index < 0) {
+                index = next_index++;
+            }
+        }
+        vertex_offsets[s + 1] = next_index;
+        triangle_offsets[s + 1] = triangle_offsets[s] + slab.triangles_.size();
+    }
+
+    mesh->vertices_.resize(vertex_offsets[num_slabs]);
+    if (color_type_ != TSDFVolumeColorType::None) {
+        mesh->vertex_colors_.resize(vertex_offsets[num_slabs]);
     }
+    mesh->triangles_.resize(triangle_offsets[num_slabs]);
+    utility::ParallelFor(0, num_slabs, [&](int s) {
+        const MarchingCubesSlab &slab = slabs[s];
+        for (size_t i = 0; i < slab.vertices_.size(); i++) {
+            // Vertices with a smaller global index belong to the previous slab.
+            const int index = slab.global_index_[i];
+            if (index >= (int)vertex_offsets[s]) {
+                mesh->vertices_[index] = slab.vertices_[i];
+                if (color_type_ != TSDFVolumeColorType::None) {
+                    mesh->vertex_colors_[index] = slab.vertex_colors_[i];
+                }
+            }
+        }
+        for (size_t i = 0; i < slab.triangles_.size(); i++) {
+            const Eigen::Vector3i &triangle = slab.triangles_[i];
+            mesh->triangles_[triangle_offsets[s] + i] =
+                    Eigen::Vector3i(slab.global_index_[triangle(0)],
+                                    slab.global_index_[triangle(1)],
+                                    slab.global_index_[triangle(2)]);
+        }
+    });
     return mesh;
 }
 
@@ -300,10 +559,7 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
     const float safe_width_f = intrinsic.width_ - 0.0001f;
     const float safe_height_f = intrinsic.height_ - 0.0001f;
 
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int x = 0; x < resolution_; x++) {
+    utility::ParallelFor(0, resolution_, [&](int x) {
         for (int y = 0; y < resolution_; y++) {
             Eigen::Vector4f pt_3d_homo(float(half_voxel_length_f +
                                              voxel_length_f * x + origin_(0)),
@@ -369,7 +625,7 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
                 }
             }
         }
-    }
+    });
 }
 
 Eigen::Vector3d UniformTSDFVolume::GetNormalAt(const Eigen::Vector3d &p) {
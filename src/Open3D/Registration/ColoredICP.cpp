@@ -29,11 +29,13 @@
 #include <Eigen/Dense>
 #include <iostream>
 
+#include "Open3D/Geometry/FixedRadiusIndex.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/KDTreeSearchParam.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -75,27 +77,21 @@ private:
             TransformationEstimationType::ColoredICP;
 };
 
-std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
-        const geometry::PointCloud &target,
+/// Color gradients from the neighbors found in a KDTreeFlann or a
+/// FixedRadiusIndex.
+template <typename Index>
+void ComputeColorGradients(
+        PointCloudForColoredICP &cloud,
+        const Index &tree,
         const geometry::KDTreeSearchParamHybrid &search_param) {
-    utility::LogDebug("InitializePointCloudForColoredICP\n");
-
-    geometry::KDTreeFlann tree;
-    tree.SetGeometry(target);
-
-    auto output = std::make_shared<PointCloudForColoredICP>();
-    output->colors_ = target.colors_;
-    output->normals_ = target.normals_;
-    output->points_ = target.points_;
-
-    size_t n_points = output->points_.size();
-    output->color_gradient_.resize(n_points, Eigen::Vector3d::Zero());
+    size_t n_points = cloud.points_.size();
+    cloud.color_gradient_.resize(n_points, Eigen::Vector3d::Zero());
 
     for (size_t k = 0; k < n_points; k++) {
-        const Eigen::Vector3d &vt = output->points_[k];
-        const Eigen::Vector3d &nt = output->normals_[k];
-        double it = (output->colors_[k](0) + output->colors_[k](1) +
-                     output->colors_[k](2)) /
+        const Eigen::Vector3d &vt = cloud.points_[k];
+        const Eigen::Vector3d &nt = cloud.normals_[k];
+        double it = (cloud.colors_[k](0) + cloud.colors_[k](1) +
+                     cloud.colors_[k](2)) /
                     3.0;
 
         std::vector<int> point_idx;
@@ -111,11 +107,11 @@ std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
             b.setZero();
             for (size_t i = 1; i < nn; i++) {
                 int P_adj_idx = point_idx[i];
-                Eigen::Vector3d vt_adj = output->points_[P_adj_idx];
+                Eigen::Vector3d vt_adj = cloud.points_[P_adj_idx];
                 Eigen::Vector3d vt_proj = vt_adj - (vt_adj - vt).dot(nt) * nt;
-                double it_adj = (output->colors_[P_adj_idx](0) +
-                                 output->colors_[P_adj_idx](1) +
-                                 output->colors_[P_adj_idx](2)) /
+                double it_adj = (cloud.colors_[P_adj_idx](0) +
+                                 cloud.colors_[P_adj_idx](1) +
+                                 cloud.colors_[P_adj_idx](2)) /
                                 3.0;
                 A(i - 1, 0) = (vt_proj(0) - vt(0));
                 A(i - 1, 1) = (vt_proj(1) - vt(1));
@@ -133,10 +129,31 @@ std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
             std::tie(is_success, x) = utility::SolveLinearSystemPSD(
                     A.transpose() * A, A.transpose() * b);
             if (is_success) {
-                output->color_gradient_[k] = x;
+                cloud.color_gradient_[k] = x;
             }
         }
     }
+}
+
+std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
+        const geometry::PointCloud &target,
+        const geometry::KDTreeSearchParamHybrid &search_param) {
+    utility::LogDebug("InitializePointCloudForColoredICP\n");
+
+    auto output = std::make_shared<PointCloudForColoredICP>();
+    output->colors_ = target.colors_;
+    output->normals_ = target.normals_;
+    output->points_ = target.points_;
+
+    double radius;
+    if (geometry::FixedRadiusIndex::IsSelectedBy(search_param, radius)) {
+        geometry::FixedRadiusIndex index(radius, target);
+        ComputeColorGradients(*output, index, search_param);
+    } else {
+        geometry::KDTreeFlann tree;
+        tree.SetGeometry(target);
+        ComputeColorGradients(*output, tree, search_param);
+    }
     return output;
 }
 
@@ -144,6 +161,8 @@ Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
         const CorrespondenceSet &corres) const {
+    OPEN3D_PROFILE_ZONE("TransformationEstimationForColoredICP");
+    OPEN3D_PROFILE_POINTS(corres.size());
     if (corres.empty() || target.HasNormals() == false ||
         target.HasColors() == false || source.HasColors() == false)
         return Eigen::Matrix4d::Identity();
@@ -255,6 +274,7 @@ RegistrationResult RegistrationColoredICP(
         const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
         const ICPConvergenceCriteria &criteria /* = ICPConvergenceCriteria()*/,
         double lambda_geometric /* = 0.968*/) {
+    OPEN3D_PROFILE_ZONE("RegistrationColoredICP");
     auto target_c = InitializePointCloudForColoredICP(
             target, geometry::KDTreeSearchParamHybrid(max_distance * 2.0, 30));
     return RegistrationICP(
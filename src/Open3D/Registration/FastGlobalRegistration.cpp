@@ -31,9 +31,11 @@
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/FeatureIndex.h"
 #include "Open3D/Registration/Registration.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
@@ -59,26 +61,58 @@ std::vector<std::pair<int, int>> AdvancedMatching(
     // STEP 1) Initial matching
     int nPti = int(point_cloud_vec[fi].points_.size());
     int nPtj = int(point_cloud_vec[fj].points_.size());
-    geometry::KDTreeFlann feature_tree_i(features_vec[fi]);
-    geometry::KDTreeFlann feature_tree_j(features_vec[fj]);
     std::vector<int> corresK;
     std::vector<double> dis;
     std::vector<std::pair<int, int>> corres;
     std::vector<std::pair<int, int>> corres_ij;
     std::vector<std::pair<int, int>> corres_ji;
     std::vector<int> i_to_j(nPti, -1);
-    for (int j = 0; j < nPtj; j++) {
-        feature_tree_i.SearchKNN(Eigen::VectorXd(features_vec[fj].data_.col(j)),
-                                 1, corresK, dis);
-        int i = corresK[0];
-        if (i_to_j[i] == -1) {
-            feature_tree_j.SearchKNN(
-                    Eigen::VectorXd(features_vec[fi].data_.col(i)), 1, corresK,
-                    dis);
-            int ij = corresK[0];
-            i_to_j[i] = ij;
+    if (option.maximum_feature_checks_ > 0) {
+        FeatureIndexOption index_option(1, option.maximum_feature_checks_);
+        FeatureIndex feature_index_i(features_vec[fi], index_option);
+        FeatureIndex feature_index_j(features_vec[fj], index_option);
+        Eigen::MatrixXi nn_indices;
+        Eigen::MatrixXd nn_distance2;
+        feature_index_i.SearchKNN(features_vec[fj], 1, nn_indices,
+                                  nn_distance2);
+        std::vector<int> matched_i;
+        for (int j = 0; j < nPtj; j++) {
+            int i = nn_indices(0, j);
+            if (i_to_j[i] == -1) {
+                i_to_j[i] = 0;
+                matched_i.push_back(i);
+            }
+            corres_ji.push_back(std::pair<int, int>(i, j));
+        }
+        Feature matched_feature;
+        matched_feature.Resize(int(features_vec[fi].Dimension()),
+                               int(matched_i.size()));
+        for (size_t k = 0; k < matched_i.size(); k++) {
+            matched_feature.data_.col(k) =
+                    features_vec[fi].data_.col(matched_i[k]);
+        }
+        feature_index_j.SearchKNN(matched_feature, 1, nn_indices,
+                                  nn_distance2);
+        for (size_t k = 0; k < matched_i.size(); k++) {
+            i_to_j[matched_i[k]] = nn_indices(0, k);
+        }
+    } else {
+        geometry::KDTreeFlann feature_tree_i(features_vec[fi]);
+        geometry::KDTreeFlann feature_tree_j(features_vec[fj]);
+        for (int j = 0; j < nPtj; j++) {
+            feature_tree_i.SearchKNN(
+                    Eigen::VectorXd(features_vec[fj].data_.col(j)), 1,
+                    corresK, dis);
+            int i = corresK[0];
+            if (i_to_j[i] == -1) {
+                feature_tree_j.SearchKNN(
+                        Eigen::VectorXd(features_vec[fi].data_.col(i)), 1,
+                        corresK, dis);
+                int ij = corresK[0];
+                i_to_j[i] = ij;
+            }
+            corres_ji.push_back(std::pair<int, int>(i, j));
         }
-        corres_ji.push_back(std::pair<int, int>(i, j));
     }
     for (int i = 0; i < nPti; i++) {
         if (i_to_j[i] != -1)
@@ -343,6 +377,7 @@ RegistrationResult FastGlobalRegistration(
         const Feature& target_feature,
         const FastGlobalRegistrationOption& option /* =
         FastGlobalRegistrationOption()*/) {
+    OPEN3D_PROFILE_ZONE("FastGlobalRegistration");
     std::vector<geometry::PointCloud> point_cloud_vec;
     point_cloud_vec.push_back(source);
     point_cloud_vec.push_back(target);
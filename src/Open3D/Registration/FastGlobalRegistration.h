@@ -50,14 +50,16 @@ public:
                                  double maximum_correspondence_distance = 0.025,
                                  int iteration_number = 64,
                                  double tuple_scale = 0.95,
-                                 int maximum_tuple_count = 1000)
+                                 int maximum_tuple_count = 1000,
+                                 int maximum_feature_checks = -1)
         : division_factor_(division_factor),
           use_absolute_scale_(use_absolute_scale),
           decrease_mu_(decrease_mu),
           maximum_correspondence_distance_(maximum_correspondence_distance),
           iteration_number_(iteration_number),
           tuple_scale_(tuple_scale),
-          maximum_tuple_count_(maximum_tuple_count) {}
+          maximum_tuple_count_(maximum_tuple_count),
+          maximum_feature_checks_(maximum_feature_checks) {}
     ~FastGlobalRegistrationOption() {}
 
 public:
@@ -75,6 +77,9 @@ public:
     double tuple_scale_;
     // Maximum tuple numbers.
     int maximum_tuple_count_;
+    // Match features with an approximate FeatureIndex comparing this many
+    // features per query, or exactly if it is not positive.
+    int maximum_feature_checks_;
 };
 
 RegistrationResult FastGlobalRegistration(
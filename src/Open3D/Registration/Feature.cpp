@@ -28,9 +28,11 @@
 
 #include <Eigen/Dense>
 
+#include "Open3D/Geometry/FixedRadiusIndex.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace open3d {
 
@@ -71,16 +73,14 @@ Eigen::Vector4d ComputePairFeatures(const Eigen::Vector3d &p1,
     return result;
 }
 
+template <typename Index>
 std::shared_ptr<Feature> ComputeSPFHFeature(
         const geometry::PointCloud &input,
-        const geometry::KDTreeFlann &kdtree,
+        const Index &kdtree,
         const geometry::KDTreeSearchParam &search_param) {
     auto feature = std::make_shared<Feature>();
     feature->Resize(33, (int)input.points_.size());
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)input.points_.size(); i++) {
+    utility::ParallelFor(0, (int)input.points_.size(), [&](int i) {
         const auto &point = input.points_[i];
         const auto &normal = input.normals_[i];
         std::vector<int> indices;
@@ -107,31 +107,20 @@ std::shared_ptr<Feature> ComputeSPFHFeature(
                 feature->data_(h_index + 22, i) += hist_incr;
             }
         }
-    }
+    });
     return feature;
 }
 
-}  // unnamed namespace
-
-namespace registration {
-std::shared_ptr<Feature> ComputeFPFHFeature(
+/// Accumulates the FPFH features of input into feature from the SPFH
+/// features of the neighbors found in a KDTreeFlann or a FixedRadiusIndex.
+template <typename Index>
+void ComputeFPFHFeatureWithIndex(
         const geometry::PointCloud &input,
-        const geometry::KDTreeSearchParam
-                &search_param /* = geometry::KDTreeSearchParamKNN()*/) {
-    auto feature = std::make_shared<Feature>();
-    feature->Resize(33, (int)input.points_.size());
-    if (input.HasNormals() == false) {
-        utility::LogWarning(
-                "[ComputeFPFHFeature] Failed because input point cloud has no "
-                "normal.\n");
-        return feature;
-    }
-    geometry::KDTreeFlann kdtree(input);
+        const Index &kdtree,
+        const geometry::KDTreeSearchParam &search_param,
+        Feature &feature) {
     auto spfh = ComputeSPFHFeature(input, kdtree, search_param);
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < (int)input.points_.size(); i++) {
+    utility::ParallelFor(0, (int)input.points_.size(), [&](int i) {
         const auto &point = input.points_[i];
         std::vector<int> indices;
         std::vector<double> distance2;
@@ -144,21 +133,46 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
                 for (int j = 0; j < 33; j++) {
                     double val = spfh->data_(j, indices[k]) / dist;
                     sum[j / 11] += val;
-                    feature->data_(j, i) += val;
+                    feature.data_(j, i) += val;
                 }
             }
             for (int j = 0; j < 3; j++)
                 if (sum[j] != 0.0) sum[j] = 100.0 / sum[j];
             for (int j = 0; j < 33; j++) {
-                feature->data_(j, i) *= sum[j / 11];
+                feature.data_(j, i) *= sum[j / 11];
                 // The commented line is the fpfh function in the paper.
                 // But according to PCL implementation, it is skipped.
                 // Our initial test shows that the full fpfh function in the
                 // paper seems to be better than PCL implementation. Further
                 // test required.
-                feature->data_(j, i) += spfh->data_(j, i);
+                feature.data_(j, i) += spfh->data_(j, i);
             }
         }
+    });
+}
+
+}  // unnamed namespace
+
+namespace registration {
+std::shared_ptr<Feature> ComputeFPFHFeature(
+        const geometry::PointCloud &input,
+        const geometry::KDTreeSearchParam
+                &search_param /* = geometry::KDTreeSearchParamKNN()*/) {
+    auto feature = std::make_shared<Feature>();
+    feature->Resize(33, (int)input.points_.size());
+    if (input.HasNormals() == false) {
+        utility::LogWarning(
+                "[ComputeFPFHFeature] Failed because input point cloud has no "
+                "normal.\n");
+        return feature;
+    }
+    double radius;
+    if (geometry::FixedRadiusIndex::IsSelectedBy(search_param, radius)) {
+        geometry::FixedRadiusIndex index(radius, input);
+        ComputeFPFHFeatureWithIndex(input, index, search_param, *feature);
+    } else {
+        geometry::KDTreeFlann kdtree(input);
+        ComputeFPFHFeatureWithIndex(input, kdtree, search_param, *feature);
     }
     return feature;
 }
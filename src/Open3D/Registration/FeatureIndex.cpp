@@ -0,0 +1,399 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Registration/FeatureIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
+#include "Open3D/Utility/Timer.h"
+
+namespace open3d {
+
+namespace {
+
+const int kLeafSize = 8;
+/// Number of features sampled to choose the split of a node.
+const int kSampleSize = 100;
+/// Number of dimensions of largest variance among which a split is drawn.
+const int kSplitCandidates = 5;
+
+}  // unnamed namespace
+
+namespace registration {
+
+FeatureIndex::FeatureIndex(const FeatureIndexOption &option)
+    : option_(option) {}
+
+FeatureIndex::FeatureIndex(const Feature &feature,
+                           const FeatureIndexOption &option)
+    : option_(option) {
+    SetFeature(feature);
+}
+
+FeatureIndex::~FeatureIndex() {}
+
+bool FeatureIndex::SetFeature(const Feature &feature) {
+    trees_.clear();
+    feature_indices_.clear();
+    dimension_ = int(feature.Dimension());
+    num_features_ = int(feature.Num());
+    if (dimension_ == 0 || num_features_ == 0) {
+        utility::LogWarning(
+                "[FeatureIndex::SetFeature] Failed due to no data.\n");
+        return false;
+    }
+    padded_dimension_ = (dimension_ + 7) / 8 * 8;
+    data_.assign(size_t(num_features_) * padded_dimension_, 0.0f);
+    utility::ParallelFor(0, num_features_, [&](int i) {
+        for (int d = 0; d < dimension_; d++) {
+            data_[size_t(i) * padded_dimension_ + d] =
+                    float(feature.data_(d, i));
+        }
+    });
+
+    trees_.resize(std::max(option_.num_trees_, 1));
+    // There are few trees, so the ranges hold one or two trees each.
+    utility::ParallelForRange(0, int(trees_.size()), [&](int begin, int end) {
+        for (int t = begin; t < end; t++) {
+            Tree &tree = trees_[t];
+            std::mt19937 rng(t);
+            tree.indices_.resize(num_features_);
+            std::iota(tree.indices_.begin(), tree.indices_.end(), 0);
+            std::shuffle(tree.indices_.begin(), tree.indices_.end(), rng);
+            tree.nodes_.reserve(2 * num_features_ / kLeafSize + 1);
+            BuildNode(tree, 0, num_features_, rng);
+        }
+    });
+
+    // Store the features in the leaf order of the first tree and let the
+    // trees refer to slots of data_.
+    feature_indices_ = trees_[0].indices_;
+    std::vector<int> slots(num_features_);
+    std::vector<float> data(data_.size());
+    utility::ParallelFor(0, num_features_, [&](int i) {
+        slots[feature_indices_[i]] = i;
+        std::copy_n(&data_[size_t(feature_indices_[i]) * padded_dimension_],
+                    padded_dimension_, &data[size_t(i) * padded_dimension_]);
+    });
+    data_.swap(data);
+    for (auto &tree : trees_) {
+        for (auto &index : tree.indices_) {
+            index = slots[index];
+        }
+    }
+    return true;
+}
+
+int FeatureIndex::BuildNode(Tree &tree,
+                            int begin,
+                            int end,
+                            std::mt19937 &rng) const {
+    int node_id = int(tree.nodes_.size());
+    tree.nodes_.push_back(Node{-1, 0.0f, begin, end});
+    if (end - begin <= kLeafSize) {
+        return node_id;
+    }
+
+    // The features are shuffled, so the first ones of a node are a sample.
+    int sample_end = std::min(end, begin + kSampleSize);
+    std::vector<double> mean(dimension_, 0.0);
+    std::vector<double> variance(dimension_, 0.0);
+    for (int i = begin; i < sample_end; i++) {
+        const float *feature = &data_[size_t(tree.indices_[i]) *
+                                      padded_dimension_];
+        for (int d = 0; d < dimension_; d++) {
+            mean[d] += feature[d];
+        }
+    }
+    for (int d = 0; d < dimension_; d++) {
+        mean[d] /= double(sample_end - begin);
+    }
+    for (int i = begin; i < sample_end; i++) {
+        const float *feature = &data_[size_t(tree.indices_[i]) *
+                                      padded_dimension_];
+        for (int d = 0; d < dimension_; d++) {
+            variance[d] += (feature[d] - mean[d]) * (feature[d] - mean[d]);
+        }
+    }
+    std::vector<int> dims(dimension_);
+    std::iota(dims.begin(), dims.end(), 0);
+    int num_candidates = std::min(kSplitCandidates, dimension_);
+    std::partial_sort(dims.begin(), dims.begin() + num_candidates, dims.end(),
+                      [&](int a, int b) { return variance[a] > variance[b]; });
+    int dim = dims[rng() % num_candidates];
+
+    float value = float(mean[dim]);
+    auto coordinate = [&](int index) {
+        return data_[size_t(index) * padded_dimension_ + dim];
+    };
+    int mid = int(std::partition(tree.indices_.begin() + begin,
+                                 tree.indices_.begin() + end,
+                                 [&](int index) {
+                                     return coordinate(index) < value;
+                                 }) -
+                  tree.indices_.begin());
+    if (mid == begin || mid == end) {
+        // The mean does not separate the features, split them in halves.
+        mid = begin + (end - begin) / 2;
+        std::nth_element(tree.indices_.begin() + begin,
+                         tree.indices_.begin() + mid,
+                         tree.indices_.begin() + end, [&](int a, int b) {
+                             return coordinate(a) < coordinate(b);
+                         });
+        value = coordinate(tree.indices_[mid]);
+    }
+    int left = BuildNode(tree, begin, mid, rng);
+    int right = BuildNode(tree, mid, end, rng);
+    tree.nodes_[node_id] = Node{dim, value, left, right};
+    return node_id;
+}
+
+float FeatureIndex::Distance2(const float *a, const float *b) const {
+    // Eight partial sums let the compiler vectorize the loop.
+    float sum[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    for (int d = 0; d < padded_dimension_; d += 8) {
+        for (int k = 0; k < 8; k++) {
+            const float diff = a[d + k] - b[d + k];
+            sum[k] += diff * diff;
+        }
+    }
+    return ((sum[0] + sum[1]) + (sum[2] + sum[3])) +
+           ((sum[4] + sum[5]) + (sum[6] + sum[7]));
+}
+
+void FeatureIndex::Descend(int tree_id,
+                           int node_id,
+                           float bound,
+                           int knn,
+                           int &size,
+                           int &checks,
+                           SearchBuffer &buffer) const {
+    auto farther = [](const Branch &a, const Branch &b) {
+        return a.bound > b.bound;
+    };
+    const Tree &tree = trees_[tree_id];
+    const float *query = buffer.query_.data();
+    const Node *node = &tree.nodes_[node_id];
+    while (node->dim >= 0) {
+        const float diff = query[node->dim] - node->value;
+        const float far_bound = bound + diff * diff;
+        if (size < knn || far_bound < buffer.distance2_[knn - 1]) {
+            buffer.branches_.push_back(Branch{
+                    far_bound, tree_id, diff < 0 ? node->right : node->left});
+            std::push_heap(buffer.branches_.begin(), buffer.branches_.end(),
+                           farther);
+        }
+        node = &tree.nodes_[diff < 0 ? node->left : node->right];
+    }
+
+    for (int i = node->left; i < node->right; i++) {
+        const int index = tree.indices_[i];
+        const float dist2 =
+                Distance2(query, &data_[size_t(index) * padded_dimension_]);
+        checks++;
+        if (size == knn && !(dist2 < buffer.distance2_[knn - 1])) {
+            continue;
+        }
+        // Other trees may have found the same feature.
+        if (std::find(buffer.indices_.begin(), buffer.indices_.begin() + size,
+                      index) != buffer.indices_.begin() + size) {
+            continue;
+        }
+        int j = size < knn ? size++ : knn - 1;
+        for (; j > 0 && buffer.distance2_[j - 1] > dist2; j--) {
+            buffer.distance2_[j] = buffer.distance2_[j - 1];
+            buffer.indices_[j] = buffer.indices_[j - 1];
+        }
+        buffer.distance2_[j] = dist2;
+        buffer.indices_[j] = index;
+    }
+}
+
+int FeatureIndex::Search(int knn, SearchBuffer &buffer) const {
+    auto farther = [](const Branch &a, const Branch &b) {
+        return a.bound > b.bound;
+    };
+    buffer.branches_.clear();
+    buffer.distance2_.resize(knn);
+    buffer.indices_.resize(knn);
+    if (knn == 0) {
+        return 0;
+    }
+    int size = 0;
+    int checks = 0;
+    for (int t = 0; t < int(trees_.size()); t++) {
+        Descend(t, 0, 0.0f, knn, size, checks, buffer);
+    }
+    while (!buffer.branches_.empty() && checks < option_.max_checks_) {
+        std::pop_heap(buffer.branches_.begin(), buffer.branches_.end(),
+                      farther);
+        Branch branch = buffer.branches_.back();
+        buffer.branches_.pop_back();
+        if (size == knn && branch.bound >= buffer.distance2_[knn - 1]) {
+            break;
+        }
+        Descend(branch.tree, branch.node, branch.bound, knn, size, checks,
+                buffer);
+    }
+    return size;
+}
+
+int FeatureIndex::SearchKNN(const Eigen::VectorXd &query,
+                            int knn,
+                            std::vector<int> &indices,
+                            std::vector<double> &distance2) const {
+    if (trees_.empty() || int(query.rows()) != dimension_ || knn < 0) {
+        return -1;
+    }
+    SearchBuffer buffer;
+    buffer.query_.assign(padded_dimension_, 0.0f);
+    for (int d = 0; d < dimension_; d++) {
+        buffer.query_[d] = float(query(d));
+    }
+    int k = Search(knn, buffer);
+    indices.resize(k);
+    for (int j = 0; j < k; j++) {
+        indices[j] = feature_indices_[buffer.indices_[j]];
+    }
+    distance2.assign(buffer.distance2_.begin(),
+                     buffer.distance2_.begin() + k);
+    return k;
+}
+
+void FeatureIndex::SearchKNN(const Feature &query,
+                             int knn,
+                             Eigen::MatrixXi &indices,
+                             Eigen::MatrixXd &distance2) const {
+    if (trees_.empty() || int(query.Dimension()) != dimension_ || knn < 0) {
+        utility::LogWarning(
+                "[FeatureIndex::SearchKNN] Failed due to no index or "
+                "mismatching dimension.\n");
+        indices.resize(0, 0);
+        distance2.resize(0, 0);
+        return;
+    }
+    int num_queries = int(query.Num());
+    indices.setConstant(knn, num_queries, -1);
+    distance2.setConstant(knn, num_queries,
+                          std::numeric_limits<double>::infinity());
+    utility::ParallelForRange(0, num_queries, [&](int begin, int end) {
+        SearchBuffer buffer;
+        buffer.query_.assign(padded_dimension_, 0.0f);
+        for (int i = begin; i < end; i++) {
+            for (int d = 0; d < dimension_; d++) {
+                buffer.query_[d] = float(query.data_(d, i));
+            }
+            int k = Search(knn, buffer);
+            for (int j = 0; j < k; j++) {
+                indices(j, i) = feature_indices_[buffer.indices_[j]];
+                distance2(j, i) = buffer.distance2_[j];
+            }
+        }
+    });
+}
+
+std::vector<FeatureIndexEvaluation> EvaluateFeatureIndex(
+        const Feature &feature,
+        const Feature &query_feature,
+        const std::vector<FeatureIndexOption> &options,
+        int knn /* = 1*/) {
+    std::vector<FeatureIndexEvaluation> evaluations;
+    if (feature.Num() == 0 || query_feature.Num() == 0 ||
+        feature.Dimension() != query_feature.Dimension() || knn <= 0) {
+        utility::LogWarning(
+                "[EvaluateFeatureIndex] Failed due to no data or mismatching "
+                "dimension.\n");
+        return evaluations;
+    }
+    int num_queries = int(query_feature.Num());
+
+    utility::Timer timer;
+    geometry::KDTreeFlann kdtree(feature);
+    Eigen::MatrixXi exact_indices;
+    exact_indices.setConstant(knn, num_queries, -1);
+    timer.Start();
+    utility::ParallelFor(0, num_queries, [&](int i) {
+        std::vector<int> indices;
+        std::vector<double> distance2;
+        int k = kdtree.SearchKNN(Eigen::VectorXd(query_feature.data_.col(i)),
+                                 knn, indices, distance2);
+        for (int j = 0; j < k; j++) {
+            exact_indices(j, i) = indices[j];
+        }
+    });
+    timer.Stop();
+    double exact_query_time = timer.GetDuration();
+
+    for (const auto &option : options) {
+        FeatureIndexEvaluation evaluation(option);
+        evaluation.exact_query_time_ = exact_query_time;
+        timer.Start();
+        FeatureIndex index(feature, option);
+        timer.Stop();
+        evaluation.build_time_ = timer.GetDuration();
+
+        Eigen::MatrixXi indices;
+        Eigen::MatrixXd distance2;
+        timer.Start();
+        index.SearchKNN(query_feature, knn, indices, distance2);
+        timer.Stop();
+        evaluation.query_time_ = timer.GetDuration();
+
+        size_t num_exact = 0;
+        size_t num_found = 0;
+        for (int i = 0; i < num_queries; i++) {
+            for (int j = 0; j < knn && exact_indices(j, i) >= 0; j++) {
+                num_exact++;
+                for (int k = 0; k < knn; k++) {
+                    if (indices(k, i) == exact_indices(j, i)) {
+                        num_found++;
+                        break;
+                    }
+                }
+            }
+        }
+        evaluation.recall_ =
+                num_exact == 0 ? 1.0 : double(num_found) / double(num_exact);
+        utility::LogInfo(
+                "[EvaluateFeatureIndex] {:d} trees, {:d} checks: recall "
+                "{:.4f}, build {:.1f} ms, query {:.1f} ms, exact query {:.1f} "
+                "ms.\n",
+                option.num_trees_, option.max_checks_, evaluation.recall_,
+                evaluation.build_time_, evaluation.query_time_,
+                evaluation.exact_query_time_);
+        evaluations.push_back(evaluation);
+    }
+    return evaluations;
+}
+
+}  // namespace registration
+}  // namespace open3d
@@ -0,0 +1,171 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <random>
+#include <vector>
+
+namespace open3d {
+namespace registration {
+
+class Feature;
+
+/// Options of a FeatureIndex.
+class FeatureIndexOption {
+public:
+    FeatureIndexOption(int num_trees = 1, int max_checks = 128)
+        : num_trees_(num_trees), max_checks_(max_checks) {}
+    ~FeatureIndexOption() {}
+
+public:
+    /// Number of randomized KD-trees. More trees raise the recall at a given
+    /// number of checks, but each tree is descended by every query.
+    int num_trees_;
+    /// Number of features compared to a query, more checks give a higher
+    /// recall.
+    int max_checks_;
+};
+
+/// Approximate nearest neighbor search over features with a forest of
+/// randomized KD-trees.
+///
+/// Each tree splits at the mean of a dimension drawn among the five of largest
+/// variance, and the trees are built in parallel. A query descends every tree,
+/// then visits the closest remaining branches of all the trees until
+/// max_checks_ features are compared. The features are stored as float and
+/// padded to a multiple of 8 dimensions, so that the distances vectorize, and
+/// in the leaf order of the first tree, so that its leaves are contiguous.
+class FeatureIndex {
+public:
+    FeatureIndex(const FeatureIndexOption &option = FeatureIndexOption());
+    FeatureIndex(const Feature &feature,
+                 const FeatureIndexOption &option = FeatureIndexOption());
+    ~FeatureIndex();
+    FeatureIndex(const FeatureIndex &) = delete;
+    FeatureIndex &operator=(const FeatureIndex &) = delete;
+
+public:
+    bool SetFeature(const Feature &feature);
+
+    /// Searches the knn nearest features of query.
+    int SearchKNN(const Eigen::VectorXd &query,
+                  int knn,
+                  std::vector<int> &indices,
+                  std::vector<double> &distance2) const;
+
+    /// Searches the knn nearest features of every query feature in parallel.
+    /// Column i of indices and distance2 holds the neighbors of query i,
+    /// padded with -1 if the index has fewer than knn features.
+    void SearchKNN(const Feature &query,
+                   int knn,
+                   Eigen::MatrixXi &indices,
+                   Eigen::MatrixXd &distance2) const;
+
+private:
+    struct Node {
+        /// Split dimension, or -1 for a leaf.
+        int dim;
+        float value;
+        /// Children, or the range of a leaf in the indices of its tree.
+        int left;
+        int right;
+    };
+
+    struct Tree {
+        std::vector<Node> nodes_;
+        std::vector<int> indices_;
+    };
+
+    struct Branch {
+        float bound;
+        int tree;
+        int node;
+    };
+
+    /// Per query buffers, reused across the queries of a batch.
+    struct SearchBuffer {
+        std::vector<float> query_;
+        std::vector<Branch> branches_;
+        std::vector<float> distance2_;
+        std::vector<int> indices_;
+    };
+
+    int BuildNode(Tree &tree, int begin, int end, std::mt19937 &rng) const;
+    float Distance2(const float *a, const float *b) const;
+    /// Searches the query in buffer, and leaves the neighbors sorted in
+    /// buffer. Returns their number.
+    int Search(int knn, SearchBuffer &buffer) const;
+    /// Descends from node to a leaf, queuing the other branches.
+    void Descend(int tree_id,
+                 int node_id,
+                 float bound,
+                 int knn,
+                 int &size,
+                 int &checks,
+                 SearchBuffer &buffer) const;
+
+protected:
+    FeatureIndexOption option_;
+    int dimension_ = 0;
+    int padded_dimension_ = 0;
+    int num_features_ = 0;
+    /// Slot i is [i * padded_dimension_, (i + 1) * padded_dimension_).
+    std::vector<float> data_;
+    /// Index in the input Feature of each slot of data_.
+    std::vector<int> feature_indices_;
+    std::vector<Tree> trees_;
+};
+
+/// Recall and speed of a FeatureIndex option.
+class FeatureIndexEvaluation {
+public:
+    FeatureIndexEvaluation(const FeatureIndexOption &option)
+        : option_(option) {}
+    ~FeatureIndexEvaluation() {}
+
+public:
+    FeatureIndexOption option_;
+    /// Times in milliseconds.
+    double build_time_ = 0.0;
+    double query_time_ = 0.0;
+    /// Time of the exact search with KDTreeFlann.
+    double exact_query_time_ = 0.0;
+    /// Fraction of the exact knn nearest neighbors that are found.
+    double recall_ = 0.0;
+};
+
+/// Function to measure the recall and the speed of FeatureIndex options on the
+/// queries of query_feature, to tune the options.
+std::vector<FeatureIndexEvaluation> EvaluateFeatureIndex(
+        const Feature &feature,
+        const Feature &query_feature,
+        const std::vector<FeatureIndexOption> &options,
+        int knn = 1);
+
+}  // namespace registration
+}  // namespace open3d
@@ -0,0 +1,199 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Registration/GeneralizedICP.h"
+
+#include <Eigen/Dense>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Parallel.h"
+#include "Open3D/Utility/Profiler.h"
+
+namespace open3d {
+
+namespace {
+using namespace registration;
+
+/// Returns W with W^T W = (source_cov + target_cov)^-1, i.e. the inverse of
+/// the Cholesky factor, so that |W r|^2 is the Mahalanobis distance of r.
+Eigen::Matrix3d ComputeWhiteningMatrix(const Eigen::Matrix3d &source_cov,
+                                       const Eigen::Matrix3d &target_cov) {
+    const Eigen::Matrix3d M = source_cov + target_cov;
+    return M.llt().matrixL().solve(Eigen::Matrix3d::Identity());
+}
+
+Eigen::Matrix3d ComputePlaneCovariance(const Eigen::Vector3d &normal,
+                                       double epsilon) {
+    return Eigen::Matrix3d::Identity() -
+           (1.0 - epsilon) * normal * normal.transpose();
+}
+
+}  // unnamed namespace
+
+namespace registration {
+
+double TransformationEstimationForGeneralizedICP::ComputeRMSE(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres) const {
+    if (corres.empty() || !source.HasCovariances() ||
+        !target.HasCovariances())
+        return 0.0;
+    double err = 0.0;
+    for (const auto &c : corres) {
+        const Eigen::Matrix3d W = ComputeWhiteningMatrix(
+                source.covariances_[c[0]], target.covariances_[c[1]]);
+        err += (W * (source.points_[c[0]] - target.points_[c[1]]))
+                       .squaredNorm();
+    }
+    return std::sqrt(err / (double)corres.size());
+}
+
+Eigen::Matrix4d
+TransformationEstimationForGeneralizedICP::ComputeTransformation(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres) const {
+    OPEN3D_PROFILE_ZONE("TransformationEstimationForGeneralizedICP");
+    OPEN3D_PROFILE_POINTS(corres.size());
+    if (corres.empty() || !source.HasCovariances() ||
+        !target.HasCovariances())
+        return Eigen::Matrix4d::Identity();
+
+    auto compute_jacobian_and_residual =
+            [&](int i,
+                std::vector<Eigen::Vector6d, utility::Vector6d_allocator> &J_r,
+                std::vector<double> &r) {
+                size_t cs = corres[i][0];
+                size_t ct = corres[i][1];
+                const Eigen::Vector3d &vs = source.points_[cs];
+                const Eigen::Vector3d &vt = target.points_[ct];
+                const Eigen::Matrix3d W = ComputeWhiteningMatrix(
+                        source.covariances_[cs], target.covariances_[ct]);
+                const Eigen::Vector3d d = W * (vs - vt);
+
+                J_r.resize(3);
+                r.resize(3);
+                for (int k = 0; k < 3; k++) {
+                    const Eigen::Vector3d w = W.row(k).transpose();
+                    J_r[k].block<3, 1>(0, 0) = vs.cross(w);
+                    J_r[k].block<3, 1>(3, 0) = w;
+                    r[k] = d(k);
+                }
+            };
+
+    Eigen::Matrix6d JTJ;
+    Eigen::Vector6d JTr;
+    double r2;
+    std::tie(JTJ, JTr, r2) =
+            utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
+                    compute_jacobian_and_residual, (int)corres.size());
+
+    bool is_success;
+    Eigen::Matrix4d extrinsic;
+    std::tie(is_success, extrinsic) =
+            utility::SolveJacobianSystemAndObtainExtrinsicMatrix(JTJ, JTr);
+
+    return is_success ? extrinsic : Eigen::Matrix4d::Identity();
+}
+
+bool ComputeCovariancesForGeneralizedICP(
+        geometry::PointCloud &cloud,
+        const geometry::KDTreeSearchParam &search_param
+        /* = geometry::KDTreeSearchParamKNN(20)*/,
+        double epsilon /* = 1e-3*/) {
+    OPEN3D_PROFILE_ZONE("ComputeCovariancesForGeneralizedICP");
+    if (!cloud.HasPoints()) return false;
+    cloud.covariances_.resize(cloud.points_.size());
+    if (cloud.HasNormals()) {
+        utility::ParallelFor(0, (int)cloud.points_.size(), [&](int i) {
+            cloud.covariances_[i] = ComputePlaneCovariance(
+                    cloud.normals_[i].normalized(), epsilon);
+        });
+        return true;
+    }
+
+    geometry::KDTreeFlann kdtree;
+    kdtree.SetGeometry(cloud);
+    utility::ParallelFor(0, (int)cloud.points_.size(), [&](int i) {
+        std::vector<int> indices;
+        std::vector<double> distance2;
+        if (kdtree.Search(cloud.points_[i], search_param, indices,
+                          distance2) < 3) {
+            cloud.covariances_[i] = Eigen::Matrix3d::Identity();
+            return;
+        }
+        Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+        for (int idx : indices) {
+            mean += cloud.points_[idx];
+        }
+        mean /= (double)indices.size();
+        Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+        for (int idx : indices) {
+            const Eigen::Vector3d d = cloud.points_[idx] - mean;
+            covariance += d * d.transpose();
+        }
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+        cloud.covariances_[i] =
+                ComputePlaneCovariance(solver.eigenvectors().col(0), epsilon);
+    });
+    return true;
+}
+
+RegistrationResult RegistrationGeneralizedICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const ICPConvergenceCriteria &criteria /* = ICPConvergenceCriteria()*/,
+        double epsilon /* = 1e-3*/) {
+    OPEN3D_PROFILE_ZONE("RegistrationGeneralizedICP");
+    geometry::PointCloud source_g, target_g;
+    const geometry::PointCloud *source_ptr = &source;
+    const geometry::PointCloud *target_ptr = &target;
+    if (!source.HasCovariances()) {
+        source_g = source;
+        ComputeCovariancesForGeneralizedICP(
+                source_g, geometry::KDTreeSearchParamKNN(20), epsilon);
+        source_ptr = &source_g;
+    }
+    if (!target.HasCovariances()) {
+        target_g = target;
+        ComputeCovariancesForGeneralizedICP(
+                target_g, geometry::KDTreeSearchParamKNN(20), epsilon);
+        target_ptr = &target_g;
+    }
+    return RegistrationICP(*source_ptr, *target_ptr,
+                           max_correspondence_distance, init,
+                           TransformationEstimationForGeneralizedICP(),
+                           criteria);
+}
+
+}  // namespace registration
+}  // namespace open3d
@@ -0,0 +1,97 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Registration/Registration.h"
+#include "Open3D/Registration/TransformationEstimation.h"
+
+namespace open3d {
+
+namespace geometry {
+class PointCloud;
+}
+
+namespace registration {
+
+/// Estimate a transformation for the plane to plane distance of Generalized
+/// ICP. Both point clouds must store per-point covariances, see
+/// ComputeCovariancesForGeneralizedICP(). The covariances of the source
+/// follow its transformation between iterations, so they are computed once
+/// and reused across iterations and across registrations sharing a cloud.
+/// This is implementation of following paper
+/// A. Segal, D. Haehnel, S. Thrun,
+/// Generalized-ICP, RSS 2009
+class TransformationEstimationForGeneralizedICP
+    : public TransformationEstimation {
+public:
+    TransformationEstimationForGeneralizedICP() {}
+    ~TransformationEstimationForGeneralizedICP() override {}
+
+public:
+    TransformationEstimationType GetTransformationEstimationType()
+            const override {
+        return type_;
+    };
+    double ComputeRMSE(const geometry::PointCloud &source,
+                       const geometry::PointCloud &target,
+                       const CorrespondenceSet &corres) const override;
+    Eigen::Matrix4d ComputeTransformation(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const CorrespondenceSet &corres) const override;
+
+private:
+    const TransformationEstimationType type_ =
+            TransformationEstimationType::GeneralizedICP;
+};
+
+/// Function to compute the per-point covariances of Generalized ICP and store
+/// them in \param cloud. Each covariance models the local surface as a plane,
+/// with variance \param epsilon along its normal and 1 along the plane. The
+/// normals of \param cloud are used if it has them, otherwise the planes are
+/// fitted to the neighbors found with \param search_param.
+bool ComputeCovariancesForGeneralizedICP(
+        geometry::PointCloud &cloud,
+        const geometry::KDTreeSearchParam &search_param =
+                geometry::KDTreeSearchParamKNN(20),
+        double epsilon = 1e-3);
+
+/// Function to align point clouds with Generalized ICP. Covariances are
+/// computed for the point clouds that do not have them yet.
+RegistrationResult RegistrationGeneralizedICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria(),
+        double epsilon = 1e-3);
+
+}  // namespace registration
+}  // namespace open3d
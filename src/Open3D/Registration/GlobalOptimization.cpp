@@ -28,14 +28,17 @@
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <algorithm>
 #include <tuple>
 #include <vector>
 
 #include "Open3D/Registration/GlobalOptimizationConvergenceCriteria.h"
 #include "Open3D/Registration/GlobalOptimizationMethod.h"
+#include "Open3D/Registration/IncrementalGlobalOptimization.h"
 #include "Open3D/Registration/PoseGraph.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Profiler.h"
 #include "Open3D/Utility/Timer.h"
 
 namespace open3d {
@@ -254,19 +257,40 @@ double ComputeResidual(const PoseGraph &pose_graph,
     return residual;
 }
 
-/// Function to compute residual defined in [Choi et al 2015] See Eq (6).
-Eigen::VectorXd ComputeZeta(const PoseGraph &pose_graph) {
+/// Function to compute residual defined in [Choi et al 2015] See Eq (6),
+/// evaluated at the given node poses.
+Eigen::VectorXd ComputeZeta(
+        const PoseGraph &pose_graph,
+        const std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator>
+                &poses) {
+    int n_nodes = (int)poses.size();
     int n_edges = (int)pose_graph.edges_.size();
+    std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> poses_inv(
+            n_nodes);
+    for (int iter_node = 0; iter_node < n_nodes; iter_node++) {
+        poses_inv[iter_node] = poses[iter_node].inverse();
+    }
     Eigen::VectorXd output(n_edges * 6);
     for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
-        Eigen::Matrix4d X_inv, Ts, Tt_inv;
-        std::tie(X_inv, Ts, Tt_inv) = GetRelativePoses(pose_graph, iter_edge);
-        Eigen::Vector6d e = GetMisalignmentVector(X_inv, Ts, Tt_inv);
-        output.block<6, 1>(iter_edge * 6, 0) = e;
+        const PoseGraphEdge &te = pose_graph.edges_[iter_edge];
+        Eigen::Matrix4d X_inv = te.transformation_.inverse();
+        output.block<6, 1>(iter_edge * 6, 0) =
+                GetMisalignmentVector(X_inv, poses[te.source_node_id_],
+                                      poses_inv[te.target_node_id_]);
     }
     return output;
 }
 
+/// Same as above, evaluated at the poses of the nodes.
+Eigen::VectorXd ComputeZeta(const PoseGraph &pose_graph) {
+    std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> poses(
+            pose_graph.nodes_.size());
+    for (size_t iter_node = 0; iter_node < poses.size(); iter_node++) {
+        poses[iter_node] = pose_graph.nodes_[iter_node].pose_;
+    }
+    return ComputeZeta(pose_graph, poses);
+}
+
 /// The information matrix used here is consistent with [Choi et al 2015].
 /// It is [-p_x | I]^T[-p_x | I]. \zeta is [\alpha \beta \gamma a b c]
 /// Another definition of information matrix used for [Kümmerle et al 2011] is
@@ -414,18 +438,13 @@ bool CheckMaxIterationLM(
     return false;
 }
 
-double ComputeLineProcessWeight(const PoseGraph &pose_graph,
+double ComputeLineProcessWeight(double total_number_of_correspondences,
+                                int n_edges,
                                 const GlobalOptimizationOption &option) {
-    int n_edges = (int)pose_graph.edges_.size();
-    double average_number_of_correspondences = 0.0;
-    for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
-        double number_of_correspondences =
-                pose_graph.edges_[iter_edge].information_(5, 5);
-        average_number_of_correspondences += number_of_correspondences;
-    }
     if (n_edges > 0) {
         // see Section 5 in [Choi et al 2015]
-        average_number_of_correspondences /= (double)n_edges;
+        double average_number_of_correspondences =
+                total_number_of_correspondences / (double)n_edges;
         double line_process_weight =
                 option.preference_loop_closure_ *
                 pow(option.max_correspondence_distance_, 2) *
@@ -436,6 +455,19 @@ double ComputeLineProcessWeight(const PoseGraph &pose_graph,
     }
 }
 
+double ComputeLineProcessWeight(const PoseGraph &pose_graph,
+                                const GlobalOptimizationOption &option) {
+    int n_edges = (int)pose_graph.edges_.size();
+    double total_number_of_correspondences = 0.0;
+    for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
+        double number_of_correspondences =
+                pose_graph.edges_[iter_edge].information_(5, 5);
+        total_number_of_correspondences += number_of_correspondences;
+    }
+    return ComputeLineProcessWeight(total_number_of_correspondences, n_edges,
+                                    option);
+}
+
 void CompensateReferencePoseGraphNode(PoseGraph &pose_graph_new,
                                       const PoseGraph &pose_graph_orig,
                                       int reference_node) {
@@ -778,6 +810,7 @@ void GlobalOptimization(PoseGraph &pose_graph,
                         /* = GlobalOptimizationConvergenceCriteria() */,
                         const GlobalOptimizationOption &option
                         /* = GlobalOptimizationOption() */) {
+    OPEN3D_PROFILE_ZONE("GlobalOptimization");
     if (!ValidatePoseGraph(pose_graph)) return;
     std::shared_ptr<PoseGraph> pose_graph_pre = std::make_shared<PoseGraph>();
     *pose_graph_pre = pose_graph;
@@ -792,5 +825,418 @@ void GlobalOptimization(PoseGraph &pose_graph,
     pose_graph = *pose_graph_pre_pruned_2;
 }
 
+struct IncrementalGlobalOptimization::Solver {
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>, Eigen::Lower> ldlt;
+    bool pattern_changed = true;
+};
+
+IncrementalGlobalOptimization::IncrementalGlobalOptimization(
+        const GlobalOptimizationConvergenceCriteria &criteria
+        /* = GlobalOptimizationConvergenceCriteria() */,
+        const GlobalOptimizationOption &option
+        /* = GlobalOptimizationOption() */,
+        double relinearize_threshold /* = 1e-3 */)
+    : criteria_(criteria),
+      option_(option),
+      relinearize_threshold_(relinearize_threshold),
+      information_sum_(0.0),
+      num_components_(0),
+      solver_(new Solver()),
+      lambda_(0.0),
+      num_relinearized_edges_(0) {}
+
+IncrementalGlobalOptimization::~IncrementalGlobalOptimization() {}
+
+int IncrementalGlobalOptimization::AddNode(const PoseGraphNode &node) {
+    int node_id = (int)pose_graph_.nodes_.size();
+    pose_graph_.nodes_.push_back(node);
+    node_motion_.push_back(0.0);
+    node_edges_.emplace_back();
+    node_parent_.push_back(node_id);
+    num_components_++;
+    hessian_diagonal_.push_back(Eigen::Matrix6d::Zero());
+    solver_->pattern_changed = true;
+    return node_id;
+}
+
+bool IncrementalGlobalOptimization::AddEdge(const PoseGraphEdge &edge) {
+    int n_nodes = (int)pose_graph_.nodes_.size();
+    int s = edge.source_node_id_;
+    int t = edge.target_node_id_;
+    if (s < 0 || s >= n_nodes || t < 0 || t >= n_nodes) {
+        utility::LogWarning(
+                "Invalid PoseGraph - an edge references an invalide node.\n");
+        return false;
+    }
+    if (!edge.uncertain_ && edge.confidence_ != 1.0) {
+        utility::LogWarning(
+                "Invalid PoseGraph - the certain edge does not have 1.0 as a "
+                "confidence.\n");
+        return false;
+    }
+    int edge_id = (int)pose_graph_.edges_.size();
+    pose_graph_.edges_.push_back(edge);
+    jacobian_source_.push_back(Eigen::Matrix6d::Zero());
+    jacobian_target_.push_back(Eigen::Matrix6d::Zero());
+    applied_confidence_.push_back(0.0);
+    edge_dirty_.push_back(true);
+    dirty_edges_.push_back(edge_id);
+    if (edge.uncertain_) uncertain_edges_.push_back(edge_id);
+    information_sum_ += edge.information_(5, 5);
+
+    node_edges_[s].push_back(edge_id);
+    if (t != s) node_edges_[t].push_back(edge_id);
+    int root_s = FindRoot(s);
+    int root_t = FindRoot(t);
+    if (root_s != root_t) {
+        node_parent_[root_t] = root_s;
+        num_components_--;
+    }
+
+    int block_id = -1;
+    if (s != t) {
+        std::pair<int, int> nodes = std::minmax(s, t);
+        auto result = hessian_block_index_.emplace(
+                nodes, (int)hessian_off_diagonal_.size());
+        if (result.second) {
+            hessian_off_diagonal_.push_back(Eigen::Matrix6d::Zero());
+            hessian_block_nodes_.push_back(nodes);
+            solver_->pattern_changed = true;
+        }
+        block_id = result.first->second;
+    }
+    edge_block_.push_back(block_id);
+    return true;
+}
+
+void IncrementalGlobalOptimization::Reset(const PoseGraph &pose_graph) {
+    pose_graph_.nodes_.clear();
+    pose_graph_.edges_.clear();
+    jacobian_source_.clear();
+    jacobian_target_.clear();
+    applied_confidence_.clear();
+    edge_block_.clear();
+    edge_dirty_.clear();
+    dirty_edges_.clear();
+    uncertain_edges_.clear();
+    information_sum_ = 0.0;
+    node_motion_.clear();
+    node_edges_.clear();
+    node_parent_.clear();
+    num_components_ = 0;
+    hessian_diagonal_.clear();
+    hessian_off_diagonal_.clear();
+    hessian_block_nodes_.clear();
+    hessian_block_index_.clear();
+    solver_.reset(new Solver());
+    lambda_ = 0.0;
+    num_relinearized_edges_ = 0;
+    for (const auto &node : pose_graph.nodes_) {
+        AddNode(node);
+    }
+    for (const auto &edge : pose_graph.edges_) {
+        AddEdge(edge);
+    }
+}
+
+void IncrementalGlobalOptimization::BatchOptimize(
+        const GlobalOptimizationMethod &method
+        /* = GlobalOptimizationLevenbergMarquardt() */) {
+    PoseGraph pose_graph = pose_graph_;
+    GlobalOptimization(pose_graph, method, criteria_, option_);
+    Reset(pose_graph);
+}
+
+int IncrementalGlobalOptimization::FindRoot(int node_id) {
+    while (node_parent_[node_id] != node_id) {
+        node_parent_[node_id] = node_parent_[node_parent_[node_id]];
+        node_id = node_parent_[node_id];
+    }
+    return node_id;
+}
+
+void IncrementalGlobalOptimization::AddEdgeToHessian(int edge_id,
+                                                     double weight) {
+    const PoseGraphEdge &t = pose_graph_.edges_[edge_id];
+    const Eigen::Matrix6d &Js = jacobian_source_[edge_id];
+    const Eigen::Matrix6d &Jt = jacobian_target_[edge_id];
+    Eigen::Matrix6d JsT_Info = weight * Js.transpose() * t.information_;
+    Eigen::Matrix6d JtT_Info = weight * Jt.transpose() * t.information_;
+
+    int id_i = t.source_node_id_;
+    int id_j = t.target_node_id_;
+    hessian_diagonal_[id_i].noalias() += JsT_Info * Js;
+    hessian_diagonal_[id_j].noalias() += JtT_Info * Jt;
+    if (id_i == id_j) {
+        hessian_diagonal_[id_i].noalias() += JsT_Info * Jt;
+        hessian_diagonal_[id_i].noalias() += JtT_Info * Js;
+    } else if (id_i < id_j) {
+        hessian_off_diagonal_[edge_block_[edge_id]].noalias() +=
+                JsT_Info * Jt;
+    } else {
+        hessian_off_diagonal_[edge_block_[edge_id]].noalias() +=
+                JtT_Info * Js;
+    }
+}
+
+void IncrementalGlobalOptimization::Relinearize() {
+    for (int edge_id : dirty_edges_) {
+        if (!edge_dirty_[edge_id]) continue;
+        edge_dirty_[edge_id] = false;
+        if (applied_confidence_[edge_id] != 0.0) {
+            AddEdgeToHessian(edge_id, -applied_confidence_[edge_id]);
+        }
+        Eigen::Matrix4d X_inv, Ts, Tt_inv;
+        std::tie(X_inv, Ts, Tt_inv) = GetRelativePoses(pose_graph_, edge_id);
+        std::tie(jacobian_source_[edge_id], jacobian_target_[edge_id]) =
+                GetJacobian(X_inv, Ts, Tt_inv);
+        applied_confidence_[edge_id] = pose_graph_.edges_[edge_id].confidence_;
+        AddEdgeToHessian(edge_id, applied_confidence_[edge_id]);
+        num_relinearized_edges_++;
+    }
+    dirty_edges_.clear();
+
+    // Confidence of uncertain edges changes with every step; reweight their
+    // cached blocks instead of linearizing them again.
+    for (int edge_id : uncertain_edges_) {
+        double confidence = pose_graph_.edges_[edge_id].confidence_;
+        if (confidence != applied_confidence_[edge_id]) {
+            AddEdgeToHessian(edge_id,
+                             confidence - applied_confidence_[edge_id]);
+            applied_confidence_[edge_id] = confidence;
+        }
+    }
+}
+
+void IncrementalGlobalOptimization::AccumulateMotion(
+        const Eigen::VectorXd &delta) {
+    int n_nodes = (int)pose_graph_.nodes_.size();
+    for (int iter_node = 0; iter_node < n_nodes; iter_node++) {
+        node_motion_[iter_node] += delta.block<6, 1>(iter_node * 6, 0).norm();
+        if (node_motion_[iter_node] > relinearize_threshold_) {
+            node_motion_[iter_node] = 0.0;
+            for (int edge_id : node_edges_[iter_node]) {
+                if (!edge_dirty_[edge_id]) {
+                    edge_dirty_[edge_id] = true;
+                    dirty_edges_.push_back(edge_id);
+                }
+            }
+        }
+    }
+}
+
+Eigen::VectorXd IncrementalGlobalOptimization::ComputeRightTerm(
+        const Eigen::VectorXd &zeta) const {
+    int n_nodes = (int)pose_graph_.nodes_.size();
+    int n_edges = (int)pose_graph_.edges_.size();
+    Eigen::VectorXd b = Eigen::VectorXd::Zero(n_nodes * 6);
+    for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
+        const PoseGraphEdge &t = pose_graph_.edges_[iter_edge];
+        Eigen::Vector6d eT_Info = t.confidence_ * t.information_ *
+                                  zeta.block<6, 1>(iter_edge * 6, 0);
+        b.block<6, 1>(t.source_node_id_ * 6, 0).noalias() -=
+                jacobian_source_[iter_edge].transpose() * eT_Info;
+        b.block<6, 1>(t.target_node_id_ * 6, 0).noalias() -=
+                jacobian_target_[iter_edge].transpose() * eT_Info;
+    }
+    return b;
+}
+
+bool IncrementalGlobalOptimization::Solve(const Eigen::VectorXd &b,
+                                          Eigen::VectorXd &delta) {
+    // The reference node, if any, is held fixed and left out of the system.
+    int n_nodes = (int)pose_graph_.nodes_.size();
+    int fixed = option_.reference_node_;
+    if (fixed < 0 || fixed >= n_nodes) fixed = -1;
+    auto var = [fixed](int node_id) {
+        return (fixed >= 0 && node_id > fixed ? node_id - 1 : node_id) * 6;
+    };
+    int n_vars = (fixed >= 0 ? n_nodes - 1 : n_nodes) * 6;
+
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(n_nodes * 21 + hessian_off_diagonal_.size() * 36);
+    for (int i = 0; i < n_nodes; i++) {
+        if (i == fixed) continue;
+        const Eigen::Matrix6d &block = hessian_diagonal_[i];
+        for (int c = 0; c < 6; c++) {
+            triplets.emplace_back(var(i) + c, var(i) + c,
+                                  block(c, c) + lambda_);
+            for (int r = c + 1; r < 6; r++) {
+                triplets.emplace_back(var(i) + r, var(i) + c, block(r, c));
+            }
+        }
+    }
+    for (size_t k = 0; k < hessian_off_diagonal_.size(); k++) {
+        int i = hessian_block_nodes_[k].first;
+        int j = hessian_block_nodes_[k].second;
+        if (i == fixed || j == fixed) continue;
+        // H(j, i) = H(i, j)^T is the block in the lower triangle.
+        const Eigen::Matrix6d &block = hessian_off_diagonal_[k];
+        for (int c = 0; c < 6; c++) {
+            for (int r = 0; r < 6; r++) {
+                triplets.emplace_back(var(j) + r, var(i) + c, block(c, r));
+            }
+        }
+    }
+    Eigen::SparseMatrix<double> H(n_vars, n_vars);
+    H.setFromTriplets(triplets.begin(), triplets.end());
+
+    if (solver_->pattern_changed) {
+        solver_->ldlt.analyzePattern(H);
+        solver_->pattern_changed = false;
+    }
+    solver_->ldlt.factorize(H);
+    if (solver_->ldlt.info() != Eigen::Success) {
+        utility::LogWarning(
+                "[IncrementalGlobalOptimization] Failed to factorize the "
+                "linear system.\n");
+        return false;
+    }
+
+    Eigen::VectorXd b_vars(n_vars);
+    for (int i = 0; i < n_nodes; i++) {
+        if (i == fixed) continue;
+        b_vars.block<6, 1>(var(i), 0) = b.block<6, 1>(i * 6, 0);
+    }
+    Eigen::VectorXd delta_vars = solver_->ldlt.solve(b_vars);
+    delta = Eigen::VectorXd::Zero(n_nodes * 6);
+    for (int i = 0; i < n_nodes; i++) {
+        if (i == fixed) continue;
+        delta.block<6, 1>(i * 6, 0) = delta_vars.block<6, 1>(var(i), 0);
+    }
+    return true;
+}
+
+bool IncrementalGlobalOptimization::Update() {
+    OPEN3D_PROFILE_ZONE("IncrementalGlobalOptimization::Update");
+    int n_nodes = (int)pose_graph_.nodes_.size();
+    int n_edges = (int)pose_graph_.edges_.size();
+    num_relinearized_edges_ = 0;
+    if (n_nodes == 0) return true;
+    if (num_components_ != 1) {
+        utility::LogWarning("Invalid PoseGraph - graph is not connected.\n");
+        return false;
+    }
+    double line_process_weight =
+            ComputeLineProcessWeight(information_sum_, n_edges, option_);
+
+    utility::LogDebug(
+            "[IncrementalGlobalOptimization] Optimizing PoseGraph having "
+            "{:d} nodes and {:d} edges. \n",
+            n_nodes, n_edges);
+
+    Eigen::VectorXd zeta = ComputeZeta(pose_graph_);
+    double current_residual, new_residual;
+    new_residual =
+            ComputeResidual(pose_graph_, zeta, line_process_weight, option_);
+    current_residual = new_residual;
+
+    int valid_edges_num =
+            UpdateConfidence(pose_graph_, zeta, line_process_weight, option_);
+    Relinearize();
+    Eigen::VectorXd b = ComputeRightTerm(zeta);
+    Eigen::VectorXd x = UpdatePoseVector(pose_graph_);
+
+    // Damping is carried over from the previous update as a warm start.
+    if (lambda_ <= 0.0) {
+        double tau = 1e-5;
+        double max_diagonal = 0.0;
+        for (const auto &block : hessian_diagonal_) {
+            max_diagonal = (std::max)(max_diagonal,
+                                      block.diagonal().maxCoeff());
+        }
+        lambda_ = tau * max_diagonal;
+    }
+    double ni = 2.0;
+    double rho = 0.0;
+
+    utility::LogDebug("[Initial     ] residual : {:e}, lambda : {:e}\n",
+                      current_residual, lambda_);
+
+    bool stop = false;
+    stop = stop || CheckRightTerm(b, criteria_);
+    if (stop) return true;
+
+    bool converged = true;
+    std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> poses_new(
+            n_nodes);
+    for (int iter = 0; !stop; iter++) {
+        int lm_count = 0;
+        do {
+            Eigen::VectorXd delta;
+            if (!Solve(b, delta)) {
+                converged = false;
+                stop = true;
+                break;
+            }
+
+            stop = stop || CheckRelativeIncrement(delta, x, criteria_);
+            if (!stop) {
+                for (int i = 0; i < n_nodes; i++) {
+                    poses_new[i] = utility::TransformVector6dToMatrix4d(
+                                           delta.block<6, 1>(i * 6, 0)) *
+                                   pose_graph_.nodes_[i].pose_;
+                }
+                Eigen::VectorXd zeta_new = ComputeZeta(pose_graph_, poses_new);
+                new_residual = ComputeResidual(pose_graph_, zeta_new,
+                                               line_process_weight, option_);
+                rho = (current_residual - new_residual) /
+                      (delta.dot(lambda_ * delta + b) + 1e-3);
+                if (rho > 0) {
+                    stop = stop ||
+                           CheckRelativeResidualIncrement(
+                                   current_residual, new_residual, criteria_);
+                    if (stop) break;
+                    double alpha = 1. - pow((2 * rho - 1), 3);
+                    alpha = (std::min)(alpha, criteria_.upper_scale_factor_);
+                    double scaleFactor =
+                            (std::max)(criteria_.lower_scale_factor_, alpha);
+                    lambda_ *= scaleFactor;
+                    ni = 2;
+                    current_residual = new_residual;
+
+                    zeta = zeta_new;
+                    for (int i = 0; i < n_nodes; i++) {
+                        pose_graph_.nodes_[i].pose_ = poses_new[i];
+                    }
+                    AccumulateMotion(delta);
+                    x = UpdatePoseVector(pose_graph_);
+                    valid_edges_num = UpdateConfidence(
+                            pose_graph_, zeta, line_process_weight, option_);
+                    Relinearize();
+                    b = ComputeRightTerm(zeta);
+
+                    stop = stop || CheckRightTerm(b, criteria_);
+                    if (stop) break;
+                } else {
+                    lambda_ *= ni;
+                    ni *= 2;
+                }
+            }
+            lm_count++;
+            stop = stop || CheckMaxIterationLM(lm_count, criteria_);
+        } while (!((rho > 0) || stop));
+        if (!stop) {
+            utility::LogDebug(
+                    "[Iteration {:02d}] residual : {:e}, valid edges : {:d}, "
+                    "relinearized edges : {:d}\n",
+                    iter, current_residual, valid_edges_num,
+                    num_relinearized_edges_);
+            stop = CheckResidual(current_residual, criteria_);
+            if (!stop && CheckMaxIteration(iter, criteria_)) {
+                converged = false;
+                stop = true;
+            }
+        }
+    }
+    if (!converged) {
+        utility::LogDebug(
+                "[IncrementalGlobalOptimization] Falling back to batch "
+                "optimization.\n");
+        BatchOptimize();
+    }
+    return true;
+}
+
 }  // namespace registration
 }  // namespace open3d
@@ -0,0 +1,132 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Open3D/Registration/GlobalOptimizationConvergenceCriteria.h"
+#include "Open3D/Registration/GlobalOptimizationMethod.h"
+#include "Open3D/Registration/PoseGraph.h"
+#include "Open3D/Utility/Eigen.h"
+
+namespace open3d {
+namespace registration {
+
+/// \class IncrementalGlobalOptimization
+///
+/// Pose graph optimizer for graphs that grow a few nodes and edges at a time.
+/// Update() warm starts Levenberg-Marquardt from the previous poses and
+/// damping, and keeps the normal equations as sparse 6x6 blocks. The Jacobian
+/// of an edge is only recomputed when one of its nodes moved more than
+/// relinearize_threshold since the edge was linearized. Uncertain edges are
+/// weighted by their line process confidence as in GlobalOptimization but are
+/// not pruned; BatchOptimize() runs GlobalOptimization on the whole graph and
+/// is used when an update does not converge within criteria.max_iteration_.
+class IncrementalGlobalOptimization {
+public:
+    IncrementalGlobalOptimization(
+            const GlobalOptimizationConvergenceCriteria &criteria =
+                    GlobalOptimizationConvergenceCriteria(),
+            const GlobalOptimizationOption &option = GlobalOptimizationOption(),
+            double relinearize_threshold = 1e-3);
+    ~IncrementalGlobalOptimization();
+    IncrementalGlobalOptimization(const IncrementalGlobalOptimization &) =
+            delete;
+    IncrementalGlobalOptimization &operator=(
+            const IncrementalGlobalOptimization &) = delete;
+
+public:
+    /// Appends a node and returns its index.
+    int AddNode(const PoseGraphNode &node);
+    /// Appends an edge between existing nodes. Returns false if the edge is
+    /// invalid.
+    bool AddEdge(const PoseGraphEdge &edge);
+    /// Optimizes the graph after nodes and edges have been added. Returns
+    /// false if the graph is not connected, in which case it is unchanged.
+    bool Update();
+    /// Optimizes the whole graph with GlobalOptimization, which also prunes
+    /// unreliable uncertain edges, and drops the cached linearization.
+    void BatchOptimize(const GlobalOptimizationMethod &method =
+                               GlobalOptimizationLevenbergMarquardt());
+    /// Replaces the graph and drops the cached linearization.
+    void Reset(const PoseGraph &pose_graph);
+    const PoseGraph &GetPoseGraph() const { return pose_graph_; }
+    /// Number of edges linearized by the last call to Update().
+    int GetNumRelinearizedEdges() const { return num_relinearized_edges_; }
+
+private:
+    struct Solver;
+
+    int FindRoot(int node_id);
+    void AddEdgeToHessian(int edge_id, double weight);
+    void Relinearize();
+    void AccumulateMotion(const Eigen::VectorXd &delta);
+    Eigen::VectorXd ComputeRightTerm(const Eigen::VectorXd &zeta) const;
+    bool Solve(const Eigen::VectorXd &b, Eigen::VectorXd &delta);
+
+private:
+    GlobalOptimizationConvergenceCriteria criteria_;
+    GlobalOptimizationOption option_;
+    double relinearize_threshold_;
+    PoseGraph pose_graph_;
+
+    /// Per edge: Jacobians at the last linearization, the confidence they
+    /// are weighted with in the blocks below, and the off-diagonal block.
+    std::vector<Eigen::Matrix6d, utility::Matrix6d_allocator> jacobian_source_;
+    std::vector<Eigen::Matrix6d, utility::Matrix6d_allocator> jacobian_target_;
+    std::vector<double> applied_confidence_;
+    std::vector<int> edge_block_;
+    std::vector<bool> edge_dirty_;
+    std::vector<int> dirty_edges_;
+    std::vector<int> uncertain_edges_;
+    double information_sum_;
+
+    /// Per node: motion since its edges were linearized, incident edges and
+    /// union-find parent used to check connectivity.
+    std::vector<double> node_motion_;
+    std::vector<std::vector<int>> node_edges_;
+    std::vector<int> node_parent_;
+    int num_components_;
+
+    /// H in 6x6 blocks. Off-diagonal blocks are stored once for nodes (i, j)
+    /// with i < j and hold H(i, j).
+    std::vector<Eigen::Matrix6d, utility::Matrix6d_allocator> hessian_diagonal_;
+    std::vector<Eigen::Matrix6d, utility::Matrix6d_allocator>
+            hessian_off_diagonal_;
+    std::vector<std::pair<int, int>> hessian_block_nodes_;
+    std::map<std::pair<int, int>, int> hessian_block_index_;
+
+    std::unique_ptr<Solver> solver_;
+    double lambda_;
+    int num_relinearized_edges_;
+};
+
+}  // namespace registration
+}  // namespace open3d
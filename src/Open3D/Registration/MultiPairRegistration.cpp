@@ -0,0 +1,193 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Registration/MultiPairRegistration.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/FeatureIndex.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
+#include "Open3D/Utility/Profiler.h"
+
+namespace open3d {
+namespace registration {
+
+std::vector<PoseGraphEdge> RegisterPointCloudPairs(
+        const std::vector<std::shared_ptr<geometry::PointCloud>> &point_clouds,
+        const std::vector<std::shared_ptr<Feature>> &features,
+        const std::vector<RegistrationPair> &pairs,
+        const MultiPairRegistrationOption &option
+        /* = MultiPairRegistrationOption()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
+                &checkers /* = {}*/) {
+    OPEN3D_PROFILE_ZONE("RegisterPointCloudPairs");
+    int n_clouds = (int)point_clouds.size();
+    int n_pairs = (int)pairs.size();
+
+    // Only the targets are searched, so only they need indices.
+    std::vector<int> valid_pairs;
+    std::vector<bool> need_kdtree(n_clouds, false);
+    std::vector<bool> need_feature_kdtree(n_clouds, false);
+    for (int k = 0; k < n_pairs; k++) {
+        int s = pairs[k].source_id_;
+        int t = pairs[k].target_id_;
+        if (s < 0 || s >= n_clouds || t < 0 || t >= n_clouds ||
+            !point_clouds[s] || !point_clouds[t]) {
+            utility::LogWarning(
+                    "[RegisterPointCloudPairs] Pair {:d} references an "
+                    "invalid point cloud.\n",
+                    k);
+            continue;
+        }
+        if (pairs[k].global_registration_ &&
+            ((int)features.size() != n_clouds || !features[s] ||
+             !features[t])) {
+            utility::LogWarning(
+                    "[RegisterPointCloudPairs] Pair {:d} requires the "
+                    "features of its point clouds.\n",
+                    k);
+            continue;
+        }
+        need_kdtree[t] = true;
+        if (pairs[k].global_registration_) need_feature_kdtree[t] = true;
+        valid_pairs.push_back(k);
+    }
+
+    // Features are matched either exactly or with approximate indices.
+    const bool approximate = option.maximum_feature_checks_ > 0;
+    std::vector<geometry::KDTreeFlann> kdtrees(n_clouds);
+    std::vector<geometry::KDTreeFlann> feature_kdtrees(n_clouds);
+    std::vector<std::unique_ptr<FeatureIndex>> feature_indices(n_clouds);
+    utility::ParallelFor(0, n_clouds, [&](int i) {
+        if (need_kdtree[i]) kdtrees[i].SetGeometry(*point_clouds[i]);
+        if (need_feature_kdtree[i] && approximate) {
+            feature_indices[i].reset(new FeatureIndex(
+                    *features[i],
+                    FeatureIndexOption(1, option.maximum_feature_checks_)));
+        } else if (need_feature_kdtree[i]) {
+            feature_kdtrees[i].SetFeature(*features[i]);
+        }
+    });
+
+    // Pairs are handed out one at a time, the most expensive first, so that
+    // a few slow global registrations do not end up on the same thread. The
+    // cost is estimated from the number of validations or iterations, each
+    // of which searches every source point.
+    std::vector<double> costs(n_pairs, 0.0);
+    for (int k : valid_pairs) {
+        double iterations = pairs[k].global_registration_
+                                    ? option.ransac_criteria_.max_validation_
+                                    : option.icp_criteria_.max_iteration_;
+        costs[k] = iterations *
+                   (double)point_clouds[pairs[k].source_id_]->points_.size();
+    }
+    std::stable_sort(valid_pairs.begin(), valid_pairs.end(),
+                     [&costs](int a, int b) { return costs[a] > costs[b]; });
+
+    // std::vector<bool> is not safe to write from several threads.
+    std::vector<PoseGraphEdge> edges(n_pairs);
+    std::vector<int> success(n_pairs, 0);
+    auto register_pair = [&](int k) {
+        const RegistrationPair &pair = pairs[k];
+        const geometry::PointCloud &source = *point_clouds[pair.source_id_];
+        const geometry::PointCloud &target = *point_clouds[pair.target_id_];
+        const geometry::KDTreeFlann &kdtree = kdtrees[pair.target_id_];
+        RegistrationResult result;
+        if (pair.global_registration_) {
+            const Feature &source_feature = *features[pair.source_id_];
+            if (approximate) {
+                result = RegistrationRANSACBasedOnFeatureMatching(
+                        source, target, source_feature, kdtree,
+                        *feature_indices[pair.target_id_],
+                        option.max_correspondence_distance_,
+                        TransformationEstimationPointToPoint(false),
+                        option.ransac_n_, checkers, option.ransac_criteria_);
+            } else {
+                result = RegistrationRANSACBasedOnFeatureMatching(
+                        source, target, source_feature, kdtree,
+                        feature_kdtrees[pair.target_id_],
+                        option.max_correspondence_distance_,
+                        TransformationEstimationPointToPoint(false),
+                        option.ransac_n_, checkers, option.ransac_criteria_);
+            }
+            if (result.fitness_ == 0.0) return;
+        } else {
+            result = RegistrationICP(source, target, kdtree,
+                                     option.max_correspondence_distance_,
+                                     pair.init_, estimation,
+                                     option.icp_criteria_);
+        }
+        // Both registrations end with the correspondences of the final
+        // transformation within max_correspondence_distance_.
+        Eigen::Matrix6d information = GetInformationMatrixFromCorrespondences(
+                target, result.correspondence_set_);
+        if (pair.global_registration_ &&
+            information(5, 5) <
+                    option.min_overlap_ * (double)std::min(
+                                                  source.points_.size(),
+                                                  target.points_.size())) {
+            return;
+        }
+        edges[k] = PoseGraphEdge(pair.source_id_, pair.target_id_,
+                                 result.transformation_, information,
+                                 pair.uncertain_);
+        success[k] = 1;
+    };
+
+    int n_valid = (int)valid_pairs.size();
+    if (n_valid == 1) {
+        // A single pair keeps the parallel loops inside the registration.
+        register_pair(valid_pairs[0]);
+    } else if (n_valid > 1) {
+        std::atomic<int> next_pair(0);
+        int n_workers = std::min(utility::GetMaxThreads(), n_valid);
+        utility::ParallelFor(0, n_workers, [&](int) {
+            for (int i = next_pair++; i < n_valid; i = next_pair++) {
+                register_pair(valid_pairs[i]);
+            }
+        });
+    }
+
+    std::vector<PoseGraphEdge> output;
+    for (int k = 0; k < n_pairs; k++) {
+        if (success[k]) output.push_back(edges[k]);
+    }
+    utility::LogDebug(
+            "[RegisterPointCloudPairs] {:d} of {:d} pairs registered.\n",
+            (int)output.size(), n_pairs);
+    return output;
+}
+
+}  // namespace registration
+}  // namespace open3d
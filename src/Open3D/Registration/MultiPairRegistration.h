@@ -0,0 +1,133 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <memory>
+#include <vector>
+
+#include "Open3D/Registration/CorrespondenceChecker.h"
+#include "Open3D/Registration/PoseGraph.h"
+#include "Open3D/Registration/Registration.h"
+#include "Open3D/Registration/TransformationEstimation.h"
+#include "Open3D/Utility/Eigen.h"
+
+namespace open3d {
+
+namespace geometry {
+class PointCloud;
+}
+
+namespace registration {
+class Feature;
+
+/// Class that defines a pair of point clouds for RegisterPointCloudPairs by
+/// their indices in the point cloud list.
+class RegistrationPair {
+public:
+    RegistrationPair(int source_id = -1,
+                     int target_id = -1,
+                     const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+                     bool global_registration = false,
+                     bool uncertain = false)
+        : source_id_(source_id),
+          target_id_(target_id),
+          init_(init),
+          global_registration_(global_registration),
+          uncertain_(uncertain) {}
+    ~RegistrationPair() {}
+
+public:
+    int source_id_;
+    int target_id_;
+    /// Initial transformation of the ICP registration
+    Eigen::Matrix4d_u init_;
+    /// If true, the transformation is found by RANSAC feature matching
+    /// instead of ICP from init_, and the pair is dropped if the overlap is
+    /// too small
+    bool global_registration_;
+    /// Copied to the uncertain_ flag of the resulting PoseGraphEdge
+    bool uncertain_;
+};
+
+/// Class that defines the options of RegisterPointCloudPairs
+class MultiPairRegistrationOption {
+public:
+    MultiPairRegistrationOption(
+            double max_correspondence_distance = 0.075,
+            double min_overlap = 0.3,
+            int ransac_n = 4,
+            const RANSACConvergenceCriteria &ransac_criteria =
+                    RANSACConvergenceCriteria(4000000, 500),
+            const ICPConvergenceCriteria &icp_criteria =
+                    ICPConvergenceCriteria(),
+            int maximum_feature_checks = -1)
+        : max_correspondence_distance_(max_correspondence_distance),
+          min_overlap_(min_overlap),
+          ransac_n_(ransac_n),
+          ransac_criteria_(ransac_criteria),
+          icp_criteria_(icp_criteria),
+          maximum_feature_checks_(maximum_feature_checks) {}
+    ~MultiPairRegistrationOption() {}
+
+public:
+    /// Maximum correspondence distance of RANSAC, ICP and the information
+    /// matrix
+    double max_correspondence_distance_;
+    /// Global registrations whose number of correspondences is below
+    /// min_overlap_ times the size of the smaller cloud are dropped
+    double min_overlap_;
+    int ransac_n_;
+    RANSACConvergenceCriteria ransac_criteria_;
+    ICPConvergenceCriteria icp_criteria_;
+    /// RANSAC matches features with an approximate FeatureIndex comparing
+    /// this many features per query, or exactly if it is not positive
+    int maximum_feature_checks_;
+};
+
+/// Function to register many pairs of point clouds, e.g. the fragment pairs
+/// of a reconstruction. The KD-trees of the points and features of every
+/// point cloud are built once and shared by all pairs, and the pairs run
+/// concurrently on the threads of utility::ParallelFor, the most expensive
+/// first. \param features is only used by pairs with global_registration_
+/// and may be empty otherwise. \param estimation is used by ICP, RANSAC always
+/// estimates point to point transformations. Returns one edge with the
+/// transformation and information matrix of each successful pair, in the
+/// order of \param pairs.
+std::vector<PoseGraphEdge> RegisterPointCloudPairs(
+        const std::vector<std::shared_ptr<geometry::PointCloud>> &point_clouds,
+        const std::vector<std::shared_ptr<Feature>> &features,
+        const std::vector<RegistrationPair> &pairs,
+        const MultiPairRegistrationOption &option =
+                MultiPairRegistrationOption(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false),
+        const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
+                &checkers = {});
+
+}  // namespace registration
+}  // namespace open3d
@@ -26,25 +26,32 @@
 
 #include "Open3D/Registration/Registration.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 
+#include "Open3D/Geometry/DynamicKDTree.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/FeatureIndex.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 
 namespace {
 using namespace registration;
 
+template <typename KDTree>
 RegistrationResult GetRegistrationResultAndCorrespondences(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
-        const geometry::KDTreeFlann &target_kdtree,
+        const KDTree &target_kdtree,
         double max_correspondence_distance,
         const Eigen::Matrix4d &transformation) {
+    OPEN3D_PROFILE_ZONE("GetRegistrationResultAndCorrespondences");
+    OPEN3D_PROFILE_POINTS(source.points_.size());
     RegistrationResult result(transformation);
     if (max_correspondence_distance <= 0.0) {
         return result;
@@ -125,34 +132,16 @@ RegistrationResult EvaluateRANSACBasedOnCorrespondence(
     return result;
 }
 
-}  // unnamed namespace
-
-namespace registration {
-RegistrationResult EvaluateRegistration(
-        const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
-        double max_correspondence_distance,
-        const Eigen::Matrix4d
-                &transformation /* = Eigen::Matrix4d::Identity()*/) {
-    geometry::KDTreeFlann kdtree;
-    kdtree.SetGeometry(target);
-    geometry::PointCloud pcd = source;
-    if (transformation.isIdentity() == false) {
-        pcd.Transform(transformation);
-    }
-    return GetRegistrationResultAndCorrespondences(
-            pcd, target, kdtree, max_correspondence_distance, transformation);
-}
-
-RegistrationResult RegistrationICP(
+template <typename KDTree>
+RegistrationResult RegistrationICPWithKDTree(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
+        const KDTree &target_kdtree,
         double max_correspondence_distance,
-        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
-        const TransformationEstimation &estimation
-        /* = TransformationEstimationPointToPoint(false)*/,
-        const ICPConvergenceCriteria
-                &criteria /* = ICPConvergenceCriteria()*/) {
+        const Eigen::Matrix4d &init,
+        const TransformationEstimation &estimation,
+        const ICPConvergenceCriteria &criteria) {
+    OPEN3D_PROFILE_ZONE("RegistrationICP");
     if (max_correspondence_distance <= 0.0) {
         utility::LogWarning("Invalid max_correspondence_distance.\n");
         return RegistrationResult(init);
@@ -165,17 +154,24 @@ RegistrationResult RegistrationICP(
                 "pre-computed normal vectors.\n");
         return RegistrationResult(init);
     }
+    if (estimation.GetTransformationEstimationType() ==
+                TransformationEstimationType::GeneralizedICP &&
+        (!source.HasCovariances() || !target.HasCovariances())) {
+        utility::LogWarning(
+                "TransformationEstimationForGeneralizedICP requires "
+                "pre-computed covariances.\n");
+        return RegistrationResult(init);
+    }
 
     Eigen::Matrix4d transformation = init;
-    geometry::KDTreeFlann kdtree;
-    kdtree.SetGeometry(target);
     geometry::PointCloud pcd = source;
     if (init.isIdentity() == false) {
         pcd.Transform(init);
     }
     RegistrationResult result;
     result = GetRegistrationResultAndCorrespondences(
-            pcd, target, kdtree, max_correspondence_distance, transformation);
+            pcd, target, target_kdtree, max_correspondence_distance,
+            transformation);
     for (int i = 0; i < criteria.max_iteration_; i++) {
         utility::LogDebug("ICP Iteration #{:d}: Fitness {:.4f}, RMSE {:.4f}\n",
                           i, result.fitness_, result.inlier_rmse_);
@@ -185,7 +181,7 @@ RegistrationResult RegistrationICP(
         pcd.Transform(update);
         RegistrationResult backup = result;
         result = GetRegistrationResultAndCorrespondences(
-                pcd, target, kdtree, max_correspondence_distance,
+                pcd, target, target_kdtree, max_correspondence_distance,
                 transformation);
         if (std::abs(backup.fitness_ - result.fitness_) <
                     criteria.relative_fitness_ &&
@@ -197,61 +193,22 @@ RegistrationResult RegistrationICP(
     return result;
 }
 
-RegistrationResult RegistrationRANSACBasedOnCorrespondence(
-        const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
-        const CorrespondenceSet &corres,
-        double max_correspondence_distance,
-        const TransformationEstimation &estimation
-        /* = TransformationEstimationPointToPoint(false)*/,
-        int ransac_n /* = 6*/,
-        const RANSACConvergenceCriteria &criteria
-        /* = RANSACConvergenceCriteria()*/) {
-    if (ransac_n < 3 || (int)corres.size() < ransac_n ||
-        max_correspondence_distance <= 0.0) {
-        return RegistrationResult();
-    }
-    std::srand((unsigned int)std::time(0));
-    Eigen::Matrix4d transformation;
-    CorrespondenceSet ransac_corres(ransac_n);
-    RegistrationResult result;
-    for (int itr = 0;
-         itr < criteria.max_iteration_ && itr < criteria.max_validation_;
-         itr++) {
-        for (int j = 0; j < ransac_n; j++) {
-            ransac_corres[j] = corres[std::rand() % (int)corres.size()];
-        }
-        transformation =
-                estimation.ComputeTransformation(source, target, ransac_corres);
-        geometry::PointCloud pcd = source;
-        pcd.Transform(transformation);
-        auto this_result = EvaluateRANSACBasedOnCorrespondence(
-                pcd, target, corres, max_correspondence_distance,
-                transformation);
-        if (this_result.fitness_ > result.fitness_ ||
-            (this_result.fitness_ == result.fitness_ &&
-             this_result.inlier_rmse_ < result.inlier_rmse_)) {
-            result = this_result;
-        }
-    }
-    utility::LogDebug("RANSAC: Fitness {:.4f}, RMSE {:.4f}\n", result.fitness_,
-                      result.inlier_rmse_);
-    return result;
-}
-
-RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
+/// RANSAC based on feature matching. The similar features are searched in
+/// any index with the SearchKNN of KDTreeFlann.
+template <typename FeatureSearch>
+RegistrationResult RANSACBasedOnFeatureMatching(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
         const Feature &source_feature,
-        const Feature &target_feature,
+        const geometry::KDTreeFlann &target_kdtree,
+        const FeatureSearch &target_feature_index,
         double max_correspondence_distance,
-        const TransformationEstimation &estimation
-        /* = TransformationEstimationPointToPoint(false)*/,
-        int ransac_n /* = 4*/,
+        const TransformationEstimation &estimation,
+        int ransac_n,
         const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
-                &checkers /* = {}*/,
-        const RANSACConvergenceCriteria &criteria
-        /* = RANSACConvergenceCriteria()*/) {
+                &checkers,
+        const RANSACConvergenceCriteria &criteria) {
+    OPEN3D_PROFILE_ZONE("RegistrationRANSACBasedOnFeatureMatching");
     if (ransac_n < 3 || max_correspondence_distance <= 0.0) {
         return RegistrationResult();
     }
@@ -261,14 +218,12 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
     bool finished_validation = false;
     int num_similar_features = 1;
     std::vector<std::vector<int>> similar_features(source.points_.size());
-
+    // The searches are const, so the threads share the trees.
 #ifdef _OPENMP
 #pragma omp parallel
     {
 #endif
         CorrespondenceSet ransac_corres(ransac_n);
-        geometry::KDTreeFlann kdtree(target);
-        geometry::KDTreeFlann kdtree_feature(target_feature);
         RegistrationResult result_private;
         unsigned int seed_number;
 #ifdef _OPENMP
@@ -286,30 +241,39 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
             if (!finished_validation) {
                 std::vector<double> dists(num_similar_features);
                 Eigen::Matrix4d transformation;
+                bool has_matches = true;
                 for (int j = 0; j < ransac_n; j++) {
                     int source_sample_id =
                             std::rand() % (int)source.points_.size();
                     if (similar_features[source_sample_id].empty()) {
                         std::vector<int> indices(num_similar_features);
-                        kdtree_feature.SearchKNN(
+                        int k = target_feature_index.SearchKNN(
                                 Eigen::VectorXd(source_feature.data_.col(
                                         source_sample_id)),
                                 num_similar_features, indices, dists);
+                        // Searches can return fewer matches, or none, e.g.
+                        // for an empty target or a failed probe.
+                        indices.resize(std::max(
+                                std::min(k, num_similar_features), 0));
 #ifdef _OPENMP
 #pragma omp critical
 #endif
                         { similar_features[source_sample_id] = indices; }
                     }
+                    const std::vector<int> &matches =
+                            similar_features[source_sample_id];
+                    if (matches.empty()) {
+                        has_matches = false;
+                        break;
+                    }
                     ransac_corres[j](0) = source_sample_id;
                     if (num_similar_features == 1)
-                        ransac_corres[j](1) =
-                                similar_features[source_sample_id][0];
+                        ransac_corres[j](1) = matches[0];
                     else
                         ransac_corres[j](1) =
-                                similar_features[source_sample_id]
-                                                [std::rand() %
-                                                 num_similar_features];
+                                matches[std::rand() % matches.size()];
                 }
+                if (!has_matches) continue;
                 bool check = true;
                 for (const auto &checker : checkers) {
                     if (checker.get().require_pointcloud_alignment_ == false &&
@@ -335,7 +299,7 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
                 geometry::PointCloud pcd = source;
                 pcd.Transform(transformation);
                 auto this_result = GetRegistrationResultAndCorrespondences(
-                        pcd, target, kdtree, max_correspondence_distance,
+                        pcd, target, target_kdtree, max_correspondence_distance,
                         transformation);
                 if (this_result.fitness_ > result_private.fitness_ ||
                     (this_result.fitness_ == result_private.fitness_ &&
@@ -371,62 +335,256 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
     return result;
 }
 
+}  // unnamed namespace
+
+namespace registration {
+RegistrationResult EvaluateRegistration(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d
+                &transformation /* = Eigen::Matrix4d::Identity()*/) {
+    geometry::KDTreeFlann kdtree;
+    kdtree.SetGeometry(target);
+    geometry::PointCloud pcd = source;
+    if (transformation.isIdentity() == false) {
+        pcd.Transform(transformation);
+    }
+    return GetRegistrationResultAndCorrespondences(
+            pcd, target, kdtree, max_correspondence_distance, transformation);
+}
+
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    geometry::KDTreeFlann kdtree;
+    kdtree.SetGeometry(target);
+    return RegistrationICPWithKDTree(source, target, kdtree,
+                                     max_correspondence_distance, init,
+                                     estimation, criteria);
+}
+
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    return RegistrationICPWithKDTree(source, target, target_kdtree,
+                                     max_correspondence_distance, init,
+                                     estimation, criteria);
+}
+
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::DynamicKDTree &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    return RegistrationICPWithKDTree(source, target, target_kdtree,
+                                     max_correspondence_distance, init,
+                                     estimation, criteria);
+}
+
+std::tuple<RegistrationResult, Eigen::Matrix6d>
+RegistrationICPWithInformationMatrix(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    RegistrationResult result =
+            RegistrationICP(source, target, max_correspondence_distance, init,
+                            estimation, criteria);
+    Eigen::Matrix6d information = GetInformationMatrixFromCorrespondences(
+            target, result.correspondence_set_);
+    return std::make_tuple(std::move(result), std::move(information));
+}
+
+RegistrationResult RegistrationRANSACBasedOnCorrespondence(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres,
+        double max_correspondence_distance,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        int ransac_n /* = 6*/,
+        const RANSACConvergenceCriteria &criteria
+        /* = RANSACConvergenceCriteria()*/) {
+    OPEN3D_PROFILE_ZONE("RegistrationRANSACBasedOnCorrespondence");
+    if (ransac_n < 3 || (int)corres.size() < ransac_n ||
+        max_correspondence_distance <= 0.0) {
+        return RegistrationResult();
+    }
+    std::srand((unsigned int)std::time(0));
+    Eigen::Matrix4d transformation;
+    CorrespondenceSet ransac_corres(ransac_n);
+    RegistrationResult result;
+    for (int itr = 0;
+         itr < criteria.max_iteration_ && itr < criteria.max_validation_;
+         itr++) {
+        for (int j = 0; j < ransac_n; j++) {
+            ransac_corres[j] = corres[std::rand() % (int)corres.size()];
+        }
+        transformation =
+                estimation.ComputeTransformation(source, target, ransac_corres);
+        geometry::PointCloud pcd = source;
+        pcd.Transform(transformation);
+        auto this_result = EvaluateRANSACBasedOnCorrespondence(
+                pcd, target, corres, max_correspondence_distance,
+                transformation);
+        if (this_result.fitness_ > result.fitness_ ||
+            (this_result.fitness_ == result.fitness_ &&
+             this_result.inlier_rmse_ < result.inlier_rmse_)) {
+            result = this_result;
+        }
+    }
+    utility::LogDebug("RANSAC: Fitness {:.4f}, RMSE {:.4f}\n", result.fitness_,
+                      result.inlier_rmse_);
+    return result;
+}
+
+RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const Feature &source_feature,
+        const Feature &target_feature,
+        double max_correspondence_distance,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        int ransac_n /* = 4*/,
+        const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
+                &checkers /* = {}*/,
+        const RANSACConvergenceCriteria &criteria
+        /* = RANSACConvergenceCriteria()*/,
+        int maximum_feature_checks /* = -1*/) {
+    if (ransac_n < 3 || max_correspondence_distance <= 0.0) {
+        return RegistrationResult();
+    }
+    geometry::KDTreeFlann kdtree(target);
+    if (maximum_feature_checks > 0) {
+        FeatureIndex feature_index(
+                target_feature, FeatureIndexOption(1, maximum_feature_checks));
+        return RANSACBasedOnFeatureMatching(
+                source, target, source_feature, kdtree, feature_index,
+                max_correspondence_distance, estimation, ransac_n, checkers,
+                criteria);
+    }
+    geometry::KDTreeFlann kdtree_feature(target_feature);
+    return RANSACBasedOnFeatureMatching(
+            source, target, source_feature, kdtree, kdtree_feature,
+            max_correspondence_distance, estimation, ransac_n, checkers,
+            criteria);
+}
+
+RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const Feature &source_feature,
+        const geometry::KDTreeFlann &target_kdtree,
+        const geometry::KDTreeFlann &target_feature_kdtree,
+        double max_correspondence_distance,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        int ransac_n /* = 4*/,
+        const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
+                &checkers /* = {}*/,
+        const RANSACConvergenceCriteria &criteria
+        /* = RANSACConvergenceCriteria()*/) {
+    return RANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_kdtree,
+            target_feature_kdtree, max_correspondence_distance, estimation,
+            ransac_n, checkers, criteria);
+}
+
+RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const Feature &source_feature,
+        const geometry::KDTreeFlann &target_kdtree,
+        const FeatureIndex &target_feature_index,
+        double max_correspondence_distance,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        int ransac_n /* = 4*/,
+        const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
+                &checkers /* = {}*/,
+        const RANSACConvergenceCriteria &criteria
+        /* = RANSACConvergenceCriteria()*/) {
+    return RANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_kdtree,
+            target_feature_index, max_correspondence_distance, estimation,
+            ransac_n, checkers, criteria);
+}
+
 Eigen::Matrix6d GetInformationMatrixFromPointClouds(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
         double max_correspondence_distance,
         const Eigen::Matrix4d &transformation) {
+    geometry::KDTreeFlann target_kdtree(target);
+    return GetInformationMatrixFromPointClouds(source, target, target_kdtree,
+                                               max_correspondence_distance,
+                                               transformation);
+}
+
+Eigen::Matrix6d GetInformationMatrixFromPointClouds(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &transformation) {
     geometry::PointCloud pcd = source;
     if (transformation.isIdentity() == false) {
         pcd.Transform(transformation);
     }
     RegistrationResult result;
-    geometry::KDTreeFlann target_kdtree(target);
     result = GetRegistrationResultAndCorrespondences(
             pcd, target, target_kdtree, max_correspondence_distance,
             transformation);
+    return GetInformationMatrixFromCorrespondences(target,
+                                                   result.correspondence_set_);
+}
 
+Eigen::Matrix6d GetInformationMatrixFromCorrespondences(
+        const geometry::PointCloud &target, const CorrespondenceSet &corres) {
     // write q^*
     // see http://redwood-data.org/indoor/registration.html
     // note: I comes first in this implementation
-    Eigen::Matrix6d GTG = Eigen::Matrix6d::Zero();
-#ifdef _OPENMP
-#pragma omp parallel
-    {
-#endif
-        Eigen::Matrix6d GTG_private = Eigen::Matrix6d::Zero();
-        Eigen::Vector6d G_r_private = Eigen::Vector6d::Zero();
-#ifdef _OPENMP
-#pragma omp for nowait
-#endif
-        for (int c = 0; c < int(result.correspondence_set_.size()); c++) {
-            int t = result.correspondence_set_[c](1);
-            double x = target.points_[t](0);
-            double y = target.points_[t](1);
-            double z = target.points_[t](2);
-            G_r_private.setZero();
-            G_r_private(1) = z;
-            G_r_private(2) = -y;
-            G_r_private(3) = 1.0;
-            GTG_private.noalias() += G_r_private * G_r_private.transpose();
-            G_r_private.setZero();
-            G_r_private(0) = -z;
-            G_r_private(2) = x;
-            G_r_private(4) = 1.0;
-            GTG_private.noalias() += G_r_private * G_r_private.transpose();
-            G_r_private.setZero();
-            G_r_private(0) = y;
-            G_r_private(1) = -x;
-            G_r_private(5) = 1.0;
-            GTG_private.noalias() += G_r_private * G_r_private.transpose();
-        }
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        { GTG += GTG_private; }
-#ifdef _OPENMP
-    }
-#endif
+    auto compute_G =
+            [&](int c,
+                std::vector<Eigen::Vector6d, utility::Vector6d_allocator> &G_r,
+                std::vector<double> &r) {
+                const Eigen::Vector3d &p = target.points_[corres[c](1)];
+                G_r.resize(3);
+                r.assign(3, 0.0);
+                G_r[0] << 0.0, p(2), -p(1), 1.0, 0.0, 0.0;
+                G_r[1] << -p(2), 0.0, p(0), 0.0, 1.0, 0.0;
+                G_r[2] << p(1), -p(0), 0.0, 0.0, 0.0, 1.0;
+            };
+    Eigen::Matrix6d GTG;
+    Eigen::Vector6d GTr;
+    double r2;
+    std::tie(GTG, GTr, r2) =
+            utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
+                    compute_G, (int)corres.size(), false);
     return GTG;
 }
 
@@ -38,10 +38,13 @@ namespace open3d {
 
 namespace geometry {
 class PointCloud;
+class KDTreeFlann;
+class DynamicKDTree;
 }
 
 namespace registration {
 class Feature;
+class FeatureIndex;
 
 /// Class that defines the convergence criteria of ICP
 /// ICP algorithm stops if the relative change of fitness and rmse hit
@@ -113,6 +116,41 @@ RegistrationResult RegistrationICP(
                 TransformationEstimationPointToPoint(false),
         const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
 
+/// Functions for ICP registration that search the correspondences in a
+/// prebuilt index of the target, whose point indices are the indices of the
+/// target points.
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::DynamicKDTree &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
+
+/// Function for ICP registration that also returns the information matrix of
+/// the final correspondences, the same as GetInformationMatrixFromPointClouds
+/// with the resulting transformation but without searching them again.
+std::tuple<RegistrationResult, Eigen::Matrix6d>
+RegistrationICPWithInformationMatrix(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
+
 /// Function for global RANSAC registration based on a given set of
 /// correspondences
 RegistrationResult RegistrationRANSACBasedOnCorrespondence(
@@ -126,7 +164,10 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
         const RANSACConvergenceCriteria &criteria =
                 RANSACConvergenceCriteria());
 
-/// Function for global RANSAC registration based on feature matching
+/// Function for global RANSAC registration based on feature matching. The
+/// features are matched with an approximate FeatureIndex comparing
+/// \param maximum_feature_checks features per query, or exactly if it is not
+/// positive.
 RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -136,6 +177,42 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
         const TransformationEstimation &estimation =
                 TransformationEstimationPointToPoint(false),
         int ransac_n = 4,
+        const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
+                &checkers = {},
+        const RANSACConvergenceCriteria &criteria =
+                RANSACConvergenceCriteria(),
+        int maximum_feature_checks = -1);
+
+/// Function for global RANSAC registration based on feature matching, with
+/// prebuilt indices of the target points and of the target features.
+RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const Feature &source_feature,
+        const geometry::KDTreeFlann &target_kdtree,
+        const geometry::KDTreeFlann &target_feature_kdtree,
+        double max_correspondence_distance,
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false),
+        int ransac_n = 4,
+        const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
+                &checkers = {},
+        const RANSACConvergenceCriteria &criteria =
+                RANSACConvergenceCriteria());
+
+/// Function for global RANSAC registration based on feature matching, with
+/// prebuilt indices of the target points and of the target features, which
+/// are matched approximately.
+RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const Feature &source_feature,
+        const geometry::KDTreeFlann &target_kdtree,
+        const FeatureIndex &target_feature_index,
+        double max_correspondence_distance,
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false),
+        int ransac_n = 4,
         const std::vector<std::reference_wrapper<const CorrespondenceChecker>>
                 &checkers = {},
         const RANSACConvergenceCriteria &criteria =
@@ -148,5 +225,20 @@ Eigen::Matrix6d GetInformationMatrixFromPointClouds(
         double max_correspondence_distance,
         const Eigen::Matrix4d &transformation);
 
+/// Function for computing information matrix from transformation matrix,
+/// searching the correspondences in a prebuilt index of the target.
+Eigen::Matrix6d GetInformationMatrixFromPointClouds(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const geometry::KDTreeFlann &target_kdtree,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &transformation);
+
+/// Function for computing information matrix from a set of correspondences,
+/// e.g. the correspondence_set_ of a RegistrationResult, which only depends on
+/// the target points.
+Eigen::Matrix6d GetInformationMatrixFromCorrespondences(
+        const geometry::PointCloud &target, const CorrespondenceSet &corres);
+
 }  // namespace registration
 }  // namespace open3d
@@ -30,6 +30,7 @@
 
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Utility/Eigen.h"
+#include "Open3D/Utility/Profiler.h"
 
 namespace open3d {
 namespace registration {
@@ -50,6 +51,8 @@ Eigen::Matrix4d TransformationEstimationPointToPoint::ComputeTransformation(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
         const CorrespondenceSet &corres) const {
+    OPEN3D_PROFILE_ZONE("TransformationEstimationPointToPoint");
+    OPEN3D_PROFILE_POINTS(corres.size());
     if (corres.empty()) return Eigen::Matrix4d::Identity();
     Eigen::MatrixXd source_mat(3, corres.size());
     Eigen::MatrixXd target_mat(3, corres.size());
@@ -78,6 +81,8 @@ Eigen::Matrix4d TransformationEstimationPointToPlane::ComputeTransformation(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
         const CorrespondenceSet &corres) const {
+    OPEN3D_PROFILE_ZONE("TransformationEstimationPointToPlane");
+    OPEN3D_PROFILE_POINTS(corres.size());
     if (corres.empty() || target.HasNormals() == false)
         return Eigen::Matrix4d::Identity();
 
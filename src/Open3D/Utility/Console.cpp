@@ -28,14 +28,18 @@
 
 #include <algorithm>
 #include <cerrno>
+#include <chrono>
 #include <climits>
 #include <cmath>
+#include <condition_variable>
 #include <cstdarg>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <limits>
 #include <string>
+#include <thread>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -49,6 +53,112 @@ namespace open3d {
 
 namespace utility {
 
+/// Multi-producer single-consumer queue of messages (an intrusive linked list
+/// with a stub node), drained by a background thread.
+class Logger::AsyncSink {
+public:
+    explicit AsyncSink(Logger &logger)
+        : logger_(logger),
+          head_(new Node()),
+          pushed_(0),
+          printed_(0),
+          stop_(false) {
+        tail_ = head_.load();
+        thread_ = std::thread([this]() { Run(); });
+    }
+
+    ~AsyncSink() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_cv_.notify_one();
+        thread_.join();
+        delete tail_;
+    }
+
+    void Push(VerbosityLevel level, std::string message) {
+        Node *node = new Node();
+        node->level_ = level;
+        node->message_ = std::move(message);
+        Node *previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next_.store(node, std::memory_order_release);
+        pushed_.fetch_add(1, std::memory_order_release);
+        wake_cv_.notify_one();
+    }
+
+    void Flush() {
+        const uint64_t target = pushed_.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_cv_.notify_one();
+        flushed_cv_.wait(lock, [this, target]() {
+            return printed_.load(std::memory_order_acquire) >= target;
+        });
+    }
+
+private:
+    class Node {
+    public:
+        std::atomic<Node *> next_{nullptr};
+        VerbosityLevel level_ = VerbosityLevel::Off;
+        std::string message_;
+    };
+
+    /// Prints the linked messages. Only the background thread moves tail_.
+    void PrintPending() {
+        Node *next = tail_->next_.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return;
+        }
+        while (next != nullptr) {
+            logger_.PrintNow(next->level_, next->message_);
+            next->message_.clear();
+            delete tail_;
+            tail_ = next;
+            printed_.fetch_add(1, std::memory_order_release);
+            next = tail_->next_.load(std::memory_order_acquire);
+        }
+        fflush(stdout);
+    }
+
+    void Run() {
+        while (true) {
+            PrintPending();
+            std::unique_lock<std::mutex> lock(mutex_);
+            flushed_cv_.notify_all();
+            if (stop_) {
+                break;
+            }
+            // Producers notify without the lock, so a wake-up can be missed;
+            // the timeout bounds the delay.
+            wake_cv_.wait_for(lock, std::chrono::milliseconds(10), [this]() {
+                return stop_ ||
+                       tail_->next_.load(std::memory_order_acquire) != nullptr;
+            });
+        }
+        PrintPending();
+    }
+
+private:
+    Logger &logger_;
+    std::atomic<Node *> head_;
+    Node *tail_;
+    std::atomic<uint64_t> pushed_;
+    std::atomic<uint64_t> printed_;
+    bool stop_;
+    std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable flushed_cv_;
+    std::thread thread_;
+};
+
+Logger::Logger() : verbosity_level_(VerbosityLevel::Info), async_(false) {}
+
+Logger::~Logger() {
+    async_.store(false, std::memory_order_release);
+    async_sink_.reset();
+}
+
 void Logger::ChangeConsoleColor(TextColor text_color, int highlight_text) {
 #ifdef _WIN32
     const WORD EMPHASIS_MASK[2] = {0, FOREGROUND_INTENSITY};
@@ -79,6 +189,157 @@ void Logger::ResetConsoleColor() {
 #endif
 }
 
+void Logger::Print(VerbosityLevel level, std::string message) {
+    if (async_.load(std::memory_order_acquire)) {
+        if (level != VerbosityLevel::Fatal) {
+            async_sink_->Push(level, std::move(message));
+            return;
+        }
+        async_sink_->Flush();
+    }
+    PrintNow(level, message);
+}
+
+void Logger::PrintNow(VerbosityLevel level, const std::string &message) {
+    switch (level) {
+        case VerbosityLevel::Fatal:
+            ChangeConsoleColor(TextColor::Red, 1);
+            fmt::print("[Open3D FATAL] {}", message);
+            ResetConsoleColor();
+            break;
+        case VerbosityLevel::Error:
+            ChangeConsoleColor(TextColor::Red, 1);
+            fmt::print("[Open3D ERROR] {}", message);
+            ResetConsoleColor();
+            break;
+        case VerbosityLevel::Warning:
+            ChangeConsoleColor(TextColor::Yellow, 1);
+            fmt::print("[Open3D WARNING] {}", message);
+            ResetConsoleColor();
+            break;
+        case VerbosityLevel::Info:
+            fmt::print("[Open3D INFO] {}", message);
+            break;
+        case VerbosityLevel::Debug:
+            fmt::print("[Open3D DEBUG] {}", message);
+            break;
+        default:
+            break;
+    }
+}
+
+void Logger::SetAsync(bool async) {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (async) {
+        // The sink is kept once created, so that threads that still see the
+        // flag set never push to a destroyed queue.
+        if (!async_sink_) {
+            async_sink_.reset(new AsyncSink(*this));
+        }
+        async_.store(true, std::memory_order_release);
+    } else if (async_sink_) {
+        async_.store(false, std::memory_order_release);
+        async_sink_->Flush();
+    }
+}
+
+void Logger::Flush() {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (async_sink_) {
+        async_sink_->Flush();
+    }
+}
+
+namespace {
+
+std::shared_ptr<const ProgressCallback> g_progress_callback;
+
+}  // unnamed namespace
+
+void SetProgressCallback(const ProgressCallback &callback) {
+    std::shared_ptr<const ProgressCallback> ptr;
+    if (callback) {
+        ptr = std::make_shared<const ProgressCallback>(callback);
+    }
+    std::atomic_store(&g_progress_callback, ptr);
+}
+
+std::shared_ptr<const ProgressCallback> GetProgressCallback() {
+    return std::atomic_load(&g_progress_callback);
+}
+
+void ConsoleProgressBar::reset(size_t expected_count,
+                               const std::string &progress_info,
+                               bool active) {
+    expected_count_ = expected_count;
+    current_count_.store(0);
+    progress_pixel_.store(0);
+    progress_info_ = progress_info;
+    active_ = active;
+    callback_ = GetProgressCallback();
+    reported_pixel_ = 0;
+    if (!active_ && !callback_) {
+        next_report_count_.store(std::numeric_limits<size_t>::max());
+        return;
+    }
+    next_report_count_.store(GetPixelCount(1));
+    if (expected_count_ == 0) {
+        Report(0);
+    }
+}
+
+size_t ConsoleProgressBar::GetPixelCount(size_t pixel) const {
+    if (pixel >= resolution_) {
+        return expected_count_;
+    }
+    return (pixel * expected_count_ + resolution_ - 1) / resolution_;
+}
+
+void ConsoleProgressBar::Report(size_t current_count) {
+    const size_t pixel =
+            current_count >= expected_count_
+                    ? resolution_
+                    : current_count * resolution_ / expected_count_;
+    size_t previous_pixel = progress_pixel_.load();
+    do {
+        if (pixel <= previous_pixel) {
+            return;
+        }
+    } while (!progress_pixel_.compare_exchange_weak(previous_pixel, pixel));
+    next_report_count_.store(pixel >= resolution_
+                                     ? std::numeric_limits<size_t>::max()
+                                     : GetPixelCount(pixel + 1));
+
+    // Steps won by different threads are reported in order, and a step that
+    // was overtaken while waiting is skipped.
+    std::lock_guard<std::mutex> lock(report_mutex_);
+    const size_t latest_pixel = progress_pixel_.load();
+    if (latest_pixel <= reported_pixel_) {
+        return;
+    }
+    reported_pixel_ = latest_pixel;
+    const size_t count = latest_pixel >= resolution_
+                                 ? expected_count_
+                                 : std::min(current_count_.load(),
+                                            expected_count_);
+    if (active_) {
+        if (latest_pixel >= resolution_) {
+            fmt::print("{}[{}] 100%\n", progress_info_,
+                       std::string(resolution_, '='));
+        } else {
+            int percent = int(count * 100 / expected_count_);
+            fmt::print("{}[{}>{}] {:d}%\r", progress_info_,
+                       std::string(latest_pixel, '='),
+                       std::string(resolution_ - 1 - latest_pixel, ' '),
+                       percent);
+            fflush(stdout);
+        }
+    }
+    if (callback_) {
+        (*callback_)(progress_info_, count, expected_count_);
+    }
+}
+
 std::string GetCurrentTimeStamp() {
     std::time_t t = std::time(nullptr);
     return fmt::format("{:%Y-%m-%d-%H-%M-%S}", *std::localtime(&t));
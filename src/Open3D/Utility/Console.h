@@ -27,6 +27,10 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -63,7 +67,8 @@ public:
         White = 7
     };
 
-    Logger() : verbosity_level_(VerbosityLevel::Info) {}
+    Logger();
+    ~Logger();
     Logger(Logger const &) = delete;
     void operator=(Logger const &) = delete;
 
@@ -79,45 +84,48 @@ public:
     void ChangeConsoleColor(TextColor text_color, int highlight_text);
     void ResetConsoleColor();
 
+    /// Function to print \param message with the prefix and color of \param
+    /// level. With asynchronous logging the message is queued and printed by
+    /// a background thread; fatal messages flush the queue and print
+    /// synchronously.
+    void Print(VerbosityLevel level, std::string message);
+
+    /// Function to switch asynchronous logging on or off. Switching it off
+    /// flushes the queued messages.
+    void SetAsync(bool async);
+    bool IsAsync() const { return async_.load(std::memory_order_acquire); }
+
+    /// Function to wait until all queued messages are printed
+    void Flush();
+
     void VFatal(const char *format, fmt::format_args args) {
         if (verbosity_level_ >= VerbosityLevel::Fatal) {
-            ChangeConsoleColor(TextColor::Red, 1);
-            fmt::print("[Open3D FATAL] ");
-            fmt::vprint(format, args);
-            ResetConsoleColor();
+            Print(VerbosityLevel::Fatal, fmt::vformat(format, args));
             exit(-1);
         }
     }
 
     void VError(const char *format, fmt::format_args args) {
         if (verbosity_level_ >= VerbosityLevel::Error) {
-            ChangeConsoleColor(TextColor::Red, 1);
-            fmt::print("[Open3D ERROR] ");
-            fmt::vprint(format, args);
-            ResetConsoleColor();
+            Print(VerbosityLevel::Error, fmt::vformat(format, args));
         }
     }
 
     void VWarning(const char *format, fmt::format_args args) {
         if (verbosity_level_ >= VerbosityLevel::Warning) {
-            ChangeConsoleColor(TextColor::Yellow, 1);
-            fmt::print("[Open3D WARNING] ");
-            fmt::vprint(format, args);
-            ResetConsoleColor();
+            Print(VerbosityLevel::Warning, fmt::vformat(format, args));
         }
     }
 
     void VInfo(const char *format, fmt::format_args args) {
         if (verbosity_level_ >= VerbosityLevel::Info) {
-            fmt::print("[Open3D INFO] ");
-            fmt::vprint(format, args);
+            Print(VerbosityLevel::Info, fmt::vformat(format, args));
         }
     }
 
     void VDebug(const char *format, fmt::format_args args) {
         if (verbosity_level_ >= VerbosityLevel::Debug) {
-            fmt::print("[Open3D DEBUG] ");
-            fmt::vprint(format, args);
+            Print(VerbosityLevel::Debug, fmt::vformat(format, args));
         }
     }
 
@@ -149,10 +157,7 @@ public:
     template <typename... Args>
     void Fatalf(const char *format, const Args &... args) {
         if (verbosity_level_ >= VerbosityLevel::Fatal) {
-            ChangeConsoleColor(TextColor::Red, 1);
-            fmt::print("[Open3D FATAL] ");
-            fmt::printf(format, args...);
-            ResetConsoleColor();
+            Print(VerbosityLevel::Fatal, fmt::sprintf(format, args...));
             exit(-1);
         }
     }
@@ -160,41 +165,42 @@ public:
     template <typename... Args>
     void Errorf(const char *format, const Args &... args) {
         if (verbosity_level_ >= VerbosityLevel::Error) {
-            ChangeConsoleColor(TextColor::Red, 1);
-            fmt::print("[Open3D ERROR] ");
-            fmt::printf(format, args...);
-            ResetConsoleColor();
+            Print(VerbosityLevel::Error, fmt::sprintf(format, args...));
         }
     }
 
     template <typename... Args>
     void Warningf(const char *format, const Args &... args) {
         if (verbosity_level_ >= VerbosityLevel::Warning) {
-            ChangeConsoleColor(TextColor::Yellow, 1);
-            fmt::print("[Open3D WARNING] ");
-            fmt::printf(format, args...);
-            ResetConsoleColor();
+            Print(VerbosityLevel::Warning, fmt::sprintf(format, args...));
         }
     }
 
     template <typename... Args>
     void Infof(const char *format, const Args &... args) {
         if (verbosity_level_ >= VerbosityLevel::Info) {
-            fmt::print("[Open3D INFO] ");
-            fmt::printf(format, args...);
+            Print(VerbosityLevel::Info, fmt::sprintf(format, args...));
         }
     }
 
     template <typename... Args>
     void Debugf(const char *format, const Args &... args) {
         if (verbosity_level_ >= VerbosityLevel::Debug) {
-            fmt::print("[Open3D DEBUG] ");
-            fmt::printf(format, args...);
+            Print(VerbosityLevel::Debug, fmt::sprintf(format, args...));
         }
     }
 
 public:
     VerbosityLevel verbosity_level_;
+
+private:
+    class AsyncSink;
+    void PrintNow(VerbosityLevel level, const std::string &message);
+
+private:
+    std::atomic<bool> async_;
+    std::mutex async_mutex_;
+    std::unique_ptr<AsyncSink> async_sink_;
 };
 
 inline void SetVerbosityLevel(VerbosityLevel level) {
@@ -205,6 +211,16 @@ inline VerbosityLevel GetVerbosityLevel() {
     return Logger::i().verbosity_level_;
 }
 
+/// Function to print log messages on a background thread instead of the
+/// calling thread, so that logging from parallel loops does not serialize the
+/// workers.
+inline void SetAsyncLogging(bool async) { Logger::i().SetAsync(async); }
+
+inline bool IsAsyncLogging() { return Logger::i().IsAsync(); }
+
+/// Function to wait until all asynchronously logged messages are printed
+inline void FlushLog() { Logger::i().Flush(); }
+
 template <typename... Args>
 inline void LogFatal(const char *format, const Args &... args) {
     Logger::i().VFatal(format, fmt::make_format_args(args...));
@@ -255,6 +271,23 @@ inline void LogDebugf(const char *format, const Args &... args) {
     Logger::i().Debugf(format, args...);
 }
 
+/// Callback that receives the progress of every ConsoleProgressBar, e.g. to
+/// forward it to a service instead of printing it.
+typedef std::function<void(const std::string &progress_info,
+                           size_t current_count,
+                           size_t expected_count)>
+        ProgressCallback;
+
+/// Function to set the progress callback of the progress bars created
+/// afterwards. An empty callback removes it.
+void SetProgressCallback(const ProgressCallback &callback);
+
+std::shared_ptr<const ProgressCallback> GetProgressCallback();
+
+/// Progress bar that can be advanced from several threads at once. The
+/// progress is printed (if active) and passed to the progress callback only
+/// when the bar grows by one of its 40 steps; other increments are a single
+/// atomic add.
 class ConsoleProgressBar {
 public:
     ConsoleProgressBar(size_t expected_count,
@@ -263,48 +296,42 @@ public:
         reset(expected_count, progress_info, active);
     }
 
+    /// Function to restart the bar. Must not run concurrently with
+    /// operator++.
     void reset(size_t expected_count,
                const std::string &progress_info,
-               bool active) {
-        expected_count_ = expected_count;
-        current_count_ = -1;
-        progress_info_ = progress_info;
-        progress_pixel_ = 0;
-        active_ = active;
-        operator++();
-    }
+               bool active);
 
     ConsoleProgressBar &operator++() {
-        current_count_++;
-        if (!active_) {
-            return *this;
-        }
-        if (current_count_ >= expected_count_) {
-            fmt::print("{}[{}] 100%\n", progress_info_,
-                       std::string(resolution_, '='));
-        } else {
-            size_t new_progress_pixel =
-                    int(current_count_ * resolution_ / expected_count_);
-            if (new_progress_pixel > progress_pixel_) {
-                progress_pixel_ = new_progress_pixel;
-                int percent = int(current_count_ * 100 / expected_count_);
-                fmt::print("{}[{}>{}] {:d}%\r", progress_info_,
-                           std::string(progress_pixel_, '='),
-                           std::string(resolution_ - 1 - progress_pixel_, ' '),
-                           percent);
-                fflush(stdout);
-            }
+        const size_t count =
+                current_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (count >= next_report_count_.load(std::memory_order_relaxed)) {
+            Report(count);
         }
         return *this;
     }
 
+private:
+    ConsoleProgressBar(const ConsoleProgressBar &) = delete;
+    ConsoleProgressBar &operator=(const ConsoleProgressBar &) = delete;
+
+    /// Smallest count at which the bar reaches \param pixel
+    size_t GetPixelCount(size_t pixel) const;
+    void Report(size_t current_count);
+
 private:
     const size_t resolution_ = 40;
     size_t expected_count_;
-    size_t current_count_;
+    std::atomic<size_t> current_count_;
+    /// Count at which the next step is reached, never reached if nobody
+    /// listens
+    std::atomic<size_t> next_report_count_;
+    std::atomic<size_t> progress_pixel_;
     std::string progress_info_;
-    size_t progress_pixel_;
     bool active_;
+    std::shared_ptr<const ProgressCallback> callback_;
+    std::mutex report_mutex_;
+    size_t reported_pixel_;
 };
 
 std::string GetCurrentTimeStamp();
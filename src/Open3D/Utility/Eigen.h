@@ -28,9 +28,13 @@
 
 #include <Eigen/Core>
 #include <Eigen/StdVector>
+#include <algorithm>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include "Open3D/Utility/Console.h"
+
 namespace Eigen {
 
 /// Extending Eigen namespace by adding frequently used matrix type
@@ -88,30 +92,148 @@ std::tuple<bool, std::vector<Eigen::Matrix4d, Matrix4d_allocator>>
 SolveJacobianSystemAndObtainExtrinsicMatrixArray(const Eigen::MatrixXd &JTJ,
                                                  const Eigen::VectorXd &JTr);
 
-/// Function to compute JTJ and Jtr
-/// Input: function pointer f and total number of rows of Jacobian matrix
-/// Output: JTJ, JTr, sum of r^2
-/// Note: f takes index of row, and outputs corresponding residual and row
-/// vector.
-template <typename MatType, typename VecType>
-std::tuple<MatType, VecType, double> ComputeJTJandJTr(
-        std::function<void(int, VecType &, double &)> f,
-        int iteration_num,
-        bool verbose = true);
+/// Running sums of JTJ, JTr and r^2 over rows of a Jacobian matrix with a
+/// fixed number of columns. Only the upper triangle of JTJ is accumulated,
+/// packed column by column, so that the update of a row compiles to a short
+/// unrolled sequence of multiply-adds.
+template <typename VecType>
+class JTJandJTrAccumulator {
+public:
+    static_assert(VecType::RowsAtCompileTime > 0,
+                  "JTJandJTrAccumulator needs a fixed size vector type");
+    static const int N = VecType::RowsAtCompileTime;
+
+    JTJandJTrAccumulator() : r2_sum_(0.0) {
+        std::fill(JTJ_, JTJ_ + N * (N + 1) / 2, 0.0);
+        std::fill(JTr_, JTr_ + N, 0.0);
+    }
+
+    void Add(const VecType &J_r, double r) {
+        // A local copy tells the compiler that J_r does not alias the sums
+        double J[N];
+        for (int i = 0; i < N; i++) {
+            J[i] = J_r(i);
+        }
+        int k = 0;
+        for (int c = 0; c < N; c++) {
+            for (int i = 0; i <= c; i++) {
+                JTJ_[k++] += J[i] * J[c];
+            }
+            JTr_[c] += J[c] * r;
+        }
+        r2_sum_ += r * r;
+    }
+
+    void Add(const JTJandJTrAccumulator &other) {
+        for (int k = 0; k < N * (N + 1) / 2; k++) {
+            JTJ_[k] += other.JTJ_[k];
+        }
+        for (int c = 0; c < N; c++) {
+            JTr_[c] += other.JTr_[c];
+        }
+        r2_sum_ += other.r2_sum_;
+    }
+
+    template <typename MatType>
+    void Get(MatType &JTJ, VecType &JTr, double &r2_sum) const {
+        int k = 0;
+        for (int c = 0; c < N; c++) {
+            for (int i = 0; i <= c; i++, k++) {
+                JTJ(i, c) = JTJ_[k];
+                JTJ(c, i) = JTJ_[k];
+            }
+            JTr(c) = JTr_[c];
+        }
+        r2_sum = r2_sum_;
+    }
+
+private:
+    double JTJ_[N * (N + 1) / 2];
+    double JTr_[N];
+    double r2_sum_;
+};
+
+/// Function to add the rows [begin, end) produced by f(i, J_r, r)
+template <typename VecType, typename FuncType>
+auto AddJTJandJTrRows(const FuncType &f,
+                      int begin,
+                      int end,
+                      JTJandJTrAccumulator<VecType> &accumulator)
+        -> decltype(f(0, std::declval<VecType &>(), std::declval<double &>()),
+                    void()) {
+    // Summing into a local lets the compiler keep the sums in registers
+    JTJandJTrAccumulator<VecType> sum;
+    VecType J_r;
+    double r;
+    for (int i = begin; i < end; i++) {
+        f(i, J_r, r);
+        sum.Add(J_r, r);
+    }
+    accumulator.Add(sum);
+}
+
+/// Function to add the rows [begin, end) when f(i, J_r, r) outputs several
+/// rows and residuals per index
+template <typename VecType, typename FuncType>
+auto AddJTJandJTrRows(const FuncType &f,
+                      int begin,
+                      int end,
+                      JTJandJTrAccumulator<VecType> &accumulator)
+        -> decltype(f(0,
+                      std::declval<std::vector<
+                              VecType, Eigen::aligned_allocator<VecType>> &>(),
+                      std::declval<std::vector<double> &>()),
+                    void()) {
+    JTJandJTrAccumulator<VecType> sum;
+    std::vector<VecType, Eigen::aligned_allocator<VecType>> J_r;
+    std::vector<double> r;
+    for (int i = begin; i < end; i++) {
+        f(i, J_r, r);
+        for (int j = 0; j < (int)r.size(); j++) {
+            sum.Add(J_r[j], r[j]);
+        }
+    }
+    accumulator.Add(sum);
+}
 
 /// Function to compute JTJ and Jtr
-/// Input: function pointer f and total number of rows of Jacobian matrix
+/// Input: functor f and total number of rows of Jacobian matrix
 /// Output: JTJ, JTr, sum of r^2
 /// Note: f takes index of row, and outputs corresponding residual and row
-/// vector.
-template <typename MatType, typename VecType>
-std::tuple<MatType, VecType, double> ComputeJTJandJTr(
-        std::function<
-                void(int,
-                     std::vector<VecType, Eigen::aligned_allocator<VecType>> &,
-                     std::vector<double> &)> f,
-        int iteration_num,
-        bool verbose = true);
+/// vector, either as f(int, VecType &, double &) or as several rows and
+/// residuals in f(int, std::vector<VecType> &, std::vector<double> &).
+/// Rows are summed in blocks of fixed size whose sums are combined in a fixed
+/// tree order, so the result does not depend on the number of threads.
+template <typename MatType, typename VecType, typename FuncType>
+std::tuple<MatType, VecType, double> ComputeJTJandJTr(const FuncType &f,
+                                                      int iteration_num,
+                                                      bool verbose = true) {
+    const int block_size = 1024;
+    const int num_blocks = (iteration_num + block_size - 1) / block_size;
+    std::vector<JTJandJTrAccumulator<VecType>> sums(std::max(num_blocks, 1));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int b = 0; b < num_blocks; b++) {
+        AddJTJandJTrRows(f, b * block_size,
+                         std::min((b + 1) * block_size, iteration_num),
+                         sums[b]);
+    }
+    for (size_t stride = 1; stride < sums.size(); stride *= 2) {
+        for (size_t b = 0; b + stride < sums.size(); b += 2 * stride) {
+            sums[b].Add(sums[b + stride]);
+        }
+    }
+    MatType JTJ;
+    VecType JTr;
+    double r2_sum;
+    sums[0].Get(JTJ, JTr, r2_sum);
+    if (verbose) {
+        LogDebug("Residual : {:.2e} (# of elements : {:d})\n",
+                 r2_sum / (double)iteration_num, iteration_num);
+    }
+    return std::make_tuple(std::move(JTJ), std::move(JTr), r2_sum);
+}
 
 Eigen::Matrix3d RotationMatrixX(double radians);
 Eigen::Matrix3d RotationMatrixY(double radians);
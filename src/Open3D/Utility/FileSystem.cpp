@@ -37,7 +37,9 @@
 #endif
 #else
 #include <dirent.h>
+#include <fcntl.h>
 #include <limits.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
@@ -199,6 +201,55 @@ bool ListFilesInDirectoryWithExtension(const std::string &directory,
     return true;
 }
 
+MappedFile::MappedFile(const std::string &filename) {
+#ifdef WINDOWS
+    FILE *file = fopen(filename.c_str(), "rb");
+    if (file == NULL) {
+        return;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size >= 0) {
+        buffer_.resize(size_t(size));
+        is_open_ = fread(buffer_.data(), 1, buffer_.size(), file) ==
+                   buffer_.size();
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+    }
+    fclose(file);
+#else
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode)) {
+        size_ = size_t(info.st_size);
+        if (size_ == 0) {
+            is_open_ = true;
+        } else {
+            void *data = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data != MAP_FAILED) {
+                data_ = (const char *)data;
+                is_open_ = true;
+            } else {
+                size_ = 0;
+            }
+        }
+    }
+    close(fd);
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifndef WINDOWS
+    if (data_ != nullptr) {
+        munmap((void *)data_, size_);
+    }
+#endif
+}
+
 }  // namespace filesystem
 }  // namespace utility
 }  // namespace open3d
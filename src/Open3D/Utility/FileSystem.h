@@ -66,6 +66,27 @@ bool ListFilesInDirectoryWithExtension(const std::string &directory,
                                        const std::string &extname,
                                        std::vector<std::string> &filenames);
 
+/// Read-only view of the content of a file. The file is mapped in memory, or
+/// read into memory on Windows.
+class MappedFile {
+public:
+    MappedFile(const std::string &filename);
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+public:
+    bool IsOpen() const { return is_open_; }
+    const char *GetData() const { return data_; }
+    size_t GetSize() const { return size_; }
+
+private:
+    bool is_open_ = false;
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<char> buffer_;
+};
+
 }  // namespace filesystem
 }  // namespace utility
 }  // namespace open3d
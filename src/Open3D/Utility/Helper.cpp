@@ -26,9 +26,12 @@
 
 #include "Open3D/Utility/Helper.h"
 
+#include <algorithm>
 #include <cctype>
 #include <unordered_set>
 
+#include "Open3D/Utility/Parallel.h"
+
 #ifdef _WIN32
 #include <windows.h>
 #else
@@ -89,6 +92,100 @@ size_t WordLength(const std::string& doc,
     return length;
 }
 
+void RadixSortByCode(std::vector<std::pair<uint64_t, size_t>>& v,
+                     size_t num_bits) {
+    const int radix_bits = 8;
+    const int num_buckets = 1 << radix_bits;
+    const int num_chunks = GetMaxThreads();
+    std::vector<std::pair<uint64_t, size_t>> buffer(v.size());
+    std::vector<size_t> offsets((size_t)num_chunks * num_buckets);
+    for (size_t shift = 0; shift < num_bits; shift += radix_bits) {
+        ParallelFor(0, num_chunks, [&](int c) {
+            size_t* histogram = offsets.data() + (size_t)c * num_buckets;
+            std::fill(histogram, histogram + num_buckets, 0);
+            const size_t end = v.size() * (c + 1) / num_chunks;
+            for (size_t i = v.size() * c / num_chunks; i < end; i++) {
+                histogram[(v[i].first >> shift) & (num_buckets - 1)]++;
+            }
+        });
+        // Exclusive prefix sum in (bucket, chunk) order
+        size_t sum = 0;
+        for (int b = 0; b < num_buckets; b++) {
+            for (int c = 0; c < num_chunks; c++) {
+                size_t& offset = offsets[(size_t)c * num_buckets + b];
+                const size_t count = offset;
+                offset = sum;
+                sum += count;
+            }
+        }
+        ParallelFor(0, num_chunks, [&](int c) {
+            size_t* offset = offsets.data() + (size_t)c * num_buckets;
+            const size_t end = v.size() * (c + 1) / num_chunks;
+            for (size_t i = v.size() * c / num_chunks; i < end; i++) {
+                buffer[offset[(v[i].first >> shift) & (num_buckets - 1)]++] =
+                        v[i];
+            }
+        });
+        v.swap(buffer);
+    }
+}
+
+std::vector<size_t> FindRunStarts(size_t n,
+                                  const std::function<uint64_t(size_t)>& key) {
+    const int num_chunks = GetMaxThreads();
+    std::vector<std::vector<size_t>> chunk_starts(num_chunks);
+    ParallelFor(0, num_chunks, [&](int c) {
+        const size_t begin = n * c / num_chunks;
+        const size_t end = n * (c + 1) / num_chunks;
+        for (size_t i = begin; i < end; i++) {
+            if (i == 0 || key(i) != key(i - 1)) {
+                chunk_starts[c].push_back(i);
+            }
+        }
+    });
+    std::vector<size_t> starts;
+    for (const auto& chunk : chunk_starts) {
+        starts.insert(starts.end(), chunk.begin(), chunk.end());
+    }
+    starts.push_back(n);
+    return starts;
+}
+
+std::vector<int> FindFirstEqual(size_t n,
+                                const std::function<size_t(int)>& hash,
+                                const std::function<bool(int, int)>& equal) {
+    std::vector<std::pair<uint64_t, size_t>> keys(n);
+    ParallelFor(0, (int)n, [&](int i) {
+        keys[i] = std::make_pair((uint64_t)hash(i), (size_t)i);
+    });
+    RadixSortByCode(keys);
+    const std::vector<size_t> starts =
+            FindRunStarts(n, [&keys](size_t i) { return keys[i].first; });
+    std::vector<int> first(n);
+    ParallelForRange(0, (int)starts.size() - 1, [&](int run_begin,
+                                                     int run_end) {
+        // Distinct elements of the current run, in increasing index order
+        std::vector<int> distinct;
+        for (int r = run_begin; r < run_end; r++) {
+            distinct.clear();
+            for (size_t k = starts[r]; k < starts[r + 1]; k++) {
+                const int i = (int)keys[k].second;
+                first[i] = i;
+                for (int j : distinct) {
+                    if (equal(j, i)) {
+                        first[i] = j;
+                        break;
+                    }
+                }
+                if (first[i] == i) {
+                    distinct.push_back(i);
+                }
+            }
+        }
+    });
+    return first;
+}
+
 void Sleep(int milliseconds) {
 #ifdef _WIN32
     Sleep(milliseconds);
@@ -26,9 +26,11 @@
 
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace open3d {
@@ -101,6 +103,26 @@ struct hash {
 
 }  // namespace hash_eigen
 
+/// Stable LSD radix sort of (code, payload) pairs by the lowest num_bits bits
+/// of the code. Each pass builds per-chunk histograms over contiguous chunks,
+/// so that the scatter can run in parallel and still preserve the order.
+void RadixSortByCode(std::vector<std::pair<uint64_t, size_t>>& v,
+                     size_t num_bits = 64);
+
+/// Returns the start of every run of equal keys among the n sorted keys
+/// key(0), ..., key(n - 1), followed by n.
+std::vector<size_t> FindRunStarts(size_t n,
+                                  const std::function<uint64_t(size_t)>& key);
+
+/// Returns for each of the n elements the smallest index of an element equal
+/// to it. Elements are bucketed by a radix sort of hash(i) and compared with
+/// equal(i, j) inside each bucket, so the result does not depend on the
+/// number of threads. Elements that are not equal to themselves (e.g.
+/// coordinates holding NaN) stay unique.
+std::vector<int> FindFirstEqual(size_t n,
+                                const std::function<size_t(int)>& hash,
+                                const std::function<bool(int, int)>& equal);
+
 /// Function to split a string, mimics boost::split
 /// http://stackoverflow.com/questions/236129/split-a-string-in-c
 void SplitString(std::vector<std::string>& tokens,
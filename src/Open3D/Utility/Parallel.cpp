@@ -0,0 +1,296 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Utility/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace open3d {
+namespace utility {
+
+namespace {
+
+std::atomic<int> g_backend((int)ParallelBackend::OpenMP);
+std::atomic<int> g_max_threads(0);
+
+/// Cap set by the innermost ScopedMaxThreads of the thread, 0 if none
+thread_local int tls_max_threads = 0;
+/// Whether the thread runs chunks of a parallel loop
+thread_local bool tls_in_parallel = false;
+
+int GetDefaultMaxThreads() {
+    static const int default_max_threads = []() {
+#ifdef _OPENMP
+        return std::max(omp_get_max_threads(), 1);
+#else
+        return std::max((int)std::thread::hardware_concurrency(), 1);
+#endif
+    }();
+    return default_max_threads;
+}
+
+/// Static partition of the loop into one chunk per thread, the same split as
+/// schedule(static).
+void RunOpenMP(int begin,
+               int end,
+               int num_threads,
+               const std::function<void(int, int)> &f) {
+#ifdef _OPENMP
+    const int64_t n = end - begin;
+#pragma omp parallel num_threads(num_threads)
+    {
+        const int64_t tid = omp_get_thread_num();
+        const int64_t nt = omp_get_num_threads();
+        const int chunk_begin = begin + int(n * tid / nt);
+        const int chunk_end = begin + int(n * (tid + 1) / nt);
+        if (chunk_begin < chunk_end) {
+            f(chunk_begin, chunk_end);
+        }
+    }
+#else
+    (void)num_threads;
+    f(begin, end);
+#endif
+}
+
+class ThreadPool {
+public:
+    static ThreadPool &GetInstance() {
+        static ThreadPool instance;
+        return instance;
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    /// The calling thread runs chunks as well, so at most num_threads - 1
+    /// workers join the loop.
+    void Run(int begin,
+             int end,
+             int num_threads,
+             const std::function<void(int, int)> &f) {
+        auto job = std::make_shared<Job>();
+        job->f_ = &f;
+        job->end_ = end;
+        // A few chunks per thread to balance uneven iterations.
+        job->chunk_size_ = std::max((end - begin) / (num_threads * 4), 1);
+        job->num_chunks_ =
+                (end - begin + job->chunk_size_ - 1) / job->chunk_size_;
+        job->next_ = begin;
+        job->max_helpers_ = num_threads - 1;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            while ((int)workers_.size() < num_threads - 1) {
+                workers_.emplace_back([this]() { WorkerLoop(); });
+            }
+            jobs_.push_back(job);
+        }
+        cv_.notify_all();
+
+        RunChunks(*job);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = std::find(jobs_.begin(), jobs_.end(), job);
+            if (it != jobs_.end()) {
+                jobs_.erase(it);
+            }
+        }
+        std::unique_lock<std::mutex> lock(job->done_mutex_);
+        job->done_cv_.wait(lock, [&job]() {
+            return job->done_chunks_.load() == job->num_chunks_;
+        });
+    }
+
+private:
+    class Job {
+    public:
+        const std::function<void(int, int)> *f_;
+        int end_;
+        int chunk_size_;
+        int num_chunks_;
+        int max_helpers_;
+        int num_helpers_ = 0;
+        std::atomic<int64_t> next_;
+        std::atomic<int> done_chunks_{0};
+        std::mutex done_mutex_;
+        std::condition_variable done_cv_;
+    };
+
+    ThreadPool() : stop_(false) {}
+
+    static void RunChunks(Job &job) {
+        const bool in_parallel = tls_in_parallel;
+        tls_in_parallel = true;
+        while (true) {
+            const int64_t chunk_begin = job.next_.fetch_add(job.chunk_size_);
+            if (chunk_begin >= job.end_) {
+                break;
+            }
+            const int64_t chunk_end = chunk_begin + job.chunk_size_;
+            (*job.f_)(int(chunk_begin),
+                      int(std::min<int64_t>(chunk_end, job.end_)));
+            if (job.done_chunks_.fetch_add(1) + 1 == job.num_chunks_) {
+                std::lock_guard<std::mutex> lock(job.done_mutex_);
+                job.done_cv_.notify_all();
+            }
+        }
+        tls_in_parallel = in_parallel;
+    }
+
+    /// Returns a job that has chunks left and is below its thread cap.
+    std::shared_ptr<Job> FindJob() {
+        for (auto &job : jobs_) {
+            if (job->num_helpers_ < job->max_helpers_ &&
+                job->next_.load() < job->end_) {
+                return job;
+            }
+        }
+        return nullptr;
+    }
+
+    void WorkerLoop() {
+#ifdef _OPENMP
+        // Plain OpenMP regions inside a chunk must not spawn a team for
+        // every worker.
+        omp_set_num_threads(1);
+#endif
+        while (true) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this, &job]() {
+                    job = FindJob();
+                    return stop_ || job != nullptr;
+                });
+                if (stop_) {
+                    return;
+                }
+                job->num_helpers_++;
+            }
+            RunChunks(*job);
+        }
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::shared_ptr<Job>> jobs_;
+    std::vector<std::thread> workers_;
+    bool stop_;
+};
+
+}  // unnamed namespace
+
+void SetParallelBackend(ParallelBackend backend) {
+    g_backend.store((int)backend);
+}
+
+ParallelBackend GetParallelBackend() {
+    return (ParallelBackend)g_backend.load();
+}
+
+void SetGlobalMaxThreads(int num_threads) {
+    g_max_threads.store(std::max(num_threads, 0));
+#ifdef _OPENMP
+    omp_set_num_threads(GetGlobalMaxThreads());
+#endif
+}
+
+int GetGlobalMaxThreads() {
+    const int num_threads = g_max_threads.load();
+    return num_threads > 0 ? num_threads : GetDefaultMaxThreads();
+}
+
+int GetMaxThreads() {
+    const int num_threads = GetGlobalMaxThreads();
+    return tls_max_threads > 0 ? std::min(tls_max_threads, num_threads)
+                               : num_threads;
+}
+
+bool IsInParallelRegion() {
+#ifdef _OPENMP
+    if (omp_in_parallel()) {
+        return true;
+    }
+#endif
+    return tls_in_parallel;
+}
+
+ScopedMaxThreads::ScopedMaxThreads(int num_threads)
+    : previous_max_threads_(tls_max_threads), previous_omp_threads_(0) {
+    tls_max_threads = std::max(num_threads, 1);
+#ifdef _OPENMP
+    previous_omp_threads_ = omp_get_max_threads();
+    omp_set_num_threads(GetMaxThreads());
+#endif
+}
+
+ScopedMaxThreads::~ScopedMaxThreads() {
+    tls_max_threads = previous_max_threads_;
+#ifdef _OPENMP
+    omp_set_num_threads(previous_omp_threads_);
+#endif
+}
+
+void ParallelForRange(int begin,
+                      int end,
+                      const std::function<void(int, int)> &f) {
+    if (begin >= end) {
+        return;
+    }
+    const int num_threads = std::min(GetMaxThreads(), end - begin);
+    if (num_threads <= 1 || IsInParallelRegion()) {
+        f(begin, end);
+        return;
+    }
+    if (GetParallelBackend() == ParallelBackend::ThreadPool) {
+        ThreadPool::GetInstance().Run(begin, end, num_threads, f);
+    } else {
+        RunOpenMP(begin, end, num_threads, f);
+    }
+}
+
+}  // namespace utility
+}  // namespace open3d
@@ -0,0 +1,100 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <functional>
+
+namespace open3d {
+namespace utility {
+
+/// Backends that run the loops of ParallelFor
+enum class ParallelBackend {
+    /// OpenMP parallel regions. Loops run serially when Open3D is built
+    /// without OpenMP.
+    OpenMP = 0,
+    /// A pool of persistent worker threads owned by Open3D. Concurrent loops
+    /// from different calling threads share the workers.
+    ThreadPool = 1,
+};
+
+void SetParallelBackend(ParallelBackend backend);
+ParallelBackend GetParallelBackend();
+
+/// Function to set the number of threads of the whole library. \param
+/// num_threads <= 0 restores the default, which is the OpenMP default
+/// (OMP_NUM_THREADS) or the hardware concurrency. The value is also applied
+/// to the plain OpenMP regions started by the calling thread.
+void SetGlobalMaxThreads(int num_threads);
+int GetGlobalMaxThreads();
+
+/// Number of threads a parallel loop started by the calling thread may use:
+/// the global limit, lowered by the innermost ScopedMaxThreads.
+int GetMaxThreads();
+
+/// Whether the calling thread already runs inside a parallel loop. Nested
+/// loops run inline on the calling thread instead of oversubscribing.
+bool IsInParallelRegion();
+
+/// RAII class that caps the threads used by the parallel loops started from
+/// the calling thread until it goes out of scope, e.g. to run several
+/// registrations concurrently with a share of the cores each. The cap also
+/// applies to the plain OpenMP regions started by the calling thread.
+class ScopedMaxThreads {
+public:
+    explicit ScopedMaxThreads(int num_threads);
+    ~ScopedMaxThreads();
+
+private:
+    ScopedMaxThreads(const ScopedMaxThreads &) = delete;
+    ScopedMaxThreads &operator=(const ScopedMaxThreads &) = delete;
+
+private:
+    int previous_max_threads_;
+    int previous_omp_threads_;
+};
+
+/// Function to split [begin, end) into chunks and call \param f(chunk_begin,
+/// chunk_end) for each of them in parallel with the current backend. Returns
+/// when all chunks are done. \param f must not throw.
+void ParallelForRange(int begin,
+                      int end,
+                      const std::function<void(int, int)> &f);
+
+/// Function to call \param f(i) for every i in [begin, end) in parallel, the
+/// replacement of `#pragma omp parallel for schedule(static)` for loops
+/// without reductions.
+template <typename FuncType>
+void ParallelFor(int begin, int end, const FuncType &f) {
+    ParallelForRange(begin, end, [&f](int chunk_begin, int chunk_end) {
+        for (int i = chunk_begin; i < chunk_end; i++) {
+            f(i);
+        }
+    });
+}
+
+}  // namespace utility
+}  // namespace open3d
@@ -0,0 +1,229 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Utility/Profiler.h"
+
+#include <cstdio>
+#include <map>
+
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace utility {
+
+namespace {
+
+std::string EscapeJsonString(const char *str) {
+    std::string escaped;
+    for (const char *c = str; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            escaped.push_back('\\');
+        }
+        escaped.push_back(*c);
+    }
+    return escaped;
+}
+
+}  // unnamed namespace
+
+Profiler::Profiler()
+    : enabled_(false), origin_(std::chrono::steady_clock::now()) {}
+
+Profiler &Profiler::GetInstance() {
+    static Profiler instance;
+    return instance;
+}
+
+void Profiler::SetEnabled(bool enabled) {
+    enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+Profiler::ThreadRecord &Profiler::GetThreadRecord() {
+    thread_local ThreadRecord *record = nullptr;
+    if (record == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        threads_.emplace_back(new ThreadRecord());
+        record = threads_.back().get();
+        record->thread_id_ = (int)threads_.size() - 1;
+    }
+    return *record;
+}
+
+double Profiler::GetTimeInMicroseconds() const {
+    return std::chrono::duration<double, std::micro>(
+                   std::chrono::steady_clock::now() - origin_)
+            .count();
+}
+
+void Profiler::BeginZone(const char *name) {
+    ThreadRecord &record = GetThreadRecord();
+    ProfileEvent event;
+    event.name_ = name;
+    event.thread_id_ = record.thread_id_;
+    event.parent_ = record.stack_.empty() ? -1 : record.stack_.back();
+    event.duration_us_ = -1.0;
+    event.points_ = 0;
+    event.bytes_ = 0;
+    record.stack_.push_back((int)record.events_.size());
+    record.events_.push_back(event);
+    // Taken last so that the bookkeeping is not part of the zone
+    record.events_.back().begin_us_ = GetTimeInMicroseconds();
+}
+
+void Profiler::EndZone() {
+    const double end_us = GetTimeInMicroseconds();
+    ThreadRecord &record = GetThreadRecord();
+    if (record.stack_.empty()) {
+        // The events were cleared while the zone was open
+        return;
+    }
+    ProfileEvent &event = record.events_[record.stack_.back()];
+    event.duration_us_ = end_us - event.begin_us_;
+    record.stack_.pop_back();
+}
+
+void Profiler::AddPoints(int64_t points) {
+    if (!IsEnabled()) return;
+    ThreadRecord &record = GetThreadRecord();
+    if (!record.stack_.empty()) {
+        record.events_[record.stack_.back()].points_ += points;
+    }
+}
+
+void Profiler::AddBytes(int64_t bytes) {
+    if (!IsEnabled()) return;
+    ThreadRecord &record = GetThreadRecord();
+    if (!record.stack_.empty()) {
+        record.events_[record.stack_.back()].bytes_ += bytes;
+    }
+}
+
+void Profiler::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (auto &record : threads_) {
+        record->events_.clear();
+        record->stack_.clear();
+    }
+}
+
+std::vector<ProfileEvent> Profiler::GetEvents() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<ProfileEvent> events;
+    for (const auto &record : threads_) {
+        // Closed zones only, with the parents renumbered accordingly
+        std::vector<int> new_index(record->events_.size(), -1);
+        for (size_t i = 0; i < record->events_.size(); i++) {
+            const ProfileEvent &event = record->events_[i];
+            if (event.duration_us_ < 0.0) continue;
+            new_index[i] = (int)events.size();
+            events.push_back(event);
+            events.back().parent_ =
+                    event.parent_ < 0 ? -1 : new_index[event.parent_];
+        }
+    }
+    return events;
+}
+
+bool Profiler::WriteChromeTrace(const std::string &filename) const {
+    FILE *file = fopen(filename.c_str(), "w");
+    if (file == NULL) {
+        LogWarning("Write Chrome trace failed: unable to open file: {}\n",
+                   filename);
+        return false;
+    }
+    const std::vector<ProfileEvent> events = GetEvents();
+    int num_threads = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        num_threads = (int)threads_.size();
+    }
+    fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    // The separator goes before every record but the first, so the array
+    // stays valid whichever kind of record comes last.
+    const char *separator = "\n";
+    for (int t = 0; t < num_threads; t++) {
+        fprintf(file,
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+                "\"tid\":%d,\"args\":{\"name\":\"thread %d\"}}",
+                separator, t, t);
+        separator = ",\n";
+    }
+    for (const ProfileEvent &event : events) {
+        fprintf(file,
+                "%s{\"name\":\"%s\",\"cat\":\"open3d\",\"ph\":\"X\","
+                "\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+                "\"args\":{\"points\":%lld,\"bytes\":%lld}}",
+                separator, EscapeJsonString(event.name_).c_str(),
+                event.thread_id_, event.begin_us_, event.duration_us_,
+                (long long)event.points_, (long long)event.bytes_);
+        separator = ",\n";
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+    return true;
+}
+
+void Profiler::PrintSummary() const {
+    class ZoneSummary {
+    public:
+        int depth_ = 0;
+        int calls_ = 0;
+        double total_us_ = 0.0;
+        int64_t points_ = 0;
+        int64_t bytes_ = 0;
+    };
+    const std::vector<ProfileEvent> events = GetEvents();
+    std::vector<std::string> paths(events.size());
+    std::vector<int> depths(events.size());
+    std::map<std::string, ZoneSummary> zones;
+    for (size_t i = 0; i < events.size(); i++) {
+        const ProfileEvent &event = events[i];
+        if (event.parent_ < 0) {
+            paths[i] = event.name_;
+            depths[i] = 0;
+        } else {
+            paths[i] = paths[event.parent_] + "/" + event.name_;
+            depths[i] = depths[event.parent_] + 1;
+        }
+        ZoneSummary &zone = zones[paths[i]];
+        zone.depth_ = depths[i];
+        zone.calls_++;
+        zone.total_us_ += event.duration_us_;
+        zone.points_ += event.points_;
+        zone.bytes_ += event.bytes_;
+    }
+    for (const auto &zone : zones) {
+        const std::string &path = zone.first;
+        const ZoneSummary &summary = zone.second;
+        std::string name = path.substr(path.rfind('/') + 1);
+        LogInfo("{}{}: {:d} calls, {:.3f} ms, {:d} points, {:d} bytes\n",
+                std::string(2 * summary.depth_, ' '), name, summary.calls_,
+                summary.total_us_ / 1000.0, summary.points_, summary.bytes_);
+    }
+}
+
+}  // namespace utility
+}  // namespace open3d
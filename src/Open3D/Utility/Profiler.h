@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace open3d {
+namespace utility {
+
+/// A closed zone recorded by the Profiler. Times are in microseconds since
+/// the profiler was created.
+class ProfileEvent {
+public:
+    /// Name of the zone, a string literal
+    const char *name_;
+    /// Index of the profiler thread that recorded the zone
+    int thread_id_;
+    /// Index of the enclosing zone of the same thread in the event list, or
+    /// -1 for a top-level zone
+    int parent_;
+    double begin_us_;
+    double duration_us_;
+    /// Number of points and bytes reported as processed inside the zone
+    int64_t points_;
+    int64_t bytes_;
+};
+
+/// Hierarchical profiler that records named zones with a stack per thread.
+/// Zones are placed with OPEN3D_PROFILE_ZONE, which compiles to nothing
+/// unless Open3D is built with ENABLE_PROFILER. Recording then also has to be
+/// switched on with SetEnabled. Clear, GetEvents and the exports must not run
+/// while other threads are inside a zone.
+class Profiler {
+public:
+    static Profiler &GetInstance();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /// Function to open a zone on the calling thread. \param name must stay
+    /// valid until the events are exported, e.g. a string literal.
+    void BeginZone(const char *name);
+
+    /// Function to close the innermost open zone of the calling thread
+    void EndZone();
+
+    /// Functions to add to the counters of the innermost open zone of the
+    /// calling thread
+    void AddPoints(int64_t points);
+    void AddBytes(int64_t bytes);
+
+    /// Function to drop all recorded events
+    void Clear();
+
+    /// Returns the closed zones of all threads. Parents come before their
+    /// children.
+    std::vector<ProfileEvent> GetEvents() const;
+
+    /// Function to write the closed zones in the Chrome trace event format,
+    /// which chrome://tracing and Perfetto can open
+    bool WriteChromeTrace(const std::string &filename) const;
+
+    /// Function to print the total time, calls and counters of every zone,
+    /// grouped by the path of enclosing zones
+    void PrintSummary() const;
+
+private:
+    class ThreadRecord {
+    public:
+        int thread_id_;
+        std::vector<ProfileEvent> events_;
+        std::vector<int> stack_;
+    };
+
+    Profiler();
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    ThreadRecord &GetThreadRecord();
+    double GetTimeInMicroseconds() const;
+
+private:
+    std::atomic<bool> enabled_;
+    std::chrono::steady_clock::time_point origin_;
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadRecord>> threads_;
+};
+
+/// Opens a profiler zone for the lifetime of the object
+class ProfileZone {
+public:
+    explicit ProfileZone(const char *name)
+        : active_(Profiler::GetInstance().IsEnabled()) {
+        if (active_) Profiler::GetInstance().BeginZone(name);
+    }
+    ~ProfileZone() {
+        if (active_) Profiler::GetInstance().EndZone();
+    }
+
+private:
+    bool active_;
+};
+
+}  // namespace utility
+}  // namespace open3d
+
+#define OPEN3D_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OPEN3D_PROFILE_CONCAT(a, b) OPEN3D_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef OPEN3D_ENABLE_PROFILER
+#define OPEN3D_PROFILE_ZONE(name)                         \
+    ::open3d::utility::ProfileZone OPEN3D_PROFILE_CONCAT( \
+            open3d_profile_zone_, __LINE__)(name)
+#define OPEN3D_PROFILE_POINTS(points) \
+    ::open3d::utility::Profiler::GetInstance().AddPoints((int64_t)(points))
+#define OPEN3D_PROFILE_BYTES(bytes) \
+    ::open3d::utility::Profiler::GetInstance().AddBytes((int64_t)(bytes))
+#else
+#define OPEN3D_PROFILE_ZONE(name)
+#define OPEN3D_PROFILE_POINTS(points)
+#define OPEN3D_PROFILE_BYTES(bytes)
+#endif
@@ -24,6 +24,7 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/DynamicKDTree.h"
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Python/docstring.h"
 #include "Python/geometry/geometry.h"
@@ -40,6 +41,11 @@ void pybind_kdtreeflann(py::module &m) {
                           "Get the search type (KNN, Radius, Hybrid) for the "
                           "search parameter.");
     docstring::ClassMethodDocInject(m, "KDTreeSearchParam", "get_search_type");
+    kdtreesearchparam.def("get_index_type",
+                          &geometry::KDTreeSearchParam::GetIndexType,
+                          "Get the index type (KDTree, FixedRadius) built for "
+                          "the search parameter.");
+    docstring::ClassMethodDocInject(m, "KDTreeSearchParam", "get_index_type");
 
     // open3d.geometry.KDTreeSearchParam.Type
     py::enum_<geometry::KDTreeSearchParam::SearchType> kdtree_search_param_type(
@@ -57,6 +63,21 @@ void pybind_kdtreeflann(py::module &m) {
             }),
             py::none(), py::none(), "");
 
+    // open3d.geometry.KDTreeSearchParam.IndexType
+    py::enum_<geometry::KDTreeSearchParam::IndexType>
+            kdtree_search_param_index_type(kdtreesearchparam, "IndexType",
+                                           py::arithmetic());
+    kdtree_search_param_index_type
+            .value("KDTree", geometry::KDTreeSearchParam::IndexType::KDTree)
+            .value("FixedRadius",
+                   geometry::KDTreeSearchParam::IndexType::FixedRadius)
+            .export_values();
+    kdtree_search_param_index_type.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class for the index built for a search.";
+            }),
+            py::none(), py::none(), "");
+
     // open3d.geometry.KDTreeSearchParamKNN
     py::class_<geometry::KDTreeSearchParamKNN> kdtreesearchparam_knn(
             m, "KDTreeSearchParamKNN", kdtreesearchparam,
@@ -76,7 +97,11 @@ void pybind_kdtreeflann(py::module &m) {
     py::class_<geometry::KDTreeSearchParamRadius> kdtreesearchparam_radius(
             m, "KDTreeSearchParamRadius", kdtreesearchparam,
             "KDTree search parameters for pure radius search.");
-    kdtreesearchparam_radius.def(py::init<double>(), "radius"_a)
+    kdtreesearchparam_radius
+            .def(py::init<double, geometry::KDTreeSearchParam::IndexType>(),
+                 "radius"_a,
+                 "index_type"_a =
+                         geometry::KDTreeSearchParam::IndexType::KDTree)
             .def("__repr__",
                  [](const geometry::KDTreeSearchParamRadius &param) {
                      return std::string(
@@ -93,7 +118,11 @@ void pybind_kdtreeflann(py::module &m) {
             m, "KDTreeSearchParamHybrid", kdtreesearchparam,
             "KDTree search parameters for hybrid KNN and radius search.");
     kdtreesearchparam_hybrid
-            .def(py::init<double, int>(), "radius"_a, "max_nn"_a)
+            .def(py::init<double, int,
+                          geometry::KDTreeSearchParam::IndexType>(),
+                 "radius"_a, "max_nn"_a,
+                 "index_type"_a =
+                         geometry::KDTreeSearchParam::IndexType::KDTree)
             .def("__repr__",
                  [](const geometry::KDTreeSearchParamHybrid &param) {
                      return std::string(
@@ -118,7 +147,9 @@ void pybind_kdtreeflann(py::module &m) {
                      "At maximum, ``max_nn`` neighbors will be searched."},
                     {"knn", "``knn`` neighbors will be searched."},
                     {"feature", "Feature data."},
-                    {"data", "Matrix data."}};
+                    {"data", "Matrix data."},
+                    {"points", "Points to add."},
+                    {"indices", "Indices of the points to remove."}};
     py::class_<geometry::KDTreeFlann, std::shared_ptr<geometry::KDTreeFlann>>
             kdtreeflann(m, "KDTreeFlann",
                         "KDTree with FLANN for nearest neighbor search.");
@@ -270,4 +301,79 @@ void pybind_kdtreeflann(py::module &m) {
                                     map_kd_tree_flann_method_docs);
     docstring::ClassMethodDocInject(m, "KDTreeFlann", "set_matrix_data",
                                     map_kd_tree_flann_method_docs);
+
+    // open3d.geometry.DynamicKDTree
+    py::class_<geometry::DynamicKDTree,
+               std::shared_ptr<geometry::DynamicKDTree>>
+            dynamickdtree(m, "DynamicKDTree",
+                          "KDTree over 3D points that supports adding and "
+                          "removing points.");
+    dynamickdtree.def(py::init<>())
+            .def(py::init<const Eigen::MatrixXd &>(), "data"_a)
+            .def("set_matrix_data", &geometry::DynamicKDTree::SetMatrixData,
+                 "data"_a)
+            .def(py::init<const geometry::Geometry &>(), "geometry"_a)
+            .def("set_geometry", &geometry::DynamicKDTree::SetGeometry,
+                 "geometry"_a)
+            .def("add_points", &geometry::DynamicKDTree::AddPoints,
+                 "Adds points, which get the indices following the points "
+                 "added before.",
+                 "points"_a)
+            .def("remove_points", &geometry::DynamicKDTree::RemovePoints,
+                 "Removes the points with the given indices.", "indices"_a)
+            .def("__len__", &geometry::DynamicKDTree::GetSize)
+            .def("search_knn_vector_3d",
+                 [](const geometry::DynamicKDTree &tree,
+                    const Eigen::Vector3d &query, int knn) {
+                     std::vector<int> indices;
+                     std::vector<double> distance2;
+                     int k = tree.SearchKNN(query, knn, indices, distance2);
+                     if (k < 0)
+                         throw std::runtime_error(
+                                 "search_knn_vector_3d() error!");
+                     return std::make_tuple(k, indices, distance2);
+                 },
+                 "query"_a, "knn"_a)
+            .def("search_radius_vector_3d",
+                 [](const geometry::DynamicKDTree &tree,
+                    const Eigen::Vector3d &query, double radius) {
+                     std::vector<int> indices;
+                     std::vector<double> distance2;
+                     int k = tree.SearchRadius(query, radius, indices,
+                                               distance2);
+                     if (k < 0)
+                         throw std::runtime_error(
+                                 "search_radius_vector_3d() error!");
+                     return std::make_tuple(k, indices, distance2);
+                 },
+                 "query"_a, "radius"_a)
+            .def("search_hybrid_vector_3d",
+                 [](const geometry::DynamicKDTree &tree,
+                    const Eigen::Vector3d &query, double radius, int max_nn) {
+                     std::vector<int> indices;
+                     std::vector<double> distance2;
+                     int k = tree.SearchHybrid(query, radius, max_nn, indices,
+                                               distance2);
+                     if (k < 0)
+                         throw std::runtime_error(
+                                 "search_hybrid_vector_3d() error!");
+                     return std::make_tuple(k, indices, distance2);
+                 },
+                 "query"_a, "radius"_a, "max_nn"_a);
+    docstring::ClassMethodDocInject(m, "DynamicKDTree", "add_points",
+                                    map_kd_tree_flann_method_docs);
+    docstring::ClassMethodDocInject(m, "DynamicKDTree", "remove_points",
+                                    map_kd_tree_flann_method_docs);
+    docstring::ClassMethodDocInject(m, "DynamicKDTree",
+                                    "search_hybrid_vector_3d",
+                                    map_kd_tree_flann_method_docs);
+    docstring::ClassMethodDocInject(m, "DynamicKDTree", "search_knn_vector_3d",
+                                    map_kd_tree_flann_method_docs);
+    docstring::ClassMethodDocInject(m, "DynamicKDTree",
+                                    "search_radius_vector_3d",
+                                    map_kd_tree_flann_method_docs);
+    docstring::ClassMethodDocInject(m, "DynamicKDTree", "set_geometry",
+                                    map_kd_tree_flann_method_docs);
+    docstring::ClassMethodDocInject(m, "DynamicKDTree", "set_matrix_data",
+                                    map_kd_tree_flann_method_docs);
 }
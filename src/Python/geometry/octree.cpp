@@ -231,8 +231,18 @@ void pybind_octree(py::module &m) {
                  &geometry::Octree::CreateFromVoxelGrid,
                  "voxel_grid"_a
                  "Convert from VoxelGrid.")
-            .def_readwrite("root_node", &geometry::Octree::root_node_,
-                           "OctreeNode: The root octree node.")
+            .def_property(
+                    "root_node",
+                    [](geometry::Octree &octree) {
+                        octree.ConvertToNodes();
+                        return octree.root_node_;
+                    },
+                    [](geometry::Octree &octree,
+                       const std::shared_ptr<geometry::OctreeNode> &node) {
+                        octree.linear_octree_.Clear();
+                        octree.root_node_ = node;
+                    },
+                    "OctreeNode: The root octree node.")
             .def_readwrite("origin", &geometry::Octree::origin_,
                            "(3, 1) float numpy array: Origin coordinate "
                            "of the octree.")
@@ -55,6 +55,9 @@ void pybind_pointcloud(py::module &m) {
                  "Returns ``True`` if the point cloud contains points.")
             .def("has_normals", &geometry::PointCloud::HasNormals,
                  "Returns ``True`` if the point cloud contains point normals.")
+            .def("has_covariances", &geometry::PointCloud::HasCovariances,
+                 "Returns ``True`` if the point cloud contains per-point "
+                 "covariances.")
             .def("has_colors", &geometry::PointCloud::HasColors,
                  "Returns ``True`` if the point cloud contains point colors.")
             .def("normalize_normals", &geometry::PointCloud::NormalizeNormals,
@@ -89,6 +92,12 @@ void pybind_pointcloud(py::module &m) {
                  "points with "
                  "the 0-th point always chosen, not at random.",
                  "every_k_points"_a)
+            .def("organized_down_sample",
+                 &geometry::PointCloud::OrganizedDownSample,
+                 "Function to downsample an organized pointcloud by "
+                 "averaging the valid points of every factor x factor block "
+                 "of pixels",
+                 "factor"_a)
             .def("crop", &geometry::PointCloud::Crop,
                  "Function to crop input pointcloud into output pointcloud",
                  "min_bound"_a, "max_bound"_a)
@@ -101,6 +110,12 @@ void pybind_pointcloud(py::module &m) {
                  "Function to remove points that have less than nb_points"
                  " in a given sphere of a given radius",
                  "nb_points"_a, "radius"_a)
+            .def("remove_organized_radius_outlier",
+                 &geometry::PointCloud::RemoveOrganizedRadiusOutliers,
+                 "Function to remove points of an organized pointcloud that "
+                 "have less than nb_points within the radius in their pixel "
+                 "window. The outliers are set to NaN",
+                 "nb_points"_a, "radius"_a, "window_radius"_a = 2)
             .def("remove_statistical_outlier",
                  &geometry::PointCloud::RemoveStatisticalOutliers,
                  "Function to remove points that are further away from their "
@@ -112,6 +127,15 @@ void pybind_pointcloud(py::module &m) {
                  "normals exist",
                  "search_param"_a = geometry::KDTreeSearchParamKNN(),
                  "fast_normal_computation"_a = true)
+            .def("estimate_normals_organized",
+                 &geometry::PointCloud::EstimateNormalsOrganized,
+                 "Function to compute the normals of an organized point "
+                 "cloud from pixel windows",
+                 "window_radius"_a = 2, "max_neighbor_distance"_a = 0.0,
+                 "fast_normal_computation"_a = true)
+            .def("is_organized", &geometry::PointCloud::IsOrganized,
+                 "Returns ``True`` if the points are stored in an image "
+                 "layout of width x height.")
             .def("orient_normals_to_align_with_direction",
                  &geometry::PointCloud::OrientNormalsToAlignWithDirection,
                  "Function to orient the normals of a point cloud",
@@ -164,7 +188,7 @@ void pybind_pointcloud(py::module &m) {
                     "depth"_a, "intrinsic"_a,
                     "extrinsic"_a = Eigen::Matrix4d::Identity(),
                     "depth_scale"_a = 1000.0, "depth_trunc"_a = 1000.0,
-                    "stride"_a = 1)
+                    "stride"_a = 1, "project_valid_depth_only"_a = true)
             .def_static(
                     "create_from_rgbd_image",
                     &geometry::PointCloud::CreateFromRGBDImage,
@@ -177,7 +201,8 @@ void pybind_pointcloud(py::module &m) {
               - y = (v - cy) * z / fy
         )",
                     "image"_a, "intrinsic"_a,
-                    "extrinsic"_a = Eigen::Matrix4d::Identity())
+                    "extrinsic"_a = Eigen::Matrix4d::Identity(),
+                    "project_valid_depth_only"_a = true)
             .def_readwrite("points", &geometry::PointCloud::points_,
                            "``float64`` array of shape ``(num_points, 3)``, "
                            "use ``numpy.asarray()`` to access data: Points "
@@ -190,9 +215,18 @@ void pybind_pointcloud(py::module &m) {
                     "colors", &geometry::PointCloud::colors_,
                     "``float64`` array of shape ``(num_points, 3)``, "
                     "range ``[0, 1]`` , use ``numpy.asarray()`` to access "
-                    "data: RGB colors of points.");
+                    "data: RGB colors of points.")
+            .def_readwrite("covariances", &geometry::PointCloud::covariances_,
+                           "``float64`` array of shape ``(num_points, 3, "
+                           "3)``, use ``numpy.asarray()`` to access data: "
+                           "Points covariances.")
+            .def_readwrite("width", &geometry::PointCloud::width_,
+                           "Image width of an organized point cloud.")
+            .def_readwrite("height", &geometry::PointCloud::height_,
+                           "Image height of an organized point cloud.");
     docstring::ClassMethodDocInject(m, "PointCloud", "has_colors");
     docstring::ClassMethodDocInject(m, "PointCloud", "has_normals");
+    docstring::ClassMethodDocInject(m, "PointCloud", "has_covariances");
     docstring::ClassMethodDocInject(m, "PointCloud", "has_points");
     docstring::ClassMethodDocInject(m, "PointCloud", "normalize_normals");
     docstring::ClassMethodDocInject(
@@ -216,6 +250,9 @@ void pybind_pointcloud(py::module &m) {
             m, "PointCloud", "uniform_down_sample",
             {{"every_k_points",
               "Sample rate, the selected point indices are [0, k, 2k, ...]"}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "organized_down_sample",
+            {{"factor", "Edge length of the pixel blocks to average."}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "crop",
             {{"min_bound", "Minimum bound for point coordinate"},
@@ -229,6 +266,11 @@ void pybind_pointcloud(py::module &m) {
             m, "PointCloud", "remove_radius_outlier",
             {{"nb_points", "Number of points within the radius."},
              {"radius", "Radius of the sphere."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "remove_organized_radius_outlier",
+            {{"nb_points", "Number of points within the radius."},
+             {"radius", "Radius of the sphere."},
+             {"window_radius", "Radius of the pixel window to search."}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "remove_statistical_outlier",
             {{"nb_neighbors", "Number of neighbors around the target point."},
@@ -241,6 +283,17 @@ void pybind_pointcloud(py::module &m) {
               "If true, the normal estiamtion uses a non-iterative method to "
               "extract the eigenvector from the covariance matrix. This is "
               "faster, but is not as numerical stable."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "estimate_normals_organized",
+            {{"window_radius", "Radius of the pixel window."},
+             {"max_neighbor_distance",
+              "If positive, neighbors further away from the center point are "
+              "ignored. Otherwise integral images are used."},
+             {"fast_normal_computation",
+              "If true, the normal estiamtion uses a non-iterative method to "
+              "extract the eigenvector from the covariance matrix. This is "
+              "faster, but is not as numerical stable."}});
+    docstring::ClassMethodDocInject(m, "PointCloud", "is_organized");
     docstring::ClassMethodDocInject(
             m, "PointCloud", "orient_normals_to_align_with_direction",
             {{"orientation_reference",
@@ -55,7 +55,8 @@ void pybind_tetramesh(py::module &m) {
             .def("remove_duplicated_vertices",
                  &geometry::TetraMesh::RemoveDuplicatedVertices,
                  "Function that removes duplicated vertices, i.e., vertices "
-                 "that have identical coordinates.")
+                 "that have identical coordinates.",
+                 "epsilon"_a = 0.0)
             .def("remove_duplicated_tetras",
                  &geometry::TetraMesh::RemoveDuplicatedTetras,
                  "Function that removes duplicated tetras, i.e., removes "
@@ -96,8 +97,11 @@ void pybind_tetramesh(py::module &m) {
                            "the tetra.");
     docstring::ClassMethodDocInject(m, "TetraMesh", "has_tetras");
     docstring::ClassMethodDocInject(m, "TetraMesh", "has_vertices");
-    docstring::ClassMethodDocInject(m, "TetraMesh",
-                                    "remove_duplicated_vertices");
+    docstring::ClassMethodDocInject(
+            m, "TetraMesh", "remove_duplicated_vertices",
+            {{"epsilon",
+              "If positive, vertices in the same grid cell of this size are "
+              "welded and their attributes averaged."}});
     docstring::ClassMethodDocInject(m, "TetraMesh", "remove_duplicated_tetras");
     docstring::ClassMethodDocInject(m, "TetraMesh",
                                     "remove_unreferenced_vertices");
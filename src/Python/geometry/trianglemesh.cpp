@@ -88,10 +88,15 @@ void pybind_trianglemesh(py::module &m) {
                  &geometry::TriangleMesh::ComputeAdjacencyList,
                  "Function to compute adjacency list, call before adjacency "
                  "list is needed")
+            .def("compute_adjacency_csr",
+                 &geometry::TriangleMesh::ComputeAdjacencyCSR,
+                 "Function to compute the vertex adjacency in compressed "
+                 "sparse row form")
             .def("remove_duplicated_vertices",
                  &geometry::TriangleMesh::RemoveDuplicatedVertices,
                  "Function that removes duplicated verties, i.e., vertices "
-                 "that have identical coordinates.")
+                 "that have identical coordinates.",
+                 "epsilon"_a = 0.0)
             .def("remove_duplicated_triangles",
                  &geometry::TriangleMesh::RemoveDuplicatedTriangles,
                  "Function that removes duplicated triangles, i.e., removes "
@@ -166,6 +171,9 @@ void pybind_trianglemesh(py::module &m) {
             .def("has_adjacency_list",
                  &geometry::TriangleMesh::HasAdjacencyList,
                  "Returns ``True`` if the mesh contains adjacency normals.")
+            .def("has_adjacency_csr", &geometry::TriangleMesh::HasAdjacencyCSR,
+                 "Returns ``True`` if the mesh contains the vertex adjacency "
+                 "in compressed sparse row form.")
             .def("normalize_normals", &geometry::TriangleMesh::NormalizeNormals,
                  "Normalize both triangle normals and vertex normals to legnth "
                  "1.")
@@ -253,6 +261,13 @@ void pybind_trianglemesh(py::module &m) {
                  "Decimation by "
                  "Garland and Heckbert",
                  "target_number_of_triangles"_a)
+            .def("simplify_quadric_decimation_multiple_choice",
+                 &geometry::TriangleMesh::
+                         SimplifyQuadricDecimationMultipleChoice,
+                 "Function to simplify mesh using Quadric Error Metric "
+                 "Decimation with multiple choice edge selection by Wu and "
+                 "Kobbelt",
+                 "target_number_of_triangles"_a, "number_of_choices"_a = 8)
             .def("compute_convex_hull",
                  &geometry::TriangleMesh::ComputeConvexHull,
                  "Computes the convex hull of the triangle mesh.")
@@ -364,14 +379,27 @@ void pybind_trianglemesh(py::module &m) {
             .def_readwrite(
                     "adjacency_list", &geometry::TriangleMesh::adjacency_list_,
                     "List of Sets: The set ``adjacency_list[i]`` contains the "
-                    "indices of adjacent vertices of vertex i.");
+                    "indices of adjacent vertices of vertex i.")
+            .def_readwrite("adjacency_offsets",
+                           &geometry::TriangleMesh::adjacency_offsets_,
+                           "``int`` array of shape ``(num_vertices + 1,)``: "
+                           "The adjacent vertices of vertex i are "
+                           "``adjacency_indices[adjacency_offsets[i]:"
+                           "adjacency_offsets[i + 1]]``.")
+            .def_readwrite("adjacency_indices",
+                           &geometry::TriangleMesh::adjacency_indices_,
+                           "``int`` array: Sorted adjacent vertices of all "
+                           "vertices, see ``adjacency_offsets``.");
     docstring::ClassMethodDocInject(m, "TriangleMesh",
                                     "compute_adjacency_list");
+    docstring::ClassMethodDocInject(m, "TriangleMesh",
+                                    "compute_adjacency_csr");
     docstring::ClassMethodDocInject(m, "TriangleMesh",
                                     "compute_triangle_normals");
     docstring::ClassMethodDocInject(m, "TriangleMesh",
                                     "compute_vertex_normals");
     docstring::ClassMethodDocInject(m, "TriangleMesh", "has_adjacency_list");
+    docstring::ClassMethodDocInject(m, "TriangleMesh", "has_adjacency_csr");
     docstring::ClassMethodDocInject(
             m, "TriangleMesh", "has_triangle_normals",
             {{"normalized",
@@ -413,8 +441,11 @@ void pybind_trianglemesh(py::module &m) {
     docstring::ClassMethodDocInject(m, "TriangleMesh", "is_orientable");
     docstring::ClassMethodDocInject(m, "TriangleMesh", "is_watertight");
     docstring::ClassMethodDocInject(m, "TriangleMesh", "orient_triangles");
-    docstring::ClassMethodDocInject(m, "TriangleMesh",
-                                    "remove_duplicated_vertices");
+    docstring::ClassMethodDocInject(
+            m, "TriangleMesh", "remove_duplicated_vertices",
+            {{"epsilon",
+              "If positive, vertices in the same grid cell of this size are "
+              "welded and their attributes averaged."}});
     docstring::ClassMethodDocInject(m, "TriangleMesh",
                                     "remove_duplicated_triangles");
     docstring::ClassMethodDocInject(m, "TriangleMesh",
@@ -490,6 +521,14 @@ void pybind_trianglemesh(py::module &m) {
             {{"target_number_of_triangles",
               "The number of triangles that the simplified mesh should have. "
               "It is not guranteed that this number will be reached."}});
+    docstring::ClassMethodDocInject(
+            m, "TriangleMesh", "simplify_quadric_decimation_multiple_choice",
+            {{"target_number_of_triangles",
+              "The number of triangles that the simplified mesh should have. "
+              "It is not guranteed that this number will be reached."},
+             {"number_of_choices",
+              "Number of randomly drawn edges out of which the cheapest one "
+              "is collapsed in each step."}});
     docstring::ClassMethodDocInject(m, "TriangleMesh", "compute_convex_hull");
     docstring::ClassMethodDocInject(
             m, "TriangleMesh", "create_from_point_cloud_ball_pivoting",
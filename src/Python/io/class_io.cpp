@@ -34,6 +34,7 @@
 #include "Open3D/IO/ClassIO/FeatureIO.h"
 #include "Open3D/IO/ClassIO/IJsonConvertibleIO.h"
 #include "Open3D/IO/ClassIO/ImageIO.h"
+#include "Open3D/IO/ClassIO/KDTreeFlannIO.h"
 #include "Open3D/IO/ClassIO/LineSetIO.h"
 #include "Open3D/IO/ClassIO/PinholeCameraTrajectoryIO.h"
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
@@ -86,6 +87,7 @@ static const std::unordered_map<std::string, std::string>
                  "The ``PinholeCameraParameters`` object for I/O"},
                 {"pose_graph", "The ``PoseGraph`` object for I/O"},
                 {"feature", "The ``Feature`` object for I/O"},
+                {"kdtree", "The ``KDTreeFlann`` object for I/O"},
                 {"print_progress",
                  "If set to true a progress bar is visualized in the console"},
 };
@@ -296,13 +298,59 @@ void pybind_class_io(py::module &m_io) {
 
     m_io.def("write_feature",
              [](const std::string &filename,
-                const registration::Feature &feature) {
-                 return io::WriteFeature(filename, feature);
+                const registration::Feature &feature, bool compressed) {
+                 return io::WriteFeature(filename, feature, compressed);
              },
-             "Function to write Feature to file", "filename"_a, "feature"_a);
+             "Function to write Feature to file", "filename"_a, "feature"_a,
+             "compressed"_a = false);
     docstring::FunctionDocInject(m_io, "write_feature",
                                  map_shared_argument_docstrings);
 
+    m_io.def("read_kdtree_flann",
+             [](const std::string &filename,
+                const geometry::Geometry &geometry) {
+                 auto kdtree = std::make_shared<geometry::KDTreeFlann>();
+                 io::ReadKDTreeFlann(filename, geometry, *kdtree);
+                 return kdtree;
+             },
+             "Function to load the KDTreeFlann of a geometry from a snapshot "
+             "file. If the snapshot is missing or was built from other data, "
+             "the index is rebuilt and the snapshot is rewritten.",
+             "filename"_a, "geometry"_a);
+    m_io.def("read_kdtree_flann",
+             [](const std::string &filename,
+                const registration::Feature &feature) {
+                 auto kdtree = std::make_shared<geometry::KDTreeFlann>();
+                 io::ReadKDTreeFlann(filename, feature, *kdtree);
+                 return kdtree;
+             },
+             "Function to load the KDTreeFlann of a feature from a snapshot "
+             "file. If the snapshot is missing or was built from other data, "
+             "the index is rebuilt and the snapshot is rewritten.",
+             "filename"_a, "feature"_a);
+    m_io.def("read_kdtree_flann",
+             [](const std::string &filename, const Eigen::MatrixXd &data) {
+                 auto kdtree = std::make_shared<geometry::KDTreeFlann>();
+                 io::ReadKDTreeFlann(filename, data, *kdtree);
+                 return kdtree;
+             },
+             "Function to load the KDTreeFlann of the columns of a matrix "
+             "from a snapshot file. If the snapshot is missing or was built "
+             "from other data, the index is rebuilt and the snapshot is "
+             "rewritten.",
+             "filename"_a, "data"_a);
+
+    m_io.def("write_kdtree_flann",
+             [](const std::string &filename,
+                const geometry::KDTreeFlann &kdtree) {
+                 return io::WriteKDTreeFlann(filename, kdtree);
+             },
+             "Function to write a snapshot of a KDTreeFlann and of the "
+             "checksum of its data to file",
+             "filename"_a, "kdtree"_a);
+    docstring::FunctionDocInject(m_io, "write_kdtree_flann",
+                                 map_shared_argument_docstrings);
+
     m_io.def("read_pose_graph",
              [](const std::string &filename) {
                  registration::PoseGraph pose_graph;
@@ -315,11 +363,11 @@ void pybind_class_io(py::module &m_io) {
 
     m_io.def("write_pose_graph",
              [](const std::string &filename,
-                const registration::PoseGraph pose_graph) {
-                 io::WritePoseGraph(filename, pose_graph);
+                const registration::PoseGraph pose_graph, bool compressed) {
+                 io::WritePoseGraph(filename, pose_graph, compressed);
              },
              "Function to write PoseGraph to file", "filename"_a,
-             "pose_graph"_a);
+             "pose_graph"_a, "compressed"_a = false);
     docstring::FunctionDocInject(m_io, "write_pose_graph",
                                  map_shared_argument_docstrings);
 
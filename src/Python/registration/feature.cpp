@@ -26,6 +26,7 @@
 
 #include "Open3D/Registration/Feature.h"
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/FeatureIndex.h"
 #include "Python/docstring.h"
 #include "Python/registration/registration.h"
 
@@ -59,6 +60,96 @@ void pybind_feature(py::module &m) {
     docstring::ClassMethodDocInject(m, "Feature", "resize",
                                     {{"dim", "Feature dimension per point."},
                                      {"n", "Number of points."}});
+
+    // open3d.registration.FeatureIndexOption
+    py::class_<registration::FeatureIndexOption> feature_index_option(
+            m, "FeatureIndexOption", "Options of a FeatureIndex.");
+    py::detail::bind_copy_functions<registration::FeatureIndexOption>(
+            feature_index_option);
+    feature_index_option
+            .def(py::init([](int num_trees, int max_checks) {
+                     return new registration::FeatureIndexOption(num_trees,
+                                                                 max_checks);
+                 }),
+                 "num_trees"_a = 1, "max_checks"_a = 128)
+            .def_readwrite("num_trees",
+                           &registration::FeatureIndexOption::num_trees_,
+                           "int: Number of randomized KD-trees.")
+            .def_readwrite("max_checks",
+                           &registration::FeatureIndexOption::max_checks_,
+                           "int: Number of features compared to a query.")
+            .def("__repr__", [](const registration::FeatureIndexOption &o) {
+                return std::string(
+                               "registration::FeatureIndexOption with "
+                               "num_trees = ") +
+                       std::to_string(o.num_trees_) +
+                       std::string(" and max_checks = ") +
+                       std::to_string(o.max_checks_);
+            });
+
+    // open3d.registration.FeatureIndex
+    py::class_<registration::FeatureIndex,
+               std::shared_ptr<registration::FeatureIndex>>
+            feature_index(m, "FeatureIndex",
+                          "Approximate nearest neighbor search over features "
+                          "with a forest of randomized KD-trees.");
+    feature_index
+            .def(py::init<const registration::FeatureIndexOption &>(),
+                 "option"_a = registration::FeatureIndexOption())
+            .def(py::init<const registration::Feature &,
+                          const registration::FeatureIndexOption &>(),
+                 "feature"_a, "option"_a = registration::FeatureIndexOption())
+            .def("set_feature", &registration::FeatureIndex::SetFeature,
+                 "Sets the features to search and builds the trees.",
+                 "feature"_a)
+            .def("search_knn_vector_xd",
+                 [](const registration::FeatureIndex &index,
+                    const Eigen::VectorXd &query, int knn) {
+                     std::vector<int> indices;
+                     std::vector<double> distance2;
+                     int k = index.SearchKNN(query, knn, indices, distance2);
+                     if (k < 0)
+                         throw std::runtime_error(
+                                 "search_knn_vector_xd() error!");
+                     return std::make_tuple(k, indices, distance2);
+                 },
+                 "query"_a, "knn"_a)
+            .def("search_knn",
+                 [](const registration::FeatureIndex &index,
+                    const registration::Feature &query, int knn) {
+                     Eigen::MatrixXi indices;
+                     Eigen::MatrixXd distance2;
+                     index.SearchKNN(query, knn, indices, distance2);
+                     return std::make_tuple(indices, distance2);
+                 },
+                 "Searches the knn nearest features of every column of "
+                 "query in parallel. Returns ``knn x n`` indices, padded "
+                 "with -1, and squared distances.",
+                 "query"_a, "knn"_a);
+
+    // open3d.registration.FeatureIndexEvaluation
+    py::class_<registration::FeatureIndexEvaluation> feature_index_evaluation(
+            m, "FeatureIndexEvaluation",
+            "Recall and speed of a FeatureIndex option.");
+    feature_index_evaluation
+            .def_readonly("option",
+                          &registration::FeatureIndexEvaluation::option_,
+                          "FeatureIndexOption: The evaluated option.")
+            .def_readonly("build_time",
+                          &registration::FeatureIndexEvaluation::build_time_,
+                          "float: Build time in milliseconds.")
+            .def_readonly("query_time",
+                          &registration::FeatureIndexEvaluation::query_time_,
+                          "float: Query time in milliseconds.")
+            .def_readonly(
+                    "exact_query_time",
+                    &registration::FeatureIndexEvaluation::exact_query_time_,
+                    "float: Query time of the exact KDTreeFlann search in "
+                    "milliseconds.")
+            .def_readonly("recall",
+                          &registration::FeatureIndexEvaluation::recall_,
+                          "float: Fraction of the exact nearest neighbors "
+                          "that are found.");
 }
 
 void pybind_feature_methods(py::module &m) {
@@ -69,4 +160,15 @@ void pybind_feature_methods(py::module &m) {
             m, "compute_fpfh_feature",
             {{"input", "The Input point cloud."},
              {"search_param", "KDTree KNN search parameter."}});
+
+    m.def("evaluate_feature_index", &registration::EvaluateFeatureIndex,
+          "Function to measure the recall and the speed of FeatureIndex "
+          "options",
+          "feature"_a, "query_feature"_a, "options"_a, "knn"_a = 1);
+    docstring::FunctionDocInject(
+            m, "evaluate_feature_index",
+            {{"feature", "The features to search."},
+             {"query_feature", "The features to query."},
+             {"options", "The FeatureIndex options to evaluate."},
+             {"knn", "Number of nearest neighbors to search."}});
 }
@@ -27,6 +27,7 @@
 #include "Open3D/Registration/GlobalOptimization.h"
 #include "Open3D/Registration/GlobalOptimizationConvergenceCriteria.h"
 #include "Open3D/Registration/GlobalOptimizationMethod.h"
+#include "Open3D/Registration/IncrementalGlobalOptimization.h"
 #include "Open3D/Registration/PoseGraph.h"
 #include "Python/docstring.h"
 #include "Python/registration/registration.h"
@@ -348,6 +349,60 @@ void pybind_global_optimization(py::module &m) {
                             std::string("\n> reference_node : ") +
                             std::to_string(goo.reference_node_);
                  });
+
+    // open3d.registration.IncrementalGlobalOptimization
+    py::class_<registration::IncrementalGlobalOptimization>
+            incremental_optimization(
+                    m, "IncrementalGlobalOptimization",
+                    "Pose graph optimizer for graphs that grow a few nodes "
+                    "and edges at a time. Each update warm starts from the "
+                    "previous solution and only relinearizes edges whose "
+                    "nodes moved.");
+    incremental_optimization
+            .def(py::init<const registration::
+                                  GlobalOptimizationConvergenceCriteria &,
+                          const registration::GlobalOptimizationOption &,
+                          double>(),
+                 "criteria"_a = registration::
+                         GlobalOptimizationConvergenceCriteria(),
+                 "option"_a = registration::GlobalOptimizationOption(),
+                 "relinearize_threshold"_a = 1e-3)
+            .def("add_node",
+                 &registration::IncrementalGlobalOptimization::AddNode,
+                 "node"_a, "Appends a node and returns its index.")
+            .def("add_edge",
+                 &registration::IncrementalGlobalOptimization::AddEdge,
+                 "edge"_a,
+                 "Appends an edge between existing nodes. Returns False if "
+                 "the edge is invalid.")
+            .def("update", &registration::IncrementalGlobalOptimization::Update,
+                 "Optimizes the graph after nodes and edges have been added. "
+                 "Returns False if the graph is not connected.")
+            .def("batch_optimize",
+                 &registration::IncrementalGlobalOptimization::BatchOptimize,
+                 "method"_a =
+                         registration::GlobalOptimizationLevenbergMarquardt(),
+                 "Optimizes the whole graph with ``global_optimization``.")
+            .def("reset", &registration::IncrementalGlobalOptimization::Reset,
+                 "pose_graph"_a,
+                 "Replaces the graph and drops the cached linearization.")
+            .def_property_readonly(
+                    "pose_graph",
+                    &registration::IncrementalGlobalOptimization::GetPoseGraph,
+                    "``PoseGraph``: The optimized pose graph.")
+            .def_property_readonly(
+                    "num_relinearized_edges",
+                    &registration::IncrementalGlobalOptimization::
+                            GetNumRelinearizedEdges,
+                    "int: Number of edges linearized by the last update.")
+            .def("__repr__",
+                 [](const registration::IncrementalGlobalOptimization &op) {
+                     return std::string("IncrementalGlobalOptimization with ") +
+                            std::to_string(op.GetPoseGraph().nodes_.size()) +
+                            std::string(" nodes and ") +
+                            std::to_string(op.GetPoseGraph().edges_.size()) +
+                            std::string(" edges.");
+                 });
 }
 
 void pybind_global_optimization_methods(py::module &m) {
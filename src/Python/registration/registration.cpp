@@ -31,6 +31,8 @@
 #include "Open3D/Registration/CorrespondenceChecker.h"
 #include "Open3D/Registration/FastGlobalRegistration.h"
 #include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/GeneralizedICP.h"
+#include "Open3D/Registration/MultiPairRegistration.h"
 #include "Open3D/Registration/Registration.h"
 #include "Open3D/Registration/TransformationEstimation.h"
 #include "Python/docstring.h"
@@ -246,6 +248,28 @@ Sets :math:`c = 1` if ``with_scaling`` is ``False``.
                 return std::string("TransformationEstimationPointToPlane");
             });
 
+    // ope3dn.registration.TransformationEstimationForGeneralizedICP:
+    // TransformationEstimation
+    py::class_<registration::TransformationEstimationForGeneralizedICP,
+               PyTransformationEstimation<
+                       registration::TransformationEstimationForGeneralizedICP>,
+               registration::TransformationEstimation>
+            te_gicp(m, "TransformationEstimationForGeneralizedICP",
+                    "Class to estimate a transformation for the plane to "
+                    "plane distance of Generalized ICP. Both point clouds "
+                    "must have covariances.");
+    py::detail::bind_default_constructor<
+            registration::TransformationEstimationForGeneralizedICP>(te_gicp);
+    py::detail::bind_copy_functions<
+            registration::TransformationEstimationForGeneralizedICP>(te_gicp);
+    te_gicp.def(
+            "__repr__",
+            [](const registration::TransformationEstimationForGeneralizedICP
+                       &te) {
+                return std::string(
+                        "TransformationEstimationForGeneralizedICP");
+            });
+
     // ope3dn.registration.CorrespondenceChecker
     py::class_<registration::CorrespondenceChecker,
                PyCorrespondenceChecker<registration::CorrespondenceChecker>>
@@ -383,17 +407,20 @@ must hold true for all edges.)");
                              bool decrease_mu,
                              double maximum_correspondence_distance,
                              int iteration_number, double tuple_scale,
-                             int maximum_tuple_count) {
+                             int maximum_tuple_count,
+                             int maximum_feature_checks) {
                      return new registration::FastGlobalRegistrationOption(
                              division_factor, use_absolute_scale, decrease_mu,
                              maximum_correspondence_distance, iteration_number,
-                             tuple_scale, maximum_tuple_count);
+                             tuple_scale, maximum_tuple_count,
+                             maximum_feature_checks);
                  }),
                  "division_factor"_a = 1.4, "use_absolute_scale"_a = false,
                  "decrease_mu"_a = false,
                  "maximum_correspondence_distance"_a = 0.025,
                  "iteration_number"_a = 64, "tuple_scale"_a = 0.95,
-                 "maximum_tuple_count"_a = 1000)
+                 "maximum_tuple_count"_a = 1000,
+                 "maximum_feature_checks"_a = -1)
             .def_readwrite(
                     "division_factor",
                     &registration::FastGlobalRegistrationOption::
@@ -427,6 +454,12 @@ must hold true for all edges.)");
                            &registration::FastGlobalRegistrationOption::
                                    maximum_tuple_count_,
                            "float: Maximum tuple numbers.")
+            .def_readwrite("maximum_feature_checks",
+                           &registration::FastGlobalRegistrationOption::
+                                   maximum_feature_checks_,
+                           "int: Match features with an approximate "
+                           "FeatureIndex comparing this many features per "
+                           "query, or exactly if it is not positive.")
             .def("__repr__",
                  [](const registration::FastGlobalRegistrationOption &c) {
                      return std::string(
@@ -447,9 +480,108 @@ must hold true for all edges.)");
                             std::string("\ntuple_scale = ") +
                             std::to_string(c.tuple_scale_) +
                             std::string("\nmaximum_tuple_count = ") +
-                            std::to_string(c.maximum_tuple_count_);
+                            std::to_string(c.maximum_tuple_count_) +
+                            std::string("\nmaximum_feature_checks = ") +
+                            std::to_string(c.maximum_feature_checks_);
                  });
 
+    // ope3dn.registration.RegistrationPair
+    py::class_<registration::RegistrationPair> registration_pair(
+            m, "RegistrationPair",
+            "Pair of point clouds for ``register_point_cloud_pairs``.");
+    py::detail::bind_copy_functions<registration::RegistrationPair>(
+            registration_pair);
+    registration_pair
+            .def(py::init([](int source_id, int target_id,
+                             const Eigen::Matrix4d &init,
+                             bool global_registration, bool uncertain) {
+                     return new registration::RegistrationPair(
+                             source_id, target_id, init, global_registration,
+                             uncertain);
+                 }),
+                 "source_id"_a = -1, "target_id"_a = -1,
+                 "init"_a = Eigen::Matrix4d::Identity(),
+                 "global_registration"_a = false, "uncertain"_a = false)
+            .def_readwrite("source_id",
+                           &registration::RegistrationPair::source_id_,
+                           "int: Index of the source point cloud.")
+            .def_readwrite("target_id",
+                           &registration::RegistrationPair::target_id_,
+                           "int: Index of the target point cloud.")
+            .def_readwrite("init", &registration::RegistrationPair::init_,
+                           "``4 x 4`` float64 numpy array: Initial "
+                           "transformation of the ICP registration.")
+            .def_readwrite(
+                    "global_registration",
+                    &registration::RegistrationPair::global_registration_,
+                    "bool: Find the transformation by RANSAC feature "
+                    "matching instead of ICP.")
+            .def_readwrite("uncertain",
+                           &registration::RegistrationPair::uncertain_,
+                           "bool: Whether the resulting edge is uncertain.")
+            .def("__repr__", [](const registration::RegistrationPair &p) {
+                return std::string("registration::RegistrationPair from ") +
+                       std::to_string(p.source_id_) + std::string(" to ") +
+                       std::to_string(p.target_id_);
+            });
+
+    // ope3dn.registration.MultiPairRegistrationOption
+    py::class_<registration::MultiPairRegistrationOption> multi_pair_option(
+            m, "MultiPairRegistrationOption",
+            "Options for ``register_point_cloud_pairs``.");
+    py::detail::bind_copy_functions<registration::MultiPairRegistrationOption>(
+            multi_pair_option);
+    multi_pair_option
+            .def(py::init([](double max_correspondence_distance,
+                             double min_overlap, int ransac_n,
+                             const registration::RANSACConvergenceCriteria
+                                     &ransac_criteria,
+                             const registration::ICPConvergenceCriteria
+                                     &icp_criteria,
+                             int maximum_feature_checks) {
+                     return new registration::MultiPairRegistrationOption(
+                             max_correspondence_distance, min_overlap,
+                             ransac_n, ransac_criteria, icp_criteria,
+                             maximum_feature_checks);
+                 }),
+                 "max_correspondence_distance"_a = 0.075,
+                 "min_overlap"_a = 0.3, "ransac_n"_a = 4,
+                 "ransac_criteria"_a =
+                         registration::RANSACConvergenceCriteria(4000000, 500),
+                 "icp_criteria"_a = registration::ICPConvergenceCriteria(),
+                 "maximum_feature_checks"_a = -1)
+            .def_readwrite("max_correspondence_distance",
+                           &registration::MultiPairRegistrationOption::
+                                   max_correspondence_distance_,
+                           "float: Maximum correspondence distance of "
+                           "RANSAC, ICP and the information matrix.")
+            .def_readwrite(
+                    "min_overlap",
+                    &registration::MultiPairRegistrationOption::min_overlap_,
+                    "float: Global registrations with fewer correspondences "
+                    "than this fraction of the smaller point cloud are "
+                    "dropped.")
+            .def_readwrite(
+                    "ransac_n",
+                    &registration::MultiPairRegistrationOption::ransac_n_,
+                    "int: Fit RANSAC with ``ransac_n`` correspondences.")
+            .def_readwrite("ransac_criteria",
+                           &registration::MultiPairRegistrationOption::
+                                   ransac_criteria_,
+                           "``RANSACConvergenceCriteria``: Convergence "
+                           "criteria of RANSAC.")
+            .def_readwrite(
+                    "icp_criteria",
+                    &registration::MultiPairRegistrationOption::icp_criteria_,
+                    "``ICPConvergenceCriteria``: Convergence criteria of "
+                    "ICP.")
+            .def_readwrite("maximum_feature_checks",
+                           &registration::MultiPairRegistrationOption::
+                                   maximum_feature_checks_,
+                           "int: RANSAC matches features with an approximate "
+                           "FeatureIndex comparing this many features per "
+                           "query, or exactly if it is not positive.");
+
     // ope3dn.registration.RegistrationResult
     py::class_<registration::RegistrationResult> registration_result(
             m, "RegistrationResult",
@@ -504,11 +636,20 @@ static const std::unordered_map<std::string, std::string>
                 {"estimation_method",
                  "Estimation method. One of "
                  "(``registration::TransformationEstimationPointToPoint``, "
-                 "``registration::TransformationEstimationPointToPlane``)"},
+                 "``registration::TransformationEstimationPointToPlane``, "
+                 "``registration::"
+                 "TransformationEstimationForGeneralizedICP``)"},
+                {"epsilon",
+                 "Variance of the local surface planes along their normals "
+                 "in the Generalized ICP covariances."},
                 {"init", "Initial transformation estimation"},
                 {"lambda_geometric", "lambda_geometric value"},
                 {"max_correspondence_distance",
                  "Maximum correspondence points-pair distance."},
+                {"maximum_feature_checks",
+                 "Match features with an approximate index comparing this "
+                 "many features per query, or exactly if it is not "
+                 "positive."},
                 {"option", "Registration option"},
                 {"ransac_n", "Fit ransac with ``ransac_n`` correspondences"},
                 {"source_feature", "Source point cloud feature."},
@@ -527,7 +668,13 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "evaluate_registration",
                                  map_shared_argument_docstrings);
 
-    m.def("registration_icp", &registration::RegistrationICP,
+    m.def("registration_icp",
+          static_cast<registration::RegistrationResult (*)(
+                  const geometry::PointCloud &, const geometry::PointCloud &,
+                  double, const Eigen::Matrix4d &,
+                  const registration::TransformationEstimation &,
+                  const registration::ICPConvergenceCriteria &)>(
+                  &registration::RegistrationICP),
           "Function for ICP registration", "source"_a, "target"_a,
           "max_correspondence_distance"_a,
           "init"_a = Eigen::Matrix4d::Identity(),
@@ -537,6 +684,18 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "registration_icp",
                                  map_shared_argument_docstrings);
 
+    m.def("registration_icp_with_information_matrix",
+          &registration::RegistrationICPWithInformationMatrix,
+          "Function for ICP registration that also returns the information "
+          "matrix of the final correspondences",
+          "source"_a, "target"_a, "max_correspondence_distance"_a,
+          "init"_a = Eigen::Matrix4d::Identity(),
+          "estimation_method"_a =
+                  registration::TransformationEstimationPointToPoint(false),
+          "criteria"_a = registration::ICPConvergenceCriteria());
+    docstring::FunctionDocInject(m, "registration_icp_with_information_matrix",
+                                 map_shared_argument_docstrings);
+
     m.def("registration_colored_icp", &registration::RegistrationColoredICP,
           "Function for Colored ICP registration", "source"_a, "target"_a,
           "max_correspondence_distance"_a,
@@ -546,6 +705,30 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "registration_colored_icp",
                                  map_shared_argument_docstrings);
 
+    m.def("registration_generalized_icp",
+          &registration::RegistrationGeneralizedICP,
+          "Function for Generalized ICP registration", "source"_a, "target"_a,
+          "max_correspondence_distance"_a,
+          "init"_a = Eigen::Matrix4d::Identity(),
+          "criteria"_a = registration::ICPConvergenceCriteria(),
+          "epsilon"_a = 1e-3);
+    docstring::FunctionDocInject(m, "registration_generalized_icp",
+                                 map_shared_argument_docstrings);
+
+    m.def("compute_covariances_for_generalized_icp",
+          &registration::ComputeCovariancesForGeneralizedICP,
+          "Function to compute the per-point covariances of Generalized ICP "
+          "and store them in the point cloud",
+          "cloud"_a, "search_param"_a = geometry::KDTreeSearchParamKNN(20),
+          "epsilon"_a = 1e-3);
+    docstring::FunctionDocInject(
+            m, "compute_covariances_for_generalized_icp",
+            {{"cloud", "The point cloud to compute the covariances for."},
+             {"search_param",
+              "KDTree search parameters used when the point cloud has no "
+              "normals."},
+             {"epsilon", map_shared_argument_docstrings.at("epsilon")}});
+
     m.def("registration_ransac_based_on_correspondence",
           &registration::RegistrationRANSACBasedOnCorrespondence,
           "Function for global RANSAC registration based on a set of "
@@ -560,7 +743,14 @@ void pybind_registration_methods(py::module &m) {
                                  map_shared_argument_docstrings);
 
     m.def("registration_ransac_based_on_feature_matching",
-          &registration::RegistrationRANSACBasedOnFeatureMatching,
+          static_cast<registration::RegistrationResult (*)(
+                  const geometry::PointCloud &, const geometry::PointCloud &,
+                  const registration::Feature &, const registration::Feature &,
+                  double, const registration::TransformationEstimation &, int,
+                  const std::vector<std::reference_wrapper<
+                          const registration::CorrespondenceChecker>> &,
+                  const registration::RANSACConvergenceCriteria &, int)>(
+                  &registration::RegistrationRANSACBasedOnFeatureMatching),
           "Function for global RANSAC registration based on feature matching",
           "source"_a, "target"_a, "source_feature"_a, "target_feature"_a,
           "max_correspondence_distance"_a,
@@ -569,7 +759,8 @@ void pybind_registration_methods(py::module &m) {
           "ransac_n"_a = 4,
           "checkers"_a = std::vector<std::reference_wrapper<
                   const registration::CorrespondenceChecker>>(),
-          "criteria"_a = registration::RANSACConvergenceCriteria(100000, 100));
+          "criteria"_a = registration::RANSACConvergenceCriteria(100000, 100),
+          "maximum_feature_checks"_a = -1);
     docstring::FunctionDocInject(
             m, "registration_ransac_based_on_feature_matching",
             map_shared_argument_docstrings);
@@ -584,13 +775,52 @@ void pybind_registration_methods(py::module &m) {
                                  map_shared_argument_docstrings);
 
     m.def("get_information_matrix_from_point_clouds",
-          &registration::GetInformationMatrixFromPointClouds,
+          static_cast<Eigen::Matrix6d (*)(
+                  const geometry::PointCloud &, const geometry::PointCloud &,
+                  double, const Eigen::Matrix4d &)>(
+                  &registration::GetInformationMatrixFromPointClouds),
           "Function for computing information matrix from transformation "
           "matrix",
           "source"_a, "target"_a, "max_correspondence_distance"_a,
           "transformation"_a);
     docstring::FunctionDocInject(m, "get_information_matrix_from_point_clouds",
                                  map_shared_argument_docstrings);
+
+    m.def("get_information_matrix_from_correspondences",
+          &registration::GetInformationMatrixFromCorrespondences,
+          "Function for computing information matrix from a set of "
+          "correspondences, e.g. the correspondence_set of a registration "
+          "result",
+          "target"_a, "corres"_a);
+    docstring::FunctionDocInject(
+            m, "get_information_matrix_from_correspondences",
+            {{"target", "The target point cloud."},
+             {"corres",
+              "Correspondence set between source and target point cloud."}});
+
+    m.def("register_point_cloud_pairs", &registration::RegisterPointCloudPairs,
+          "Function to register many pairs of point clouds concurrently, "
+          "sharing the KD-trees of each point cloud between its pairs. "
+          "Returns a PoseGraphEdge for each successful pair.",
+          "point_clouds"_a, "features"_a, "pairs"_a,
+          "option"_a = registration::MultiPairRegistrationOption(),
+          "estimation_method"_a =
+                  registration::TransformationEstimationPointToPoint(false),
+          "checkers"_a = std::vector<std::reference_wrapper<
+                  const registration::CorrespondenceChecker>>());
+    docstring::FunctionDocInject(
+            m, "register_point_cloud_pairs",
+            {{"point_clouds", "The point clouds."},
+             {"features",
+              "Features of the point clouds, may be empty if no pair uses "
+              "global registration."},
+             {"pairs", "Pairs of point cloud indices to register."},
+             {"option", "Registration option"},
+             {"estimation_method",
+              "Estimation method of ICP. One of "
+              "(``registration::TransformationEstimationPointToPoint``, "
+              "``registration::TransformationEstimationPointToPlane``)"},
+             {"checkers", "Correspondence checkers of RANSAC."}});
 }
 
 void pybind_registration(py::module &m) {
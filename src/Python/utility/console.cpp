@@ -58,4 +58,16 @@ void pybind_console(py::module &m) {
     m.def("get_verbosity_level", &utility::GetVerbosityLevel,
           "Get global verbosity level of Open3D");
     docstring::FunctionDocInject(m, "get_verbosity_level");
+
+    m.def("set_async_logging", &utility::SetAsyncLogging,
+          "Print log messages on a background thread", py::arg("enabled"));
+    docstring::FunctionDocInject(
+            m, "set_async_logging",
+            {{"enabled",
+              "If ``False``, the queued messages are flushed and later "
+              "messages are printed synchronously."}});
+
+    m.def("flush_log", &utility::FlushLog,
+          "Wait until all asynchronously logged messages are printed");
+    docstring::FunctionDocInject(m, "flush_log");
 }
@@ -0,0 +1,67 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Utility/Parallel.h"
+#include "Python/docstring.h"
+#include "Python/open3d_pybind.h"
+
+using namespace open3d;
+
+void pybind_parallel(py::module &m) {
+    py::enum_<utility::ParallelBackend> pb(m, "ParallelBackend",
+                                           "ParallelBackend");
+    pb.value("OpenMP", utility::ParallelBackend::OpenMP)
+            .value("ThreadPool", utility::ParallelBackend::ThreadPool)
+            .export_values();
+    // Trick to write docs without listing the members in the enum class again.
+    pb.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class for ParallelBackend.";
+            }),
+            py::none(), py::none(), "");
+
+    m.def("set_parallel_backend", &utility::SetParallelBackend,
+          "Set the backend that runs the parallel loops of Open3D",
+          py::arg("backend"));
+    docstring::FunctionDocInject(m, "set_parallel_backend");
+
+    m.def("get_parallel_backend", &utility::GetParallelBackend,
+          "Get the backend that runs the parallel loops of Open3D");
+    docstring::FunctionDocInject(m, "get_parallel_backend");
+
+    m.def("set_global_max_threads", &utility::SetGlobalMaxThreads,
+          "Set the number of threads used by the parallel loops of Open3D",
+          py::arg("num_threads"));
+    docstring::FunctionDocInject(
+            m, "set_global_max_threads",
+            {{"num_threads",
+              "Values <= 0 restore the default, the OpenMP default or the "
+              "hardware concurrency."}});
+
+    m.def("get_global_max_threads", &utility::GetGlobalMaxThreads,
+          "Get the number of threads used by the parallel loops of Open3D");
+    docstring::FunctionDocInject(m, "get_global_max_threads");
+}
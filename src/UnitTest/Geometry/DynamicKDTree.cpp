@@ -0,0 +1,103 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "Open3D/Geometry/DynamicKDTree.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(DynamicKDTree, AddAndRemovePoints) {
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    geometry::DynamicKDTree kdtree;
+    vector<Vector3d> points;
+    vector<bool> removed;
+
+    // Batches of new points alternate with removals, crossing the buffer
+    // size, merging blocks and rebuilding blocks with many removed points.
+    vector<size_t> batch_sizes = {100, 200, 1000, 5, 300, 2000, 60};
+    for (size_t batch = 0; batch < batch_sizes.size(); batch++) {
+        vector<Vector3d> new_points(batch_sizes[batch]);
+        Rand(new_points, vmin, vmax, int(batch));
+        kdtree.AddPoints(new_points);
+        points.insert(points.end(), new_points.begin(), new_points.end());
+        removed.resize(points.size(), false);
+
+        vector<size_t> indices;
+        for (size_t i = batch; i < points.size(); i += 3 + batch) {
+            indices.push_back(i);
+            removed[i] = true;
+        }
+        kdtree.RemovePoints(indices);
+        EXPECT_EQ(size_t(count(removed.begin(), removed.end(), false)),
+                  kdtree.GetSize());
+
+        vector<Vector3d> queries(20);
+        Rand(queries, vmin, vmax, 100 + int(batch));
+        for (const auto &query : queries) {
+            vector<pair<double, int>> ref_neighbors;
+            for (int i = 0; i < int(points.size()); i++) {
+                double dist2 = (points[i] - query).squaredNorm();
+                if (!removed[i] && dist2 < double(float(1.5 * 1.5))) {
+                    ref_neighbors.push_back(make_pair(dist2, i));
+                }
+            }
+            sort(ref_neighbors.begin(), ref_neighbors.end());
+
+            vector<int> indices;
+            vector<double> distance2;
+            int result = kdtree.SearchRadius(query, 1.5, indices, distance2);
+            EXPECT_EQ(int(ref_neighbors.size()), result);
+            for (int i = 0; i < result; i++) {
+                EXPECT_EQ(ref_neighbors[i].second, indices[i]);
+                EXPECT_NEAR(ref_neighbors[i].first, distance2[i],
+                            unit_test::THRESHOLD_1E_6);
+            }
+
+            result = kdtree.SearchHybrid(query, 1.5, 5, indices, distance2);
+            EXPECT_EQ(min(int(ref_neighbors.size()), 5), result);
+            for (int i = 0; i < result; i++) {
+                EXPECT_EQ(ref_neighbors[i].second, indices[i]);
+            }
+        }
+    }
+
+    vector<int> indices;
+    vector<double> distance2;
+    kdtree.Clear();
+    EXPECT_EQ(0u, kdtree.GetSize());
+    EXPECT_EQ(0, kdtree.SearchKNN(Vector3d(0.0, 0.0, 0.0), 3, indices,
+                                  distance2));
+}
@@ -0,0 +1,123 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cmath>
+#include <limits>
+
+#include "Open3D/Geometry/FixedRadiusIndex.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FixedRadiusIndex, SearchMatchesKDTreeFlann) {
+    int size = 1000;
+    double radius = 1.5;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    geometry::KDTreeFlann kdtree(pc);
+    geometry::FixedRadiusIndex index(radius, pc);
+
+    vector<Vector3d> queries(100);
+    Rand(queries, vmin, vmax, 1);
+    queries.insert(queries.end(), pc.points_.begin(), pc.points_.begin() + 10);
+
+    for (const auto &query : queries) {
+        vector<int> ref_indices;
+        vector<double> ref_distance2;
+        vector<int> indices;
+        vector<double> distance2;
+
+        int ref_result =
+                kdtree.SearchRadius(query, radius, ref_indices, ref_distance2);
+        int result = index.SearchRadius(query, radius, indices, distance2);
+        EXPECT_EQ(ref_result, result);
+        EXPECT_EQ(ref_indices, indices);
+        ExpectEQ(ref_distance2, distance2);
+        EXPECT_EQ(ref_result, index.CountRadius(query, radius));
+
+        ref_result = kdtree.SearchHybrid(query, radius, 5, ref_indices,
+                                         ref_distance2);
+        result = index.Search(query,
+                              geometry::KDTreeSearchParamHybrid(
+                                      radius, 5,
+                                      geometry::KDTreeSearchParam::IndexType::
+                                              FixedRadius),
+                              indices, distance2);
+        EXPECT_EQ(ref_result, result);
+        EXPECT_EQ(ref_indices, indices);
+        ExpectEQ(ref_distance2, distance2);
+    }
+
+    vector<int> indices;
+    vector<double> distance2;
+    EXPECT_EQ(-1, index.Search(queries[0], geometry::KDTreeSearchParamKNN(5),
+                               indices, distance2));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FixedRadiusIndex, ExtremeCoordinates) {
+    // Cell coordinates far beyond the int64 range and non-finite points.
+    const double inf = numeric_limits<double>::infinity();
+    geometry::PointCloud pc;
+    pc.points_.push_back(Vector3d(0, 0, 0));
+    pc.points_.push_back(Vector3d(1e-3, 0, 0));
+    pc.points_.push_back(Vector3d(1e300, 0, 0));
+    pc.points_.push_back(Vector3d(1e300, 1e-3, 0));
+    pc.points_.push_back(Vector3d(-1e300, 0, -1e300));
+    pc.points_.push_back(Vector3d(inf, 0, 0));
+    pc.points_.push_back(Vector3d(0, NAN, 0));
+    const double radius = 1e-2;
+    geometry::FixedRadiusIndex index(radius, pc);
+
+    vector<int> indices;
+    vector<double> distance2;
+    EXPECT_EQ(2, index.SearchRadius(Vector3d(0, 0, 0), radius, indices,
+                                    distance2));
+    EXPECT_EQ(vector<int>({0, 1}), indices);
+    EXPECT_EQ(2, index.SearchRadius(Vector3d(1e300, 0, 0), radius, indices,
+                                    distance2));
+    EXPECT_EQ(vector<int>({2, 3}), indices);
+    EXPECT_EQ(1, index.CountRadius(Vector3d(-1e300, 0, -1e300), radius));
+    EXPECT_EQ(0, index.CountRadius(Vector3d(inf, 0, 0), radius));
+    EXPECT_EQ(0, index.CountRadius(Vector3d(0, 0, 0), NAN));
+}
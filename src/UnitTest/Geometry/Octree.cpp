@@ -28,6 +28,7 @@
 #include <iostream>
 #include <memory>
 
+#include "Open3D/Geometry/LinearOctree.h"
 #include "Open3D/Geometry/Octree.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/VoxelGrid.h"
@@ -290,6 +291,45 @@ TEST(Octree, ConvertFromPointCloudBoundTwoPoints) {
     EXPECT_EQ(octree.size_, 4.04);  // 4.04 = 4 * (1 + 0.01)
 }
 
+TEST(Octree, ConvertFromPointCloudMatchesInsertPoint) {
+    geometry::PointCloud pcd;
+    pcd.points_.resize(5000);
+    pcd.colors_.resize(5000);
+    Rand(pcd.points_, Eigen::Vector3d(-1, -1, -1), Eigen::Vector3d(1, 1, 1), 0);
+    Rand(pcd.colors_, Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(1, 1, 1), 1);
+    // Duplicate points, the last color inserted wins
+    for (size_t i = 0; i < 100; i++) {
+        pcd.points_.push_back(pcd.points_[i]);
+        pcd.colors_.push_back(Eigen::Vector3d(1, 0, 0));
+    }
+
+    for (size_t max_depth : {0, 1, 4, 7}) {
+        geometry::Octree octree(max_depth);
+        octree.ConvertFromPointCloud(pcd, 0.01);
+
+        geometry::Octree ref_octree(max_depth, octree.origin_, octree.size_);
+        for (size_t i = 0; i < pcd.points_.size(); i++) {
+            ref_octree.InsertPoint(
+                    pcd.points_[i],
+                    geometry::OctreeColorLeafNode::GetInitFunction(),
+                    geometry::OctreeColorLeafNode::GetUpdateFunction(
+                            pcd.colors_[i]));
+        }
+        EXPECT_TRUE(octree == ref_octree);
+
+        geometry::LinearOctree linear_octree(max_depth, octree.origin_,
+                                             octree.size_);
+        linear_octree.CreateFromPointCloud(pcd);
+        for (size_t i = 0; i < 100; i++) {
+            int64_t leaf = linear_octree.LocateLeafNode(pcd.points_[i]);
+            ASSERT_GE(leaf, 0);
+            ExpectEQ(linear_octree.leaf_colors_[leaf],
+                     Eigen::Vector3d(1, 0, 0));
+        }
+        EXPECT_EQ(linear_octree.LocateLeafNode(Eigen::Vector3d(5, 5, 5)), -1);
+    }
+}
+
 TEST(Octree, Visualization) {
     geometry::PointCloud pcd;
     io::ReadPointCloud(std::string(TEST_DATA_DIR) + "/fragment.ply", pcd);
@@ -314,3 +354,99 @@ TEST(Octree, ConvertToJsonValue) {
 
     EXPECT_TRUE(src_octree == dst_octree);
 }
+
+TEST(Octree, ConvertFromPointCloudKeepsLinearNodes) {
+    geometry::PointCloud pcd;
+    pcd.points_.resize(2000);
+    pcd.colors_.resize(2000);
+    Rand(pcd.points_, Eigen::Vector3d(-1, -1, -1), Eigen::Vector3d(1, 1, 1), 0);
+    Rand(pcd.colors_, Eigen::Vector3d(0, 0, 0), Eigen::Vector3d(1, 1, 1), 1);
+    size_t max_depth = 4;
+    geometry::Octree octree(max_depth);
+    octree.ConvertFromPointCloud(pcd, 0.01);
+    EXPECT_TRUE(octree.root_node_ == nullptr);
+    EXPECT_FALSE(octree.linear_octree_.IsEmpty());
+    EXPECT_FALSE(octree.IsEmpty());
+
+    geometry::Octree ref_octree(max_depth, octree.origin_, octree.size_);
+    for (size_t i = 0; i < pcd.points_.size(); i++) {
+        ref_octree.InsertPoint(pcd.points_[i],
+                               geometry::OctreeColorLeafNode::GetInitFunction(),
+                               geometry::OctreeColorLeafNode::GetUpdateFunction(
+                                       pcd.colors_[i]));
+    }
+
+    // The const traversal visits the same nodes
+    std::vector<Eigen::Vector3d> origins;
+    std::vector<size_t> depths;
+    std::vector<size_t> num_children;
+    std::vector<Eigen::Vector3d> colors;
+    auto f = [&](const std::shared_ptr<geometry::OctreeNode>& node,
+                 const std::shared_ptr<geometry::OctreeNodeInfo>& node_info) {
+        origins.push_back(node_info->origin_);
+        depths.push_back(node_info->depth_);
+        if (auto internal_node =
+                    std::dynamic_pointer_cast<geometry::OctreeInternalNode>(
+                            node)) {
+            size_t n = 0;
+            for (const auto& child : internal_node->children_) {
+                n += child != nullptr;
+            }
+            num_children.push_back(n);
+        } else if (auto leaf_node = std::dynamic_pointer_cast<
+                           geometry::OctreeColorLeafNode>(node)) {
+            colors.push_back(leaf_node->color_);
+        }
+    };
+    const geometry::Octree& const_octree = octree;
+    const_octree.Traverse(f);
+    std::vector<Eigen::Vector3d> linear_origins = origins;
+    std::vector<size_t> linear_depths = depths;
+    std::vector<size_t> linear_num_children = num_children;
+    std::vector<Eigen::Vector3d> linear_colors = colors;
+    origins.clear();
+    depths.clear();
+    num_children.clear();
+    colors.clear();
+    const geometry::Octree& const_ref_octree = ref_octree;
+    const_ref_octree.Traverse(f);
+    ExpectEQ(linear_origins, origins);
+    EXPECT_EQ(linear_depths, depths);
+    EXPECT_EQ(linear_num_children, num_children);
+    ExpectEQ(linear_colors, colors);
+    EXPECT_TRUE(octree.root_node_ == nullptr);
+
+    // The JSON value and the located leaves are the same
+    Json::Value json_value, ref_json_value;
+    EXPECT_TRUE(octree.ConvertToJsonValue(json_value));
+    EXPECT_TRUE(ref_octree.ConvertToJsonValue(ref_json_value));
+    EXPECT_TRUE(json_value == ref_json_value);
+    for (size_t i = 0; i < pcd.points_.size(); i += 100) {
+        auto leaf = octree.LocateLeafNode(pcd.points_[i]);
+        auto ref_leaf = ref_octree.LocateLeafNode(pcd.points_[i]);
+        ASSERT_TRUE(leaf.first != nullptr);
+        EXPECT_TRUE(*leaf.first == *ref_leaf.first);
+        ExpectEQ(leaf.second->origin_, ref_leaf.second->origin_);
+        EXPECT_EQ(leaf.second->child_index_, ref_leaf.second->child_index_);
+    }
+    EXPECT_TRUE(octree.LocateLeafNode(Eigen::Vector3d(5, 5, 5)).first ==
+                nullptr);
+    EXPECT_EQ(octree.ToVoxelGrid()->voxels_.size(),
+              ref_octree.ToVoxelGrid()->voxels_.size());
+
+    // Copies keep the linear nodes, edits convert them
+    geometry::Octree copy(octree);
+    EXPECT_TRUE(copy.root_node_ == nullptr);
+    EXPECT_TRUE(copy == octree);
+    EXPECT_TRUE(octree == ref_octree);
+    copy.ConvertToNodes();
+    EXPECT_TRUE(copy.linear_octree_.IsEmpty());
+    EXPECT_TRUE(copy.root_node_ != nullptr);
+    EXPECT_TRUE(copy == ref_octree);
+    octree.InsertPoint(Eigen::Vector3d(0, 0, 0),
+                       geometry::OctreeColorLeafNode::GetInitFunction(),
+                       geometry::OctreeColorLeafNode::GetUpdateFunction(
+                               Eigen::Vector3d(1, 0, 0)));
+    EXPECT_TRUE(octree.linear_octree_.IsEmpty());
+    EXPECT_TRUE(octree.root_node_ != nullptr);
+}
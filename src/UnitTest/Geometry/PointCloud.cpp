@@ -942,6 +942,31 @@ TEST(PointCloud, ComputePointCloudNearestNeighborDistance) {
     ExpectEQ(ref, distance);
 }
 
+// ----------------------------------------------------------------------------
+// Two lines of points and an isolated point. The end points of the lines are
+// border points, the clusters are numbered in the order of their first point.
+// ----------------------------------------------------------------------------
+TEST(PointCloud, ClusterDBSCAN) {
+    geometry::PointCloud pc;
+    pc.points_.push_back(Vector3d(5.0, 5.0, 5.0));
+    for (int i = 0; i < 10; i++) {
+        pc.points_.push_back(Vector3d(0.1 * i, 10.0, 0.0));
+    }
+    for (int i = 0; i < 10; i++) {
+        pc.points_.push_back(Vector3d(0.1 * i, 0.0, 0.0));
+    }
+
+    vector<int> ref(pc.points_.size(), 1);
+    ref[0] = -1;
+    for (int i = 1; i <= 10; i++) {
+        ref[i] = 0;
+    }
+    EXPECT_EQ(ref, pc.ClusterDBSCAN(0.15, 3));
+
+    // No point has 4 neighbors
+    EXPECT_EQ(vector<int>(pc.points_.size(), -1), pc.ClusterDBSCAN(0.15, 4));
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -1135,3 +1160,80 @@ TEST(PointCloud, CreatePointCloudFromRGBDImage_1_4) {
                                        color_bytes_per_channel, ref_points,
                                        ref_colors);
 }
+
+// ----------------------------------------------------------------------------
+// Organized point cloud of a tilted plane z = 1 + 0.5 * x with invalid pixels
+// on the border of the depth image and a single outlier pixel.
+// ----------------------------------------------------------------------------
+TEST(PointCloud, OrganizedPointCloud) {
+    const int width = 64;
+    const int height = 48;
+    const double fx = 50.0;
+    const double cx = 31.5;
+    const double cy = 23.5;
+    camera::PinholeCameraIntrinsic intrinsic(width, height, fx, fx, cx, cy);
+
+    geometry::Image depth;
+    depth.Prepare(width, height, 1, 4);
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            // Intersection of the ray through (u, v) with the plane
+            const double d = 1.0 / (1.0 - 0.5 * (u - cx) / fx);
+            const bool valid = u > 0 && v > 0;
+            *depth.PointerAt<float>(u, v) = valid ? float(d) : 0.0f;
+        }
+    }
+    *depth.PointerAt<float>(20, 20) = 3.0f;
+
+    auto pcd = geometry::PointCloud::CreateFromDepthImage(
+            depth, intrinsic, Matrix4d::Identity(), 1000.0, 1000.0, 1, false);
+    auto pcd_valid = geometry::PointCloud::CreateFromDepthImage(
+            depth, intrinsic, Matrix4d::Identity(), 1000.0, 1000.0, 1, true);
+    EXPECT_TRUE(pcd->IsOrganized());
+    EXPECT_FALSE(pcd_valid->IsOrganized());
+    EXPECT_EQ(pcd->width_, width);
+    EXPECT_EQ(pcd->height_, height);
+    EXPECT_EQ(pcd_valid->points_.size(), size_t((width - 1) * (height - 1)));
+    EXPECT_TRUE(std::isnan(pcd->points_[0](0)));
+    ExpectEQ(pcd->points_[width + 1], pcd_valid->points_[0]);
+
+    const Vector3d plane_normal = Vector3d(-0.5, 0, 1).normalized();
+    for (double max_neighbor_distance : {0.0, 0.1}) {
+        pcd->normals_.clear();
+        EXPECT_TRUE(pcd->EstimateNormalsOrganized(3, max_neighbor_distance));
+        ASSERT_TRUE(pcd->HasNormals());
+        EXPECT_TRUE(std::isnan(pcd->normals_[0](0)));
+        for (int v = 1; v < height; v++) {
+            for (int u = 1; u < width; u++) {
+                // The outlier only disturbs the integral image windows
+                if (std::abs(u - 20) <= 3 && std::abs(v - 20) <= 3 &&
+                    (max_neighbor_distance == 0.0 || (u == 20 && v == 20))) {
+                    continue;
+                }
+                const Vector3d &normal = pcd->normals_[v * width + u];
+                EXPECT_NEAR(std::abs(normal.dot(plane_normal)), 1.0, 1e-6);
+            }
+        }
+    }
+
+    std::shared_ptr<geometry::PointCloud> inliers;
+    std::vector<size_t> indices;
+    std::tie(inliers, indices) = pcd->RemoveOrganizedRadiusOutliers(3, 0.1);
+    EXPECT_TRUE(inliers->IsOrganized());
+    EXPECT_EQ(indices.size(), size_t((width - 1) * (height - 1) - 1));
+    EXPECT_TRUE(std::isnan(inliers->points_[20 * width + 20](0)));
+    ExpectEQ(inliers->points_[21 * width + 21], pcd->points_[21 * width + 21]);
+
+    auto down = inliers->OrganizedDownSample(2);
+    EXPECT_TRUE(down->IsOrganized());
+    EXPECT_EQ(down->width_, width / 2);
+    EXPECT_EQ(down->height_, height / 2);
+    ASSERT_TRUE(down->HasNormals());
+    // Block (0, 0) only has the valid pixel (1, 1)
+    ExpectEQ(down->points_[0], pcd->points_[width + 1]);
+    const Vector3d mean =
+            (pcd->points_[2 * width + 2] + pcd->points_[2 * width + 3] +
+             pcd->points_[3 * width + 2] + pcd->points_[3 * width + 3]) /
+            4.0;
+    ExpectEQ(down->points_[down->width_ + 1], mean);
+}
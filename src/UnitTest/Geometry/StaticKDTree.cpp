@@ -0,0 +1,195 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/StaticKDTree.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Brute force search sorted by distance and then by index.
+void BruteForceSearch(const vector<Vector3d> &points,
+                      const Vector3d &query,
+                      double radius,
+                      int max_nn,
+                      vector<int> &indices,
+                      vector<double> &distance2) {
+    vector<pair<double, int>> neighbors;
+    for (int i = 0; i < int(points.size()); i++) {
+        double dist2 = (points[i] - query).squaredNorm();
+        if (dist2 < double(float(radius * radius))) {
+            neighbors.push_back(make_pair(dist2, i));
+        }
+    }
+    sort(neighbors.begin(), neighbors.end());
+    neighbors.resize(min(neighbors.size(), size_t(max_nn)));
+    indices.clear();
+    distance2.clear();
+    for (const auto &neighbor : neighbors) {
+        distance2.push_back(neighbor.first);
+        indices.push_back(neighbor.second);
+    }
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(StaticKDTree, SearchMatchesBruteForce) {
+    int size = 1000;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+    // Duplicates are returned by increasing index.
+    pc.points_.insert(pc.points_.end(), pc.points_.begin(),
+                      pc.points_.begin() + 100);
+
+    geometry::StaticKDTree<double, 3> kdtree(pc);
+
+    vector<Vector3d> queries(100);
+    Rand(queries, vmin, vmax, 1);
+    queries.insert(queries.end(), pc.points_.begin(), pc.points_.begin() + 10);
+
+    for (const auto &query : queries) {
+        vector<int> ref_indices;
+        vector<double> ref_distance2;
+        vector<int> indices;
+        vector<double> distance2;
+
+        BruteForceSearch(pc.points_, query, 1e10, 30, ref_indices,
+                         ref_distance2);
+        EXPECT_EQ(30, kdtree.SearchKNN(query, 30, indices, distance2));
+        EXPECT_EQ(ref_indices, indices);
+        ExpectEQ(ref_distance2, distance2);
+
+        BruteForceSearch(pc.points_, query, 1.5, size, ref_indices,
+                         ref_distance2);
+        kdtree.SearchRadius(query, 1.5, indices, distance2);
+        EXPECT_EQ(ref_indices, indices);
+        ExpectEQ(ref_distance2, distance2);
+
+        BruteForceSearch(pc.points_, query, 1.5, 5, ref_indices,
+                         ref_distance2);
+        kdtree.SearchHybrid(query, 1.5, 5, indices, distance2);
+        EXPECT_EQ(ref_indices, indices);
+        ExpectEQ(ref_distance2, distance2);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(StaticKDTree, FloatStorage) {
+    vector<Vector3d> points = {{0.0, 0.0, 0.0},
+                               {1.0, 0.0, 0.0},
+                               {0.0, 2.0, 0.0},
+                               {NAN, 0.0, 0.0},
+                               {0.0, 0.0, 3.0}};
+    MatrixXd data(3, points.size());
+    for (size_t i = 0; i < points.size(); i++) {
+        data.col(i) = points[i];
+    }
+
+    geometry::StaticKDTree<float, 3> kdtree(data);
+
+    vector<int> indices;
+    vector<double> distance2;
+    EXPECT_EQ(4, kdtree.SearchKNN(Vector3f(0.1f, 0.0f, 0.0f), 10, indices,
+                                  distance2));
+    EXPECT_EQ(vector<int>({0, 1, 2, 4}), indices);
+    EXPECT_EQ(2, kdtree.SearchRadius(Vector3d(0.0, 0.0, 0.0), 1.5, indices,
+                                     distance2));
+    EXPECT_EQ(vector<int>({0, 1}), indices);
+    ExpectEQ(vector<double>({0.0, 1.0}), distance2);
+    VectorXd query = VectorXd::Zero(4);
+    EXPECT_EQ(-1, kdtree.SearchKNN(query, 1, indices, distance2));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(StaticKDTree, ReadFromBuffer) {
+    MatrixXd data = MatrixXd::Random(3, 100);
+    geometry::StaticKDTree<double, 3> kdtree(data);
+    FILE *file = tmpfile();
+    ASSERT_TRUE(file != NULL);
+    EXPECT_TRUE(kdtree.WriteToFile(file));
+    vector<char> buffer(ftell(file));
+    rewind(file);
+    EXPECT_EQ(buffer.size(), fread(buffer.data(), 1, buffer.size(), file));
+    fclose(file);
+
+    geometry::StaticKDTree<double, 3> loaded;
+    EXPECT_EQ(buffer.size(),
+              loaded.ReadFromBuffer(buffer.data(), buffer.size(), 100));
+    vector<int> indices0, indices1;
+    vector<double> distance20, distance21;
+    kdtree.SearchKNN(Vector3d(0.1, 0.2, 0.3), 10, indices0, distance20);
+    loaded.SearchKNN(Vector3d(0.1, 0.2, 0.3), 10, indices1, distance21);
+    EXPECT_EQ(indices0, indices1);
+
+    // The 100 points make a tree of 15 nodes.
+    int64_t header[3];
+    memcpy(header, buffer.data(), sizeof(header));
+    ASSERT_EQ(15, header[1]);
+    const size_t node_size =
+            (buffer.size() - sizeof(header) - 100 * (sizeof(int) + 24)) / 15;
+
+    // Children that do not split their parent are rejected.
+    vector<char> changed = buffer;
+    int end;
+    char *left_end = changed.data() + sizeof(header) + node_size + 4;
+    memcpy(&end, left_end, sizeof(end));
+    end++;
+    memcpy(left_end, &end, sizeof(end));
+    EXPECT_EQ(0u, loaded.ReadFromBuffer(changed.data(), changed.size(), 100));
+
+    // A root holding all points as a single leaf is rejected.
+    const int64_t leaf_header[3] = {0, 1, 100};
+    changed.assign((const char *)leaf_header,
+                   (const char *)leaf_header + sizeof(leaf_header));
+    changed.insert(changed.end(), buffer.begin() + sizeof(header),
+                   buffer.begin() + sizeof(header) + node_size);
+    changed.insert(changed.end(),
+                   buffer.begin() + sizeof(header) + 15 * node_size,
+                   buffer.end());
+    EXPECT_EQ(0u, loaded.ReadFromBuffer(changed.data(), changed.size(), 100));
+}
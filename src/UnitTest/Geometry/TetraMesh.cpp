@@ -357,6 +357,31 @@ TEST(TetraMesh, Purge) {
     ExpectEQ(ref_tetras_after_degenerate_removal, tm.tetras_);
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TetraMesh, RemoveDuplicatedVerticesEpsilon) {
+    geometry::TetraMesh tm;
+    tm.vertices_ = {{0.05, 0.05, 0.05}, {1.05, 0.05, 0.05},
+                    {0.05, 1.05, 0.05}, {0.05, 0.05, 1.05},
+                    {1.054, 0.052, 0.05}, {1.05, 1.05, 1.05}};
+    tm.tetras_ = {{0, 1, 2, 3}, {4, 2, 3, 5}};
+
+    geometry::TetraMesh exact = tm;
+    exact.RemoveDuplicatedVertices();
+    EXPECT_EQ(6u, exact.vertices_.size());
+
+    tm.RemoveDuplicatedVertices(0.1);
+    vector<Eigen::Vector3d> ref_vertices = {{0.05, 0.05, 0.05},
+                                            {1.052, 0.051, 0.05},
+                                            {0.05, 1.05, 0.05},
+                                            {0.05, 0.05, 1.05},
+                                            {1.05, 1.05, 1.05}};
+    ExpectEQ(ref_vertices, tm.vertices_);
+    EXPECT_EQ(Eigen::Vector4i(0, 1, 2, 3), tm.tetras_[0]);
+    EXPECT_EQ(Eigen::Vector4i(1, 2, 3, 4), tm.tetras_[1]);
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
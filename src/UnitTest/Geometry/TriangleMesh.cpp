@@ -28,6 +28,12 @@
 #include "Open3D/Geometry/PointCloud.h"
 #include "TestUtility/UnitTest.h"
 
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace Eigen;
 using namespace open3d;
 using namespace std;
@@ -509,6 +515,45 @@ TEST(TriangleMesh, ComputeAdjacencyList) {
     EXPECT_TRUE(tm.adjacency_list_[4] == std::unordered_set<int>({0, 1, 2, 3}));
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, ComputeAdjacencyCSR) {
+    geometry::TriangleMesh tm;
+    tm.vertices_ = {{1, 1, 0}, {-1, 1, 0}, {-1, -1, 0}, {1, -1, 0},
+                    {0, 0, 1}, {5, 5, 5}};
+    tm.triangles_ = {Eigen::Vector3i(0, 1, 2), Eigen::Vector3i(0, 2, 3),
+                     Eigen::Vector3i(0, 3, 4), Eigen::Vector3i(0, 4, 1),
+                     Eigen::Vector3i(1, 2, 4), Eigen::Vector3i(2, 3, 4),
+                     Eigen::Vector3i(3, 3, 4)};
+    EXPECT_FALSE(tm.HasAdjacencyCSR());
+    tm.ComputeAdjacencyCSR();
+    EXPECT_TRUE(tm.HasAdjacencyCSR());
+
+    // The degenerate triangle makes vertex 3 adjacent to itself, and vertex
+    // 5 has no neighbors.
+    vector<int> ref_offsets = {0, 4, 7, 11, 15, 19, 19};
+    vector<int> ref_indices = {1, 2, 3, 4, 0, 2, 4, 0, 1, 3,
+                               4, 0, 2, 3, 4, 0, 1, 2, 3};
+    EXPECT_EQ(ref_offsets, tm.adjacency_offsets_);
+    EXPECT_EQ(ref_indices, tm.adjacency_indices_);
+
+    // The adjacency list holds the same neighbors.
+    tm.ComputeAdjacencyList();
+    for (size_t i = 0; i < tm.vertices_.size(); i++) {
+        EXPECT_EQ(std::unordered_set<int>(
+                          tm.adjacency_indices_.begin() +
+                                  tm.adjacency_offsets_[i],
+                          tm.adjacency_indices_.begin() +
+                                  tm.adjacency_offsets_[i + 1]),
+                  tm.adjacency_list_[i]);
+    }
+
+    tm.RemoveUnreferencedVertices();
+    EXPECT_TRUE(tm.HasAdjacencyCSR());
+    EXPECT_EQ(6u, tm.adjacency_offsets_.size());
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -668,6 +713,61 @@ TEST(TriangleMesh, Purge) {
     ExpectEQ(ref_triangle_normals, tm.triangle_normals_);
 }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, RemoveDuplicatedVerticesEpsilon) {
+    geometry::TriangleMesh tm;
+    tm.vertices_ = {{0.05, 0.05, 0.05}, {1.05, 0.05, 0.05},
+                    {0.05, 1.05, 0.05}, {1.052, 0.054, 0.05},
+                    {0.054, 1.052, 0.05}, {1.05, 1.05, 0.05},
+                    {0.05, 0.05, 0.05}};
+    tm.vertex_colors_ = {{0.0, 0.0, 0.0}, {0.2, 0.0, 0.0}, {0.0, 0.0, 1.0},
+                         {0.4, 0.0, 0.0}, {0.0, 0.0, 0.0},
+                         {0.0, 1.0, 0.0}, {1.0, 1.0, 1.0}};
+    tm.triangles_ = {{0, 1, 2}, {3, 5, 4}, {6, 1, 2}};
+
+    // Without a tolerance only the bit-identical vertex is merged
+    geometry::TriangleMesh exact = tm;
+    exact.RemoveDuplicatedVertices();
+    EXPECT_EQ(6u, exact.vertices_.size());
+    ExpectEQ(Eigen::Vector3d(0.0, 0.0, 0.0), exact.vertex_colors_[0]);
+    ExpectEQ(Eigen::Vector3i(0, 1, 2), exact.triangles_[2]);
+
+    tm.RemoveDuplicatedVertices(0.1);
+    vector<Eigen::Vector3d> ref_vertices = {{0.05, 0.05, 0.05},
+                                            {1.051, 0.052, 0.05},
+                                            {0.052, 1.051, 0.05},
+                                            {1.05, 1.05, 0.05}};
+    vector<Eigen::Vector3d> ref_vertex_colors = {{0.5, 0.5, 0.5},
+                                                 {0.3, 0.0, 0.0},
+                                                 {0.0, 0.0, 0.5},
+                                                 {0.0, 1.0, 0.0}};
+    vector<Eigen::Vector3i> ref_triangles = {{0, 1, 2}, {1, 3, 2}, {0, 1, 2}};
+    ExpectEQ(ref_vertices, tm.vertices_);
+    ExpectEQ(ref_vertex_colors, tm.vertex_colors_);
+    ExpectEQ(ref_triangles, tm.triangles_);
+
+    tm.RemoveDuplicatedTriangles();
+    ExpectEQ(vector<Eigen::Vector3i>({{0, 1, 2}, {1, 3, 2}}), tm.triangles_);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, RemoveDuplicatedVerticesExtremeCoordinates) {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    geometry::TriangleMesh tm;
+    tm.vertices_ = {{1e300, 0.0, 0.0}, {nan, 0.0, 0.0}, {1e300, 0.0, 0.0},
+                    {nan, 0.0, 0.0},   {-1e300, 0.0, 0.0}};
+    tm.triangles_ = {{0, 1, 4}, {2, 3, 4}};
+
+    // Cells far outside the int64 range still weld, NaN vertices stay unique
+    tm.RemoveDuplicatedVertices(1e-3);
+    EXPECT_EQ(4u, tm.vertices_.size());
+    ExpectEQ(vector<Eigen::Vector3i>({{0, 1, 3}, {0, 2, 3}}), tm.triangles_);
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -1555,3 +1655,105 @@ TEST(TriangleMesh, CreateMeshCoordinateFrame) {
     ExpectEQ(ref_triangles, output->triangles_);
     ExpectEQ(ref_triangle_normals, output->triangle_normals_);
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, CreateFromPointCloudBallPivoting) {
+    geometry::PointCloud pcd;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            pcd.points_.push_back(
+                    Vector3d(x, y + 0.1 * (x % 2), 0.05 * ((x + y) % 3)));
+            pcd.normals_.push_back(Vector3d(0, 0, 1));
+        }
+    }
+
+    vector<Vector3i> ref_triangles = {
+            {0, 1, 4},    {1, 5, 4},   {5, 8, 4},   {5, 9, 8},  {9, 12, 8},
+            {9, 13, 12},  {9, 14, 13}, {9, 10, 14}, {10, 11, 14},
+            {11, 15, 14}, {10, 7, 11}, {10, 6, 7},  {6, 3, 7},  {6, 2, 3},
+            {6, 1, 2},    {6, 5, 1},   {6, 10, 5},  {10, 9, 5}};
+
+    auto output_tm = geometry::TriangleMesh::CreateFromPointCloudBallPivoting(
+            pcd, {0.8, 1.2});
+
+    ExpectEQ(pcd.points_, output_tm->vertices_);
+    ExpectEQ(ref_triangles, output_tm->triangles_);
+    EXPECT_EQ(ref_triangles.size(), output_tm->triangle_normals_.size());
+    EXPECT_TRUE(output_tm->IsEdgeManifold(true));
+    EXPECT_TRUE(output_tm->IsVertexManifold());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, CreateFromPointCloudBallPivotingPartitions) {
+    // Large enough compared to the radius to be split into partitions.
+    geometry::PointCloud pcd;
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            pcd.points_.push_back(Vector3d(0.01 * x, 0.01 * y + 0.001 * (x % 2),
+                                           0.0005 * ((x + y) % 3)));
+            pcd.normals_.push_back(Vector3d(0, 0, 1));
+        }
+    }
+
+    auto output_tm = geometry::TriangleMesh::CreateFromPointCloudBallPivoting(
+            pcd, {0.008, 0.012});
+    EXPECT_TRUE(output_tm->IsEdgeManifold(true));
+    EXPECT_TRUE(output_tm->IsVertexManifold());
+    EXPECT_EQ(2 * 99 * 99, int(output_tm->triangles_.size()));
+
+#ifdef _OPENMP
+    // The partitions are stitched in a fixed order.
+    int num_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+    auto serial_tm = geometry::TriangleMesh::CreateFromPointCloudBallPivoting(
+            pcd, {0.008, 0.012});
+    omp_set_num_threads(num_threads);
+    ExpectEQ(serial_tm->triangles_, output_tm->triangles_);
+#endif
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, SimplifyQuadricDecimation) {
+    auto input = geometry::TriangleMesh::CreateSphere(1.0, 20);
+    input->ComputeVertexNormals();
+
+    auto output_tm = input->SimplifyQuadricDecimation(100);
+
+    EXPECT_EQ(100u, output_tm->triangles_.size());
+    EXPECT_EQ(output_tm->vertices_.size(),
+              output_tm->vertex_normals_.size());
+    EXPECT_TRUE(output_tm->IsEdgeManifold(false));
+    EXPECT_TRUE(output_tm->IsVertexManifold());
+    EXPECT_EQ(2, output_tm->EulerPoincareCharacteristic());
+    for (const auto& vertex : output_tm->vertices_) {
+        EXPECT_NEAR(1.0, vertex.norm(), 0.1);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(TriangleMesh, SimplifyQuadricDecimationMultipleChoice) {
+    auto input = geometry::TriangleMesh::CreateSphere(1.0, 20);
+
+    auto output_tm = input->SimplifyQuadricDecimationMultipleChoice(100, 8);
+
+    EXPECT_EQ(100u, output_tm->triangles_.size());
+    EXPECT_TRUE(output_tm->IsEdgeManifold(false));
+    EXPECT_TRUE(output_tm->IsVertexManifold());
+    EXPECT_EQ(2, output_tm->EulerPoincareCharacteristic());
+    for (const auto& vertex : output_tm->vertices_) {
+        EXPECT_NEAR(1.0, vertex.norm(), 0.1);
+    }
+
+    // same seed, same result
+    auto output_tm2 = input->SimplifyQuadricDecimationMultipleChoice(100, 8);
+    ExpectEQ(output_tm->vertices_, output_tm2->vertices_);
+    ExpectEQ(output_tm->triangles_, output_tm2->triangles_);
+}
@@ -0,0 +1,130 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <cstdio>
+
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/KDTreeFlannIO.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+void ExpectSameKNN(const geometry::KDTreeFlann &kdtree0,
+                   const geometry::KDTreeFlann &kdtree1,
+                   const MatrixXd &queries) {
+    for (int i = 0; i < queries.cols(); i++) {
+        VectorXd query = queries.col(i);
+        vector<int> indices0, indices1;
+        vector<double> distance20, distance21;
+        EXPECT_EQ(5, kdtree0.SearchKNN(query, 5, indices0, distance20));
+        EXPECT_EQ(5, kdtree1.SearchKNN(query, 5, indices1, distance21));
+        EXPECT_EQ(indices0, indices1);
+        ExpectEQ(distance20, distance21);
+    }
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(KDTreeFlannIO, PointCloudSnapshot) {
+    string file_name = string(TEST_DATA_DIR) + "/temp_kdtree.bin";
+    geometry::PointCloud pcd;
+    pcd.points_.resize(1000);
+    Rand(pcd.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+
+    geometry::KDTreeFlann kdtree(pcd);
+    EXPECT_TRUE(io::WriteKDTreeFlann(file_name, kdtree));
+
+    geometry::KDTreeFlann loaded;
+    EXPECT_TRUE(loaded.ReadSnapshot(file_name, pcd));
+    MatrixXd queries = MatrixXd::Random(3, 20) * 10.0;
+    ExpectSameKNN(kdtree, loaded, queries);
+
+    // Other data is detected and the snapshot is rebuilt.
+    pcd.points_[500](0) += 1e-9;
+    EXPECT_FALSE(loaded.ReadSnapshot(file_name, pcd));
+    EXPECT_TRUE(io::ReadKDTreeFlann(file_name, pcd, loaded));
+    EXPECT_TRUE(loaded.ReadSnapshot(file_name, pcd));
+    geometry::KDTreeFlann rebuilt(pcd);
+    ExpectSameKNN(rebuilt, loaded, queries);
+
+    // A truncated snapshot is rejected.
+    vector<char> content(1 << 20);
+    FILE *file = fopen(file_name.c_str(), "rb");
+    ASSERT_TRUE(file != NULL);
+    content.resize(fread(content.data(), 1, content.size(), file));
+    fclose(file);
+    file = fopen(file_name.c_str(), "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(content.data(), 1, content.size() / 2, file);
+    fclose(file);
+    EXPECT_FALSE(loaded.ReadSnapshot(file_name, pcd));
+    ExpectSameKNN(rebuilt, loaded, queries);
+
+    // A damaged index is rejected.
+    content[100] ^= 1;
+    file = fopen(file_name.c_str(), "wb");
+    ASSERT_TRUE(file != NULL);
+    fwrite(content.data(), 1, content.size(), file);
+    fclose(file);
+    EXPECT_FALSE(loaded.ReadSnapshot(file_name, pcd));
+    ExpectSameKNN(rebuilt, loaded, queries);
+
+    EXPECT_EQ(std::remove(file_name.c_str()), 0);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(KDTreeFlannIO, MatrixSnapshot) {
+    string file_name = string(TEST_DATA_DIR) + "/temp_kdtree.bin";
+    std::remove(file_name.c_str());
+    MatrixXd data = MatrixXd::Random(5, 500);
+
+    // The missing snapshot is built and written.
+    geometry::KDTreeFlann kdtree;
+    EXPECT_TRUE(io::ReadKDTreeFlann(file_name, data, kdtree));
+
+    geometry::KDTreeFlann loaded;
+    EXPECT_TRUE(loaded.ReadSnapshot(file_name, data));
+    MatrixXd queries = MatrixXd::Random(5, 20);
+    ExpectSameKNN(kdtree, loaded, queries);
+
+    MatrixXd other = data;
+    other(2, 100) = 0.5;
+    EXPECT_FALSE(loaded.ReadSnapshot(file_name, other));
+    EXPECT_FALSE(loaded.ReadSnapshot(file_name, MatrixXd(data.leftCols(499))));
+
+    EXPECT_EQ(std::remove(file_name.c_str()), 0);
+}
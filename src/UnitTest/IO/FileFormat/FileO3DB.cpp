@@ -0,0 +1,290 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Open3D/IO/ClassIO/FeatureIO.h"
+#include "Open3D/IO/ClassIO/LineSetIO.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/ClassIO/TriangleMeshIO.h"
+#include "Open3D/IO/ClassIO/VoxelGridIO.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+vector<char> ReadFileData(const string &file_name) {
+    vector<char> data;
+    FILE *file = fopen(file_name.c_str(), "rb");
+    char buffer[4096];
+    size_t size;
+    while ((size = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + size);
+    }
+    fclose(file);
+    return data;
+}
+
+void WriteFileData(const string &file_name, const vector<char> &data) {
+    FILE *file = fopen(file_name.c_str(), "wb");
+    fwrite(data.data(), 1, data.size(), file);
+    fclose(file);
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3DB, PointCloud) {
+    geometry::PointCloud pointcloud;
+    pointcloud.points_.resize(100000);
+    pointcloud.normals_.resize(100000);
+    pointcloud.colors_.resize(100000);
+    Rand(pointcloud.points_, Vector3d::Zero(), Vector3d::Ones(), 0);
+    Rand(pointcloud.normals_, Vector3d::Zero(), Vector3d::Ones(), 1);
+    // Colors compress well, the other attributes do not.
+    pointcloud.PaintUniformColor(Vector3d(0.2, 0.4, 0.6));
+    pointcloud.covariances_.assign(100000, Matrix3d::Identity());
+    pointcloud.width_ = 400;
+    pointcloud.height_ = 250;
+
+    string file_name = string(TEST_DATA_DIR) + "/temp_pointcloud.o3db";
+    for (bool compressed : {false, true}) {
+        EXPECT_TRUE(io::WritePointCloud(file_name, pointcloud, false,
+                                        compressed));
+        geometry::PointCloud loaded;
+        EXPECT_TRUE(io::ReadPointCloud(file_name, loaded, "auto", false,
+                                       false));
+        ExpectEQ(pointcloud.points_, loaded.points_, 0.0);
+        ExpectEQ(pointcloud.normals_, loaded.normals_, 0.0);
+        ExpectEQ(pointcloud.colors_, loaded.colors_, 0.0);
+        ExpectEQ(pointcloud.covariances_, loaded.covariances_, 0.0);
+        EXPECT_EQ(pointcloud.width_, loaded.width_);
+        EXPECT_EQ(pointcloud.height_, loaded.height_);
+    }
+
+    // Optional attributes are only written if present.
+    geometry::PointCloud points_only;
+    points_only.points_ = pointcloud.points_;
+    EXPECT_TRUE(io::WritePointCloud(file_name, points_only));
+    geometry::PointCloud loaded = pointcloud;
+    EXPECT_TRUE(io::ReadPointCloud(file_name, loaded));
+    ExpectEQ(points_only.points_, loaded.points_, 0.0);
+    EXPECT_FALSE(loaded.HasNormals());
+    EXPECT_FALSE(loaded.HasColors());
+    EXPECT_FALSE(loaded.HasCovariances());
+    EXPECT_FALSE(loaded.IsOrganized());
+    remove(file_name.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3DB, TriangleMesh) {
+    geometry::TriangleMesh mesh;
+    mesh.vertices_.resize(1000);
+    mesh.vertex_normals_.resize(1000);
+    mesh.vertex_colors_.resize(1000);
+    mesh.triangles_.resize(2000);
+    Rand(mesh.vertices_, Vector3d::Zero(), Vector3d::Ones(), 0);
+    Rand(mesh.vertex_normals_, Vector3d::Zero(), Vector3d::Ones(), 1);
+    Rand(mesh.vertex_colors_, Vector3d::Zero(), Vector3d::Ones(), 2);
+    Rand(mesh.triangles_, Vector3i::Zero(), Vector3i::Constant(999), 3);
+    mesh.ComputeTriangleNormals(false);
+
+    string file_name = string(TEST_DATA_DIR) + "/temp_mesh.o3db";
+    for (bool compressed : {false, true}) {
+        EXPECT_TRUE(io::WriteTriangleMesh(file_name, mesh, false, compressed));
+        geometry::TriangleMesh loaded;
+        EXPECT_TRUE(io::ReadTriangleMesh(file_name, loaded));
+        ExpectEQ(mesh.vertices_, loaded.vertices_, 0.0);
+        ExpectEQ(mesh.vertex_normals_, loaded.vertex_normals_, 0.0);
+        ExpectEQ(mesh.vertex_colors_, loaded.vertex_colors_, 0.0);
+        ExpectEQ(mesh.triangles_, loaded.triangles_);
+        ExpectEQ(mesh.triangle_normals_, loaded.triangle_normals_, 0.0);
+    }
+
+    EXPECT_TRUE(io::WriteTriangleMesh(file_name, mesh, false, false, false,
+                                      false));
+    geometry::TriangleMesh loaded;
+    EXPECT_TRUE(io::ReadTriangleMesh(file_name, loaded));
+    EXPECT_FALSE(loaded.HasVertexNormals());
+    EXPECT_FALSE(loaded.HasVertexColors());
+    ExpectEQ(mesh.triangles_, loaded.triangles_);
+    remove(file_name.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3DB, LineSet) {
+    geometry::LineSet lineset;
+    lineset.points_.resize(100);
+    lineset.lines_.resize(300);
+    lineset.colors_.resize(300);
+    Rand(lineset.points_, Vector3d::Zero(), Vector3d::Ones(), 0);
+    Rand(lineset.lines_, Vector2i::Zero(), Vector2i::Constant(99), 1);
+    Rand(lineset.colors_, Vector3d::Zero(), Vector3d::Ones(), 2);
+
+    string file_name = string(TEST_DATA_DIR) + "/temp_lineset.o3db";
+    for (bool compressed : {false, true}) {
+        EXPECT_TRUE(io::WriteLineSet(file_name, lineset, false, compressed));
+        geometry::LineSet loaded;
+        EXPECT_TRUE(io::ReadLineSet(file_name, loaded));
+        ExpectEQ(lineset.points_, loaded.points_, 0.0);
+        ExpectEQ(lineset.lines_, loaded.lines_);
+        ExpectEQ(lineset.colors_, loaded.colors_, 0.0);
+    }
+    remove(file_name.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3DB, VoxelGrid) {
+    geometry::VoxelGrid voxelgrid;
+    voxelgrid.voxel_size_ = 0.05;
+    voxelgrid.origin_ = Vector3d(0.1, -0.2, 0.3);
+    vector<Vector3i> grid_indices(500);
+    vector<Vector3d> colors(500);
+    Rand(grid_indices, Vector3i::Zero(), Vector3i::Constant(100), 0);
+    Rand(colors, Vector3d::Zero(), Vector3d::Ones(), 1);
+    for (size_t i = 0; i < grid_indices.size(); i++) {
+        voxelgrid.voxels_.emplace_back(grid_indices[i], colors[i]);
+    }
+
+    string file_name = string(TEST_DATA_DIR) + "/temp_voxelgrid.o3db";
+    for (bool compressed : {false, true}) {
+        EXPECT_TRUE(
+                io::WriteVoxelGrid(file_name, voxelgrid, false, compressed));
+        geometry::VoxelGrid loaded;
+        EXPECT_TRUE(io::ReadVoxelGrid(file_name, loaded));
+        EXPECT_EQ(voxelgrid.voxel_size_, loaded.voxel_size_);
+        ExpectEQ(voxelgrid.origin_, loaded.origin_, 0.0);
+        ASSERT_EQ(voxelgrid.voxels_.size(), loaded.voxels_.size());
+        for (size_t i = 0; i < voxelgrid.voxels_.size(); i++) {
+            ExpectEQ(voxelgrid.voxels_[i].grid_index_,
+                     loaded.voxels_[i].grid_index_);
+            ExpectEQ(voxelgrid.voxels_[i].color_, loaded.voxels_[i].color_,
+                     0.0);
+        }
+    }
+
+    // A failed read leaves an empty grid.
+    vector<char> data = ReadFileData(file_name);
+    data[data.size() - 100] ^= 1;
+    WriteFileData(file_name, data);
+    geometry::VoxelGrid loaded = voxelgrid;
+    EXPECT_FALSE(io::ReadVoxelGrid(file_name, loaded));
+    EXPECT_FALSE(loaded.HasVoxels());
+    EXPECT_EQ(0.0, loaded.voxel_size_);
+    remove(file_name.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3DB, Feature) {
+    registration::Feature feature;
+    feature.Resize(33, 1000);
+    feature.data_.setRandom();
+
+    string file_name = string(TEST_DATA_DIR) + "/temp_feature.o3db";
+    for (bool compressed : {false, true}) {
+        EXPECT_TRUE(io::WriteFeature(file_name, feature, compressed));
+        registration::Feature loaded;
+        EXPECT_TRUE(io::ReadFeature(file_name, loaded));
+        EXPECT_EQ(feature.data_, loaded.data_);
+    }
+    remove(file_name.c_str());
+
+    // BIN has no compression and is written uncompressed.
+    file_name = string(TEST_DATA_DIR) + "/temp_feature.bin";
+    EXPECT_TRUE(io::WriteFeature(file_name, feature, true));
+    registration::Feature loaded;
+    EXPECT_TRUE(io::ReadFeature(file_name, loaded));
+    EXPECT_EQ(feature.data_, loaded.data_);
+    remove(file_name.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FileO3DB, Corrupted) {
+    geometry::PointCloud pointcloud;
+    pointcloud.points_.resize(1000);
+    Rand(pointcloud.points_, Vector3d::Zero(), Vector3d::Ones(), 0);
+    string file_name = string(TEST_DATA_DIR) + "/temp_pointcloud.o3db";
+
+    for (bool compressed : {false, true}) {
+        EXPECT_TRUE(io::WritePointCloudToO3DB(file_name, pointcloud, false,
+                                              compressed));
+        const vector<char> data = ReadFileData(file_name);
+        geometry::PointCloud loaded;
+
+        // Changed data fails the checksum.
+        vector<char> changed = data;
+        changed[changed.size() - 100] ^= 1;
+        WriteFileData(file_name, changed);
+        EXPECT_FALSE(io::ReadPointCloudFromO3DB(file_name, loaded));
+        EXPECT_FALSE(loaded.HasPoints());
+
+        // Truncated files are rejected.
+        vector<char> truncated(data.begin(), data.end() - 1);
+        WriteFileData(file_name, truncated);
+        EXPECT_FALSE(io::ReadPointCloudFromO3DB(file_name, loaded));
+        truncated.resize(16);
+        WriteFileData(file_name, truncated);
+        EXPECT_FALSE(io::ReadPointCloudFromO3DB(file_name, loaded));
+
+        // A block larger than its stored data is rejected before it is
+        // allocated.
+        vector<char> enlarged = data;
+        const uint64_t num_elements = INT32_MAX;
+        memcpy(enlarged.data() + 56, &num_elements, sizeof(num_elements));
+        WriteFileData(file_name, enlarged);
+        EXPECT_FALSE(io::ReadPointCloudFromO3DB(file_name, loaded));
+        EXPECT_FALSE(loaded.HasPoints());
+    }
+
+    // Files of other geometries are rejected.
+    EXPECT_TRUE(io::WritePointCloudToO3DB(file_name, pointcloud));
+    geometry::TriangleMesh mesh;
+    EXPECT_FALSE(io::ReadTriangleMeshFromO3DB(file_name, mesh));
+    remove(file_name.c_str());
+    file_name = string(TEST_DATA_DIR) + "/test_pose_graph.json";
+    geometry::PointCloud loaded;
+    EXPECT_FALSE(io::ReadPointCloudFromO3DB(file_name, loaded));
+}
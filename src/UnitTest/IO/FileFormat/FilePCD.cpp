@@ -24,8 +24,13 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -100,3 +105,35 @@ TEST(FilePCD, DISABLED_ReadPointCloudFromPCD) { unit_test::NotImplemented(); }
 //
 // ----------------------------------------------------------------------------
 TEST(FilePCD, DISABLED_WritePointCloudToPCD) { unit_test::NotImplemented(); }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FilePCD, WriteReadPointCloudFromPCD) {
+    // Large enough for the binary data to span several chunks.
+    const int num_points = 300007;
+    geometry::PointCloud pc_gt;
+    pc_gt.points_.resize(num_points);
+    pc_gt.normals_.resize(num_points);
+    pc_gt.colors_.resize(num_points);
+    Rand(pc_gt.points_, Eigen::Vector3d(-10.0, -10.0, -10.0),
+         Eigen::Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc_gt.normals_, Eigen::Vector3d(-1.0, -1.0, -1.0),
+         Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+    for (int i = 0; i < num_points; i++) {
+        // Values that survive the float and 8-bit color conversions exactly.
+        pc_gt.points_[i] = pc_gt.points_[i].cast<float>().cast<double>();
+        pc_gt.normals_[i] = pc_gt.normals_[i].cast<float>().cast<double>();
+        pc_gt.colors_[i] = Eigen::Vector3d(i % 256, i / 256 % 256, 7) / 255.0;
+    }
+
+    for (bool compressed : {false, true}) {
+        io::WritePointCloudToPCD("tmp.pcd", pc_gt, /*write_ascii*/ false,
+                                 compressed, false);
+        geometry::PointCloud pc_test;
+        io::ReadPointCloudFromPCD("tmp.pcd", pc_test, false);
+        ExpectEQ(pc_gt.points_, pc_test.points_);
+        ExpectEQ(pc_gt.normals_, pc_test.normals_);
+        ExpectEQ(pc_gt.colors_, pc_test.colors_);
+    }
+}
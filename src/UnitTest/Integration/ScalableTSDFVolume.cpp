@@ -24,8 +24,13 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Integration/ScalableTSDFVolume.h"
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Geometry/RGBDImage.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -54,7 +59,36 @@ TEST(ScalableTSDFVolume, DISABLED_Reset) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(ScalableTSDFVolume, DISABLED_Integrate) { unit_test::NotImplemented(); }
+TEST(ScalableTSDFVolume, Integrate) {
+    // A fronto-parallel wall at depth 1m.
+    geometry::RGBDImage rgbd;
+    rgbd.depth_.Prepare(64, 48, 1, 4);
+    for (int v = 0; v < 48; v++) {
+        for (int u = 0; u < 64; u++) {
+            *rgbd.depth_.PointerAt<float>(u, v) = 1.0f;
+        }
+    }
+    camera::PinholeCameraIntrinsic intrinsic(64, 48, 50.0, 50.0, 31.5, 23.5);
+
+    integration::ScalableTSDFVolume volume(
+            0.01, 0.04, integration::TSDFVolumeColorType::None);
+    volume.Integrate(rgbd, intrinsic, Eigen::Matrix4d::Identity());
+    EXPECT_EQ(volume.volume_units_.size(), 63u);
+    for (const auto &unit : volume.volume_units_) {
+        EXPECT_EQ(unit.first(2), 6);
+    }
+
+    // Integrating again with another intrinsic must not reuse stale tables.
+    camera::PinholeCameraIntrinsic wide(64, 48, 25.0, 25.0, 31.5, 23.5);
+    volume.Integrate(rgbd, wide, Eigen::Matrix4d::Identity());
+    EXPECT_EQ(volume.volume_units_.size(), 221u);
+
+    auto mesh = volume.ExtractTriangleMesh();
+    EXPECT_GT(mesh->triangles_.size(), 0u);
+    for (const auto &vertex : mesh->vertices_) {
+        EXPECT_NEAR(vertex(2), 1.0, 0.01);
+    }
+}
 
 // ----------------------------------------------------------------------------
 //
@@ -216,3 +216,41 @@ TEST(UniformTSDFVolume, DISABLED_IndexOf) {}
 TEST(UniformTSDFVolume, DISABLED_GetNormalAt) {}
 
 TEST(UniformTSDFVolume, DISABLED_GetTSDFAt) {}
+
+TEST(UniformTSDFVolume, ExtractTriangleMeshSphere) {
+    // A resolution that is not a multiple of the slab thickness, so that the
+    // extracted sphere crosses several slab seams, including a partial one.
+    const int resolution = 37;
+    const double length = 2.0;
+    const double sdf_trunc = 0.2;
+    integration::UniformTSDFVolume tsdf_volume(
+            length, resolution, sdf_trunc,
+            integration::TSDFVolumeColorType::None);
+    const Eigen::Vector3d center(1.0, 1.0, 1.0);
+    for (int x = 0; x < resolution; x++) {
+        for (int y = 0; y < resolution; y++) {
+            for (int z = 0; z < resolution; z++) {
+                Eigen::Vector3d p = (Eigen::Vector3d(x, y, z).array() + 0.5) *
+                                    tsdf_volume.voxel_length_;
+                double sdf = ((p - center).norm() - 0.7) / sdf_trunc;
+                auto &voxel = tsdf_volume.voxels_[tsdf_volume.IndexOf(x, y, z)];
+                voxel.tsdf_ = (float)std::max(-1.0, std::min(1.0, sdf));
+                voxel.weight_ = 1.0f;
+            }
+        }
+    }
+
+    auto mesh = tsdf_volume.ExtractTriangleMesh();
+    EXPECT_GT(mesh->triangles_.size(), 0u);
+    // Closed and manifold, i.e. no vertex is duplicated along slab seams.
+    EXPECT_TRUE(mesh->IsEdgeManifold(/*allow_boundary_edges*/ false));
+    EXPECT_TRUE(mesh->IsVertexManifold());
+    EXPECT_EQ(mesh->vertices_.size(), mesh->triangles_.size() / 2 + 2);
+    for (const auto &vertex : mesh->vertices_) {
+        EXPECT_NEAR((vertex - center).norm(), 0.7, tsdf_volume.voxel_length_);
+    }
+
+    auto pcd = tsdf_volume.ExtractPointCloud();
+    EXPECT_GT(pcd->points_.size(), 0u);
+    EXPECT_EQ(pcd->normals_.size(), pcd->points_.size());
+}
@@ -0,0 +1,111 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <random>
+
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/FeatureIndex.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+registration::Feature RandomFeature(int dim, int num, unsigned int seed) {
+    mt19937 rng(seed);
+    uniform_real_distribution<double> distribution(0.0, 100.0);
+    registration::Feature feature;
+    feature.Resize(dim, num);
+    for (int i = 0; i < num; i++) {
+        for (int d = 0; d < dim; d++) {
+            feature.data_(d, i) = distribution(rng);
+        }
+    }
+    return feature;
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FeatureIndex, Recall) {
+    registration::Feature feature = RandomFeature(33, 2000, 0);
+    registration::Feature query = RandomFeature(33, 200, 1);
+
+    vector<registration::FeatureIndexOption> options = {
+            registration::FeatureIndexOption(1, 2000),
+            registration::FeatureIndexOption(4, 2000)};
+    auto evaluations =
+            registration::EvaluateFeatureIndex(feature, query, options, 3);
+    ASSERT_EQ(options.size(), evaluations.size());
+    for (const auto &evaluation : evaluations) {
+        EXPECT_GE(evaluation.recall_, 0.95);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(FeatureIndex, SearchKNN) {
+    registration::Feature feature = RandomFeature(10, 500, 2);
+    registration::Feature query = RandomFeature(10, 50, 3);
+
+    registration::FeatureIndex index(feature,
+                                     registration::FeatureIndexOption(4, 64));
+    MatrixXi indices;
+    MatrixXd distance2;
+    index.SearchKNN(query, 5, indices, distance2);
+    ASSERT_EQ(5, indices.rows());
+    ASSERT_EQ(50, indices.cols());
+
+    // The batched search matches the search of each query.
+    for (int i = 0; i < 50; i++) {
+        vector<int> ref_indices;
+        vector<double> ref_distance2;
+        VectorXd column = query.data_.col(i);
+        EXPECT_EQ(5, index.SearchKNN(column, 5, ref_indices, ref_distance2));
+        for (int j = 0; j < 5; j++) {
+            EXPECT_EQ(ref_indices[j], indices(j, i));
+            EXPECT_DOUBLE_EQ(ref_distance2[j], distance2(j, i));
+            EXPECT_NEAR((feature.data_.col(indices(j, i)) - column)
+                                .squaredNorm(),
+                        distance2(j, i), 1e-2);
+        }
+    }
+
+    // Missing neighbors are padded with -1.
+    registration::Feature small_feature = RandomFeature(10, 3, 4);
+    registration::FeatureIndex small_index(small_feature);
+    small_index.SearchKNN(query, 5, indices, distance2);
+    for (int i = 0; i < 50; i++) {
+        EXPECT_EQ(-1, indices(3, i));
+        EXPECT_EQ(-1, indices(4, i));
+    }
+}
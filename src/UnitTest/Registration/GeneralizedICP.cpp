@@ -0,0 +1,149 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <Eigen/Dense>
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/GeneralizedICP.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+// A curved surface patch, so that all six degrees of freedom are constrained.
+geometry::PointCloud CreateSurface() {
+    geometry::PointCloud cloud;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 40; j++) {
+            double x = i / 40.0, y = j / 40.0;
+            cloud.points_.push_back(Eigen::Vector3d(
+                    x, y, 0.3 * std::sin(3.0 * x) * std::cos(2.0 * y)));
+        }
+    }
+    return cloud;
+}
+
+Eigen::Matrix4d CreateTransformation() {
+    Eigen::Vector6d v;
+    v << 0.02, -0.01, 0.03, 0.01, 0.02, -0.01;
+    return utility::TransformVector6dToMatrix4d(v);
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GeneralizedICP, ComputeCovariancesForGeneralizedICP) {
+    geometry::PointCloud cloud = CreateSurface();
+    EXPECT_FALSE(cloud.HasCovariances());
+    EXPECT_TRUE(registration::ComputeCovariancesForGeneralizedICP(
+            cloud, geometry::KDTreeSearchParamKNN(20), 1e-3));
+    ASSERT_TRUE(cloud.HasCovariances());
+    for (const auto &covariance : cloud.covariances_) {
+        ExpectEQ(Eigen::Matrix3d(covariance.transpose()), covariance);
+        Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance);
+        ExpectEQ(Eigen::Vector3d(solver.eigenvalues()),
+                 Eigen::Vector3d(1e-3, 1.0, 1.0));
+    }
+
+    // With normals the covariances are built from them.
+    cloud.EstimateNormals(geometry::KDTreeSearchParamKNN(20));
+    registration::ComputeCovariancesForGeneralizedICP(cloud);
+    for (size_t i = 0; i < cloud.points_.size(); i++) {
+        ExpectEQ(Eigen::Vector3d(cloud.covariances_[i] * cloud.normals_[i]),
+                 Eigen::Vector3d(1e-3 * cloud.normals_[i]));
+    }
+
+    // The covariances follow rigid transformations of the point cloud.
+    geometry::PointCloud transformed = cloud;
+    transformed.Transform(CreateTransformation());
+    geometry::PointCloud ref = transformed;
+    registration::ComputeCovariancesForGeneralizedICP(ref);
+    ExpectEQ(transformed.covariances_, ref.covariances_);
+
+    geometry::PointCloud empty;
+    EXPECT_FALSE(registration::ComputeCovariancesForGeneralizedICP(empty));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GeneralizedICP, RegistrationGeneralizedICP) {
+    geometry::PointCloud source = CreateSurface();
+    geometry::PointCloud target = source;
+    const Eigen::Matrix4d transformation = CreateTransformation();
+    target.Transform(transformation);
+    const double max_correspondence_distance = 0.1;
+
+    registration::RegistrationResult result =
+            registration::RegistrationGeneralizedICP(
+                    source, target, max_correspondence_distance);
+    ExpectEQ(Eigen::Matrix4d(result.transformation_), transformation, 1e-4);
+    EXPECT_NEAR(result.fitness_, 1.0, THRESHOLD_1E_6);
+
+    // Precomputed covariances are used by RegistrationICP directly.
+    registration::ComputeCovariancesForGeneralizedICP(source);
+    registration::ComputeCovariancesForGeneralizedICP(target);
+    registration::RegistrationResult result_icp = registration::RegistrationICP(
+            source, target, max_correspondence_distance,
+            Eigen::Matrix4d::Identity(),
+            registration::TransformationEstimationForGeneralizedICP());
+    ExpectEQ(Eigen::Matrix4d(result_icp.transformation_),
+             Eigen::Matrix4d(result.transformation_));
+
+    geometry::PointCloud aligned = source;
+    aligned.Transform(result_icp.transformation_);
+    registration::TransformationEstimationForGeneralizedICP estimation;
+    EXPECT_NEAR(estimation.ComputeRMSE(aligned, target,
+                                       result_icp.correspondence_set_),
+                0.0, 1e-3);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GeneralizedICP, RegistrationICPWithoutCovariances) {
+    geometry::PointCloud source = CreateSurface();
+    geometry::PointCloud target = source;
+    target.Transform(CreateTransformation());
+
+    registration::TransformationEstimationForGeneralizedICP estimation;
+    EXPECT_EQ(estimation.GetTransformationEstimationType(),
+              registration::TransformationEstimationType::GeneralizedICP);
+    ExpectEQ(estimation.ComputeTransformation(
+                     source, target, registration::CorrespondenceSet()),
+             Eigen::Matrix4d(Eigen::Matrix4d::Identity()));
+
+    registration::RegistrationResult result = registration::RegistrationICP(
+            source, target, 0.1, Eigen::Matrix4d::Identity(), estimation);
+    ExpectEQ(Eigen::Matrix4d(result.transformation_),
+             Eigen::Matrix4d(Eigen::Matrix4d::Identity()));
+    EXPECT_TRUE(result.correspondence_set_.empty());
+}
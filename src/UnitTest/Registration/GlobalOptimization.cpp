@@ -24,8 +24,56 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Dense>
+
+#include "Open3D/Registration/GlobalOptimization.h"
+#include "Open3D/Registration/IncrementalGlobalOptimization.h"
+#include "Open3D/Registration/PoseGraph.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+/// Poses on a circle. Odometry edges carry noise so that chaining them drifts,
+/// loop closures from the last poses back to the first ones are exact.
+void CreateLoopPoseGraph(int n_nodes,
+                         std::vector<registration::PoseGraphNode> &nodes,
+                         std::vector<registration::PoseGraphEdge> &odometry,
+                         std::vector<registration::PoseGraphEdge> &loops) {
+    std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> poses(n_nodes);
+    for (int i = 0; i < n_nodes; i++) {
+        double angle = 2.0 * M_PI * i / n_nodes;
+        Eigen::Vector6d v;
+        v << 0.0, 0.0, angle, cos(angle), sin(angle), 0.0;
+        poses[i] = utility::TransformVector6dToMatrix4d(v);
+    }
+    std::vector<double> noise(n_nodes * 6);
+    Rand(noise, -0.01, 0.01, 0);
+    Eigen::Matrix6d information = Eigen::Matrix6d::Identity() * 1000.0;
+
+    nodes.clear();
+    odometry.clear();
+    loops.clear();
+    nodes.emplace_back(poses[0]);
+    for (int i = 1; i < n_nodes; i++) {
+        Eigen::Matrix4d measured =
+                utility::TransformVector6dToMatrix4d(
+                        Eigen::Map<Eigen::Vector6d>(&noise[i * 6])) *
+                poses[i].inverse() * poses[i - 1];
+        odometry.emplace_back(i - 1, i, measured, information, false);
+        nodes.emplace_back(nodes.back().pose_ * measured.inverse());
+    }
+    for (int i = n_nodes - 3; i < n_nodes; i++) {
+        int j = i + 3 - n_nodes;
+        loops.emplace_back(i, j, poses[j].inverse() * poses[i], information,
+                           true);
+    }
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -63,3 +111,102 @@ TEST(GlobalOptimization, DISABLED_GlobalOptimizationOption) {
 TEST(GlobalOptimization, DISABLED_CreatePoseGraphWithoutInvalidEdges) {
     unit_test::NotImplemented();
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GlobalOptimization, IncrementalGlobalOptimization) {
+    std::vector<registration::PoseGraphNode> nodes;
+    std::vector<registration::PoseGraphEdge> odometry, loops;
+    CreateLoopPoseGraph(60, nodes, odometry, loops);
+
+    registration::GlobalOptimizationOption option;
+    option.reference_node_ = 0;
+    registration::GlobalOptimizationConvergenceCriteria criteria;
+
+    registration::PoseGraph batch;
+    batch.nodes_ = nodes;
+    batch.edges_ = odometry;
+    batch.edges_.insert(batch.edges_.end(), loops.begin(), loops.end());
+    registration::GlobalOptimization(
+            batch, registration::GlobalOptimizationLevenbergMarquardt(),
+            criteria, option);
+    ASSERT_EQ(batch.edges_.size(), odometry.size() + loops.size());
+
+    registration::IncrementalGlobalOptimization optimizer(criteria, option);
+    EXPECT_EQ(optimizer.AddNode(nodes[0]), 0);
+    for (size_t i = 1; i < nodes.size(); i++) {
+        EXPECT_EQ(optimizer.AddNode(nodes[i]), (int)i);
+        EXPECT_TRUE(optimizer.AddEdge(odometry[i - 1]));
+        EXPECT_TRUE(optimizer.Update());
+        // Odometry agrees with the new pose, nothing else needs to move.
+        EXPECT_EQ(optimizer.GetNumRelinearizedEdges(), 1);
+    }
+    for (const auto &edge : loops) {
+        EXPECT_TRUE(optimizer.AddEdge(edge));
+    }
+    EXPECT_TRUE(optimizer.Update());
+
+    const registration::PoseGraph &result = optimizer.GetPoseGraph();
+    ASSERT_EQ(result.nodes_.size(), batch.nodes_.size());
+    ASSERT_EQ(result.edges_.size(), batch.edges_.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        ExpectEQ(result.nodes_[i].pose_, batch.nodes_[i].pose_, 1e-4);
+    }
+    for (size_t i = 0; i < loops.size(); i++) {
+        size_t k = odometry.size() + i;
+        EXPECT_NEAR(result.edges_[k].confidence_, batch.edges_[k].confidence_,
+                    1e-4);
+    }
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GlobalOptimization, IncrementalGlobalOptimizationInvalid) {
+    registration::IncrementalGlobalOptimization optimizer;
+    optimizer.AddNode(registration::PoseGraphNode());
+    optimizer.AddNode(registration::PoseGraphNode());
+    EXPECT_FALSE(optimizer.AddEdge(registration::PoseGraphEdge(0, 2)));
+    EXPECT_FALSE(optimizer.AddEdge(registration::PoseGraphEdge(
+            0, 1, Eigen::Matrix4d::Identity(), Eigen::Matrix6d::Identity(),
+            false, 0.5)));
+    EXPECT_FALSE(optimizer.Update());
+    EXPECT_TRUE(optimizer.AddEdge(registration::PoseGraphEdge(0, 1)));
+    EXPECT_TRUE(optimizer.Update());
+    EXPECT_EQ(optimizer.GetPoseGraph().edges_.size(), 1u);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(GlobalOptimization, IncrementalGlobalOptimizationBatch) {
+    std::vector<registration::PoseGraphNode> nodes;
+    std::vector<registration::PoseGraphEdge> odometry, loops;
+    CreateLoopPoseGraph(20, nodes, odometry, loops);
+    registration::PoseGraph pose_graph;
+    pose_graph.nodes_ = nodes;
+    pose_graph.edges_ = odometry;
+    pose_graph.edges_.insert(pose_graph.edges_.end(), loops.begin(),
+                             loops.end());
+    // An outlier loop closure is pruned by the batch optimization.
+    pose_graph.edges_.emplace_back(
+            10, 0, Eigen::Matrix4d::Identity(),
+            Eigen::Matrix6d::Identity() * 1000.0, true);
+
+    registration::GlobalOptimizationOption option;
+    registration::GlobalOptimizationConvergenceCriteria criteria;
+    registration::IncrementalGlobalOptimization optimizer(criteria, option);
+    optimizer.Reset(pose_graph);
+    optimizer.BatchOptimize();
+
+    registration::GlobalOptimization(
+            pose_graph, registration::GlobalOptimizationLevenbergMarquardt(),
+            criteria, option);
+    const registration::PoseGraph &result = optimizer.GetPoseGraph();
+    ASSERT_EQ(result.edges_.size(), pose_graph.edges_.size());
+    EXPECT_EQ(result.edges_.size(), odometry.size() + loops.size());
+    for (size_t i = 0; i < nodes.size(); i++) {
+        ExpectEQ(result.nodes_[i].pose_, pose_graph.nodes_[i].pose_, 0.0);
+    }
+}
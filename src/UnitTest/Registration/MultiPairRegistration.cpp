@@ -0,0 +1,103 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <Eigen/Dense>
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/MultiPairRegistration.h"
+#include "Open3D/Utility/Parallel.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(MultiPairRegistration, RegisterPointCloudPairs) {
+    auto cloud = std::make_shared<geometry::PointCloud>();
+    cloud->points_.resize(2000);
+    Rand(cloud->points_, Eigen::Vector3d::Zero(), Eigen::Vector3d::Ones(), 0);
+    cloud->EstimateNormals(geometry::KDTreeSearchParamKNN(20));
+
+    std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> transformations;
+    Eigen::Vector6d v;
+    v << 0.02, -0.01, 0.03, 0.01, 0.02, -0.01;
+    transformations.push_back(utility::TransformVector6dToMatrix4d(v));
+    v << 0.5, 0.3, -0.7, 0.4, -0.2, 0.3;
+    transformations.push_back(utility::TransformVector6dToMatrix4d(v));
+
+    std::vector<std::shared_ptr<geometry::PointCloud>> clouds{cloud};
+    for (const auto &transformation : transformations) {
+        clouds.push_back(std::make_shared<geometry::PointCloud>(*cloud));
+        clouds.back()->Transform(transformation);
+    }
+    std::vector<std::shared_ptr<registration::Feature>> features;
+    for (const auto &c : clouds) {
+        features.push_back(registration::ComputeFPFHFeature(
+                *c, geometry::KDTreeSearchParamKNN(50)));
+    }
+
+    std::vector<registration::RegistrationPair> pairs;
+    pairs.emplace_back(0, 1);
+    pairs.emplace_back(0, 3);
+    pairs.emplace_back(0, 2, Eigen::Matrix4d::Identity(), true, true);
+    pairs.emplace_back(2, 0, transformations[1].inverse());
+    registration::MultiPairRegistrationOption option;
+
+    // Global registration matches the features exactly and approximately.
+    for (int checks : {-1, 64}) {
+        option.maximum_feature_checks_ = checks;
+        auto backend = checks > 0 ? utility::ParallelBackend::ThreadPool
+                                  : utility::ParallelBackend::OpenMP;
+        utility::SetParallelBackend(backend);
+        auto edges = registration::RegisterPointCloudPairs(clouds, features,
+                                                           pairs, option);
+        // The pair with the invalid index is skipped.
+        ASSERT_EQ(edges.size(), 3u);
+        std::vector<int> sources{0, 0, 2};
+        std::vector<int> targets{1, 2, 0};
+        std::vector<Eigen::Matrix4d, utility::Matrix4d_allocator> expected{
+                transformations[0], transformations[1],
+                transformations[1].inverse()};
+        for (size_t i = 0; i < edges.size(); i++) {
+            EXPECT_EQ(edges[i].source_node_id_, sources[i]);
+            EXPECT_EQ(edges[i].target_node_id_, targets[i]);
+            EXPECT_EQ(edges[i].uncertain_, i == 1);
+            ExpectEQ(Eigen::Matrix4d(edges[i].transformation_), expected[i],
+                     1e-3);
+            Eigen::Matrix6d information =
+                    registration::GetInformationMatrixFromPointClouds(
+                            *clouds[sources[i]], *clouds[targets[i]],
+                            option.max_correspondence_distance_,
+                            edges[i].transformation_);
+            ExpectEQ(Eigen::Matrix6d(edges[i].information_), information);
+        }
+    }
+    utility::SetParallelBackend(utility::ParallelBackend::OpenMP);
+}
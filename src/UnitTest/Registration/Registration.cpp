@@ -24,8 +24,32 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/FeatureIndex.h"
+#include "Open3D/Registration/Registration.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+void CreateRegistrationPair(geometry::PointCloud &source,
+                            geometry::PointCloud &target,
+                            Eigen::Matrix4d &transformation) {
+    source.points_.resize(1000);
+    Rand(source.points_, Eigen::Vector3d::Zero(), Eigen::Vector3d::Ones(), 0);
+    Eigen::Vector6d v;
+    v << 0.02, -0.01, 0.03, 0.01, 0.02, -0.01;
+    transformation = utility::TransformVector6dToMatrix4d(v);
+    target = source;
+    target.Transform(transformation);
+}
+
+}  // unnamed namespace
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -96,6 +120,84 @@ TEST(Registration, DISABLED_RegistrationRANSACBasedOnFeatureMatching) {
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(Registration, DISABLED_GetInformationMatrixFromPointClouds) {
-    unit_test::NotImplemented();
+TEST(Registration, GetInformationMatrixFromPointClouds) {
+    geometry::PointCloud source, target;
+    Eigen::Matrix4d transformation;
+    CreateRegistrationPair(source, target, transformation);
+    const double max_correspondence_distance = 0.05;
+
+    registration::RegistrationResult result =
+            registration::EvaluateRegistration(source, target,
+                                               max_correspondence_distance,
+                                               transformation);
+    Eigen::Matrix6d ref = Eigen::Matrix6d::Zero();
+    for (const auto &c : result.correspondence_set_) {
+        const Eigen::Vector3d &p = target.points_[c(1)];
+        Eigen::Matrix<double, 3, 6> G;
+        G << 0, p(2), -p(1), 1, 0, 0, -p(2), 0, p(0), 0, 1, 0, p(1), -p(0), 0,
+                0, 0, 1;
+        ref += G.transpose() * G;
+    }
+    EXPECT_EQ(ref(5, 5), (double)source.points_.size());
+
+    ExpectEQ(registration::GetInformationMatrixFromPointClouds(
+                     source, target, max_correspondence_distance,
+                     transformation),
+             ref);
+    ExpectEQ(registration::GetInformationMatrixFromCorrespondences(
+                     target, result.correspondence_set_),
+             ref);
+    ExpectEQ(registration::GetInformationMatrixFromCorrespondences(
+                     target, registration::CorrespondenceSet()),
+             Eigen::Matrix6d(Eigen::Matrix6d::Zero()));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Registration, RegistrationICPWithInformationMatrix) {
+    geometry::PointCloud source, target;
+    Eigen::Matrix4d transformation;
+    CreateRegistrationPair(source, target, transformation);
+    const double max_correspondence_distance = 0.05;
+
+    registration::RegistrationResult result;
+    Eigen::Matrix6d information;
+    std::tie(result, information) =
+            registration::RegistrationICPWithInformationMatrix(
+                    source, target, max_correspondence_distance);
+    registration::RegistrationResult ref = registration::RegistrationICP(
+            source, target, max_correspondence_distance);
+
+    ExpectEQ(Eigen::Matrix4d(result.transformation_),
+             Eigen::Matrix4d(ref.transformation_));
+    EXPECT_NEAR(result.fitness_, ref.fitness_, THRESHOLD_1E_6);
+    EXPECT_NEAR(result.inlier_rmse_, ref.inlier_rmse_, THRESHOLD_1E_6);
+    ExpectEQ(Eigen::Matrix4d(result.transformation_), transformation, 1e-4);
+    ExpectEQ(information,
+             registration::GetInformationMatrixFromPointClouds(
+                     source, target, max_correspondence_distance,
+                     result.transformation_));
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Registration, RegistrationRANSACBasedOnFeatureMatchingWithoutMatches) {
+    geometry::PointCloud source, target;
+    Eigen::Matrix4d transformation;
+    CreateRegistrationPair(source, target, transformation);
+    registration::Feature source_feature;
+    source_feature.Resize(33, int(source.points_.size()));
+    source_feature.data_.setRandom();
+
+    // An index without features finds no match for any source point.
+    const geometry::KDTreeFlann target_kdtree(target);
+    const registration::FeatureIndex target_feature_index;
+    registration::RegistrationResult result =
+            registration::RegistrationRANSACBasedOnFeatureMatching(
+                    source, target, source_feature, target_kdtree,
+                    target_feature_index, 0.05);
+    EXPECT_EQ(0.0, result.fitness_);
+    EXPECT_TRUE(result.correspondence_set_.empty());
 }
@@ -24,8 +24,17 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace open3d;
+using namespace std;
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -56,6 +65,30 @@ TEST(Console, DISABLED_LogInfo) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 TEST(Console, DISABLED_LogDebug) { unit_test::NotImplemented(); }
 
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Console, AsyncLogging) {
+    utility::VerbosityLevel level = utility::GetVerbosityLevel();
+    utility::SetVerbosityLevel(utility::VerbosityLevel::Info);
+
+    testing::internal::CaptureStdout();
+    utility::SetAsyncLogging(true);
+    EXPECT_TRUE(utility::IsAsyncLogging());
+    string expected;
+    for (int i = 0; i < 100; i++) {
+        utility::LogInfo("message {}\n", i);
+        expected += "[Open3D INFO] message " + to_string(i) + "\n";
+    }
+    utility::LogDebug("not printed\n");
+    utility::FlushLog();
+    utility::SetAsyncLogging(false);
+    EXPECT_FALSE(utility::IsAsyncLogging());
+    EXPECT_EQ(expected, testing::internal::GetCapturedStdout());
+
+    utility::SetVerbosityLevel(level);
+}
+
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
@@ -69,7 +102,35 @@ TEST(Console, DISABLED_ResetConsoleProgress) { unit_test::NotImplemented(); }
 // ----------------------------------------------------------------------------
 //
 // ----------------------------------------------------------------------------
-TEST(Console, DISABLED_AdvanceConsoleProgress) { unit_test::NotImplemented(); }
+TEST(Console, AdvanceConsoleProgress) {
+    vector<size_t> reported;
+    utility::SetProgressCallback([&reported](const string &info,
+                                             size_t current_count,
+                                             size_t expected_count) {
+        EXPECT_EQ("Counting", info);
+        EXPECT_EQ(1000u, expected_count);
+        reported.push_back(current_count);
+    });
+    utility::ConsoleProgressBar progress_bar(1000, "Counting");
+    utility::SetProgressCallback(utility::ProgressCallback());
+
+    utility::SetGlobalMaxThreads(4);
+    utility::ParallelFor(0, 1000, [&](int) { ++progress_bar; });
+    utility::SetGlobalMaxThreads(0);
+
+    // Only the steps of the bar are reported, in order, ending at 100%.
+    ASSERT_FALSE(reported.empty());
+    EXPECT_LE(reported.size(), 40u);
+    EXPECT_TRUE(is_sorted(reported.begin(), reported.end()));
+    EXPECT_EQ(1000u, reported.back());
+
+    // Bars created without a callback do not report.
+    utility::ConsoleProgressBar silent_bar(10, "Silent");
+    for (int i = 0; i < 10; i++) {
+        ++silent_bar;
+    }
+    EXPECT_EQ(1000u, reported.back());
+}
 
 // ----------------------------------------------------------------------------
 //
@@ -27,6 +27,10 @@
 #include "Open3D/Utility/Eigen.h"
 #include "TestUtility/UnitTest.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace Eigen;
 using namespace open3d;
 using namespace std;
@@ -274,3 +278,56 @@ TEST(Eigen, ComputeJTJandJTr_vector) {
     ExpectEQ(ref_JTr, JTr);
     ExpectEQ(ref_JTJ, JTJ);
 }
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Eigen, ComputeJTJandJTr_deterministic) {
+    int iteration_num = 5000;
+    vector<Vector6d, utility::Vector6d_allocator> J(iteration_num);
+    vector<double> residuals(iteration_num);
+    for (int i = 0; i < iteration_num; i++) {
+        vector<double> v(6);
+        Rand(v, -1.0, 1.0, i);
+        for (int k = 0; k < 6; k++) J[i](k) = v[k];
+        residuals[i] = (double)(i % 7) / 7;
+    }
+    auto testFunction = [&](int i, Vector6d &J_r, double &r) {
+        J_r = J[i];
+        r = residuals[i];
+    };
+
+    Matrix6d ref_JTJ = Matrix6d::Zero();
+    Vector6d ref_JTr = Vector6d::Zero();
+    for (int i = 0; i < iteration_num; i++) {
+        ref_JTJ += J[i] * J[i].transpose();
+        ref_JTr += J[i] * residuals[i];
+    }
+
+    Matrix6d JTJ;
+    Vector6d JTr;
+    double r2 = 0.0;
+    tie(JTJ, JTr, r2) = utility::ComputeJTJandJTr<Matrix6d, Vector6d>(
+            testFunction, iteration_num);
+    ExpectEQ(ref_JTJ, JTJ);
+    ExpectEQ(ref_JTr, JTr);
+    EXPECT_TRUE(JTJ == JTJ.transpose());
+
+    // Same bits for any number of threads
+#ifdef _OPENMP
+    int num_threads = omp_get_max_threads();
+    omp_set_num_threads(3);
+#endif
+    Matrix6d JTJ_other;
+    Vector6d JTr_other;
+    double r2_other = 0.0;
+    tie(JTJ_other, JTr_other, r2_other) =
+            utility::ComputeJTJandJTr<Matrix6d, Vector6d>(testFunction,
+                                                          iteration_num);
+#ifdef _OPENMP
+    omp_set_num_threads(num_threads);
+#endif
+    EXPECT_TRUE(JTJ == JTJ_other);
+    EXPECT_TRUE(JTr == JTr_other);
+    EXPECT_EQ(r2, r2_other);
+}
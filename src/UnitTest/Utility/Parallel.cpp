@@ -0,0 +1,141 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include "Open3D/Utility/Parallel.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace std;
+
+namespace {
+
+// Calls every index of a nested 2D loop once per backend and checks that
+// no index is skipped or repeated.
+void CheckCoverage(utility::ParallelBackend backend) {
+    utility::SetParallelBackend(backend);
+    const int rows = 37;
+    const int cols = 1001;
+    vector<atomic<int>> counts(rows * cols);
+    for (auto &count : counts) {
+        count = 0;
+    }
+    utility::ParallelFor(0, rows, [&](int r) {
+        utility::ParallelFor(0, cols, [&](int c) {
+            EXPECT_TRUE(utility::IsInParallelRegion());
+            counts[r * cols + c]++;
+        });
+    });
+    for (auto &count : counts) {
+        EXPECT_EQ(1, count.load());
+    }
+    utility::SetParallelBackend(utility::ParallelBackend::OpenMP);
+}
+
+}  // unnamed namespace
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Parallel, ParallelFor) {
+    utility::SetGlobalMaxThreads(4);
+    CheckCoverage(utility::ParallelBackend::OpenMP);
+    CheckCoverage(utility::ParallelBackend::ThreadPool);
+    EXPECT_FALSE(utility::IsInParallelRegion());
+
+    // Empty and reversed ranges call nothing.
+    int calls = 0;
+    utility::ParallelFor(5, 5, [&](int) { calls++; });
+    utility::ParallelFor(5, 0, [&](int) { calls++; });
+    EXPECT_EQ(0, calls);
+    utility::SetGlobalMaxThreads(0);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Parallel, ScopedMaxThreads) {
+    utility::SetGlobalMaxThreads(4);
+    EXPECT_EQ(4, utility::GetMaxThreads());
+    {
+        utility::ScopedMaxThreads outer(2);
+        EXPECT_EQ(2, utility::GetMaxThreads());
+        {
+            utility::ScopedMaxThreads inner(8);
+            // The global limit still applies.
+            EXPECT_EQ(4, utility::GetMaxThreads());
+        }
+        EXPECT_EQ(2, utility::GetMaxThreads());
+
+        for (auto backend : {utility::ParallelBackend::OpenMP,
+                             utility::ParallelBackend::ThreadPool}) {
+            utility::SetParallelBackend(backend);
+            mutex ids_mutex;
+            set<thread::id> ids;
+            utility::ParallelFor(0, 10000, [&](int) {
+                lock_guard<mutex> lock(ids_mutex);
+                ids.insert(this_thread::get_id());
+            });
+            EXPECT_LE(ids.size(), 2u);
+        }
+        utility::SetParallelBackend(utility::ParallelBackend::OpenMP);
+    }
+    EXPECT_EQ(4, utility::GetMaxThreads());
+    utility::SetGlobalMaxThreads(0);
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Parallel, ConcurrentCallers) {
+    utility::SetGlobalMaxThreads(4);
+    utility::SetParallelBackend(utility::ParallelBackend::ThreadPool);
+    const int n = 100000;
+    vector<int64_t> sums(4, 0);
+    vector<thread> callers;
+    for (int t = 0; t < 4; t++) {
+        callers.emplace_back([&sums, t]() {
+            utility::ScopedMaxThreads limit(2);
+            vector<int> values(n, 0);
+            utility::ParallelFor(0, n, [&](int i) { values[i] = i + t; });
+            for (int value : values) {
+                sums[t] += value;
+            }
+        });
+    }
+    for (auto &caller : callers) {
+        caller.join();
+    }
+    for (int t = 0; t < 4; t++) {
+        EXPECT_EQ(int64_t(n) * (n - 1) / 2 + int64_t(n) * t, sums[t]);
+    }
+    utility::SetParallelBackend(utility::ParallelBackend::OpenMP);
+    utility::SetGlobalMaxThreads(0);
+}
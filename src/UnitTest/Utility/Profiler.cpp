@@ -0,0 +1,142 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <json/json.h>
+#include <cstdio>
+#include <fstream>
+
+#include "Open3D/Utility/Profiler.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace std;
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, NestedZones) {
+    utility::Profiler &profiler = utility::Profiler::GetInstance();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+    {
+        utility::ProfileZone outer("outer");
+        profiler.AddPoints(10);
+        for (int i = 0; i < 2; i++) {
+            utility::ProfileZone inner("inner");
+            profiler.AddBytes(100);
+        }
+    }
+    profiler.SetEnabled(false);
+    {
+        // Not recorded while disabled
+        utility::ProfileZone ignored("ignored");
+    }
+
+    vector<utility::ProfileEvent> events = profiler.GetEvents();
+    ASSERT_EQ(3u, events.size());
+    EXPECT_STREQ("outer", events[0].name_);
+    EXPECT_EQ(-1, events[0].parent_);
+    EXPECT_EQ(10, events[0].points_);
+    EXPECT_EQ(0, events[0].bytes_);
+    for (int i = 1; i < 3; i++) {
+        EXPECT_STREQ("inner", events[i].name_);
+        EXPECT_EQ(0, events[i].parent_);
+        EXPECT_EQ(100, events[i].bytes_);
+        EXPECT_GE(events[i].begin_us_, events[0].begin_us_);
+        EXPECT_LE(events[i].begin_us_ + events[i].duration_us_,
+                  events[0].begin_us_ + events[0].duration_us_);
+    }
+    profiler.Clear();
+    EXPECT_TRUE(profiler.GetEvents().empty());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, WriteChromeTrace) {
+    utility::Profiler &profiler = utility::Profiler::GetInstance();
+    profiler.Clear();
+    profiler.SetEnabled(true);
+    {
+        utility::ProfileZone zone("zone \"quoted\"");
+        profiler.AddPoints(5);
+    }
+    profiler.SetEnabled(false);
+
+    const string filename = "test_profiler_trace.json";
+    EXPECT_TRUE(profiler.WriteChromeTrace(filename));
+    profiler.Clear();
+
+    ifstream file(filename);
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    Json::CharReaderBuilder::strictMode(&builder.settings_);
+    string errs;
+    ASSERT_TRUE(Json::parseFromStream(builder, file, &root, &errs));
+    const Json::Value &trace_events = root["traceEvents"];
+    ASSERT_TRUE(trace_events.isArray());
+    int num_zones = 0;
+    for (const auto &event : trace_events) {
+        if (event["ph"].asString() != "X") continue;
+        num_zones++;
+        EXPECT_EQ("zone \"quoted\"", event["name"].asString());
+        EXPECT_EQ(5, event["args"]["points"].asInt());
+        EXPECT_GE(event["dur"].asDouble(), 0.0);
+    }
+    EXPECT_EQ(1, num_zones);
+    file.close();
+    remove(filename.c_str());
+}
+
+// ----------------------------------------------------------------------------
+//
+// ----------------------------------------------------------------------------
+TEST(Profiler, WriteChromeTraceWithoutEvents) {
+    utility::Profiler &profiler = utility::Profiler::GetInstance();
+    profiler.SetEnabled(true);
+    { utility::ProfileZone zone("zone"); }
+    profiler.SetEnabled(false);
+    // Keeps the thread records, so only metadata records are written.
+    profiler.Clear();
+
+    const string filename = "test_profiler_empty_trace.json";
+    EXPECT_TRUE(profiler.WriteChromeTrace(filename));
+
+    ifstream file(filename);
+    Json::Value root;
+    Json::CharReaderBuilder builder;
+    Json::CharReaderBuilder::strictMode(&builder.settings_);
+    string errs;
+    EXPECT_TRUE(Json::parseFromStream(builder, file, &root, &errs)) << errs;
+    const Json::Value &trace_events = root["traceEvents"];
+    ASSERT_TRUE(trace_events.isArray());
+    EXPECT_GE(trace_events.size(), 1u);
+    for (const auto &event : trace_events) {
+        EXPECT_EQ("M", event["ph"].asString());
+    }
+    file.close();
+    remove(filename.c_str());
+}